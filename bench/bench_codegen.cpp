@@ -0,0 +1,44 @@
+/// @file bench_codegen.cpp
+/// @brief Benchmarks a generated straight-line evaluator against propagate_packed()
+///
+/// eval_rca512_nand is generated by gateflow_cli --emit-cpp at build time
+/// (see bench/CMakeLists.txt). Both sides evaluate the same 64 vectors.
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/nand_decompose.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace gateflow;
+
+extern "C" void eval_rca512_nand(const uint64_t* in, uint64_t* out);
+extern "C" const uint64_t eval_rca512_nand_structural_hash;
+
+TEST_CASE("Generated evaluator vs propagate_packed", "[bench][codegen]") {
+    auto circuit = build_ripple_carry_adder(512);
+    decompose_to_nand(*circuit);
+    REQUIRE(circuit->structural_hash() == eval_rca512_nand_structural_hash);
+
+    std::mt19937_64 rng(3);
+    std::vector<uint64_t> in(circuit->num_inputs());
+    for (size_t i = 0; i < in.size(); i++) {
+        in[i] = rng();
+        circuit->set_input_packed(i, in[i]);
+    }
+    std::vector<uint64_t> out(circuit->num_outputs());
+
+    BENCHMARK("propagate_packed 512-bit NAND") {
+        circuit->propagate_packed();
+        return circuit->get_output_packed(0);
+    };
+    BENCHMARK("generated evaluator 512-bit NAND") {
+        eval_rca512_nand(in.data(), out.data());
+        return out[0];
+    };
+}
@@ -0,0 +1,82 @@
+/// @file bench_finalize.cpp
+/// @brief Benchmarks finalize() on million-gate netlists, including high fan-out,
+///        against loading the same netlist from a stored file image
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/nand_decompose.hpp"
+#include "simulation/netlist_file.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace gateflow;
+
+namespace {
+
+/// One primary input driving @p fanout NOT gates, each with its own output.
+/// A quadratic connectivity check shows up immediately on this shape.
+std::unique_ptr<Circuit> build_fanout_star(int fanout) {
+    auto circuit = std::make_unique<Circuit>();
+    Wire* hub = circuit->add_wire();
+    circuit->mark_input(hub);
+    for (int i = 0; i < fanout; i++) {
+        Gate* gate = circuit->add_gate(GateType::NOT);
+        Wire* out = circuit->add_wire();
+        circuit->mark_output(out);
+        circuit->connect(hub, nullptr, gate);
+        circuit->connect(out, gate, nullptr);
+    }
+    return circuit;
+}
+
+} // namespace
+
+TEST_CASE("finalize() on a 1M-gate ripple-carry adder", "[bench][finalize]") {
+    // 2 gates for bit 0 plus 5 per further bit
+    constexpr int BITS = 200'000;
+    auto circuit = build_ripple_carry_adder(BITS);
+    REQUIRE(circuit->gates().size() == 2 + 5 * (BITS - 1));
+
+    BENCHMARK("finalize 1M gates") {
+        circuit->finalize();
+        return circuit->compiled().num_levels();
+    };
+}
+
+TEST_CASE("finalize() on a 1M-way fan-out star", "[bench][finalize]") {
+    auto circuit = build_fanout_star(1'000'000);
+
+    BENCHMARK("finalize 1M fan-out") {
+        circuit->finalize();
+        return circuit->compiled().num_levels();
+    };
+
+    // Every NOT reads the hub, so unlinking gates from it one by one would be quadratic here
+    BENCHMARK_ADVANCED("decompose_to_nand 100k fan-out")(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::unique_ptr<Circuit>> stars(static_cast<size_t>(meter.runs()));
+        for (auto& star : stars) {
+            star = build_fanout_star(100'000);
+            star->finalize();
+        }
+        meter.measure([&](int i) { decompose_to_nand(*stars[static_cast<size_t>(i)]); });
+    };
+}
+
+TEST_CASE("Loading a 1M-gate netlist file image", "[bench][finalize]") {
+    constexpr int BITS = 200'000;
+    auto circuit = build_ripple_carry_adder(BITS);
+    const NetlistFile file = NetlistFile::from_bytes(serialize_netlist(*circuit));
+
+    BENCHMARK("rebuild 1M gates") {
+        auto rebuilt = build_ripple_carry_adder(BITS);
+        return rebuilt->compiled().num_levels();
+    };
+    BENCHMARK("load_circuit 1M gates") {
+        auto loaded = load_circuit(file);
+        return loaded->compiled().num_levels();
+    };
+}
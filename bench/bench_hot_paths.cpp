@@ -0,0 +1,188 @@
+/// @file bench_hot_paths.cpp
+/// @brief Benchmarks each layer's hot path on 8- to 4096-bit adders, logical and NAND
+///
+/// Every case runs once per (bits, NAND) combination, and the benchmark
+/// names carry both, so reporter output can be compared across runs, e.g.
+///   gateflow_bench "[hot_path]" --reporter xml::out=bench.xml
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "rendering/animation_state.hpp"
+#include "rendering/layout_engine.hpp"
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/fault_simulator.hpp"
+#include "simulation/nand_decompose.hpp"
+#include "timing/propagation_scheduler.hpp"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gateflow;
+
+namespace {
+
+constexpr float FRAME_DT = 1.0f / 60.0f;
+
+/// Cap on simulated frames per playback, well above any adder's depth
+constexpr int MAX_PLAYBACK_FRAMES = 1'000'000;
+
+/// Test-set size for the fault simulation benchmark
+constexpr size_t FAULT_VECTORS = 4096;
+
+/// Builds a finalized adder, optionally decomposed to NAND gates
+std::unique_ptr<Circuit> make_adder(int bits, bool nand) {
+    auto circuit = build_ripple_carry_adder(bits);
+    if (nand) {
+        decompose_to_nand(*circuit);
+    }
+    return circuit;
+}
+
+/// "<what> <bits>-bit[ NAND]", so each parameter set has a distinct name
+std::string bench_name(const char* what, int bits, bool nand) {
+    return std::string(what) + " " + std::to_string(bits) + "-bit" + (nand ? " NAND" : "");
+}
+
+/// A = all ones, B = 0, so toggling B's bit 0 ripples the whole carry chain
+void set_carry_chain_inputs(Circuit& circuit, int bits) {
+    for (int i = 0; i < bits; i++) {
+        circuit.set_input(static_cast<size_t>(i), true);
+        circuit.set_input(static_cast<size_t>(bits + i), false);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Circuit construction and finalize", "[bench][hot_path]") {
+    const int bits = GENERATE(8, 64, 512, 4096);
+    const bool nand = GENERATE(false, true);
+
+    if (!nand) {
+        BENCHMARK(bench_name("build_ripple_carry_adder", bits, false)) {
+            return build_ripple_carry_adder(bits);
+        };
+    } else {
+        // Stamps cells decomposed once, against decomposing the whole adder
+        BENCHMARK(bench_name("build_ripple_carry_adder", bits, true)) {
+            return build_ripple_carry_adder(bits, true);
+        };
+        BENCHMARK_ADVANCED(bench_name("decompose_to_nand", bits, false))
+        (Catch::Benchmark::Chronometer meter) {
+            std::vector<std::unique_ptr<Circuit>> circuits(static_cast<size_t>(meter.runs()));
+            for (auto& circuit : circuits) {
+                circuit = build_ripple_carry_adder(bits);
+            }
+            meter.measure([&](int i) { decompose_to_nand(*circuits[static_cast<size_t>(i)]); });
+        };
+    }
+
+    auto circuit = make_adder(bits, nand);
+    BENCHMARK(bench_name("finalize", bits, nand)) {
+        circuit->finalize();
+        return circuit->compiled().num_levels();
+    };
+}
+
+TEST_CASE("Incremental propagate", "[bench][hot_path]") {
+    const int bits = GENERATE(8, 64, 512, 4096);
+    const bool nand = GENERATE(false, true);
+
+    auto circuit = make_adder(bits, nand);
+    set_carry_chain_inputs(*circuit, bits);
+    (void)circuit->propagate();
+
+    PropagationResult result;
+    bool carry_in = false;
+    BENCHMARK(bench_name("propagate carry chain", bits, nand)) {
+        carry_in = !carry_in;
+        circuit->set_input(static_cast<size_t>(bits), carry_in);
+        circuit->propagate(result);
+        return result.changed_gates.size();
+    };
+}
+
+TEST_CASE("Stuck-at fault simulation", "[bench][hot_path]") {
+    const int bits = GENERATE(8, 64, 512);
+    const bool nand = GENERATE(false, true);
+
+    // Random vectors detect nearly every adder fault within the first batch
+    // or two, so this mostly measures the first batches and fault dropping
+    auto circuit = make_adder(bits, nand);
+    std::mt19937_64 rng(1);
+    std::vector<std::vector<bool>> vectors(FAULT_VECTORS, std::vector<bool>(circuit->num_inputs()));
+    for (auto& v : vectors) {
+        for (size_t i = 0; i < v.size(); i++) {
+            v[i] = (rng() & 1) != 0;
+        }
+    }
+    BENCHMARK(bench_name("FaultSimulator all faults", bits, nand)) {
+        FaultSimulator sim(*circuit);
+        for (const auto& v : vectors) {
+            sim.add_vector(v);
+        }
+        sim.flush();
+        return sim.num_detected();
+    };
+}
+
+TEST_CASE("PropagationScheduler and AnimationState", "[bench][hot_path]") {
+    const int bits = GENERATE(8, 64, 512, 4096);
+    const bool nand = GENERATE(false, true);
+
+    auto circuit = make_adder(bits, nand);
+    set_carry_chain_inputs(*circuit, bits);
+    (void)circuit->propagate();
+
+    BENCHMARK(bench_name("PropagationScheduler construction", bits, nand)) {
+        PropagationScheduler scheduler(circuit.get());
+        return scheduler.max_depth();
+    };
+
+    // One depth per 60 Hz frame, from reset until every gate has resolved
+    PropagationScheduler scheduler(circuit.get());
+    scheduler.set_speed(1.0f / FRAME_DT);
+    BENCHMARK(bench_name("PropagationScheduler playback", bits, nand)) {
+        scheduler.reset();
+        int frames = 0;
+        while (!scheduler.is_complete() && frames < MAX_PLAYBACK_FRAMES) {
+            scheduler.tick(FRAME_DT);
+            frames++;
+        }
+        return frames;
+    };
+
+    // Same playback with AnimationState::update per frame, until it settles
+    AnimationState anim(circuit.get());
+    BENCHMARK(bench_name("AnimationState playback", bits, nand)) {
+        scheduler.reset();
+        anim.reset();
+        int frames = 0;
+        while ((!scheduler.is_complete() || !anim.is_settled()) && frames < MAX_PLAYBACK_FRAMES) {
+            scheduler.tick(FRAME_DT);
+            anim.update(FRAME_DT, scheduler);
+            frames++;
+        }
+        return frames;
+    };
+}
+
+TEST_CASE("compute_layout", "[bench][hot_path]") {
+    const int bits = GENERATE(8, 64, 512, 4096);
+    const bool nand = GENERATE(false, true);
+
+    auto circuit = make_adder(bits, nand);
+    BENCHMARK(bench_name("compute_layout", bits, nand)) {
+        return compute_layout(*circuit);
+    };
+
+    // Wire routing splits across the circuit's pool
+    circuit->set_parallelism(0);
+    BENCHMARK(bench_name("compute_layout parallel", bits, nand)) {
+        return compute_layout(*circuit);
+    };
+}
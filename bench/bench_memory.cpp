@@ -0,0 +1,65 @@
+/// @file bench_memory.cpp
+/// @brief Prints the heap bytes and allocations of every per-circuit structure
+///
+/// Not timed: each section prints one table per adder width and variant,
+/// by structure and category, so a memory regression shows up next to
+/// the timings in gateflow_bench output. Run with
+///   gateflow_bench "[memory]"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "rendering/animation_state.hpp"
+#include "rendering/layout_engine.hpp"
+#include "rendering/spatial_index.hpp"
+#include "rendering/wire_geometry.hpp"
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/memory_usage.hpp"
+#include "simulation/nand_decompose.hpp"
+#include "timing/propagation_scheduler.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace gateflow;
+
+TEST_CASE("Memory usage per structure", "[bench][memory]") {
+    const int bits = GENERATE(8, 64, 512);
+    const bool nand = GENERATE(false, true);
+
+    auto circuit = build_ripple_carry_adder(bits);
+    if (nand) {
+        decompose_to_nand(*circuit);
+    }
+    const Layout layout = compute_layout(*circuit);
+    PropagationScheduler scheduler(circuit.get());
+    AnimationState anim(circuit.get());
+    scheduler.tick(scheduler.end_time() + 1.0f); // Every gate resolved
+    anim.update(0.0f, scheduler);
+    WireGeometry geometry;
+    geometry.update(*circuit, layout, 40.0f, {0.0f, 0.0f});
+    const SpatialIndex index(layout);
+
+    const std::vector<NamedMemoryUsage> report = {
+        {"Circuit", circuit->memory_usage()},   {"Layout", layout.memory_usage()},
+        {"Scheduler", scheduler.memory_usage()}, {"Animation", anim.memory_usage()},
+        {"Wire geometry", geometry.memory_usage()}, {"Spatial index", index.memory_usage()},
+    };
+
+    size_t total_bytes = 0;
+    size_t total_allocations = 0;
+    std::printf("\nmemory: %d-bit%s, %zu gates, %zu wires\n", bits, nand ? " NAND" : "",
+                circuit->gates().size(), circuit->wires().size());
+    std::printf("  %-14s %-18s %12s %8s\n", "structure", "category", "bytes", "allocs");
+    for (const NamedMemoryUsage& entry : report) {
+        for (const MemoryCategory& c : entry.usage.categories) {
+            std::printf("  %-14s %-18s %12zu %8zu\n", entry.name.c_str(), c.name.c_str(), c.bytes,
+                        c.allocations);
+        }
+        total_bytes += entry.usage.total_bytes();
+        total_allocations += entry.usage.total_allocations();
+    }
+    std::printf("  %-33s %12zu %8zu\n", "total", total_bytes, total_allocations);
+    CHECK(total_bytes > 0);
+}
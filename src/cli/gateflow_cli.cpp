@@ -0,0 +1,583 @@
+/// @file gateflow_cli.cpp
+/// @brief Headless batch simulator — streams input vectors through a built circuit
+///
+/// Links only the simulation and timing layers, so it runs without a window
+/// or GPU. Each input line is one vector, applied on top of the previous one
+/// and propagated incrementally. Each output line carries the circuit's
+/// outputs and the settling depth of that transition.
+///
+/// Usage:
+///   gateflow_cli [--builder NAME] [--bits N | --load FILE] [--nand] [--optimize] [-i FILE]
+///                [-o FILE] [--vcd FILE [--delay-time]] [--quiet]
+///   gateflow_cli [--builder NAME] [--bits N | --load FILE] [--nand] [--optimize] --save FILE
+///   gateflow_cli [--builder NAME] [--bits N | --load FILE] [--nand] [--optimize] --faults
+///                [-i FILE] [-o FILE] [--quiet]
+///   gateflow_cli [--builder NAME] [--bits N | --load FILE] [--nand] [--optimize]
+///                --emit-cpp FILE [--function NAME]
+///   gateflow_cli --report [--nand] [--optimize] [-o FILE]
+///
+/// Input lines (blank lines and lines starting with '#' are skipped):
+///   "A B"     two unsigned integers, for adders up to 63 bits
+///   "0110..." one bit per primary input, index 0 first
+/// Output lines mirror the input form of that line:
+///   "SUM DEPTH" or "<one bit per primary output> DEPTH"
+///
+/// DEPTH is the number of levels the change rippled through:
+/// the deepest gate whose state changed, plus 1 (0 = nothing changed).
+/// Throughput and depth statistics go to stderr unless --quiet is given.
+///
+/// --load reads the circuit from a netlist file (see netlist_file.hpp)
+/// instead of building it; --save writes the finished circuit to one and
+/// exits, so large circuits can be prebaked once and loaded instantly.
+///
+/// --vcd streams every wire change to a VCD trace, one window per vector,
+/// stamped in depth time or (with --delay-time) in typical gate-delay time.
+///
+/// --faults grades the input vectors as a test set instead: every gate's
+/// output stuck at 0 and at 1 is fault-simulated over all of them (see
+/// fault_simulator.hpp), and the output is one line per gate, "ID TYPE SA0
+/// SA1" with the index of the first vector detecting each fault ('-' if
+/// none), then "coverage DETECTED/FAULTS PERCENT%".
+///
+/// --emit-cpp writes the circuit as a straight-line C++ evaluator over
+/// 64-lane words (see codegen.hpp) and exits; --function names the
+/// generated function (default gateflow_eval).
+///
+/// --report builds every adder at 7, 32 and 64 bits instead and prints a
+/// table of gate counts against scheduler depth.
+
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/codegen.hpp"
+#include "simulation/fault_simulator.hpp"
+#include "simulation/nand_decompose.hpp"
+#include "simulation/netlist_file.hpp"
+#include "simulation/optimize.hpp"
+#include "timing/propagation_scheduler.hpp"
+#include "timing/static_timing.hpp"
+#include "timing/vcd_writer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t IO_BUFFER_BYTES = 1 << 20;
+
+/// An adder builder selectable with --builder
+struct Builder {
+    const char* name;
+    const char* description;
+    std::unique_ptr<gateflow::Circuit> (*build)(int bits);
+};
+
+const Builder BUILDERS[] = {
+    {"rca", "ripple-carry", [](int bits) { return gateflow::build_ripple_carry_adder(bits); }},
+    {"ks", "Kogge-Stone", &gateflow::build_kogge_stone_adder},
+    {"bk", "Brent-Kung", &gateflow::build_brent_kung_adder},
+    {"csa", "carry-select (4-bit blocks)",
+     [](int bits) { return gateflow::build_carry_select_adder(bits); }},
+};
+
+constexpr int REPORT_WIDTHS[] = {7, 32, 64};
+
+struct Options {
+    std::string builder = "rca";
+    int bits = 8;
+    bool nand = false;
+    bool optimize = false;
+    bool report = false;
+    std::string load_path;
+    std::string save_path;
+    std::string emit_cpp_path;
+    std::string function_name = "gateflow_eval";
+    std::string input_path = "-";
+    std::string output_path = "-";
+    std::string vcd_path;
+    bool delay_time = false;
+    bool faults = false;
+    bool quiet = false;
+};
+
+void print_usage(std::FILE* out) {
+    std::fputs("usage: gateflow_cli [--builder NAME] [--bits N | --load FILE] [--nand] [--optimize]\n"
+               "                   [-i FILE] [-o FILE] [--vcd FILE [--delay-time]] [--quiet]\n"
+               "       gateflow_cli [--builder NAME] [--bits N | --load FILE] [--nand] [--optimize]\n"
+               "                   --save FILE\n"
+               "       gateflow_cli [--builder NAME] [--bits N | --load FILE] [--nand] [--optimize]\n"
+               "                   --faults [-i FILE] [-o FILE] [--quiet]\n"
+               "       gateflow_cli [--builder NAME] [--bits N | --load FILE] [--nand] [--optimize]\n"
+               "                   --emit-cpp FILE [--function NAME]\n"
+               "       gateflow_cli --report [--nand] [--optimize] [-o FILE]\n"
+               "  --builder NAME  adder to build: rca (ripple-carry, default), ks (Kogge-Stone),\n"
+               "                  bk (Brent-Kung), csa (carry-select)\n"
+               "  --bits N        adder width (default 8)\n"
+               "  --nand          decompose the circuit to NAND gates\n"
+               "  --optimize      merge equivalent gates and drop dead ones (after --nand)\n"
+               "  --load FILE     read the circuit from a netlist file instead of building it\n"
+               "  --save FILE     write the circuit to a netlist file and exit\n"
+               "  -i FILE         input vectors (default: stdin)\n"
+               "  -o FILE         output file (default: stdout)\n"
+               "  --vcd FILE      stream every wire change to a VCD trace, one window per vector\n"
+               "  --delay-time    stamp the trace in typical gate-delay time instead of depth\n"
+               "  --faults        grade the vectors: first vector detecting each gate's\n"
+               "                  stuck-at-0/1 fault, and the fault coverage\n"
+               "  --emit-cpp FILE write a straight-line C++ evaluator of the circuit and exit\n"
+               "  --function NAME name of the generated evaluator (default gateflow_eval)\n"
+               "  --quiet         do not print statistics to stderr\n"
+               "  --report        print gates and depth of every adder at 7, 32 and 64 bits\n",
+               out);
+}
+
+/// Parses argv into Options; exits on --help.
+/// @throws std::invalid_argument on an unknown or incomplete option
+Options parse_options(int argc, char** argv) {
+    Options opts;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--builder") {
+            opts.builder = value();
+        } else if (arg == "--bits") {
+            opts.bits = std::stoi(value());
+        } else if (arg == "--nand") {
+            opts.nand = true;
+        } else if (arg == "--optimize") {
+            opts.optimize = true;
+        } else if (arg == "--load") {
+            opts.load_path = value();
+        } else if (arg == "--save") {
+            opts.save_path = value();
+        } else if (arg == "--emit-cpp") {
+            opts.emit_cpp_path = value();
+        } else if (arg == "--function") {
+            opts.function_name = value();
+        } else if (arg == "-i" || arg == "--input") {
+            opts.input_path = value();
+        } else if (arg == "-o" || arg == "--output") {
+            opts.output_path = value();
+        } else if (arg == "--vcd") {
+            opts.vcd_path = value();
+        } else if (arg == "--delay-time") {
+            opts.delay_time = true;
+        } else if (arg == "--faults") {
+            opts.faults = true;
+        } else if (arg == "--quiet") {
+            opts.quiet = true;
+        } else if (arg == "--report") {
+            opts.report = true;
+        } else if (arg == "-h" || arg == "--help") {
+            print_usage(stdout);
+            std::exit(0);
+        } else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+    if (opts.bits < 1) {
+        throw std::invalid_argument("--bits must be at least 1");
+    }
+    if (opts.delay_time && opts.vcd_path.empty()) {
+        throw std::invalid_argument("--delay-time needs --vcd");
+    }
+    if (opts.faults && !opts.vcd_path.empty()) {
+        throw std::invalid_argument("--faults cannot be combined with --vcd");
+    }
+    return opts;
+}
+
+/// Maps and loads --load's netlist file
+std::unique_ptr<gateflow::Circuit> load_circuit_file(const Options& opts) {
+    const auto start = std::chrono::steady_clock::now();
+    const gateflow::NetlistFile file = gateflow::NetlistFile::open(opts.load_path);
+    std::unique_ptr<gateflow::Circuit> circuit = gateflow::load_circuit(file);
+    const auto stop = std::chrono::steady_clock::now();
+    if (!opts.quiet) {
+        std::fprintf(stderr, "load: %zu gates from %s in %.3f ms (%s%s)\n",
+                     circuit->gates().size(), opts.load_path.c_str(),
+                     std::chrono::duration<double, std::milli>(stop - start).count(),
+                     file.is_mapped() ? "mapped" : "read",
+                     file.has_compiled() ? ", precompiled" : "");
+    }
+    return circuit;
+}
+
+/// Builds (or loads) the circuit, then applies --nand and --optimize.
+/// @throws std::invalid_argument for an unknown builder name
+std::unique_ptr<gateflow::Circuit> build_circuit(const Options& opts) {
+    std::unique_ptr<gateflow::Circuit> circuit;
+    if (!opts.load_path.empty()) {
+        circuit = load_circuit_file(opts);
+    } else {
+        auto it = std::find_if(std::begin(BUILDERS), std::end(BUILDERS),
+                               [&](const Builder& b) { return opts.builder == b.name; });
+        if (it == std::end(BUILDERS)) {
+            throw std::invalid_argument("Unknown builder: " + opts.builder);
+        }
+        circuit = it->build(opts.bits);
+    }
+    if (opts.nand) {
+        gateflow::decompose_to_nand(*circuit);
+    }
+    if (opts.optimize) {
+        const gateflow::OptimizeStats st = gateflow::optimize(*circuit);
+        if (!opts.quiet) {
+            std::fprintf(stderr, "optimize: %zu -> %zu gates, depth %zu -> %zu\n",
+                         st.gates_before, st.gates_after, st.depth_before, st.depth_after);
+        }
+    }
+    return circuit;
+}
+
+/// Writes gate count and scheduler max_depth for every builder and width
+void write_report(const Options& opts, std::FILE* out) {
+    std::fprintf(out, "%-28s", "");
+    for (int bits : REPORT_WIDTHS) {
+        const std::string width = std::to_string(bits) + "-bit";
+        std::fprintf(out, "  %12s", width.c_str());
+    }
+    std::fprintf(out, "\n%-28s", opts.nand ? "adder (NAND)" : "adder");
+    for (size_t i = 0; i < std::size(REPORT_WIDTHS); i++) {
+        std::fputs("  gates  depth", out);
+    }
+    std::fputc('\n', out);
+
+    for (const Builder& builder : BUILDERS) {
+        std::fprintf(out, "%-28s", builder.description);
+        for (int bits : REPORT_WIDTHS) {
+            Options one = opts;
+            one.builder = builder.name;
+            one.bits = bits;
+            one.quiet = true;
+            auto circuit = build_circuit(one);
+            gateflow::PropagationScheduler scheduler(circuit.get());
+            std::fprintf(out, "  %5zu  %5d", circuit->gates().size(), scheduler.max_depth());
+        }
+        std::fputc('\n', out);
+    }
+}
+
+/// Opens a stdio stream ("-" = stdin/stdout) with a large buffer
+std::FILE* open_stream(const std::string& path, const char* mode, std::FILE* standard) {
+    std::FILE* f = (path == "-") ? standard : std::fopen(path.c_str(), mode);
+    if (f == nullptr) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    std::setvbuf(f, nullptr, _IOFBF, IO_BUFFER_BYTES);
+    return f;
+}
+
+/// Reads one line (without the newline) into @p line; false at end of input
+bool read_line(std::FILE* in, std::string& line) {
+    line.clear();
+    char chunk[4096];
+    while (std::fgets(chunk, sizeof(chunk), in) != nullptr) {
+        size_t len = std::strlen(chunk);
+        if (len > 0 && chunk[len - 1] == '\n') {
+            line.append(chunk, len - 1);
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            return true;
+        }
+        line.append(chunk, len);
+    }
+    return !line.empty();
+}
+
+/// Totals over a run, for the summary line
+struct Stats {
+    uint64_t vectors = 0;
+    uint64_t depth_sum = 0;
+    int max_depth = 0;
+};
+
+/// Parses one input line into @p words, one bit per primary input laid out
+/// as Circuit::set_inputs() reads them (@p words holds at least
+/// (n_in + 63) / 64 words). Returns true for the bit-string form, false for "A B".
+/// @throws std::invalid_argument if the line is malformed
+bool parse_vector(const std::string& line, size_t line_no, size_t n_in,
+                  std::vector<uint64_t>& words) {
+    std::fill(words.begin(), words.end(), uint64_t{0});
+    if (line.find_first_not_of("01") == std::string::npos) {
+        if (line.size() != n_in) {
+            throw std::invalid_argument("Line " + std::to_string(line_no) + ": expected " +
+                                        std::to_string(n_in) + " input bits, got " +
+                                        std::to_string(line.size()));
+        }
+        for (size_t i = 0; i < n_in; i++) {
+            words[i / 64] |= uint64_t{line[i] == '1'} << (i % 64);
+        }
+        return true;
+    }
+
+    // The two N-bit operands of an adder
+    const size_t bits = n_in / 2;
+    if (n_in % 2 != 0 || bits > 63) {
+        throw std::invalid_argument("Line " + std::to_string(line_no) +
+                                    ": \"A B\" form needs a 2x(<=63)-input adder; use bits");
+    }
+    char* end = nullptr;
+    const char* p = line.c_str();
+    errno = 0;
+    unsigned long long a = std::strtoull(p, &end, 10);
+    const char* after_a = end;
+    unsigned long long b = std::strtoull(after_a, &end, 10);
+    while (*end == ' ' || *end == '\t') {
+        end++;
+    }
+    if (after_a == p || end == after_a || *end != '\0' || errno == ERANGE) {
+        throw std::invalid_argument("Line " + std::to_string(line_no) +
+                                    ": expected \"A B\" or a bit string");
+    }
+    const unsigned long long limit = 1ULL << bits;
+    if (a >= limit || b >= limit) {
+        throw std::invalid_argument("Line " + std::to_string(line_no) + ": operand exceeds " +
+                                    std::to_string(bits) + " bits");
+    }
+    // A is inputs [0, bits), B is [bits, 2 * bits), which may spill into word 1
+    if (bits > 0) {
+        words[0] = a | b << bits;
+        if (const uint64_t high = b >> (64 - bits); high != 0) {
+            words[1] = high;
+        }
+    }
+    return false;
+}
+
+class VectorRunner {
+  public:
+    /// @param trace Optional VCD sink for every propagated vector
+    VectorRunner(gateflow::Circuit& circuit, std::FILE* out, gateflow::VcdWriter* trace)
+        : circuit_(circuit), scheduler_(&circuit), out_(out), trace_(trace),
+          inputs_((circuit.num_inputs() + 63) / 64), outputs_((circuit.num_outputs() + 63) / 64) {}
+
+    /// Applies one input line and writes its output line.
+    /// @throws std::invalid_argument if the line is malformed
+    void run_line(const std::string& line, size_t line_no) {
+        const bool bit_form = parse_vector(line, line_no, circuit_.num_inputs(), inputs_);
+        circuit_.set_inputs(inputs_.data());
+
+        circuit_.propagate(result_);
+        if (trace_ != nullptr) {
+            trace_->record(result_);
+        }
+        const int depth = settle_depth();
+        stats_.vectors++;
+        stats_.depth_sum += static_cast<uint64_t>(depth);
+        stats_.max_depth = std::max(stats_.max_depth, depth);
+
+        out_line_.clear();
+        circuit_.read_outputs(outputs_.data());
+        if (bit_form) {
+            for (size_t i = 0; i < circuit_.num_outputs(); i++) {
+                out_line_.push_back(((outputs_[i / 64] >> (i % 64)) & 1) != 0 ? '1' : '0');
+            }
+        } else {
+            out_line_ += std::to_string(outputs_[0]); // N + 1 <= 64 sum bits
+        }
+        out_line_.push_back(' ');
+        out_line_ += std::to_string(depth);
+        out_line_.push_back('\n');
+        std::fwrite(out_line_.data(), 1, out_line_.size(), out_);
+    }
+
+    [[nodiscard]] const Stats& stats() const { return stats_; }
+
+  private:
+    /// Levels the last propagation rippled through (0 = no gate changed)
+    [[nodiscard]] int settle_depth() const {
+        int deepest = -1;
+        for (const gateflow::Gate* gate : result_.changed_gates) {
+            deepest = std::max(deepest, scheduler_.gate_depth(gate));
+        }
+        return deepest + 1;
+    }
+
+    gateflow::Circuit& circuit_;
+    gateflow::PropagationScheduler scheduler_; // Used for its per-gate depths
+    std::FILE* out_;
+    gateflow::VcdWriter* trace_;
+    gateflow::PropagationResult result_;
+    std::vector<uint64_t> inputs_;  // Packed as Circuit::set_inputs() reads them
+    std::vector<uint64_t> outputs_; // Packed by Circuit::read_outputs()
+    std::string out_line_;
+    Stats stats_;
+};
+
+/// --faults: grades every input line as one test vector and writes the
+/// per-gate detections and the coverage
+void write_fault_report(const Options& opts, const gateflow::Circuit& circuit, std::FILE* in,
+                        std::FILE* out) {
+    gateflow::FaultSimulator sim(circuit);
+    std::vector<uint64_t> inputs((circuit.num_inputs() + 63) / 64);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::string line;
+    size_t line_no = 0;
+    while (read_line(in, line)) {
+        line_no++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        (void)parse_vector(line, line_no, circuit.num_inputs(), inputs);
+        sim.add_vector(inputs.data());
+    }
+    sim.flush();
+    const auto stop = std::chrono::steady_clock::now();
+
+    auto detection = [](int64_t vector) {
+        return vector == gateflow::FaultSimulator::UNDETECTED ? std::string("-")
+                                                               : std::to_string(vector);
+    };
+    for (const gateflow::Gate* gate : circuit.gates()) {
+        if (gate->get_output() == nullptr) {
+            continue; // Drives nothing, so it has no fault site
+        }
+        const std::string type(gateflow::gate_type_name(gate->get_type()));
+        std::fprintf(out, "%u %s %s %s\n", gate->get_id(), type.c_str(),
+                     detection(sim.detecting_vector(gate, false)).c_str(),
+                     detection(sim.detecting_vector(gate, true)).c_str());
+    }
+    std::fprintf(out, "coverage %zu/%zu %.2f%%\n", sim.num_detected(), sim.num_faults(),
+                 100.0 * sim.coverage());
+
+    if (!opts.quiet) {
+        std::fprintf(stderr, "faults: %zu stuck-at faults, %llu vectors in %.3f s\n",
+                     sim.num_faults(), static_cast<unsigned long long>(sim.vectors()),
+                     std::chrono::duration<double>(stop - start).count());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const Options opts = parse_options(argc, argv);
+        if (opts.report) {
+            std::FILE* out = open_stream(opts.output_path, "w", stdout);
+            write_report(opts, out);
+            std::fflush(out);
+            if (out != stdout) {
+                std::fclose(out);
+            }
+            return 0;
+        }
+
+        auto circuit = build_circuit(opts);
+        if (!opts.save_path.empty()) {
+            gateflow::save_netlist(*circuit, opts.save_path);
+            if (!opts.quiet) {
+                std::fprintf(stderr, "save: %zu gates, %zu wires to %s\n",
+                             circuit->gates().size(), circuit->wires().size(),
+                             opts.save_path.c_str());
+            }
+            return 0;
+        }
+        if (!opts.emit_cpp_path.empty()) {
+            gateflow::save_evaluator(*circuit, opts.function_name, opts.emit_cpp_path);
+            if (!opts.quiet) {
+                std::fprintf(stderr, "emit-cpp: %zu gates as %s to %s\n",
+                             circuit->gates().size(), opts.function_name.c_str(),
+                             opts.emit_cpp_path.c_str());
+            }
+            return 0;
+        }
+        std::FILE* in = open_stream(opts.input_path, "r", stdin);
+        std::FILE* out = open_stream(opts.output_path, "w", stdout);
+        if (opts.faults) {
+            write_fault_report(opts, *circuit, in, out);
+            std::fflush(out);
+            if (in != stdin) {
+                std::fclose(in);
+            }
+            if (out != stdout) {
+                std::fclose(out);
+            }
+            return 0;
+        }
+        (void)circuit->propagate(); // Settle the all-zero state first
+
+        // Opened after settling, so the trace starts from the all-zero state
+        std::unique_ptr<gateflow::TimingAnalysis> timing;
+        std::unique_ptr<gateflow::VcdWriter> trace;
+        if (!opts.vcd_path.empty()) {
+            if (opts.delay_time) {
+                timing = std::make_unique<gateflow::TimingAnalysis>(
+                    *circuit, gateflow::DelayModel::typical());
+                trace = std::make_unique<gateflow::VcdWriter>(*timing, opts.vcd_path);
+            } else {
+                trace = std::make_unique<gateflow::VcdWriter>(*circuit, opts.vcd_path);
+            }
+        }
+
+        VectorRunner runner(*circuit, out, trace.get());
+        const auto start = std::chrono::steady_clock::now();
+
+        std::string line;
+        size_t line_no = 0;
+        while (read_line(in, line)) {
+            line_no++;
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            runner.run_line(line, line_no);
+        }
+
+        const auto stop = std::chrono::steady_clock::now();
+        if (trace) {
+            trace->close();
+        }
+        std::fflush(out);
+        if (in != stdin) {
+            std::fclose(in);
+        }
+        if (out != stdout) {
+            std::fclose(out);
+        }
+
+        if (!opts.quiet) {
+            const Stats& st = runner.stats();
+            const double seconds = std::chrono::duration<double>(stop - start).count();
+            const double rate = seconds > 0.0 ? static_cast<double>(st.vectors) / seconds : 0.0;
+            const double mean_depth =
+                st.vectors > 0 ? static_cast<double>(st.depth_sum) / static_cast<double>(st.vectors)
+                               : 0.0;
+            const std::string name = opts.load_path.empty()
+                                         ? opts.builder + " " + std::to_string(opts.bits) + "-bit"
+                                         : opts.load_path;
+            std::fprintf(stderr,
+                         "%s%s%s: %zu gates, %llu vectors in %.3f s (%.0f vectors/s), "
+                         "depth mean %.2f max %d\n",
+                         name.c_str(), opts.nand ? " NAND" : "", opts.optimize ? " optimized" : "",
+                         circuit->gates().size(), static_cast<unsigned long long>(st.vectors),
+                         seconds, rate, mean_depth, st.max_depth);
+            if (trace) {
+                std::fprintf(stderr, "vcd: %llu changes in %llu vectors to %s (%s time)\n",
+                             static_cast<unsigned long long>(trace->changes()),
+                             static_cast<unsigned long long>(trace->vectors()),
+                             opts.vcd_path.c_str(), trace->delay_time() ? "delay" : "depth");
+            }
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "gateflow_cli: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
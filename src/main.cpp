@@ -8,12 +8,23 @@
 #include "rendering/animation_state.hpp"
 #include "rendering/app_font.hpp"
 #include "rendering/gate_renderer.hpp"
+#include "rendering/layout_cache.hpp"
 #include "rendering/layout_engine.hpp"
+#include "rendering/layout_file.hpp"
+#include "rendering/render_layer.hpp"
+#include "rendering/spatial_index.hpp"
+#include "rendering/viewport.hpp"
 #include "rendering/wire_renderer.hpp"
+#include "simulation/background_job.hpp"
 #include "simulation/circuit.hpp"
 #include "simulation/circuit_builder.hpp"
-#include "simulation/nand_decompose.hpp"
+#include "simulation/netlist_file.hpp"
+#include "timing/event_simulator.hpp"
+#include "timing/frame_pacer.hpp"
+#include "timing/frame_profiler.hpp"
 #include "timing/propagation_scheduler.hpp"
+#include "timing/static_timing.hpp"
+#include "timing/vcd_writer.hpp"
 #include "ui/info_panel.hpp"
 #include "ui/input_panel.hpp"
 #include "ui/ui_scale.hpp"
@@ -25,8 +36,15 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace {
 
@@ -35,75 +53,211 @@ constexpr int INITIAL_HEIGHT = 720;
 constexpr int MIN_WIDTH = 900;
 constexpr int MIN_HEIGHT = 500;
 constexpr int TARGET_FPS = 60;
-
-constexpr int ADDER_BITS = 7;
-
-/// Holds the entire simulation + rendering state that gets rebuilt on input/NAND changes.
-struct AppState {
+constexpr int IDLE_POLL_MS = 50;       // Input polling interval while nothing changes
+constexpr int ACTIVE_GRACE_FRAMES = 2; // Frames still drawn after the last change
+
+// Scheduler and animation advance in fixed steps, two per frame at TARGET_FPS;
+// a frame longer than MAX_SIM_STEPS steps only advances that far
+constexpr float SIM_STEP = 1.0f / 120.0f;
+constexpr int MAX_SIM_STEPS = 8;
+
+constexpr int ADDER_BITS = 7;    // Default width; `gateflow --bits N` builds another
+// Narrowest width, for `--bits` and [: the UI's 0-99 operands need 7 bits
+constexpr int MIN_ADDER_BITS = ADDER_BITS;
+constexpr int MAX_ADDER_BITS = 1024;
+
+// Camera: wheel zoom step, zoom range relative to the fitted view, and the
+// most pixels per unit relative to ui_scale().max_ppu
+constexpr float ZOOM_STEP = 1.15f;
+constexpr float MIN_ZOOM_OF_FIT = 0.5f;
+constexpr float MAX_ZOOM_OF_PPU = 4.0f;
+
+// Prebaked variants written by `gateflow --bake DIR`, looked up relative to
+// the working directory like the font (embedded there in the WASM build
+// when GATEFLOW_EMSCRIPTEN_NETLIST_DIR is set)
+constexpr const char* PREBAKED_DIR = "resources/netlists";
+constexpr const char* LOGICAL_NETLIST = "adder7.gfnl";
+constexpr const char* NAND_NETLIST = "adder7_nand.gfnl";
+
+/// One prebuilt circuit variant with its own scheduler and animation state.
+struct CircuitVariant {
     std::unique_ptr<gateflow::Circuit> circuit;
-    gateflow::Layout layout;
+    const gateflow::Layout* layout = nullptr; // Owned by AppState::layout_cache
     std::unique_ptr<gateflow::PropagationScheduler> scheduler;
     std::unique_ptr<gateflow::AnimationState> anim;
+    std::unique_ptr<gateflow::TimingAnalysis> timing; // Under DelayModel::typical()
+    std::unique_ptr<gateflow::EventSimulator> events; // Same model, for event time
+    gateflow::WireGeometry wire_geometry;             // Screen-space wires for layout
+    std::unique_ptr<gateflow::SpatialIndex> index;    // Culling grid over layout
+    gateflow::GateBlocks blocks;                      // Layout columns, for the LOD view
+    gateflow::GateBlocks groups;                      // Adder bits: instances, else columns
+    gateflow::GateTooltipCache tooltips;              // Hover text per gate
+};
+
+/// Both variants built off the main thread: everything a CircuitVariant
+/// holds except its layout pointer, with the layouts still to be moved into
+/// AppState::layout_cache by install_build().
+struct CircuitBuild {
+    int bits = ADDER_BITS;
+    CircuitVariant logical;
+    CircuitVariant nand;
+    gateflow::Layout logical_layout;
+    gateflow::Layout nand_layout;
+};
+
+/// What the scheduler's clock counts, cycled with T.
+enum class TimeBase {
+    DEPTH,  // One step per depth level
+    DELAY,  // Static gate delays
+    EVENTS, // Event-driven run, flashing glitches
+};
+
+/// The time base T switches to from @p base.
+TimeBase next_time_base(TimeBase base) {
+    switch (base) {
+    case TimeBase::DEPTH:
+        return TimeBase::DELAY;
+    case TimeBase::DELAY:
+        return TimeBase::EVENTS;
+    case TimeBase::EVENTS:
+        break;
+    }
+    return TimeBase::DEPTH;
+}
+
+/// Holds the entire simulation + rendering state. Both the logical and the
+/// NAND variant are built together, at startup and on width changes;
+/// toggling NAND view only switches which one is active, and input changes
+/// re-propagate the active one.
+struct AppState {
+    gateflow::LayoutCache layout_cache;
+    CircuitVariant logical;
+    CircuitVariant nand;
+    CircuitVariant* active = &logical;
+    TimeBase time_base = TimeBase::DEPTH; // Animation clock (T)
+    bool show_critical_path = false; // Critical-path overlay and panel (C)
+    gateflow::RenderEffects effects; // Optional effects, as FrameState::governor allows
+    int bits = ADDER_BITS;
     int result = 0;
     float scale = 40.0f;  // Will be recomputed by refit_circuit
     Vector2 offset = {0, 0};
+    float fit_scale = 40.0f;      // Scale chosen by refit_circuit, the zoom reference
+    gateflow::VisibleSet visible; // What the view shows, queried each frame
+
+    // Cached parts of the circuit drawing (see draw_circuit()), invalidated by
+    // invalidate_layers() whenever what they show changes
+    gateflow::RenderLayer background_layer; // Adder groups
+    gateflow::RenderLayer label_layer;      // I/O dots and labels
+    gateflow::RenderLayer scene_layer;      // Everything, once the animation has settled
+
+    // Background rebuild at another width (request_build()). The slot is
+    // declared first so the job, which writes it, is joined before it goes.
+    std::unique_ptr<CircuitBuild> pending_build;
+    gateflow::BackgroundJob build_job;
+    int building_bits = 0; // Width being built while build_job is active
+
+    // `gateflow --vcd FILE`: the logical adder's propagation, whichever variant is shown
+    std::unique_ptr<gateflow::VcdWriter> trace;
 };
 
-/// Sets the bits of value A and B on a 7-bit ripple-carry adder circuit.
+/// Marks every cached layer stale: the circuit, its values or the view changed.
+void invalidate_layers(AppState& app) {
+    app.background_layer.invalidate();
+    app.label_layer.invalidate();
+    app.scene_layer.invalidate();
+}
+
+/// Sets the bits of value A and B on an adder circuit (bits above 30 are 0).
 void set_adder_inputs(gateflow::Circuit& circuit, int a, int b) {
-    for (int i = 0; i < ADDER_BITS; i++) {
-        circuit.set_input(i, (a >> i) & 1);
-        circuit.set_input(ADDER_BITS + i, (b >> i) & 1);
-    }
+    circuit.set_bus("A", static_cast<uint64_t>(a));
+    circuit.set_bus("B", static_cast<uint64_t>(b));
 }
 
-/// Reads the sum result from a 7-bit ripple-carry adder.
+/// Reads the sum result from an adder circuit. The UI's operands are at most
+/// 99, so only the low 30 sum bits and (on narrower adders) the carry matter.
 int read_adder_output(const gateflow::Circuit& circuit) {
-    int result = 0;
-    for (int i = 0; i < ADDER_BITS; i++) {
-        if (circuit.get_output(i)) {
-            result |= (1 << i);
-        }
-    }
-    if (circuit.get_output(ADDER_BITS)) {
-        result |= (1 << ADDER_BITS);
+    const size_t bits = circuit.num_inputs() / 2;
+    uint64_t sum = circuit.read_bus("Sum");
+    if (bits < 30) {
+        sum |= circuit.read_bus("Cout") << bits;
     }
-    return result;
+    return static_cast<int>(sum & ((uint64_t{1} << 30) - 1));
 }
 
-// Forward declaration — defined after rebuild_app_state
-void refit_circuit(AppState& app);
-
-/// Builds (or rebuilds) the complete app state from the current UI inputs.
-void rebuild_app_state(AppState& app, const gateflow::UIState& ui) {
-    // 1. Build the circuit
-    app.circuit = gateflow::build_ripple_carry_adder(ADDER_BITS);
-
-    // 2. Apply NAND decomposition if toggled
-    if (ui.show_nand) {
-        gateflow::decompose_to_nand(*app.circuit);
+/// Creates the scheduler, animation state, timing analysis, culling grid,
+/// columns and adder groups for a finished circuit laid out as @p layout. Touches no shared
+/// state, so it runs on the build job too.
+void prepare_variant(CircuitVariant& variant, const gateflow::Layout& layout) {
+    variant.scheduler = std::make_unique<gateflow::PropagationScheduler>(variant.circuit.get());
+    variant.anim = std::make_unique<gateflow::AnimationState>(variant.circuit.get());
+    variant.timing = std::make_unique<gateflow::TimingAnalysis>(*variant.circuit,
+                                                                gateflow::DelayModel::typical());
+    variant.events = std::make_unique<gateflow::EventSimulator>(*variant.circuit,
+                                                                gateflow::DelayModel::typical());
+    variant.index = std::make_unique<gateflow::SpatialIndex>(layout);
+    variant.blocks = gateflow::compute_gate_blocks(layout);
+    variant.groups = gateflow::compute_instance_blocks(*variant.circuit, layout);
+    if (variant.groups.size() == 0) {
+        variant.groups = variant.blocks;
     }
+}
 
-    // 3. Set inputs and propagate
-    set_adder_inputs(*app.circuit, ui.input_a, ui.input_b);
-    (void)app.circuit->propagate();
-    app.result = read_adder_output(*app.circuit);
-
-    // 4. Compute layout
-    app.layout = gateflow::compute_layout(*app.circuit);
+/// Loads a prebaked variant's circuit and its stored layout. Returns false,
+/// leaving no circuit, if the file is missing, is not a 7-bit adder, or has
+/// no current layout.
+bool load_prebaked(CircuitVariant& variant, gateflow::Layout& layout, const std::string& path) {
+    if (!std::filesystem::exists(path)) {
+        return false;
+    }
+    try {
+        const gateflow::NetlistFile file = gateflow::NetlistFile::open(path);
+        if (file.num_inputs() != 2 * ADDER_BITS || file.num_outputs() != ADDER_BITS + 1 ||
+            !gateflow::has_layout_for(file)) {
+            std::fprintf(stderr, "[gateflow] Ignoring stale prebaked netlist %s\n", path.c_str());
+            return false;
+        }
+        variant.circuit = gateflow::load_circuit(file);
+        gateflow::add_adder_buses(*variant.circuit);
+        layout = gateflow::load_layout(file);
+        return true;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "[gateflow] Ignoring prebaked netlist %s: %s\n", path.c_str(),
+                     e.what());
+        variant.circuit.reset();
+        return false;
+    }
+}
 
-    // 5. Create scheduler and animation
-    app.scheduler = std::make_unique<gateflow::PropagationScheduler>(app.circuit.get());
-    app.scheduler->set_speed(ui.speed);
-    app.anim = std::make_unique<gateflow::AnimationState>(app.circuit.get());
+/// Builds both variants at @p bits, unless both can be loaded prebaked
+/// (default width only). The NAND variant stamps adder cells decomposed once
+/// per definition rather than decomposing every gate. Touches no shared
+/// state, so it runs on the build job; install_build() swaps the result in.
+std::unique_ptr<CircuitBuild> build_circuits(int bits) {
+    auto build = std::make_unique<CircuitBuild>();
+    build->bits = bits;
+    const std::string dir = PREBAKED_DIR;
+    const bool prebaked =
+        bits == ADDER_BITS &&
+        load_prebaked(build->logical, build->logical_layout, dir + "/" + LOGICAL_NETLIST) &&
+        load_prebaked(build->nand, build->nand_layout, dir + "/" + NAND_NETLIST);
+    if (!prebaked) {
+        build->logical.circuit = gateflow::build_ripple_carry_adder(bits);
+        build->nand.circuit = gateflow::build_ripple_carry_adder(bits, true);
+        build->logical_layout = gateflow::compute_layout(*build->logical.circuit);
+        build->nand_layout = gateflow::compute_layout(*build->nand.circuit);
+    }
 
-    // 6. Fit circuit into available area and center it
-    refit_circuit(app);
+    prepare_variant(build->logical, build->logical_layout);
+    prepare_variant(build->nand, build->nand_layout);
+    return build;
 }
 
-/// Recomputes scale and offset to fit the circuit in the current window.
-/// Called on rebuild and on window resize.
+/// Recomputes scale and offset to fit the circuit in the current window,
+/// resetting any pan and zoom. Called when the active variant changes, on
+/// window resize and with F. Wide circuits fit at any scale; below
+/// DETAIL_MIN_SCALE they are drawn at the block level of detail.
 void refit_circuit(AppState& app) {
+    invalidate_layers(app);
     const auto& sc = gateflow::ui_scale();
     float screen_w = static_cast<float>(GetScreenWidth());
     float screen_h = static_cast<float>(GetScreenHeight());
@@ -111,11 +265,12 @@ void refit_circuit(AppState& app) {
     float available_w = screen_w - sc.panel_w - 2.0f * sc.margin - 2.0f * sc.circuit_padding;
     float available_h = screen_h - 2.0f * sc.circuit_padding - 40.0f; // 40px for title bar
 
-    float bbox_w = app.layout.bounding_box.w;
-    float bbox_h = app.layout.bounding_box.h;
+    float bbox_w = app.active->layout->bounding_box.w;
+    float bbox_h = app.active->layout->bounding_box.h;
 
     if (bbox_w <= 0.0f || bbox_h <= 0.0f) {
         app.scale = sc.max_ppu;
+        app.fit_scale = app.scale;
         app.offset = {0, 0};
         return;
     }
@@ -123,27 +278,136 @@ void refit_circuit(AppState& app) {
     // Pick the largest scale that fits both dimensions, capped at MAX
     float scale_w = available_w / bbox_w;
     float scale_h = available_h / bbox_h;
-    app.scale = std::min({scale_w, scale_h, sc.max_ppu});
-    if (app.scale < 4.0f) app.scale = 4.0f; // Floor to keep things visible
+    app.scale = std::max(std::min({scale_w, scale_h, sc.max_ppu}), 0.01f);
+    app.fit_scale = app.scale;
 
     float circuit_w = bbox_w * app.scale;
     float circuit_h = bbox_h * app.scale;
     float area_w = screen_w - sc.panel_w - sc.margin;
 
     app.offset = {
-        (area_w - circuit_w) / 2.0f - app.layout.bounding_box.x * app.scale,
-        (screen_h - circuit_h) / 2.0f - app.layout.bounding_box.y * app.scale + 20.0f};
+        (area_w - circuit_w) / 2.0f - app.active->layout->bounding_box.x * app.scale,
+        (screen_h - circuit_h) / 2.0f - app.active->layout->bounding_box.y * app.scale + 20.0f};
+}
+
+/// Closes the --vcd trace, if one is open, reporting @p why.
+void stop_trace(AppState& app, const char* why) {
+    if (!app.trace) {
+        return;
+    }
+    try {
+        app.trace->close();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "[gateflow] %s\n", e.what());
+    }
+    app.trace.reset();
+    std::fprintf(stderr, "[gateflow] VCD trace closed: %s\n", why);
 }
 
 /// Resets propagation without rebuilding the circuit (for input value changes only).
 void reset_propagation(AppState& app, const gateflow::UIState& ui) {
-    set_adder_inputs(*app.circuit, ui.input_a, ui.input_b);
-    (void)app.circuit->propagate();
-    app.result = read_adder_output(*app.circuit);
+    set_adder_inputs(*app.active->circuit, ui.input_a, ui.input_b);
+    gateflow::PropagationResult changes = app.active->circuit->propagate();
+    if (app.trace) {
+        if (app.active != &app.logical) {
+            set_adder_inputs(*app.logical.circuit, ui.input_a, ui.input_b);
+            changes = app.logical.circuit->propagate();
+        }
+        // Replays and variant switches change nothing; any new operand flips a sum XOR
+        if (!changes.changed_wires.empty()) {
+            try {
+                app.trace->record(changes);
+            } catch (const std::exception& e) {
+                std::fprintf(stderr, "[gateflow] %s\n", e.what());
+                stop_trace(app, "write failed");
+            }
+        }
+    }
+    app.result = read_adder_output(*app.active->circuit);
+    invalidate_layers(app);
+
+    // Event time replays the run the new inputs start
+    if (app.time_base == TimeBase::EVENTS) {
+        (void)app.active->events->simulate();
+        app.active->scheduler->use_event_time(*app.active->events);
+    }
+    app.active->scheduler->reset();
+    app.active->anim->reset();
+    app.active->scheduler->set_speed(ui.speed);
+}
+
+/// Switches every variant's scheduler to app.time_base, then replays
+/// propagation on the active one. In event time, a variant replays its
+/// simulator's last run until reset_propagation() runs it on new inputs.
+void apply_time_base(AppState& app, const gateflow::UIState& ui) {
+    for (CircuitVariant* variant : {&app.logical, &app.nand}) {
+        switch (app.time_base) {
+        case TimeBase::DEPTH:
+            variant->scheduler->use_depth_time();
+            break;
+        case TimeBase::DELAY:
+            variant->scheduler->use_delay_time(*variant->timing);
+            break;
+        case TimeBase::EVENTS:
+            variant->scheduler->use_event_time(*variant->events);
+            break;
+        }
+    }
+    reset_propagation(app, ui);
+}
+
+/// Activates the variant matching the NAND toggle and replays propagation on
+/// it with the current inputs. Nothing is rebuilt.
+void select_variant(AppState& app, const gateflow::UIState& ui) {
+    app.active = ui.show_nand ? &app.nand : &app.logical;
+    reset_propagation(app, ui);
+    refit_circuit(app);
+}
+
+/// Replaces both variants with a finished build in one step between frames,
+/// keeping the NAND toggle, time base and inputs, and fits the new circuit.
+void install_build(AppState& app, const gateflow::UIState& ui, CircuitBuild& build) {
+    stop_trace(app, "circuit rebuilt"); // It names the outgoing circuit's wires
+    // Only the outgoing variants point into the cache
+    app.layout_cache.clear();
+    build.logical.layout =
+        &app.layout_cache.insert(*build.logical.circuit, std::move(build.logical_layout));
+    build.nand.layout = &app.layout_cache.insert(*build.nand.circuit, std::move(build.nand_layout));
+    app.logical = std::move(build.logical);
+    app.nand = std::move(build.nand);
+    app.bits = build.bits;
+
+    apply_time_base(app, ui);
+    refit_circuit(app);
+}
 
-    app.scheduler->reset();
-    app.anim->reset();
-    app.scheduler->set_speed(ui.speed);
+/// Starts rebuilding both variants at @p bits on the build job. The current
+/// variants stay on screen until poll_build() swaps the new ones in. Ignored
+/// while a build is running or if the width is unchanged.
+void request_build(AppState& app, int bits) {
+    if (app.build_job.active() || bits == app.bits) {
+        return;
+    }
+    app.building_bits = bits;
+    app.build_job.start([&slot = app.pending_build, bits] { slot = build_circuits(bits); });
+}
+
+/// Installs the background build once it is done. Returns true if it did.
+bool poll_build(AppState& app, const gateflow::UIState& ui) {
+    if (!app.build_job.active() || !app.build_job.done()) {
+        return false;
+    }
+    try {
+        app.build_job.finish();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "[gateflow] Rebuild at %d bits failed: %s\n", app.building_bits,
+                     e.what());
+        app.pending_build.reset();
+        return false;
+    }
+    install_build(app, ui, *app.pending_build);
+    app.pending_build.reset();
+    return true;
 }
 
 /// All mutable state needed by the frame loop, bundled so it can be passed
@@ -151,62 +415,232 @@ void reset_propagation(AppState& app, const gateflow::UIState& ui) {
 struct FrameState {
     gateflow::UIState ui;
     AppState app;
+    int redraw_frames = ACTIVE_GRACE_FRAMES; // Frames left to draw before going idle
+    bool idle = false;                       // Skipping redraws until something changes
+    gateflow::FixedTimestep sim_clock{SIM_STEP, MAX_SIM_STEPS};
+    gateflow::QualityGovernor governor{1.0f / static_cast<float>(TARGET_FPS)};
+#if GATEFLOW_ENABLE_PROFILER
+    bool show_profiler = false; // Toggled with F3
+#endif
 };
 
-/// One frame of the application — called each tick by the native loop or by
-/// emscripten_set_main_loop_arg.
-void frame_tick(FrameState& state) {
-    auto& ui = state.ui;
-    auto& app = state.app;
-    float dt = GetFrameTime();
+/// Repaints @p layer with @p paint if it is stale, then draws it. Paints to
+/// the screen instead if the layer's render texture cannot be created.
+template <typename Paint>
+void draw_layer(gateflow::RenderLayer& layer, int screen_w, int screen_h, const Paint& paint) {
+    if (!layer.is_valid(screen_w, screen_h) && layer.begin_paint(screen_w, screen_h)) {
+        paint();
+        layer.end_paint();
+    }
+    if (layer.is_valid(screen_w, screen_h)) {
+        layer.draw();
+    } else {
+        paint();
+    }
+}
 
-    int screen_w = GetScreenWidth();
-    int screen_h = GetScreenHeight();
+/// Draws the active circuit: adder groups, wires, gates, the critical-path
+/// overlay and the I/O labels. Only what the spatial index finds in view is
+/// drawn, and below DETAIL_MIN_SCALE the groups and gates give way to one
+/// block per column. The groups and labels only change with the inputs or
+/// the view, so they come from cached layers; once the animation has
+/// settled nothing changes at all and the whole circuit is one layer.
+void draw_circuit(AppState& app, int screen_w, int screen_h) {
+    CircuitVariant& v = *app.active;
+    const Rectangle screen = {0.0f, 0.0f, static_cast<float>(screen_w),
+                              static_cast<float>(screen_h)};
+    v.index->query(gateflow::visible_area(app.scale, app.offset, screen), app.visible);
+    const bool detailed = gateflow::is_detailed(app.scale);
+
+    // Adder groups (or LOD blocks) are the background; their time counts toward gates
+    auto background = [&] {
+        GATEFLOW_PROFILE_PHASE(GATES);
+        if (detailed) {
+            gateflow::draw_adder_groups(*v.circuit, *v.layout, v.groups, app.scale, app.offset);
+        } else {
+            gateflow::draw_gate_blocks(*v.circuit, v.blocks, *v.anim, app.scale, app.offset);
+        }
+    };
+    auto wires = [&] {
+        GATEFLOW_PROFILE_PHASE(WIRES);
+        gateflow::draw_wires(*v.circuit, *v.layout, *v.anim, v.wire_geometry,
+                             app.visible.wires(), app.scale, app.offset, app.effects);
+        if (app.show_critical_path) {
+            gateflow::draw_critical_wires(*v.layout, *v.timing, app.scale, app.offset);
+        }
+    };
+    auto gates = [&] {
+        GATEFLOW_PROFILE_PHASE(GATES);
+        if (detailed) {
+            gateflow::draw_gates(*v.circuit, *v.layout, *v.anim, app.visible.gates(), app.scale,
+                                 app.offset, app.effects);
+        }
+        if (app.show_critical_path) {
+            gateflow::draw_critical_gates(*v.layout, *v.timing, app.scale, app.offset);
+        }
+    };
+    auto labels = [&] {
+        GATEFLOW_PROFILE_PHASE(GATES);
+        gateflow::draw_io_labels(*v.circuit, *v.layout, app.scale, app.offset);
+    };
+
+    if (v.anim->is_settled()) {
+        draw_layer(app.scene_layer, screen_w, screen_h, [&] {
+            background();
+            wires();
+            gates();
+            labels();
+        });
+    } else {
+        if (detailed) {
+            draw_layer(app.background_layer, screen_w, screen_h, background);
+        } else {
+            background(); // Blocks follow the animation
+        }
+        wires();
+        gates();
+        draw_layer(app.label_layer, screen_w, screen_h, labels);
+    }
 
-    // --- Detect any size change (native resize OR Emscripten canvas resize) ---
-    static int last_w = 0, last_h = 0;
-    if (screen_w != last_w || screen_h != last_h) {
-        last_w = screen_w;
-        last_h = screen_h;
-        gateflow::update_ui_scale(screen_w, screen_h);
-        refit_circuit(app);
+    if (detailed) {
+        GATEFLOW_PROFILE_PHASE(GATES);
+        gateflow::draw_gate_tooltip(*v.circuit, *v.layout, *v.index, v.tooltips, app.scale,
+                                    app.offset, app.effects);
     }
+}
 
-    // --- Recompute responsive UI metrics each frame ---
-    gateflow::update_ui_scale(screen_w, screen_h);
+/// Pans and zooms the view: the wheel or +/- zooms about the cursor (or
+/// the centre of the circuit area), dragging with any mouse button in the
+/// circuit area pans, and F fits the circuit again. Any change invalidates
+/// the cached layers.
+void update_camera(AppState& app, const gateflow::UIState& ui, int screen_w, int screen_h) {
     const auto& sc = gateflow::ui_scale();
-    float panel_w = sc.panel_w;
-    float ui_margin = sc.margin;
+    const float area_w = static_cast<float>(screen_w) - sc.panel_w - sc.margin;
+    const Vector2 mouse = GetMousePosition();
+    const bool in_area = mouse.x < area_w;
+    const float old_scale = app.scale;
+    const Vector2 old_offset = app.offset;
+
+    // Drag to pan, for as long as a button pressed inside the area is held
+    static bool panning = false;
+    for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_MIDDLE; button++) {
+        if (IsMouseButtonPressed(button) && in_area) {
+            panning = true;
+        }
+    }
+    if (panning) {
+        if (IsMouseButtonDown(MOUSE_BUTTON_LEFT) || IsMouseButtonDown(MOUSE_BUTTON_RIGHT) ||
+            IsMouseButtonDown(MOUSE_BUTTON_MIDDLE)) {
+            const Vector2 delta = GetMouseDelta();
+            app.offset.x += delta.x;
+            app.offset.y += delta.y;
+        } else {
+            panning = false;
+        }
+    }
 
-    // --- Handle keyboard shortcuts (only when not editing a text field) ---
+    float zoom = 1.0f;
+    Vector2 anchor = mouse;
+    if (in_area) {
+        zoom = std::pow(ZOOM_STEP, GetMouseWheelMove());
+    }
     if (!ui.editing_a && !ui.editing_b) {
-        if (IsKeyPressed(KEY_SPACE)) {
-            app.scheduler->toggle_pause();
-            ui.is_running = (app.scheduler->mode() == gateflow::PlaybackMode::REALTIME);
+        const Vector2 centre = {area_w / 2.0f, static_cast<float>(screen_h) / 2.0f};
+        if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) {
+            zoom = ZOOM_STEP;
+            anchor = centre;
+        } else if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) {
+            zoom = 1.0f / ZOOM_STEP;
+            anchor = centre;
         }
-        if (IsKeyPressed(KEY_RIGHT)) {
-            app.scheduler->step();
+        if (IsKeyPressed(KEY_F)) {
+            refit_circuit(app);
+            return;
         }
-        if (IsKeyPressed(KEY_R)) {
-            reset_propagation(app, ui);
-            app.scheduler->set_mode(gateflow::PlaybackMode::REALTIME);
-            ui.is_running = true;
+    }
+    if (zoom != 1.0f) {
+        gateflow::zoom_about(app.scale, app.offset, anchor, zoom, app.fit_scale * MIN_ZOOM_OF_FIT,
+                             std::max(sc.max_ppu * MAX_ZOOM_OF_PPU, app.fit_scale));
+    }
+
+    if (app.scale != old_scale || app.offset.x != old_offset.x || app.offset.y != old_offset.y) {
+        invalidate_layers(app);
+    }
+}
+
+/// True if the user did anything since the last poll: moved, clicked or
+/// scrolled the mouse, touched the screen, or pressed, held or released a key.
+/// Only reads input state, so the UI still sees every key and character.
+bool input_activity() {
+    Vector2 delta = GetMouseDelta();
+    if (delta.x != 0.0f || delta.y != 0.0f || GetMouseWheelMove() != 0.0f ||
+        GetTouchPointCount() > 0) {
+        return true;
+    }
+    for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_MIDDLE; button++) {
+        if (IsMouseButtonDown(button) || IsMouseButtonReleased(button)) {
+            return true;
+        }
+    }
+    for (int key = 1; key <= KEY_KB_MENU; key++) {
+        if (IsKeyDown(key) || IsKeyReleased(key)) {
+            return true;
         }
     }
+    return false;
+}
 
-    // --- Update simulation ---
-    app.scheduler->tick(dt);
-    app.anim->update(dt, *app.scheduler);
+/// True if this frame may look different from the last one drawn
+bool needs_redraw(const FrameState& state, bool resized) {
+    const auto& app = state.app;
+#if GATEFLOW_ENABLE_PROFILER
+    if (state.show_profiler) {
+        return true; // The overlay shows live frame times
+    }
+#endif
+    // Hover changes come with mouse movement, which counts as input
+    return resized || !app.active->anim->is_settled() || state.ui.editing_a ||
+           state.ui.editing_b || input_activity();
+}
 
-    // --- Draw ---
-    BeginDrawing();
-    ClearBackground({25, 25, 30, 255});
+/// Enters or leaves idle mode. The browser loop drops from
+/// requestAnimationFrame to a slow timer while idle; the native loop sleeps
+/// in frame_tick() instead.
+void set_idle(FrameState& state, bool idle) {
+    if (state.idle == idle) {
+        return;
+    }
+    state.idle = idle;
+#ifdef __EMSCRIPTEN__
+    if (idle) {
+        emscripten_set_main_loop_timing(EM_TIMING_SETTIMEOUT, IDLE_POLL_MS);
+    } else {
+        emscripten_set_main_loop_timing(EM_TIMING_RAF, 1);
+    }
+#endif
+}
 
-    // Draw circuit in the main area (left of the UI panels)
-    gateflow::draw_adder_groups(*app.circuit, app.layout, app.scale, app.offset);
-    gateflow::draw_wires(*app.circuit, app.layout, *app.anim, app.scale, app.offset);
-    gateflow::draw_gates(*app.circuit, app.layout, *app.anim, app.scale, app.offset);
-    gateflow::draw_io_labels(*app.circuit, app.layout, app.scale, app.offset);
+#if GATEFLOW_ENABLE_PROFILER
+/// Heap usage of everything a variant holds, one entry per structure
+std::vector<gateflow::NamedMemoryUsage> memory_report(const CircuitVariant& v) {
+    return {{"Circuit", v.circuit->memory_usage()},
+            {"Layout", v.layout->memory_usage()},
+            {"Scheduler", v.scheduler->memory_usage()},
+            {"Event simulator", v.events->memory_usage()},
+            {"Animation", v.anim->memory_usage()},
+            {"Wire geometry", v.wire_geometry.memory_usage()},
+            {"Spatial index", v.index->memory_usage()}};
+}
+#endif
+
+/// Draws the title, progress bar, status indicator and right-side panels
+/// (plus the profiler overlay when enabled). Returns the input panel's actions.
+gateflow::UIAction draw_hud_and_panels(FrameState& state, int screen_w, int screen_h) {
+    auto& ui = state.ui;
+    auto& app = state.app;
+    const auto& sc = gateflow::ui_scale();
+    float panel_w = sc.panel_w;
+    float ui_margin = sc.margin;
 
     // Draw title
     std::string title = std::to_string(ui.input_a) + " + " + std::to_string(ui.input_b) + " = " +
@@ -220,37 +654,47 @@ void frame_tick(FrameState& state) {
 
     // Global propagation progress bar
     float progress = 0.0f;
-    if (app.scheduler->max_depth() > 0) {
-        progress = std::clamp(app.scheduler->current_depth() /
-                                  static_cast<float>(app.scheduler->max_depth()),
+    if (app.active->scheduler->end_time() > 0.0f) {
+        progress = std::clamp(app.active->scheduler->current_time() /
+                                  app.active->scheduler->end_time(),
                               0.0f, 1.0f);
     }
     Rectangle progress_track = {12.0f, 44.0f, circuit_area_w - 24.0f, sc.progress_h};
     DrawRectangleRounded(progress_track, 0.35f, 4, {45, 45, 55, 255});
     Rectangle progress_fill = progress_track;
     progress_fill.width *= progress;
-    Color bar_color = app.scheduler->is_complete() ? Color{80, 220, 100, 230}
+    Color bar_color = app.active->scheduler->is_complete() ? Color{80, 220, 100, 230}
                                                    : Color{245, 190, 70, 220};
     DrawRectangleRounded(progress_fill, 0.35f, 4, bar_color);
 
     // --- Right-side UI panels ---
     float panel_x = static_cast<float>(screen_w) - panel_w - ui_margin;
 
-    // Input panel (top right)
+    // Input panel (top right); the time slider follows playback unless dragged
+    if (!ui.dragging_scrub) {
+        ui.scrub_time = std::max(app.active->scheduler->current_time(), 0.0f);
+        ui.scrub_end = app.active->scheduler->end_time();
+    }
     gateflow::InputPanelResult input_panel =
         gateflow::draw_input_panel(ui, panel_x, ui_margin, panel_w);
-    gateflow::UIAction action = input_panel.action;
 
     // Info panel (below input panel)
     float info_panel_y = ui_margin + input_panel.panel_height + 10.0f;
     float info_panel_h =
-        gateflow::draw_info_panel(*app.circuit, *app.scheduler, ui.input_a, ui.input_b,
+        gateflow::draw_info_panel(*app.active->circuit, *app.active->scheduler, ui.input_a, ui.input_b,
                                   app.result, panel_x, info_panel_y, panel_w);
 
-    // Explanation panel (fills remaining vertical space)
+    // Critical-path panel (only while the overlay is on)
     float expl_y = info_panel_y + info_panel_h + 10.0f;
+    if (app.show_critical_path) {
+        expl_y += gateflow::draw_timing_panel(*app.active->timing, *app.active->scheduler, panel_x,
+                                              expl_y, panel_w) +
+                  10.0f;
+    }
+
+    // Explanation panel (fills remaining vertical space)
     float expl_available_h = static_cast<float>(screen_h) - expl_y - ui_margin;
-    gateflow::draw_explanation_panel(panel_x, expl_y, panel_w, *app.scheduler, ui.input_a,
+    gateflow::draw_explanation_panel(panel_x, expl_y, panel_w, *app.active->scheduler, ui.input_a,
                                      ui.input_b, app.result, expl_available_h);
 
     // --- Unified status indicator (top-right of circuit area) ---
@@ -258,13 +702,13 @@ void frame_tick(FrameState& state) {
         const char* status_str = nullptr;
         Color status_color = {140, 140, 160, 255};
 
-        if (app.scheduler->is_complete()) {
+        if (app.active->scheduler->is_complete()) {
             status_str = "COMPLETE";
             status_color = {80, 220, 200, 255};
-        } else if (app.scheduler->mode() == gateflow::PlaybackMode::PAUSED) {
+        } else if (app.active->scheduler->mode() == gateflow::PlaybackMode::PAUSED) {
             status_str = "PAUSED";
             status_color = {255, 200, 80, 255};
-        } else if (app.scheduler->mode() == gateflow::PlaybackMode::REALTIME) {
+        } else if (app.active->scheduler->mode() == gateflow::PlaybackMode::REALTIME) {
             status_str = "PLAYING";
             status_color = {80, 220, 100, 255};
         } else {
@@ -281,37 +725,196 @@ void frame_tick(FrameState& state) {
             gateflow::DrawAppText(nand_str, static_cast<int>(status_x) - nand_w - 12, 16,
                                   sc.hud_font - 1, {255, 160, 60, 255});
         }
+
+        if (app.build_job.active()) {
+            std::string building = "Building " + std::to_string(app.building_bits) + "-bit...";
+            gateflow::DrawAppText(building.c_str(), 14, 16, sc.hud_font - 1,
+                                  {140, 140, 160, 255});
+        }
     }
 
-    EndDrawing();
+#if GATEFLOW_ENABLE_PROFILER
+    if (state.show_profiler) {
+        gateflow::draw_profiler_overlay(*app.active->circuit, gateflow::frame_profiler(),
+                                        memory_report(*app.active), 12.0f,
+                                        60.0f + sc.progress_h);
+    }
+#endif
 
-    // --- Process UI actions (take effect next frame) ---
-    if (action.nand_toggled) {
-        rebuild_app_state(app, ui);
-        app.scheduler->set_mode(gateflow::PlaybackMode::REALTIME);
-        ui.is_running = true;
-    } else if (action.inputs_changed || action.run_pressed) {
-        reset_propagation(app, ui);
-        app.scheduler->set_mode(gateflow::PlaybackMode::REALTIME);
+    return input_panel.action;
+}
+
+/// One frame of the application — called each tick by the native loop or by
+/// emscripten_set_main_loop_arg.
+void frame_tick(FrameState& state) {
+    auto& ui = state.ui;
+    auto& app = state.app;
+    float dt = GetFrameTime();
+
+    int screen_w = GetScreenWidth();
+    int screen_h = GetScreenHeight();
+
+    // --- Detect any size change (native resize OR Emscripten canvas resize) ---
+    static int last_w = 0, last_h = 0;
+    bool resized = false;
+    if (screen_w != last_w || screen_h != last_h) {
+        last_w = screen_w;
+        last_h = screen_h;
+        resized = true;
+        gateflow::update_ui_scale(screen_w, screen_h);
+        refit_circuit(app);
+    }
+
+    // --- Swap in a finished background rebuild ---
+    if (poll_build(app, ui)) {
+        app.active->scheduler->set_mode(gateflow::PlaybackMode::REALTIME);
         ui.is_running = true;
     }
 
-    if (action.pause_pressed) {
-        app.scheduler->toggle_pause();
-        ui.is_running = (app.scheduler->mode() == gateflow::PlaybackMode::REALTIME);
+    // --- Idle: nothing animates or reacts, so keep the last frame on screen ---
+    const bool was_idle = state.idle;
+    if (needs_redraw(state, resized)) {
+        state.redraw_frames = ACTIVE_GRACE_FRAMES;
+    } else if (state.redraw_frames > 0) {
+        state.redraw_frames--;
+    }
+    set_idle(state, state.redraw_frames == 0);
+    if (state.idle) {
+        state.sim_clock.reset();
+        PollInputEvents(); // EndDrawing() would have done this
+#ifndef __EMSCRIPTEN__
+        WaitTime(IDLE_POLL_MS / 1000.0);
+#endif
+        return;
     }
-    if (action.step_pressed) {
-        app.scheduler->step();
-        ui.is_running = false;
+    GATEFLOW_PROFILE_BEGIN_FRAME();
+    const double work_start = GetTime();
+
+    // --- Recompute responsive UI metrics each frame ---
+    gateflow::update_ui_scale(screen_w, screen_h);
+
+    // --- Pan and zoom ---
+    {
+        GATEFLOW_PROFILE_PHASE(INPUT);
+        update_camera(app, ui, screen_w, screen_h);
     }
-    if (action.reset_pressed) {
-        reset_propagation(app, ui);
-        app.scheduler->set_mode(gateflow::PlaybackMode::REALTIME);
-        ui.is_running = true;
+
+    // --- Handle keyboard shortcuts (only when not editing a text field) ---
+    if (!ui.editing_a && !ui.editing_b) {
+        GATEFLOW_PROFILE_PHASE(INPUT);
+        if (IsKeyPressed(KEY_SPACE)) {
+            app.active->scheduler->toggle_pause();
+            ui.is_running = (app.active->scheduler->mode() == gateflow::PlaybackMode::REALTIME);
+        }
+        if (IsKeyPressed(KEY_RIGHT)) {
+            app.active->scheduler->step();
+        }
+        if (IsKeyPressed(KEY_LEFT)) {
+            app.active->scheduler->step_back();
+            ui.is_running = false;
+        }
+        if (IsKeyPressed(KEY_R)) {
+            reset_propagation(app, ui);
+            app.active->scheduler->set_mode(gateflow::PlaybackMode::REALTIME);
+            ui.is_running = true;
+        }
+        if (IsKeyPressed(KEY_T)) {
+            app.time_base = next_time_base(app.time_base);
+            apply_time_base(app, ui);
+            app.active->scheduler->set_mode(gateflow::PlaybackMode::REALTIME);
+            ui.is_running = true;
+        }
+        if (IsKeyPressed(KEY_C)) {
+            app.show_critical_path = !app.show_critical_path;
+            invalidate_layers(app);
+        }
+        if (IsKeyPressed(KEY_LEFT_BRACKET)) {
+            request_build(app, std::max(app.bits / 2, MIN_ADDER_BITS));
+        }
+        if (IsKeyPressed(KEY_RIGHT_BRACKET)) {
+            request_build(app, std::min(app.bits * 2, MAX_ADDER_BITS));
+        }
+#if GATEFLOW_ENABLE_PROFILER
+        if (IsKeyPressed(KEY_F3)) {
+            state.show_profiler = !state.show_profiler;
+        }
+#endif
+    }
+
+    // --- Update simulation in fixed steps, however long the last frame took ---
+    const int steps = state.sim_clock.advance(dt);
+    for (int i = 0; i < steps; i++) {
+        {
+            GATEFLOW_PROFILE_PHASE(SCHEDULER);
+            app.active->scheduler->tick(SIM_STEP);
+        }
+        {
+            GATEFLOW_PROFILE_PHASE(ANIMATION);
+            app.active->anim->update(SIM_STEP, *app.active->scheduler);
+        }
     }
-    if (action.speed_changed) {
-        app.scheduler->set_speed(ui.speed);
+
+    // --- Draw ---
+    BeginDrawing();
+    ClearBackground({25, 25, 30, 255});
+
+    // Draw circuit in the main area (left of the UI panels)
+    draw_circuit(app, screen_w, screen_h);
+
+    gateflow::UIAction action;
+    {
+        GATEFLOW_PROFILE_PHASE(UI);
+        action = draw_hud_and_panels(state, screen_w, screen_h);
+    }
+
+    // EndDrawing() waits for the frame cap, so the work ends here
+    const auto work_time = static_cast<float>(GetTime() - work_start);
+    EndDrawing();
+
+    // --- Drop or restore optional effects to hold the frame budget ---
+    // (the first frame after idle carries the idle wait, so it is not counted)
+    if (!was_idle && state.governor.record(dt, work_time)) {
+        app.effects = state.governor.effects();
+        invalidate_layers(app);
+    }
+
+    // --- Process UI actions (take effect next frame) ---
+    {
+        GATEFLOW_PROFILE_PHASE(INPUT);
+        if (action.nand_toggled) {
+            select_variant(app, ui);
+            app.active->scheduler->set_mode(gateflow::PlaybackMode::REALTIME);
+            ui.is_running = true;
+        } else if (action.inputs_changed || action.run_pressed) {
+            reset_propagation(app, ui);
+            app.active->scheduler->set_mode(gateflow::PlaybackMode::REALTIME);
+            ui.is_running = true;
+        }
+
+        if (action.pause_pressed) {
+            app.active->scheduler->toggle_pause();
+            ui.is_running = (app.active->scheduler->mode() == gateflow::PlaybackMode::REALTIME);
+        }
+        if (action.step_pressed) {
+            app.active->scheduler->step();
+            ui.is_running = false;
+        }
+        if (action.reset_pressed) {
+            reset_propagation(app, ui);
+            app.active->scheduler->set_mode(gateflow::PlaybackMode::REALTIME);
+            ui.is_running = true;
+        }
+        if (action.speed_changed) {
+            app.active->scheduler->set_speed(ui.speed);
+        }
+        if (action.scrubbed) {
+            app.active->scheduler->seek(ui.scrub_time);
+            app.active->scheduler->set_mode(gateflow::PlaybackMode::PAUSED);
+            ui.is_running = false;
+        }
     }
+
+    GATEFLOW_PROFILE_END_FRAME();
 }
 
 #ifdef __EMSCRIPTEN__
@@ -322,9 +925,58 @@ void emscripten_frame(void* arg) {
 }
 #endif
 
+/// Writes both variants with their layouts into @p dir, for build_circuits()
+/// to load instead of building (`gateflow --bake resources/netlists`).
+int bake_netlists(const std::string& dir) {
+    try {
+        std::filesystem::create_directories(dir);
+        auto logical = gateflow::build_ripple_carry_adder(ADDER_BITS);
+        auto nand = gateflow::build_ripple_carry_adder(ADDER_BITS, true);
+
+        const std::pair<const gateflow::Circuit*, const char*> variants[] = {
+            {logical.get(), LOGICAL_NETLIST}, {nand.get(), NAND_NETLIST}};
+        for (const auto& [circuit, name] : variants) {
+            gateflow::NetlistSaveOptions options;
+            options.layout = gateflow::serialize_layout(gateflow::compute_layout(*circuit));
+            const std::string path = dir + "/" + name;
+            gateflow::save_netlist(*circuit, path, options);
+            std::printf("%s: %zu gates\n", path.c_str(), circuit->gates().size());
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "gateflow --bake: %s\n", e.what());
+        return 1;
+    }
+}
+
 } // namespace
 
-int main() {
+int main(int argc, char** argv) {
+    // --- Prebake circuits and layouts, without opening a window ---
+    if (argc == 3 && std::string(argv[1]) == "--bake") {
+        return bake_netlists(argv[2]);
+    }
+
+    // --- Adder width (`--bits N`, e.g. 256 to try the camera and LOD) and trace (`--vcd FILE`) ---
+    int bits = ADDER_BITS;
+    std::string vcd_path;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string arg = argv[i];
+        if (arg == "--bits") {
+            bits = std::atoi(argv[i + 1]);
+            if (bits < MIN_ADDER_BITS || bits > MAX_ADDER_BITS) {
+                std::fprintf(stderr, "gateflow --bits: expected %d..%d\n", MIN_ADDER_BITS,
+                             MAX_ADDER_BITS);
+                return 1;
+            }
+        } else if (arg == "--vcd") {
+            vcd_path = argv[i + 1];
+        } else {
+            std::fprintf(stderr, "gateflow: unknown option %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
     // --- Initialize Raylib window ---
     SetConfigFlags(FLAG_WINDOW_RESIZABLE);
     InitWindow(INITIAL_WIDTH, INITIAL_HEIGHT, "Gateflow — Logic Gate Simulator");
@@ -334,19 +986,29 @@ int main() {
     // --- Load custom font (must be after InitWindow) ---
     gateflow::init_app_font();
 
-    // --- Create all mutable state ---
-    FrameState state;
-    rebuild_app_state(state.app, state.ui);
+    {
+        // --- Create all mutable state (scoped: its render layers need the window) ---
+        FrameState state;
+        install_build(state.app, state.ui, *build_circuits(bits));
+        if (!vcd_path.empty()) {
+            try {
+                state.app.trace =
+                    std::make_unique<gateflow::VcdWriter>(*state.app.logical.circuit, vcd_path);
+            } catch (const std::exception& e) {
+                std::fprintf(stderr, "gateflow --vcd: %s\n", e.what());
+            }
+        }
 
 #ifdef __EMSCRIPTEN__
-    // Emscripten takes ownership of the main loop — we pass state via void*.
-    // 0 = use requestAnimationFrame (browser-native vsync), 1 = simulate infinite loop.
-    emscripten_set_main_loop_arg(emscripten_frame, &state, 0, 1);
+        // Emscripten takes ownership of the main loop — we pass state via void*.
+        // 0 = use requestAnimationFrame (browser-native vsync), 1 = simulate infinite loop.
+        emscripten_set_main_loop_arg(emscripten_frame, &state, 0, 1);
 #else
-    while (!WindowShouldClose()) {
-        frame_tick(state);
-    }
+        while (!WindowShouldClose()) {
+            frame_tick(state);
+        }
 #endif
+    }
 
     gateflow::cleanup_app_font();
     CloseWindow();
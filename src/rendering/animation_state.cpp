@@ -14,72 +14,215 @@ const WireAnim AnimationState::DEFAULT_WIRE_ANIM = {};
 
 namespace {
 
-constexpr float PULSE_SPEED = 4.0f;   ///< Radians per second for pending pulse
-constexpr float FADE_IN_SPEED = 5.0f; ///< Alpha units per second for gate fade-in
-constexpr float PI_2 = 6.2831853f;    ///< 2π
+constexpr float PULSE_SPEED = 4.0f;       ///< Radians per second for pending pulse
+constexpr float FADE_IN_SPEED = 5.0f;     ///< Alpha units per second for gate fade-in
+constexpr float HAZARD_FADE_SPEED = 2.5f; ///< Hazard units per second after a glitch
+constexpr float PI_2 = 6.2831853f;        ///< 2π
 
 } // namespace
 
 AnimationState::AnimationState(const Circuit* circuit) : circuit_(circuit) {
-    // Pre-allocate entries for all gates and wires
-    for (auto& gate_ptr : circuit_->gates()) {
-        gate_anims_[gate_ptr.get()] = {};
-    }
-    for (auto& wire_ptr : circuit_->wires()) {
-        wire_anims_[wire_ptr.get()] = {};
-    }
+    reset();
 }
 
 void AnimationState::update(float delta_time, const PropagationScheduler& scheduler) {
-    // Update gate animations
-    for (auto& [gate, anim] : gate_anims_) {
-        anim.resolved = scheduler.is_gate_resolved(gate);
-
-        if (anim.resolved) {
-            // Fade in toward full opacity
-            anim.alpha = std::min(1.0f, anim.alpha + FADE_IN_SPEED * delta_time);
-            anim.pulse_phase = 0.0f; // Stop pulsing once resolved
+    const float time = scheduler.current_time();
+    if (time < last_time_) {
+        rewind_to(scheduler.resolved_count(), scheduler);
+    }
+    if (settled_ && time == last_time_) {
+        return;
+    }
+    last_time_ = time;
+
+    // Shared pending pulse: 0.3 + 0.15 * sin(phase) → range [0.15, 0.45]
+    pending_anim_.pulse_phase += PULSE_SPEED * delta_time;
+    if (pending_anim_.pulse_phase > PI_2) {
+        pending_anim_.pulse_phase -= PI_2;
+    }
+    pending_anim_.alpha = 0.3f + 0.15f * std::sin(pending_anim_.pulse_phase);
+
+    if (!inputs_resolved_ && time >= 0.0f) {
+        // Primary inputs arrive as soon as propagation starts
+        for (const Wire* wire : circuit_->input_wires()) {
+            wire_anims_[wire->get_id()] = {1.0f, true};
+        }
+        inputs_resolved_ = true;
+    }
+    const size_t target = scheduler.resolved_count();
+    if (target > resolved_count_) {
+        resolve_through(target, scheduler);
+    }
+
+    // Fade earlier glitches before flashing the ones this frame passed
+    for (size_t i = 0; i < flashing_.size();) {
+        WireAnim& anim = wire_anims_[flashing_[i]];
+        anim.hazard = std::max(0.0f, anim.hazard - HAZARD_FADE_SPEED * delta_time);
+        if (anim.hazard <= 0.0f) {
+            flashing_[i] = flashing_.back();
+            flashing_.pop_back();
         } else {
-            // Pending state: gentle pulse, low alpha
-            anim.pulse_phase += PULSE_SPEED * delta_time;
-            if (anim.pulse_phase > PI_2) {
-                anim.pulse_phase -= PI_2;
-            }
-            // Base alpha for pending gates: 0.3 + 0.15 * sin(phase) → range [0.15, 0.45]
-            anim.alpha = 0.3f + 0.15f * std::sin(anim.pulse_phase);
+            i++;
         }
     }
+    if (const EventSimulator* events = scheduler.events()) {
+        flash_hazards(*events, time);
+    }
 
-    // Update wire animations
-    for (auto& [wire, anim] : wire_anims_) {
-        anim.resolved = scheduler.is_wire_resolved(wire);
-        anim.signal_progress = scheduler.wire_signal_progress(wire);
+    // Advance the signals still travelling out of resolved gates
+    const std::vector<Wire*>& wires = circuit_->wires();
+    for (size_t i = 0; i < in_flight_.size();) {
+        WireAnim& anim = wire_anims_[in_flight_[i]];
+        anim.signal_progress = scheduler.wire_signal_progress(wires[in_flight_[i]]);
+        if (anim.signal_progress >= 1.0f) {
+            in_flight_[i] = in_flight_.back();
+            in_flight_.pop_back();
+        } else {
+            i++;
+        }
     }
+
+    // Fade resolved gates in toward full opacity
+    for (size_t i = 0; i < fading_.size();) {
+        GateAnim& anim = gate_anims_[fading_[i]];
+        anim.alpha = std::min(1.0f, anim.alpha + FADE_IN_SPEED * delta_time);
+        if (anim.alpha >= 1.0f) {
+            fading_[i] = fading_.back();
+            fading_.pop_back();
+        } else {
+            i++;
+        }
+    }
+
+    settled_ = scheduler.is_complete() && fading_.empty() && in_flight_.empty() &&
+               flashing_.empty();
 }
 
-void AnimationState::reset() {
-    for (auto& [gate, anim] : gate_anims_) {
-        anim = {};
+void AnimationState::flash_hazards(const EventSimulator& events, float time) {
+    const std::vector<Transition>& transitions = events.transitions();
+    const std::vector<Wire*>& wires = circuit_->wires();
+    for (; transitions_seen_ < transitions.size() && transitions[transitions_seen_].time <= time;
+         transitions_seen_++) {
+        const Transition& t = transitions[transitions_seen_];
+        // A wire's last transition is its settled value, not a glitch
+        if (t.time >= events.settle_time(wires[t.wire])) {
+            continue;
+        }
+        WireAnim& anim = wire_anims_[t.wire];
+        if (anim.hazard <= 0.0f) {
+            flashing_.push_back(t.wire);
+        }
+        anim.hazard = 1.0f;
     }
-    for (auto& [wire, anim] : wire_anims_) {
-        anim = {};
+}
+
+void AnimationState::resolve_through(size_t count, const PropagationScheduler& scheduler) {
+    const std::vector<const Gate*>& order = scheduler.resolve_order();
+    for (size_t i = resolved_count_; i < count; i++) {
+        const Gate* gate = order[i];
+        // Start the fade from the pulse's current brightness
+        GateAnim& anim = gate_anims_[gate->get_id()];
+        anim = {pending_anim_.alpha, 0.0f, true};
+        fading_.push_back(gate->get_id());
+        if (const Wire* out = gate->get_output(); out != nullptr) {
+            wire_anims_[out->get_id()].resolved = true;
+            in_flight_.push_back(out->get_id());
+        }
     }
+    resolved_count_ = count;
+}
+
+void AnimationState::rewind_to(size_t count, const PropagationScheduler& scheduler) {
+    const std::vector<const Gate*>& order = scheduler.resolve_order();
+    for (size_t i = count; i < resolved_count_; i++) {
+        const Gate* gate = order[i];
+        gate_anims_[gate->get_id()] = GateAnim{};
+        if (const Wire* out = gate->get_output(); out != nullptr) {
+            wire_anims_[out->get_id()] = WireAnim{};
+        }
+    }
+    resolved_count_ = std::min(resolved_count_, count);
+
+    const float time = scheduler.current_time();
+    for (uint32_t id : flashing_) {
+        wire_anims_[id].hazard = 0.0f;
+    }
+    flashing_.clear();
+    if (const EventSimulator* events = scheduler.events()) {
+        // Glitches after the new time flash again on the way forward
+        const std::vector<Transition>& transitions = events->transitions();
+        transitions_seen_ = static_cast<size_t>(
+            std::upper_bound(transitions.begin(), transitions.end(), time,
+                             [](float t, const Transition& tr) { return t < tr.time; }) -
+            transitions.begin());
+    }
+    if (inputs_resolved_ && time < 0.0f) {
+        for (const Wire* wire : circuit_->input_wires()) {
+            wire_anims_[wire->get_id()] = WireAnim{};
+        }
+        inputs_resolved_ = false;
+    }
+
+    // Work lists keep only what is still resolved
+    auto pending_gate = [this](uint32_t id) { return !gate_anims_[id].resolved; };
+    fading_.erase(std::remove_if(fading_.begin(), fading_.end(), pending_gate), fading_.end());
+    auto pending_wire = [this](uint32_t id) { return !wire_anims_[id].resolved; };
+    in_flight_.erase(std::remove_if(in_flight_.begin(), in_flight_.end(), pending_wire),
+                     in_flight_.end());
+
+    // Gates that resolved less than the longest gate duration ago may be
+    // mid-switch again; their finished signals travel once more
+    const std::vector<float>& times = scheduler.resolve_times();
+    const float recent = time - scheduler.max_gate_duration();
+    for (size_t i = resolved_count_; i > 0 && times[i - 1] > recent; i--) {
+        const Wire* out = order[i - 1]->get_output();
+        if (out != nullptr && wire_anims_[out->get_id()].signal_progress >= 1.0f &&
+            scheduler.wire_signal_progress(out) < 1.0f) {
+            in_flight_.push_back(out->get_id());
+        }
+    }
+    settled_ = false;
+}
+
+void AnimationState::reset() {
+    gate_anims_.assign(circuit_->gates().size(), GateAnim{});
+    wire_anims_.assign(circuit_->wires().size(), WireAnim{});
+    fading_.clear();
+    in_flight_.clear();
+    flashing_.clear();
+    pending_anim_ = {};
+    resolved_count_ = 0;
+    transitions_seen_ = 0;
+    inputs_resolved_ = false;
+    last_time_ = -1.0f;
+    settled_ = false;
 }
 
 const GateAnim& AnimationState::gate_anim(const Gate* gate) const {
-    auto it = gate_anims_.find(gate);
-    if (it != gate_anims_.end()) {
-        return it->second;
+    uint32_t id = gate->get_id();
+    if (id >= gate_anims_.size() || circuit_->gates()[id] != gate) {
+        return DEFAULT_GATE_ANIM;
     }
-    return DEFAULT_GATE_ANIM;
+    const GateAnim& anim = gate_anims_[id];
+    return anim.resolved ? anim : pending_anim_;
 }
 
 const WireAnim& AnimationState::wire_anim(const Wire* wire) const {
-    auto it = wire_anims_.find(wire);
-    if (it != wire_anims_.end()) {
-        return it->second;
+    uint32_t id = wire->get_id();
+    if (id >= wire_anims_.size() || circuit_->wires()[id] != wire) {
+        return DEFAULT_WIRE_ANIM;
     }
-    return DEFAULT_WIRE_ANIM;
+    return wire_anims_[id];
+}
+
+MemoryUsage AnimationState::memory_usage() const {
+    MemoryUsage usage;
+    usage.add_vector("gate animations", gate_anims_);
+    usage.add_vector("gate animations", fading_);
+    usage.add_vector("wire animations", wire_anims_);
+    usage.add_vector("wire animations", in_flight_);
+    usage.add_vector("wire animations", flashing_);
+    return usage;
 }
 
 } // namespace gateflow
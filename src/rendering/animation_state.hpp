@@ -9,9 +9,11 @@
 #pragma once
 
 #include "simulation/circuit.hpp"
+#include "simulation/memory_usage.hpp"
 #include "timing/propagation_scheduler.hpp"
 
-#include <unordered_map>
+#include <cstdint>
+#include <vector>
 
 namespace gateflow {
 
@@ -26,16 +28,30 @@ struct GateAnim {
 struct WireAnim {
     float signal_progress = 0.0f; ///< 0.0–1.0, how far signal has traveled
     bool resolved = false;        ///< Whether the wire value is fully visible
+    float hazard = 0.0f;          ///< 1 at a glitch (event time only), fading to 0
 };
 
 /// Manages all animation state for a circuit visualization.
 /// Updated each frame from the propagation scheduler.
+///
+/// State lives in flat arrays indexed by gate/wire id. Pending gates share a
+/// single pulse (they all started pulsing together at reset()), so a frame
+/// only touches newly resolved gates, gates that are still fading in and
+/// wires whose signal is still travelling. Once the scheduler is complete
+/// and every fade has finished, update() does no work at all.
+///
+/// In event time (PropagationScheduler::use_event_time()) each transition the
+/// scheduler's time passes that is not the wire's last, i.e. a glitch,
+/// sets the wire's hazard to 1, and it fades back out over a fraction of a
+/// second of real time.
 class AnimationState {
   public:
     /// Initialize animation state for all gates and wires in the circuit
     explicit AnimationState(const Circuit* circuit);
 
-    /// Update all animations based on the scheduler's current depth.
+    /// Update animations based on the scheduler's current time. When the
+    /// scheduler moved back (seek(), step_back()), only the gates resolved
+    /// after the new time are returned to pending.
     /// @param delta_time Seconds since last frame
     /// @param scheduler The propagation scheduler driving the animation
     void update(float delta_time, const PropagationScheduler& scheduler);
@@ -49,12 +65,42 @@ class AnimationState {
     /// Get animation state for a specific wire
     [[nodiscard]] const WireAnim& wire_anim(const Wire* wire) const;
 
+    /// True once propagation is complete and no fade is in progress; further
+    /// update() calls are no-ops until the scheduler moves again.
+    [[nodiscard]] bool is_settled() const { return settled_; }
+
+    /// Heap memory by category: "gate animations" (per-gate state and the
+    /// fading list) and "wire animations" (per-wire state, the in-flight and
+    /// flashing lists)
+    [[nodiscard]] MemoryUsage memory_usage() const;
+
   private:
+    /// Marks scheduler.resolve_order()[resolved_count_, count) resolved and
+    /// puts their output wires in flight
+    void resolve_through(size_t count, const PropagationScheduler& scheduler);
+
+    /// Returns resolve_order()[count, resolved_count_) to pending and puts
+    /// the signals of gates still switching at the scheduler's time back in
+    /// flight
+    void rewind_to(size_t count, const PropagationScheduler& scheduler);
+
+    /// Flashes the glitches among the transitions up to @p time
+    void flash_hazards(const EventSimulator& events, float time);
+
     const Circuit* circuit_;
-    std::unordered_map<const Gate*, GateAnim> gate_anims_;
-    std::unordered_map<const Wire*, WireAnim> wire_anims_;
+    std::vector<GateAnim> gate_anims_; ///< Per gate id (only resolved entries are read)
+    std::vector<WireAnim> wire_anims_; ///< Per wire id
+    std::vector<uint32_t> fading_;     ///< Ids of resolved gates with alpha < 1
+    std::vector<uint32_t> in_flight_;  ///< Ids of resolved wires with progress < 1
+    std::vector<uint32_t> flashing_;   ///< Ids of wires with hazard > 0
+    GateAnim pending_anim_;            ///< Shared by every unresolved gate
+    size_t resolved_count_ = 0;        ///< Leading resolve_order() gates marked resolved
+    size_t transitions_seen_ = 0;      ///< Leading EventSimulator transitions passed
+    bool inputs_resolved_ = false;     ///< Primary inputs marked as arrived
+    float last_time_ = -1.0f;          ///< Scheduler time seen by the last update()
+    bool settled_ = false;
 
-    // Default return values for missing keys
+    // Default return values for gates/wires outside this circuit
     static const GateAnim DEFAULT_GATE_ANIM;
     static const WireAnim DEFAULT_WIRE_ANIM;
 };
@@ -4,12 +4,14 @@
 #include "rendering/gate_renderer.hpp"
 
 #include "rendering/app_font.hpp"
+#include "rendering/viewport.hpp"
 #include "simulation/gate.hpp"
 #include "simulation/wire.hpp"
+#include "timing/frame_profiler.hpp"
 
 #include <algorithm>
 #include <cmath>
-#include <map>
+#include <cstdio>
 #include <string>
 #include <vector>
 
@@ -42,6 +44,8 @@ const Color TOOLTIP_TITLE = {226, 226, 236, 255};
 const Color TOOLTIP_BODY = {190, 208, 228, 255};
 const Color TOOLTIP_ROW = {170, 170, 185, 255};
 const Color TOOLTIP_ROW_ACTIVE = {255, 225, 145, 255};
+const Color CRITICAL_OUTLINE = {255, 80, 160, 255}; // Matches the critical wire overlay
+const Color CRITICAL_LABEL = {255, 150, 200, 255};
 
 constexpr float CORNER_ROUNDNESS = 0.3f; // Raylib roundness parameter (0.0–1.0)
 constexpr int CORNER_SEGMENTS = 4;
@@ -50,6 +54,8 @@ constexpr int FONT_SIZE_GATE = 19;
 constexpr int FONT_SIZE_IO = 19;
 constexpr float IO_DOT_RADIUS = 4.0f;
 constexpr float GROUP_MARGIN = 0.6f;
+constexpr float CRITICAL_OUTLINE_THICKNESS = 3.0f;
+constexpr int FONT_SIZE_ARRIVAL = 12;
 
 /// Converts a logical-unit rect to screen-space
 Rectangle to_screen(const Rect& r, float scale, Vector2 offset) {
@@ -93,61 +99,52 @@ Color gate_type_accent(GateType type) {
     return ACCENT_OTHER;
 }
 
-int rounded_x_bucket(float x) {
-    return static_cast<int>(std::round(x * 100.0f));
+/// True if a screen rect is at least partly on screen
+bool on_screen(const Rectangle& r) {
+    return r.x + r.width >= 0.0f && r.y + r.height >= 0.0f &&
+           r.x <= static_cast<float>(GetScreenWidth()) &&
+           r.y <= static_cast<float>(GetScreenHeight());
+}
+
+/// True if a screen point is within @p margin pixels of the screen
+bool near_screen(Vector2 p, float margin) {
+    return p.x >= -margin && p.y >= -margin &&
+           p.x <= static_cast<float>(GetScreenWidth()) + margin &&
+           p.y <= static_cast<float>(GetScreenHeight()) + margin;
 }
 
 } // namespace
 
-void draw_adder_groups(const Circuit& circuit, const Layout& layout, float scale, Vector2 offset) {
+void draw_adder_groups(const Circuit& circuit, const Layout& layout, const GateBlocks& blocks,
+                       float scale, Vector2 offset) {
     if (circuit.num_inputs() % 2 != 0 || circuit.num_outputs() != circuit.num_inputs() / 2 + 1) {
         return;
     }
-
-    std::map<int, Rect> column_bounds;
-    for (const auto& [gate, rect] : layout.gate_positions) {
-        (void)gate;
-        int bucket = rounded_x_bucket(rect.x);
-        auto it = column_bounds.find(bucket);
-        if (it == column_bounds.end()) {
-            column_bounds[bucket] = rect;
-        } else {
-            Rect& b = it->second;
-            float min_x = std::min(b.x, rect.x);
-            float min_y = std::min(b.y, rect.y);
-            float max_x = std::max(b.x + b.w, rect.x + rect.w);
-            float max_y = std::max(b.y + b.h, rect.y + rect.h);
-            b = {min_x, min_y, max_x - min_x, max_y - min_y};
-        }
-    }
-
-    if (column_bounds.empty()) {
+    if (blocks.size() == 0) {
         return;
     }
 
-    // Sort columns right-to-left for bit indexing (Bit 0 at rightmost).
-    std::vector<Rect> columns;
-    columns.reserve(column_bounds.size());
-    for (const auto& [bucket, rect] : column_bounds) {
-        (void)bucket;
-        columns.push_back(rect);
-    }
-    std::sort(columns.begin(), columns.end(), [](const Rect& a, const Rect& b) { return a.x > b.x; });
-
-    for (size_t bit = 0; bit < columns.size(); bit++) {
-        Rect r = columns[bit];
+    // Instance blocks and right-to-left columns alike: block b is bit b
+    const bool detailed = is_detailed(scale);
+    for (size_t bit = 0; bit < blocks.size(); bit++) {
+        Rect r = blocks.bounds[bit];
         r.x -= GROUP_MARGIN;
         r.y -= (GROUP_MARGIN + 1.0f);
         r.w += GROUP_MARGIN * 2.0f;
         r.h += GROUP_MARGIN * 2.0f + 1.8f;
 
         Rectangle sr = to_screen(r, scale, offset);
+        if (!on_screen(sr)) {
+            continue;
+        }
         DrawRectangleRounded(sr, 0.15f, 4, GROUP_BG_COLOR);
         DrawRectangleRoundedLines(sr, 0.15f, 4, 1.0f, GROUP_BORDER_COLOR);
 
-        std::string label = "Bit " + std::to_string(bit);
-        DrawAppText(label.c_str(), static_cast<int>(sr.x + 6), static_cast<int>(sr.y + 4), 14,
-                 {180, 180, 200, 240});
+        if (detailed) {
+            std::string label = "Bit " + std::to_string(bit);
+            DrawAppText(label.c_str(), static_cast<int>(sr.x + 6), static_cast<int>(sr.y + 4), 14,
+                        {180, 180, 200, 240});
+        }
     }
 
     // Overflow (Cout) group near the final output pin.
@@ -176,18 +173,16 @@ void draw_adder_groups(const Circuit& circuit, const Layout& layout, float scale
 }
 
 void draw_gates(const Circuit& circuit, const Layout& layout, const AnimationState& anim,
-                float scale, Vector2 offset) {
-    const Gate* hovered_gate = nullptr;
-    Rectangle hovered_rect = {0, 0, 0, 0};
-
-    for (auto& gate_ptr : circuit.gates()) {
-        const Gate* gate = gate_ptr.get();
-        auto it = layout.gate_positions.find(gate);
-        if (it == layout.gate_positions.end()) {
+                const std::vector<uint32_t>& gate_ids, float scale, Vector2 offset,
+                const RenderEffects& effects) {
+    for (uint32_t id : gate_ids) {
+        const Gate* gate = circuit.gates()[id];
+        const Rect* rect = layout.gate_rect(gate);
+        if (rect == nullptr) {
             continue;
         }
 
-        Rectangle screen_rect = to_screen(it->second, scale, offset);
+        Rectangle screen_rect = to_screen(*rect, scale, offset);
         const GateAnim& ga = anim.gate_anim(gate);
 
         // Determine the gate's output value in O(1)
@@ -225,9 +220,11 @@ void draw_gates(const Circuit& circuit, const Layout& layout, const AnimationSta
                                   outline);
 
         // Draw gate-type accent stripe for quick visual differentiation.
-        Color accent = with_alpha(gate_type_accent(gate->get_type()), std::max(alpha, 0.45f));
-        DrawRectangle(static_cast<int>(screen_rect.x), static_cast<int>(screen_rect.y), 4,
-                  static_cast<int>(screen_rect.height), accent);
+        if (effects.gate_accents) {
+            Color accent = with_alpha(gate_type_accent(gate->get_type()), std::max(alpha, 0.45f));
+            DrawRectangle(static_cast<int>(screen_rect.x), static_cast<int>(screen_rect.y), 4,
+                          static_cast<int>(screen_rect.height), accent);
+        }
 
         // Draw gate type label centered
         auto label_sv = gate_type_name(gate->get_type());
@@ -240,68 +237,63 @@ void draw_gates(const Circuit& circuit, const Layout& layout, const AnimationSta
         Color label_color = with_alpha(LABEL_COLOR, std::max(alpha, 0.2f));
         DrawAppText(label, static_cast<int>(text_x), static_cast<int>(text_y), FONT_SIZE_GATE,
                  label_color);
+        GATEFLOW_PROFILE_DRAW_CALLS(effects.gate_accents ? 4 : 3); // Body, outline, accent, label
+    }
+}
 
-        if (CheckCollisionPointRec(GetMousePosition(), screen_rect)) {
-            hovered_gate = gate;
-            hovered_rect = screen_rect;
+void draw_gate_blocks(const Circuit& circuit, const GateBlocks& blocks, const AnimationState& anim,
+                      float scale, Vector2 offset) {
+    for (size_t b = 0; b < blocks.size(); b++) {
+        Rectangle screen_rect = to_screen(blocks.bounds[b], scale, offset);
+        if (!on_screen(screen_rect)) {
+            continue;
         }
-    }
 
-    if (hovered_gate != nullptr) {
-        std::vector<bool> in_vals;
-        in_vals.reserve(hovered_gate->get_inputs().size());
-        for (const Wire* w : hovered_gate->get_inputs()) {
-            in_vals.push_back(w->get_value());
+        // Fill mixes the pending, inactive and active colours by gate count
+        int counts[3] = {0, 0, 0}; // Pending, resolved 0, resolved 1
+        for (uint32_t i = blocks.offsets[b]; i < blocks.offsets[b + 1]; i++) {
+            const Gate* gate = circuit.gates()[blocks.gates[i]];
+            if (!anim.gate_anim(gate).resolved) {
+                counts[0]++;
+            } else {
+                const Wire* out = gate->get_output();
+                counts[(out != nullptr && out->get_value()) ? 2 : 1]++;
+            }
         }
-        bool out_val = false;
-        if (const Wire* out = hovered_gate->get_output(); out != nullptr) {
-            out_val = out->get_value();
+        const int total = counts[0] + counts[1] + counts[2];
+        if (total == 0) {
+            continue;
         }
-
-        std::vector<std::pair<std::string, bool>> rows;
-        auto add_row = [&](std::string row, bool highlight) {
-            rows.emplace_back(std::move(row), highlight);
-        };
-
-        bool a = in_vals.size() >= 1 ? in_vals[0] : false;
-        bool b = in_vals.size() >= 2 ? in_vals[1] : false;
-        switch (hovered_gate->get_type()) {
-        case GateType::XOR:
-            add_row("0,0 -> 0", !a && !b);
-            add_row("0,1 -> 1", !a && b);
-            add_row("1,0 -> 1", a && !b);
-            add_row("1,1 -> 0", a && b);
-            break;
-        case GateType::AND:
-            add_row("0,0 -> 0", !a && !b);
-            add_row("0,1 -> 0", !a && b);
-            add_row("1,0 -> 0", a && !b);
-            add_row("1,1 -> 1", a && b);
-            break;
-        case GateType::OR:
-            add_row("0,0 -> 0", !a && !b);
-            add_row("0,1 -> 1", !a && b);
-            add_row("1,0 -> 1", a && !b);
-            add_row("1,1 -> 1", a && b);
-            break;
-        case GateType::NAND:
-            add_row("0,0 -> 1", !a && !b);
-            add_row("0,1 -> 1", !a && b);
-            add_row("1,0 -> 1", a && !b);
-            add_row("1,1 -> 0", a && b);
-            break;
-        case GateType::NOT:
-            add_row("0 -> 1", !a);
-            add_row("1 -> 0", a);
-            break;
-        case GateType::BUFFER:
-            add_row("0 -> 0", !a);
-            add_row("1 -> 1", a);
-            break;
+        Color fill = lerp_color(GATE_PENDING_FILL, GATE_INACTIVE_FILL,
+                                static_cast<float>(counts[1] + counts[2]) / total);
+        if (counts[1] + counts[2] > 0) {
+            fill = lerp_color(fill, GATE_ACTIVE_FILL,
+                              static_cast<float>(counts[2]) / (counts[1] + counts[2]));
         }
+        Color outline = counts[0] > 0 ? GATE_PENDING_OUTLINE : GATE_INACTIVE_OUTLINE;
+
+        DrawRectangleRec(screen_rect, fill);
+        DrawRectangleLinesEx(screen_rect, 1.0f, outline);
+        GATEFLOW_PROFILE_DRAW_CALLS(2); // Body, outline
+    }
+}
+
+void draw_gate_tooltip(const Circuit& circuit, const Layout& layout, const SpatialIndex& index,
+                       GateTooltipCache& cache, float scale, Vector2 offset,
+                       const RenderEffects& effects) {
+    const Vector2 mouse = GetMousePosition();
+    const uint32_t hovered =
+        index.gate_at({(mouse.x - offset.x) / scale, (mouse.y - offset.y) / scale});
+
+    if (hovered != NO_GATE) {
+        const Gate* hovered_gate = circuit.gates()[hovered];
+        const Rectangle hovered_rect = to_screen(layout.gate_positions[hovered], scale, offset);
+        const GateTooltip& content = cache.get(*hovered_gate);
+        const size_t row_count = effects.tooltip_tables ? content.rows.size() : 0;
 
         const float tip_width = 294.0f;
-        const float tip_height = 62.0f + static_cast<float>(rows.size()) * 16.0f;
+        const float tip_height = row_count > 0 ? 62.0f + static_cast<float>(row_count) * 16.0f
+                                               : 50.0f;
         Rectangle tip = {hovered_rect.x + hovered_rect.width + 10.0f, hovered_rect.y - 6.0f,
                          tip_width, tip_height};
 
@@ -323,28 +315,21 @@ void draw_gates(const Circuit& circuit, const Layout& layout, const AnimationSta
         DrawRectangle(static_cast<int>(tip.x), static_cast<int>(tip.y), static_cast<int>(tip.width),
                       3, with_alpha(accent, 0.85f));
 
-        std::string title = std::string(gate_type_name(hovered_gate->get_type())) + " gate";
-        DrawAppText(title.c_str(), static_cast<int>(tip.x + 10), static_cast<int>(tip.y + 8), 14,
+        DrawAppText(content.title.c_str(), static_cast<int>(tip.x + 10), static_cast<int>(tip.y + 8), 14,
                  TOOLTIP_TITLE);
 
-        std::string io = "in: ";
-        for (size_t i = 0; i < in_vals.size(); i++) {
-            io += (in_vals[i] ? '1' : '0');
-            if (i + 1 < in_vals.size()) {
-                io += ", ";
-            }
-        }
-        io += "   out: ";
-        io += out_val ? '1' : '0';
-        DrawAppText(io.c_str(), static_cast<int>(tip.x + 10), static_cast<int>(tip.y + 29), 13,
+        DrawAppText(content.io.c_str(), static_cast<int>(tip.x + 10), static_cast<int>(tip.y + 29), 13,
                  TOOLTIP_BODY);
 
+        if (row_count == 0) {
+            return;
+        }
         DrawLine(static_cast<int>(tip.x + 8), static_cast<int>(tip.y + 46),
                  static_cast<int>(tip.x + tip.width - 8), static_cast<int>(tip.y + 46),
                  with_alpha(accent, 0.35f));
 
         int y = static_cast<int>(tip.y + 50);
-        for (const auto& [text, highlight] : rows) {
+        for (const auto& [text, highlight] : content.rows) {
             if (highlight) {
                 DrawRectangle(static_cast<int>(tip.x + 8), y - 1, static_cast<int>(tip.width - 16),
                               14, with_alpha(accent, 0.28f));
@@ -356,12 +341,43 @@ void draw_gates(const Circuit& circuit, const Layout& layout, const AnimationSta
     }
 }
 
+void draw_critical_gates(const Layout& layout, const TimingAnalysis& timing, float scale,
+                         Vector2 offset) {
+    char arrival[16];
+    const bool detailed = is_detailed(scale);
+    for (const Gate* gate : timing.critical_path().gates) {
+        const Rect* rect = layout.gate_rect(gate);
+        if (rect == nullptr) {
+            continue;
+        }
+        Rectangle screen_rect = to_screen(*rect, scale, offset);
+        if (!on_screen(screen_rect)) {
+            continue;
+        }
+        DrawRectangleRoundedLines(screen_rect, CORNER_ROUNDNESS, CORNER_SEGMENTS,
+                                  CRITICAL_OUTLINE_THICKNESS, CRITICAL_OUTLINE);
+        GATEFLOW_PROFILE_DRAW_CALLS(1);
+        if (!detailed) {
+            continue;
+        }
+
+        // Arrival time just above the gate
+        std::snprintf(arrival, sizeof(arrival), "%.1f", static_cast<double>(timing.arrival(gate)));
+        DrawAppText(arrival, static_cast<int>(screen_rect.x),
+                    static_cast<int>(screen_rect.y) - FONT_SIZE_ARRIVAL - 1, FONT_SIZE_ARRIVAL,
+                    CRITICAL_LABEL);
+        GATEFLOW_PROFILE_DRAW_CALLS(1);
+    }
+}
+
 void draw_io_labels(const Circuit& circuit, const Layout& layout, float scale, Vector2 offset) {
     int num_inputs = static_cast<int>(circuit.input_wires().size());
     int bits = num_inputs / 2;
 
     // Slightly smaller font for input labels to avoid overlap, but readable.
     constexpr int INPUT_FONT = 17;
+    constexpr float LABEL_REACH = 80.0f; // Pixels a label can extend past its dot
+    const bool detailed = is_detailed(scale);
 
     // Draw input dots and labels.
     // A[i] and B[i] share a column and are close together, so we right-align
@@ -369,7 +385,13 @@ void draw_io_labels(const Circuit& circuit, const Layout& layout, float scale, V
     // extends right of the dot) to prevent overlap.
     for (size_t i = 0; i < layout.input_positions.size(); i++) {
         Vector2 pos = to_screen(layout.input_positions[i], scale, offset);
+        if (!near_screen(pos, LABEL_REACH)) {
+            continue;
+        }
         DrawCircleV(pos, IO_DOT_RADIUS, IO_DOT_COLOR);
+        if (!detailed) {
+            continue;
+        }
 
         std::string label;
         bool is_a = static_cast<int>(i) < bits;
@@ -400,7 +422,13 @@ void draw_io_labels(const Circuit& circuit, const Layout& layout, float scale, V
     int num_outputs = static_cast<int>(circuit.output_wires().size());
     for (size_t i = 0; i < layout.output_positions.size(); i++) {
         Vector2 pos = to_screen(layout.output_positions[i], scale, offset);
+        if (!near_screen(pos, LABEL_REACH)) {
+            continue;
+        }
         DrawCircleV(pos, IO_DOT_RADIUS, IO_DOT_COLOR);
+        if (!detailed) {
+            continue;
+        }
 
         // Label: S0, S1, ... or Cout
         std::string label;
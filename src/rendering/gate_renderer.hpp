@@ -4,30 +4,78 @@
 #pragma once
 
 #include "rendering/animation_state.hpp"
+#include "rendering/gate_tooltip.hpp"
 #include "rendering/layout_engine.hpp"
+#include "rendering/spatial_index.hpp"
 #include "simulation/circuit.hpp"
+#include "timing/frame_pacer.hpp"
+#include "timing/static_timing.hpp"
 
 #include <raylib.h>
 
+#include <cstdint>
+#include <vector>
+
 namespace gateflow {
 
-/// Draws subtle structural grouping for ripple-carry adder columns.
+/// Draws subtle structural grouping for ripple-carry adder bits, with
+/// "Bit n" labels when the view is detailed (see is_detailed()).
 /// @param circuit The circuit
 /// @param layout  Precomputed positions
+/// @param blocks  One block per bit: the adder's instances (compute_instance_blocks()),
+///                or the layout's columns (compute_gate_blocks())
 /// @param scale   Pixels per logical unit
 /// @param offset  Screen-space offset
-void draw_adder_groups(const Circuit& circuit, const Layout& layout, float scale, Vector2 offset);
+void draw_adder_groups(const Circuit& circuit, const Layout& layout, const GateBlocks& blocks,
+                       float scale, Vector2 offset);
+
+/// Draws gates with animation state (pending/resolved/active coloring).
+/// @param circuit  The circuit whose gates are drawn
+/// @param layout   Precomputed positions for gates and wires
+/// @param anim     Current animation state for fade-in and pulsing
+/// @param gate_ids Ids of the gates to draw, in draw order (e.g. the visible ones)
+/// @param scale    Pixels per logical unit
+/// @param offset   Screen-space offset (for camera/viewport)
+/// @param effects  Optional effects to draw (gate_accents)
+void draw_gates(const Circuit& circuit, const Layout& layout, const AnimationState& anim,
+                const std::vector<uint32_t>& gate_ids, float scale, Vector2 offset,
+                const RenderEffects& effects = {});
 
-/// Draws all gates with animation state (pending/resolved/active coloring).
-/// @param circuit The circuit whose gates are drawn
-/// @param layout  Precomputed positions for gates and wires
-/// @param anim    Current animation state for fade-in and pulsing
+/// Level-of-detail stand-in for draw_gates(): one plain block per layout
+/// column, filled by the share of its gates still pending, resolved to 0
+/// and resolved to 1. No text.
+/// @param circuit The circuit whose gates are summarized
+/// @param blocks  The layout's columns (compute_gate_blocks())
+/// @param anim    Current animation state
 /// @param scale   Pixels per logical unit
 /// @param offset  Screen-space offset (for camera/viewport)
-void draw_gates(const Circuit& circuit, const Layout& layout, const AnimationState& anim,
-                float scale, Vector2 offset);
+void draw_gate_blocks(const Circuit& circuit, const GateBlocks& blocks, const AnimationState& anim,
+                      float scale, Vector2 offset);
+
+/// Draws the truth-table tooltip of the gate under the mouse, if any. Kept
+/// apart from draw_gates() so the gate bodies can be cached in a RenderLayer
+/// while the tooltip follows the mouse.
+/// @param circuit The circuit whose gates are hit-tested
+/// @param layout  Precomputed positions
+/// @param index   Grid over @p layout, for the hit-test
+/// @param cache   Tooltip text per gate of @p circuit
+/// @param scale   Pixels per logical unit
+/// @param offset  Screen-space offset (for camera/viewport)
+/// @param effects Optional effects to draw (tooltip_tables; title and values always show)
+void draw_gate_tooltip(const Circuit& circuit, const Layout& layout, const SpatialIndex& index,
+                       GateTooltipCache& cache, float scale, Vector2 offset,
+                       const RenderEffects& effects = {});
+
+/// Outlines the gates on the critical path and labels each with its
+/// arrival time (labels only when detailed). Drawn over draw_gates().
+/// @param layout  Precomputed positions
+/// @param timing  Timing analysis providing the critical path
+/// @param scale   Pixels per logical unit
+/// @param offset  Screen-space offset (for camera/viewport)
+void draw_critical_gates(const Layout& layout, const TimingAnalysis& timing, float scale,
+                         Vector2 offset);
 
-/// Draws input/output labels and connection points.
+/// Draws input/output connection points, and their labels when detailed.
 /// @param circuit The circuit
 /// @param layout  Precomputed positions
 /// @param scale   Pixels per logical unit
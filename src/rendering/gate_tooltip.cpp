@@ -0,0 +1,105 @@
+/// @file gate_tooltip.cpp
+/// @brief Tooltip text and the value-keyed per-gate cache
+
+#include "rendering/gate_tooltip.hpp"
+
+namespace gateflow {
+
+namespace {
+
+/// Input values packed one bit per input (fan-in is at most MAX_GATE_INPUTS)
+uint64_t input_bits(const Gate& gate) {
+    uint64_t bits = 0;
+    const auto& inputs = gate.get_inputs();
+    for (size_t i = 0; i < inputs.size(); i++) {
+        if (inputs[i]->get_value()) {
+            bits |= uint64_t{1} << i;
+        }
+    }
+    return bits;
+}
+
+bool output_value(const Gate& gate) {
+    const Wire* out = gate.get_output();
+    return out != nullptr && out->get_value();
+}
+
+} // namespace
+
+GateTooltip build_gate_tooltip(const Gate& gate) {
+    GateTooltip tip;
+    const auto& inputs = gate.get_inputs();
+    const bool out_val = output_value(gate);
+
+    auto add_row = [&](const char* row, bool highlight) { tip.rows.emplace_back(row, highlight); };
+
+    bool a = !inputs.empty() && inputs[0]->get_value();
+    bool b = inputs.size() >= 2 && inputs[1]->get_value();
+    switch (gate.get_type()) {
+    case GateType::XOR:
+        add_row("0,0 -> 0", !a && !b);
+        add_row("0,1 -> 1", !a && b);
+        add_row("1,0 -> 1", a && !b);
+        add_row("1,1 -> 0", a && b);
+        break;
+    case GateType::AND:
+        add_row("0,0 -> 0", !a && !b);
+        add_row("0,1 -> 0", !a && b);
+        add_row("1,0 -> 0", a && !b);
+        add_row("1,1 -> 1", a && b);
+        break;
+    case GateType::OR:
+        add_row("0,0 -> 0", !a && !b);
+        add_row("0,1 -> 1", !a && b);
+        add_row("1,0 -> 1", a && !b);
+        add_row("1,1 -> 1", a && b);
+        break;
+    case GateType::NAND:
+        add_row("0,0 -> 1", !a && !b);
+        add_row("0,1 -> 1", !a && b);
+        add_row("1,0 -> 1", a && !b);
+        add_row("1,1 -> 0", a && b);
+        break;
+    case GateType::NOT:
+        add_row("0 -> 1", !a);
+        add_row("1 -> 0", a);
+        break;
+    case GateType::BUFFER:
+        add_row("0 -> 0", !a);
+        add_row("1 -> 1", a);
+        break;
+    }
+
+    tip.title = std::string(gate_type_name(gate.get_type())) + " gate";
+
+    tip.io = "in: ";
+    for (size_t i = 0; i < inputs.size(); i++) {
+        tip.io += (inputs[i]->get_value() ? '1' : '0');
+        if (i + 1 < inputs.size()) {
+            tip.io += ", ";
+        }
+    }
+    tip.io += "   out: ";
+    tip.io += out_val ? '1' : '0';
+    return tip;
+}
+
+const GateTooltip& GateTooltipCache::get(const Gate& gate) {
+    const uint32_t id = gate.get_id();
+    if (id >= entries_.size()) {
+        entries_.resize(id + 1);
+    }
+    Entry& entry = entries_[id];
+    const uint64_t inputs = input_bits(gate);
+    const bool output = output_value(gate);
+    if (!entry.valid || entry.inputs != inputs || entry.output != output) {
+        entry.tooltip = build_gate_tooltip(gate);
+        entry.inputs = inputs;
+        entry.output = output;
+        entry.valid = true;
+        builds_++;
+    }
+    return entry.tooltip;
+}
+
+} // namespace gateflow
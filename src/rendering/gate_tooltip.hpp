@@ -0,0 +1,51 @@
+/// @file gate_tooltip.hpp
+/// @brief Per-gate cache of the hover tooltip's text (title, values, truth table)
+
+#pragma once
+
+#include "simulation/circuit.hpp"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gateflow {
+
+/// Text of one gate's tooltip for its current input and output values.
+struct GateTooltip {
+    std::string title;                              ///< e.g. "XOR gate"
+    std::string io;                                 ///< e.g. "in: 0, 1   out: 1"
+    std::vector<std::pair<std::string, bool>> rows; ///< Truth-table rows, true = current row
+};
+
+/// Builds the tooltip text of @p gate from its wires' current values.
+[[nodiscard]] GateTooltip build_gate_tooltip(const Gate& gate);
+
+/// Tooltips by gate id, built on first hover and rebuilt only when that
+/// gate's input or output values differ from the ones it was built for.
+/// Belongs to a single circuit.
+class GateTooltipCache {
+  public:
+    /// Returns the (possibly cached) tooltip of @p gate.
+    const GateTooltip& get(const Gate& gate);
+
+    /// Drops every cached tooltip
+    void clear() { entries_.clear(); }
+
+    /// Number of tooltips built so far
+    [[nodiscard]] size_t builds() const { return builds_; }
+
+  private:
+    struct Entry {
+        GateTooltip tooltip;
+        uint64_t inputs = 0; ///< Bit i = value of input i when built
+        bool output = false;
+        bool valid = false;
+    };
+
+    std::vector<Entry> entries_; ///< Per gate id
+    size_t builds_ = 0;
+};
+
+} // namespace gateflow
@@ -0,0 +1,40 @@
+/// @file layout_cache.cpp
+/// @brief Implementation of the structural-hash keyed layout cache
+
+#include "rendering/layout_cache.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace gateflow {
+
+const Layout& LayoutCache::get(const Circuit& circuit) {
+    const uint64_t key = circuit.structural_hash();
+    auto it = entries_.find(key);
+    // The element counts guard the id-indexed vectors against a hash collision
+    if (it != entries_.end() && it->second.gate_positions.size() == circuit.gates().size() &&
+        it->second.wire_paths.size() == circuit.wires().size()) {
+        hits_++;
+        return it->second;
+    }
+    misses_++;
+    Layout& slot = entries_[key];
+    slot = compute_layout(circuit);
+    return slot;
+}
+
+const Layout& LayoutCache::insert(const Circuit& circuit, Layout layout) {
+    if (layout.gate_positions.size() != circuit.gates().size() ||
+        layout.wire_paths.size() != circuit.wires().size()) {
+        throw std::invalid_argument("Layout does not match the circuit's gates and wires");
+    }
+    Layout& slot = entries_[circuit.structural_hash()];
+    slot = std::move(layout);
+    return slot;
+}
+
+void LayoutCache::clear() {
+    entries_.clear();
+}
+
+} // namespace gateflow
@@ -0,0 +1,44 @@
+/// @file layout_cache.hpp
+/// @brief Reuses computed layouts across circuits with the same structure.
+///
+/// compute_layout() depends only on a circuit's structure, never on its
+/// signal values, and Layout is indexed by gate/wire id. A layout computed
+/// once can therefore be reused for any circuit whose structural_hash()
+/// matches, e.g. when toggling between logical and NAND views.
+
+#pragma once
+
+#include "rendering/layout_engine.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace gateflow {
+
+class LayoutCache {
+  public:
+    /// Returns the layout for this circuit's structure, computing it on a miss.
+    /// The reference stays valid until clear() or the cache is destroyed.
+    const Layout& get(const Circuit& circuit);
+
+    /// Stores a layout computed elsewhere (e.g. loaded from a netlist file)
+    /// for this circuit's structure, replacing any cached one.
+    /// @throws std::invalid_argument if the layout is not sized for the circuit
+    const Layout& insert(const Circuit& circuit, Layout layout);
+
+    /// Drops every cached layout
+    void clear();
+
+    [[nodiscard]] size_t size() const { return entries_.size(); }
+    [[nodiscard]] size_t hits() const { return hits_; }
+    [[nodiscard]] size_t misses() const { return misses_; }
+
+  private:
+    // unordered_map nodes never move, so returned references survive inserts
+    std::unordered_map<uint64_t, Layout> entries_;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+};
+
+} // namespace gateflow
@@ -3,9 +3,12 @@
 
 #include "rendering/layout_engine.hpp"
 
+#include "simulation/thread_pool.hpp"
+
 #include <algorithm>
 #include <cmath>
-#include <unordered_map>
+#include <functional>
+#include <map>
 #include <unordered_set>
 #include <utility>
 
@@ -23,36 +26,6 @@ constexpr float OUTPUT_MARGIN_BOTTOM = 2.0f;  // Space below last row for output
 constexpr float CARRY_WIRE_Y = 0.0f;          // Y position for carry chain
 constexpr float LABEL_AREA_HEIGHT = 3.0f;     // Space for input labels at top
 
-/// Computes the topological depth of each gate (longest path from any input).
-/// Used for generic fallback layout.
-std::unordered_map<const Gate*, int> compute_gate_depths(const Circuit& circuit) {
-    std::unordered_map<const Gate*, int> depth;
-    for (const Gate* gate : circuit.topological_order()) {
-        int max_input_depth = -1;
-        for (const Wire* input_wire : gate->get_inputs()) {
-            const Gate* src = input_wire->get_source();
-            if (src != nullptr) {
-                auto it = depth.find(src);
-                if (it != depth.end()) {
-                    max_input_depth = std::max(max_input_depth, it->second);
-                }
-            }
-        }
-        depth[gate] = max_input_depth + 1;
-    }
-    return depth;
-}
-
-/// Groups gates by depth column for generic layout
-std::map<int, std::vector<const Gate*>>
-group_by_depth(const std::unordered_map<const Gate*, int>& depths) {
-    std::map<int, std::vector<const Gate*>> columns;
-    for (auto& [gate, d] : depths) {
-        columns[d].push_back(gate);
-    }
-    return columns;
-}
-
 /// Computes a Manhattan-routed wire path between two points.
 /// Routes horizontally first, then vertically, then horizontally to destination.
 std::vector<Vec2> route_wire(Vec2 from, Vec2 to, float channel_offset = 0.0f) {
@@ -105,10 +78,186 @@ Vec2 gate_input_point(const Rect& r, int input_index, int total_inputs) {
     return {r.x, r.y + step * static_cast<float>(input_index + 1)};
 }
 
+/// Smallest rect containing both
+Rect bounding_union(const Rect& a, const Rect& b) {
+    const float min_x = std::min(a.x, b.x);
+    const float min_y = std::min(a.y, b.y);
+    const float max_x = std::max(a.x + a.w, b.x + b.w);
+    const float max_y = std::max(a.y + a.h, b.y + b.h);
+    return {min_x, min_y, max_x - min_x, max_y - min_y};
+}
+
+/// Marks a wire that is not a primary input (or output) in RoutingTables
+constexpr uint32_t NO_INDEX = UINT32_MAX;
+
+/// Fewest wires a parallel routing chunk covers; smaller circuits route serially
+constexpr size_t MIN_ROUTE_GRAIN = 1024;
+
+/// Lookups that let route_wires() handle each edge once instead of
+/// searching the primary I/O lists and each destination's inputs per wire.
+struct RoutingTables {
+    std::vector<uint32_t> input_index;  ///< Per wire id: first position in input_wires()
+    std::vector<uint32_t> output_index; ///< Per wire id: first position in output_wires()
+    std::vector<uint32_t> pin_offsets;  ///< Pins of wire w: pins[pin_offsets[w], pin_offsets[w+1])
+    std::vector<uint32_t> pins;         ///< Input slot per destination, in destination order
+};
+
+/// Builds the tables in O(gates + wires + edges). A destination that reads
+/// a wire more than once connects every branch to its first matching slot.
+RoutingTables build_routing_tables(const Circuit& circuit) {
+    const auto& wires = circuit.wires();
+    const auto& gates = circuit.gates();
+    const size_t num_wires = wires.size();
+    RoutingTables t;
+
+    // Filled back to front so the first occurrence wins
+    t.input_index.assign(num_wires, NO_INDEX);
+    for (size_t i = circuit.input_wires().size(); i-- > 0;) {
+        t.input_index[circuit.input_wires()[i]->get_id()] = static_cast<uint32_t>(i);
+    }
+    t.output_index.assign(num_wires, NO_INDEX);
+    for (size_t i = circuit.output_wires().size(); i-- > 0;) {
+        t.output_index[circuit.output_wires()[i]->get_id()] = static_cast<uint32_t>(i);
+    }
+
+    t.pin_offsets.assign(num_wires + 1, 0);
+    for (size_t w = 0; w < num_wires; w++) {
+        t.pin_offsets[w + 1] =
+            t.pin_offsets[w] + static_cast<uint32_t>(wires[w]->get_destinations().size());
+    }
+
+    // Gate-major pass: record each gate's first slot per wire it reads in
+    // that wire's pin range. A gate's inputs are visited together, so
+    // remembering the last gate per wire is enough to skip repeats.
+    struct Reader {
+        uint32_t gate;
+        uint32_t slot;
+    };
+    std::vector<Reader> readers(t.pin_offsets.back());
+    std::vector<uint32_t> fill(t.pin_offsets.begin(), t.pin_offsets.end() - 1);
+    std::vector<uint32_t> last_gate(num_wires, NO_INDEX);
+    for (const Gate* gate : gates) {
+        const uint32_t g = gate->get_id();
+        const auto& inputs = gate->get_inputs();
+        for (uint32_t k = 0; k < inputs.size(); k++) {
+            const uint32_t w = inputs[k]->get_id();
+            if (last_gate[w] != g && fill[w] < t.pin_offsets[w + 1]) {
+                last_gate[w] = g;
+                readers[fill[w]++] = {g, k};
+            }
+        }
+    }
+
+    // Wire-major pass: scatter a wire's readers into per-gate scratch, then
+    // gather them back in destination order
+    t.pins.assign(readers.size(), 0);
+    std::vector<uint32_t> gate_slot(gates.size(), 0);
+    std::vector<uint32_t> gate_wire(gates.size(), NO_INDEX);
+    for (uint32_t w = 0; w < num_wires; w++) {
+        for (uint32_t r = t.pin_offsets[w]; r < fill[w]; r++) {
+            gate_slot[readers[r].gate] = readers[r].slot;
+            gate_wire[readers[r].gate] = w;
+        }
+        const auto& dests = wires[w]->get_destinations();
+        for (uint32_t j = 0; j < dests.size(); j++) {
+            const uint32_t g = dests[j]->get_id();
+            if (gate_wire[g] == w) {
+                t.pins[t.pin_offsets[w] + j] = gate_slot[g];
+            }
+        }
+    }
+    return t;
+}
+
+/// Routes wires [lo, hi): one branch per destination, or a single branch to
+/// the output position for a driven wire without destinations. Writes only
+/// those wires' entries of layout.wire_paths.
+void route_wire_range(const Circuit& circuit, const RoutingTables& t, Layout& layout,
+                      size_t lo, size_t hi) {
+    for (size_t w = lo; w < hi; w++) {
+        const Wire* wire = circuit.wires()[w];
+        const Gate* src_gate = wire->get_source();
+        const auto& dests = wire->get_destinations();
+        std::vector<WirePath>& branches = layout.wire_paths[w];
+
+        Vec2 from;
+        if (src_gate == nullptr) {
+            // Primary input wire — route from its input position
+            if (dests.empty() || t.input_index[w] == NO_INDEX) {
+                continue;
+            }
+            from = layout.input_positions[t.input_index[w]];
+        } else {
+            const Rect* src_rect = layout.gate_rect(src_gate);
+            if (src_rect == nullptr) {
+                continue;
+            }
+            from = gate_output_point(*src_rect);
+            if (dests.empty()) {
+                // Output-only wire — route to its output position
+                if (t.output_index[w] != NO_INDEX) {
+                    Vec2 to = layout.output_positions[t.output_index[w]];
+                    branches.push_back(build_wire_path(route_wire(from, to)));
+                }
+                continue;
+            }
+        }
+
+        branches.reserve(dests.size());
+        for (uint32_t j = 0; j < dests.size(); j++) {
+            const Gate* dest = dests[j];
+            const Rect* dest_rect = layout.gate_rect(dest);
+            if (dest_rect == nullptr) {
+                continue;
+            }
+            const int pin = static_cast<int>(t.pins[t.pin_offsets[w] + j]);
+            const int total = static_cast<int>(dest->get_inputs().size());
+            Vec2 to = gate_input_point(*dest_rect, pin, total);
+            branches.push_back(build_wire_path(route_wire(from, to)));
+        }
+    }
+}
+
+/// Routes every wire once gates and I/O are placed. Wires route independently,
+/// so large circuits are split across the circuit's thread pool, if it has one.
+void route_wires(const Circuit& circuit, Layout& layout) {
+    const RoutingTables tables = build_routing_tables(circuit);
+    const size_t num_wires = circuit.wires().size();
+
+    ThreadPool* pool = circuit.thread_pool();
+    if (pool == nullptr || pool->concurrency() == 1 || num_wires < 2 * MIN_ROUTE_GRAIN) {
+        route_wire_range(circuit, tables, layout, 0, num_wires);
+        return;
+    }
+    // A few chunks per thread, as in propagate_lanes(), so uneven chunks balance out
+    const size_t grain = std::max(MIN_ROUTE_GRAIN, num_wires / (pool->concurrency() * 4));
+    pool->parallel_for(0, num_wires, grain, [&](size_t lo, size_t hi) {
+        route_wire_range(circuit, tables, layout, lo, hi);
+    });
+}
+
 } // namespace
 
+MemoryUsage Layout::memory_usage() const {
+    MemoryUsage usage;
+    usage.add_vector("gate positions", gate_positions);
+    usage.add_vector("wire paths", wire_paths);
+    for (const std::vector<WirePath>& branches : wire_paths) {
+        usage.add_vector("wire paths", branches);
+        for (const WirePath& path : branches) {
+            usage.add_vector("path points", path.points);
+            usage.add_vector("path points", path.cumulative_lengths);
+        }
+    }
+    usage.add_vector("io positions", input_positions);
+    usage.add_vector("io positions", output_positions);
+    return usage;
+}
+
 Layout compute_layout(const Circuit& circuit) {
     Layout layout;
+    layout.gate_positions.resize(circuit.gates().size());
+    layout.wire_paths.resize(circuit.wires().size());
 
     // Detect the circuit structure:
     // A ripple-carry adder built by build_ripple_carry_adder(n) has
@@ -128,6 +277,19 @@ Layout compute_layout(const Circuit& circuit) {
     int expected_gates = (bits > 0) ? 2 + (bits - 1) * 5 : 0;
     is_rca = is_rca && (num_gates == expected_gates) && (bits >= 1);
 
+    // Other adders with the same input/output convention (e.g. a small
+    // Kogge-Stone adder) can match that count, so also check the gate types
+    if (is_rca) {
+        static constexpr GateType HALF_ADDER[] = {GateType::XOR, GateType::AND};
+        static constexpr GateType FULL_ADDER[] = {GateType::XOR, GateType::AND, GateType::XOR,
+                                                  GateType::AND, GateType::OR};
+        const auto& gates = circuit.gates();
+        for (int g = 0; g < num_gates && is_rca; g++) {
+            GateType expected = g < 2 ? HALF_ADDER[g] : FULL_ADDER[(g - 2) % 5];
+            is_rca = gates[g]->get_type() == expected;
+        }
+    }
+
     if (is_rca) {
         // --- Ripple-carry adder specific layout ---
         // Column 0 (rightmost) = bit 0 (half adder, 2 gates)
@@ -147,33 +309,33 @@ Layout compute_layout(const Circuit& circuit) {
 
             if (bit == 0) {
                 // Half adder: XOR (row 0), AND (row 1)
-                Gate* xor_g = gates[0].get();
-                Gate* and_g = gates[1].get();
+                Gate* xor_g = gates[0];
+                Gate* and_g = gates[1];
 
-                layout.gate_positions[xor_g] = {col_x, start_y, GATE_WIDTH, GATE_HEIGHT};
-                layout.gate_positions[and_g] = {
+                layout.gate_positions[xor_g->get_id()] = {col_x, start_y, GATE_WIDTH, GATE_HEIGHT};
+                layout.gate_positions[and_g->get_id()] = {
                     col_x, start_y + GATE_HEIGHT + GATE_VERTICAL_SPACING, GATE_WIDTH, GATE_HEIGHT};
             } else {
                 // Full adder: XOR1, AND1, XOR2, AND2, OR
                 int base = 2 + (bit - 1) * 5;
-                Gate* xor1 = gates[base + 0].get();
-                Gate* and1 = gates[base + 1].get();
-                Gate* xor2 = gates[base + 2].get();
-                Gate* and2 = gates[base + 3].get();
-                Gate* or_g = gates[base + 4].get();
+                Gate* xor1 = gates[base + 0];
+                Gate* and1 = gates[base + 1];
+                Gate* xor2 = gates[base + 2];
+                Gate* and2 = gates[base + 3];
+                Gate* or_g = gates[base + 4];
 
                 float y = start_y;
                 float row_step = GATE_HEIGHT + GATE_VERTICAL_SPACING;
 
-                layout.gate_positions[xor1] = {col_x, y, GATE_WIDTH, GATE_HEIGHT};
+                layout.gate_positions[xor1->get_id()] = {col_x, y, GATE_WIDTH, GATE_HEIGHT};
                 y += row_step;
-                layout.gate_positions[and1] = {col_x, y, GATE_WIDTH, GATE_HEIGHT};
+                layout.gate_positions[and1->get_id()] = {col_x, y, GATE_WIDTH, GATE_HEIGHT};
                 y += row_step;
-                layout.gate_positions[xor2] = {col_x, y, GATE_WIDTH, GATE_HEIGHT};
+                layout.gate_positions[xor2->get_id()] = {col_x, y, GATE_WIDTH, GATE_HEIGHT};
                 y += row_step;
-                layout.gate_positions[and2] = {col_x, y, GATE_WIDTH, GATE_HEIGHT};
+                layout.gate_positions[and2->get_id()] = {col_x, y, GATE_WIDTH, GATE_HEIGHT};
                 y += row_step;
-                layout.gate_positions[or_g] = {col_x, y, GATE_WIDTH, GATE_HEIGHT};
+                layout.gate_positions[or_g->get_id()] = {col_x, y, GATE_WIDTH, GATE_HEIGHT};
             }
         }
 
@@ -194,7 +356,7 @@ Layout compute_layout(const Circuit& circuit) {
         // Output positions: Sum[0..n-1] then Carry-out
         // Each sum output is at the bottom of its column
         float max_y = start_y; // Track the tallest column
-        for (auto& [gate, rect] : layout.gate_positions) {
+        for (const Rect& rect : layout.gate_positions) {
             max_y = std::max(max_y, rect.y + rect.h);
         }
         float output_y = max_y + OUTPUT_MARGIN_BOTTOM;
@@ -206,95 +368,23 @@ Layout compute_layout(const Circuit& circuit) {
         // Carry-out: at the leftmost column, slightly above
         float carry_out_x = static_cast<float>(bits - 1) * COLUMN_SPACING + COLUMN_SPACING * 0.5f;
         layout.output_positions.push_back({carry_out_x, output_y});
-
-        // --- Wire routing ---
-        for (auto& wire_ptr : circuit.wires()) {
-            const Wire* wire = wire_ptr.get();
-            const Gate* src_gate = wire->get_source();
-            const auto& dests = wire->get_destinations();
-
-            if (src_gate == nullptr && dests.empty()) {
-                continue; // Unconnected wire
-            }
-
-            if (src_gate == nullptr) {
-                // Primary input wire — route from input position to gate input
-                // Find which input index this wire is
-                for (size_t idx = 0; idx < circuit.input_wires().size(); idx++) {
-                    if (circuit.input_wires()[idx] == wire) {
-                        Vec2 from = layout.input_positions[idx];
-                        for (const Gate* dest : dests) {
-                            auto it = layout.gate_positions.find(dest);
-                            if (it == layout.gate_positions.end()) {
-                                continue;
-                            }
-                            int inp_idx = 0;
-                            for (size_t k = 0; k < dest->get_inputs().size(); k++) {
-                                if (dest->get_inputs()[k] == wire) {
-                                    inp_idx = static_cast<int>(k);
-                                    break;
-                                }
-                            }
-                            Vec2 to = gate_input_point(it->second, inp_idx,
-                                                       static_cast<int>(dest->get_inputs().size()));
-                            layout.wire_paths[wire].push_back(build_wire_path(route_wire(from, to)));
-                        }
-                        break;
-                    }
-                }
-                continue;
-            }
-
-            // Gate-to-gate wire or gate-to-output wire
-            auto src_it = layout.gate_positions.find(src_gate);
-            if (src_it == layout.gate_positions.end()) {
-                continue;
-            }
-            Vec2 from = gate_output_point(src_it->second);
-
-            if (dests.empty()) {
-                // Output-only wire — route to output position
-                for (size_t idx = 0; idx < circuit.output_wires().size(); idx++) {
-                    if (circuit.output_wires()[idx] == wire) {
-                        Vec2 to = layout.output_positions[idx];
-                        layout.wire_paths[wire].push_back(build_wire_path(route_wire(from, to)));
-                        break;
-                    }
-                }
-            } else {
-                // Gate-to-gate fan-out: route one branch per destination.
-                for (const Gate* dest : dests) {
-                    auto dest_it = layout.gate_positions.find(dest);
-                    if (dest_it == layout.gate_positions.end()) {
-                        continue;
-                    }
-                    int inp_idx = 0;
-                    for (size_t k = 0; k < dest->get_inputs().size(); k++) {
-                        if (dest->get_inputs()[k] == wire) {
-                            inp_idx = static_cast<int>(k);
-                            break;
-                        }
-                    }
-                    Vec2 to = gate_input_point(dest_it->second, inp_idx,
-                                               static_cast<int>(dest->get_inputs().size()));
-                    layout.wire_paths[wire].push_back(build_wire_path(route_wire(from, to)));
-                }
-            }
-        }
-
     } else {
         // --- Generic fallback layout: arrange by topological depth ---
-        auto depths = compute_gate_depths(circuit);
-        auto columns = group_by_depth(depths);
+        // Each compiled level is one depth column, and topological_order()
+        // lists a level as one contiguous span of slots.
+        const CompiledNetlist& net = circuit.compiled();
+        const auto& order = circuit.topological_order();
 
         float start_y = LABEL_AREA_HEIGHT + INPUT_MARGIN_TOP;
-        int max_depth = columns.empty() ? 0 : columns.rbegin()->first;
+        int max_depth = net.num_levels() > 0 ? static_cast<int>(net.num_levels()) - 1 : 0;
 
-        for (auto& [depth, col_gates] : columns) {
+        for (size_t depth = 0; depth < net.num_levels(); depth++) {
             float col_x = static_cast<float>(depth) * COLUMN_SPACING;
-            for (size_t row = 0; row < col_gates.size(); row++) {
-                float y = start_y + static_cast<float>(row) * (GATE_HEIGHT + GATE_VERTICAL_SPACING);
-                layout.gate_positions[col_gates[row]] = {col_x, y, GATE_WIDTH, GATE_HEIGHT};
+            const uint32_t first = net.level_offsets[depth];
+            for (uint32_t slot = first; slot < net.level_offsets[depth + 1]; slot++) {
+                float row = static_cast<float>(slot - first);
+                float y = start_y + row * (GATE_HEIGHT + GATE_VERTICAL_SPACING);
+                layout.gate_positions[order[slot]->get_id()] = {col_x, y, GATE_WIDTH, GATE_HEIGHT};
             }
         }
 
@@ -308,75 +398,13 @@ Layout compute_layout(const Circuit& circuit) {
             float y = start_y + static_cast<float>(i) * (GATE_HEIGHT + GATE_VERTICAL_SPACING);
             layout.output_positions.push_back({output_x, y});
         }
-
-        // Wire routing for generic layout
-        for (auto& wire_ptr : circuit.wires()) {
-            const Wire* wire = wire_ptr.get();
-            const Gate* src_gate = wire->get_source();
-            const auto& dests = wire->get_destinations();
-
-            if (src_gate == nullptr && !dests.empty()) {
-                for (size_t idx = 0; idx < circuit.input_wires().size(); idx++) {
-                    if (circuit.input_wires()[idx] == wire) {
-                        Vec2 from = layout.input_positions[idx];
-                        for (const Gate* dest : dests) {
-                            auto it = layout.gate_positions.find(dest);
-                            if (it != layout.gate_positions.end()) {
-                                int inp_idx = 0;
-                                for (size_t k = 0; k < dest->get_inputs().size(); k++) {
-                                    if (dest->get_inputs()[k] == wire) {
-                                        inp_idx = static_cast<int>(k);
-                                        break;
-                                    }
-                                }
-                                Vec2 to = gate_input_point(
-                                    it->second, inp_idx, static_cast<int>(dest->get_inputs().size()));
-                                layout.wire_paths[wire].push_back(
-                                    build_wire_path(route_wire(from, to)));
-                            }
-                        }
-                        break;
-                    }
-                }
-            } else if (src_gate != nullptr) {
-                auto src_it = layout.gate_positions.find(src_gate);
-                if (src_it == layout.gate_positions.end()) {
-                    continue;
-                }
-                Vec2 from = gate_output_point(src_it->second);
-
-                if (dests.empty()) {
-                    for (size_t idx = 0; idx < circuit.output_wires().size(); idx++) {
-                        if (circuit.output_wires()[idx] == wire) {
-                            layout.wire_paths[wire].push_back(
-                                build_wire_path(route_wire(from, layout.output_positions[idx])));
-                            break;
-                        }
-                    }
-                } else {
-                    for (const Gate* dest : dests) {
-                        auto dest_it = layout.gate_positions.find(dest);
-                        if (dest_it != layout.gate_positions.end()) {
-                            int inp_idx = 0;
-                            for (size_t k = 0; k < dest->get_inputs().size(); k++) {
-                                if (dest->get_inputs()[k] == wire) {
-                                    inp_idx = static_cast<int>(k);
-                                    break;
-                                }
-                            }
-                            Vec2 to = gate_input_point(dest_it->second, inp_idx,
-                                                       static_cast<int>(dest->get_inputs().size()));
-                            layout.wire_paths[wire].push_back(build_wire_path(route_wire(from, to)));
-                        }
-                    }
-                }
-            }
-        }
     }
 
+    route_wires(circuit, layout);
+
     // Compute bounding box
     float min_x = 1e9f, min_y = 1e9f, max_x = -1e9f, max_y = -1e9f;
-    for (auto& [gate, rect] : layout.gate_positions) {
+    for (const Rect& rect : layout.gate_positions) {
         min_x = std::min(min_x, rect.x);
         min_y = std::min(min_y, rect.y);
         max_x = std::max(max_x, rect.x + rect.w);
@@ -402,4 +430,86 @@ Layout compute_layout(const Circuit& circuit) {
     return layout;
 }
 
+GateBlocks compute_gate_blocks(const Layout& layout) {
+    // Columns keyed by x rounded to 1/100 unit, iterated right to left
+    std::map<int, std::vector<uint32_t>, std::greater<int>> columns;
+    for (uint32_t g = 0; g < layout.gate_positions.size(); g++) {
+        columns[static_cast<int>(std::round(layout.gate_positions[g].x * 100.0f))].push_back(g);
+    }
+
+    GateBlocks blocks;
+    blocks.offsets.push_back(0);
+    for (const auto& [bucket, gates] : columns) {
+        (void)bucket;
+        Rect b = layout.gate_positions[gates.front()];
+        for (uint32_t g : gates) {
+            b = bounding_union(b, layout.gate_positions[g]);
+        }
+        blocks.bounds.push_back(b);
+        blocks.gates.insert(blocks.gates.end(), gates.begin(), gates.end());
+        blocks.offsets.push_back(static_cast<uint32_t>(blocks.gates.size()));
+    }
+    return blocks;
+}
+
+GateBlocks compute_instance_blocks(const Circuit& circuit, const Layout& layout) {
+    GateBlocks blocks;
+    const size_t count = circuit.num_instances();
+    if (count == 0 || layout.gate_positions.size() != circuit.gates().size()) {
+        return blocks;
+    }
+
+    // Counting sort by instance keeps gate ids ascending within a block
+    blocks.offsets.assign(count + 1, 0);
+    for (const Gate* gate : circuit.gates()) {
+        const uint32_t instance = circuit.instance_of(gate);
+        if (instance != Circuit::NO_INSTANCE) {
+            blocks.offsets[instance + 1]++;
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        blocks.offsets[i + 1] += blocks.offsets[i];
+    }
+    blocks.gates.resize(blocks.offsets.back());
+    std::vector<uint32_t> fill(blocks.offsets.begin(), blocks.offsets.end() - 1);
+    for (const Gate* gate : circuit.gates()) {
+        const uint32_t instance = circuit.instance_of(gate);
+        if (instance != Circuit::NO_INSTANCE) {
+            blocks.gates[fill[instance]++] = gate->get_id();
+        }
+    }
+
+    blocks.bounds.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t first = blocks.offsets[i];
+        const uint32_t last = blocks.offsets[i + 1];
+        if (first == last) {
+            return {}; // An empty instance has nowhere to be drawn
+        }
+        Rect b = layout.gate_positions[blocks.gates[first]];
+        for (uint32_t k = first + 1; k < last; k++) {
+            b = bounding_union(b, layout.gate_positions[blocks.gates[k]]);
+        }
+        blocks.bounds[i] = b;
+    }
+
+    // Sweep in x order: only blocks starting inside another's x span can overlap it
+    std::vector<uint32_t> by_x(count);
+    for (uint32_t i = 0; i < count; i++) {
+        by_x[i] = i;
+    }
+    std::sort(by_x.begin(), by_x.end(),
+              [&](uint32_t l, uint32_t r) { return blocks.bounds[l].x < blocks.bounds[r].x; });
+    for (size_t i = 0; i < count; i++) {
+        const Rect& a = blocks.bounds[by_x[i]];
+        for (size_t j = i + 1; j < count && blocks.bounds[by_x[j]].x < a.x + a.w; j++) {
+            const Rect& b = blocks.bounds[by_x[j]];
+            if (b.y < a.y + a.h && a.y < b.y + b.h) {
+                return {};
+            }
+        }
+    }
+    return blocks;
+}
+
 } // namespace gateflow
@@ -4,8 +4,9 @@
 /// @brief Computes screen positions for circuit elements in logical units
 
 #include "simulation/circuit.hpp"
+#include "simulation/memory_usage.hpp"
 
-#include <map>
+#include <cstdint>
 #include <vector>
 
 namespace gateflow {
@@ -34,14 +35,56 @@ struct WirePath {
 
 /// Holds the computed positions of every visual element in a circuit.
 /// All coordinates are in logical units — the renderer scales to screen pixels.
+/// Per-element data is indexed by gate/wire id, so lookups are O(1) and a
+/// layout stays valid for any circuit with the same structure.
 struct Layout {
-    std::map<const Gate*, Rect> gate_positions;
-    std::map<const Wire*, std::vector<WirePath>> wire_paths;
+    std::vector<Rect> gate_positions;              ///< Per gate id
+    std::vector<std::vector<WirePath>> wire_paths; ///< Per wire id (empty = not drawn)
     std::vector<Vec2> input_positions;
     std::vector<Vec2> output_positions;
     Rect bounding_box;
+
+    /// Rect of a gate, or nullptr if the gate has no position in this layout
+    [[nodiscard]] const Rect* gate_rect(const Gate* gate) const {
+        uint32_t id = gate->get_id();
+        return id < gate_positions.size() ? &gate_positions[id] : nullptr;
+    }
+
+    /// Routed branches of a wire (empty if the wire is not drawn)
+    [[nodiscard]] const std::vector<WirePath>& wire_branches(const Wire* wire) const {
+        static const std::vector<WirePath> none;
+        uint32_t id = wire->get_id();
+        return id < wire_paths.size() ? wire_paths[id] : none;
+    }
+
+    /// Heap memory by category: "gate positions", "wire paths" (the per-wire
+    /// branch lists), "path points" (every branch's points and cumulative
+    /// lengths) and "io positions"
+    [[nodiscard]] MemoryUsage memory_usage() const;
 };
 
+/// Gates grouped into blocks: by layout column (one full adder per block in
+/// the ripple-carry layout, one depth level per block in the generic layout,
+/// ordered right to left so in an adder block b is bit b), or by module
+/// instance.
+struct GateBlocks {
+    std::vector<Rect> bounds;      ///< Per block: bounding box of its gates
+    std::vector<uint32_t> offsets; ///< Gates of block b are gates[offsets[b], offsets[b + 1])
+    std::vector<uint32_t> gates;   ///< Gate ids, ascending within a block
+
+    [[nodiscard]] size_t size() const { return bounds.size(); }
+};
+
+/// Groups a layout's gates by column (gates whose rects share an x position).
+[[nodiscard]] GateBlocks compute_gate_blocks(const Layout& layout);
+
+/// Groups a layout's gates by module instance (Circuit::instance_of()), one
+/// block per instance in instance order, so in a ripple-carry adder block b
+/// is bit b. Gates outside any instance are left out. Returns no blocks if
+/// the circuit has no instances or two instances' bounds overlap, i.e. the
+/// layout does not place instances apart (callers fall back to columns).
+[[nodiscard]] GateBlocks compute_instance_blocks(const Circuit& circuit, const Layout& layout);
+
 /// Computes a deterministic layout for a circuit.
 ///
 /// For a ripple-carry adder, gates are grouped by full-adder columns arranged
@@ -49,6 +92,10 @@ struct Layout {
 /// top-to-bottom. Inputs enter from the top, outputs exit at the bottom,
 /// and the carry chain flows left across the top.
 ///
+/// Routing takes time linear in the number of wire destinations. If the
+/// circuit has a thread pool (see Circuit::set_parallelism), wires are routed
+/// across it; the result is the same either way.
+///
 /// @param circuit The finalized circuit to lay out
 /// @return Layout with all positions in logical units
 [[nodiscard]] Layout compute_layout(const Circuit& circuit);
@@ -0,0 +1,173 @@
+/// @file layout_file.cpp
+/// @brief Flat encoding of a Layout for the netlist file's layout section
+
+#include "rendering/layout_file.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace gateflow {
+
+static_assert(std::is_trivially_copyable_v<Rect> && sizeof(Rect) == 4 * sizeof(float));
+static_assert(std::is_trivially_copyable_v<Vec2> && sizeof(Vec2) == 2 * sizeof(float));
+
+namespace {
+
+/// Leading block of the section
+struct LayoutSectionHeader {
+    uint32_t version; ///< LAYOUT_SECTION_VERSION
+    uint32_t num_gates;
+    uint32_t num_wires;
+    uint32_t num_inputs;
+    uint32_t num_outputs;
+    uint32_t num_branches;
+    uint32_t num_points;
+    Rect bounding_box;
+};
+static_assert(sizeof(LayoutSectionHeader) == 44);
+
+/// Bytes the arrays after @p h take up
+size_t payload_size(const LayoutSectionHeader& h) {
+    return size_t{h.num_gates} * sizeof(Rect) +
+           (size_t{h.num_inputs} + h.num_outputs) * sizeof(Vec2) +
+           (size_t{h.num_wires} + 1 + h.num_branches + 1) * sizeof(uint32_t) +
+           size_t{h.num_points} * (sizeof(Vec2) + sizeof(float));
+}
+
+/// Sequential reader over the section bytes (bounds are checked up front)
+struct Cursor {
+    const uint8_t* at;
+
+    template <typename T> void read(T* out, size_t count) {
+        if (count > 0) {
+            std::memcpy(out, at, count * sizeof(T));
+        }
+        at += count * sizeof(T);
+    }
+};
+
+template <typename T> void append(std::vector<uint8_t>& bytes, const T* data, size_t count) {
+    const size_t at = bytes.size();
+    bytes.resize(at + count * sizeof(T));
+    if (count > 0) {
+        std::memcpy(bytes.data() + at, data, count * sizeof(T));
+    }
+}
+
+bool read_header(const NetlistFile& file, LayoutSectionHeader& h) {
+    const ArrayView<uint8_t> bytes = file.section_bytes(NetlistSection::LAYOUT);
+    if (bytes.size < sizeof(h)) {
+        return false;
+    }
+    std::memcpy(&h, bytes.data, sizeof(h));
+    return h.version == LAYOUT_SECTION_VERSION && h.num_gates == file.num_gates() && h.num_wires == file.num_wires() &&
+           h.num_inputs == file.num_inputs() && h.num_outputs == file.num_outputs() &&
+           bytes.size - sizeof(h) == payload_size(h);
+}
+
+} // namespace
+
+std::vector<uint8_t> serialize_layout(const Layout& layout) {
+    LayoutSectionHeader h{};
+    h.version = LAYOUT_SECTION_VERSION;
+    h.num_gates = static_cast<uint32_t>(layout.gate_positions.size());
+    h.num_wires = static_cast<uint32_t>(layout.wire_paths.size());
+    h.num_inputs = static_cast<uint32_t>(layout.input_positions.size());
+    h.num_outputs = static_cast<uint32_t>(layout.output_positions.size());
+    h.bounding_box = layout.bounding_box;
+
+    std::vector<uint32_t> branch_offsets{0};
+    std::vector<uint32_t> point_offsets{0};
+    std::vector<Vec2> points;
+    std::vector<float> lengths;
+    for (const auto& branches : layout.wire_paths) {
+        for (const WirePath& path : branches) {
+            points.insert(points.end(), path.points.begin(), path.points.end());
+            lengths.insert(lengths.end(), path.cumulative_lengths.begin(),
+                           path.cumulative_lengths.end());
+            lengths.resize(points.size()); // Keep one length per point
+            point_offsets.push_back(static_cast<uint32_t>(points.size()));
+        }
+        branch_offsets.push_back(static_cast<uint32_t>(point_offsets.size() - 1));
+    }
+    h.num_branches = static_cast<uint32_t>(point_offsets.size() - 1);
+    h.num_points = static_cast<uint32_t>(points.size());
+
+    std::vector<uint8_t> bytes;
+    bytes.reserve(sizeof(h) + payload_size(h));
+    append(bytes, &h, 1);
+    append(bytes, layout.gate_positions.data(), layout.gate_positions.size());
+    append(bytes, layout.input_positions.data(), layout.input_positions.size());
+    append(bytes, layout.output_positions.data(), layout.output_positions.size());
+    append(bytes, branch_offsets.data(), branch_offsets.size());
+    append(bytes, point_offsets.data(), point_offsets.size());
+    append(bytes, points.data(), points.size());
+    append(bytes, lengths.data(), lengths.size());
+    return bytes;
+}
+
+bool has_layout_for(const NetlistFile& file) {
+    LayoutSectionHeader h{};
+    return read_header(file, h);
+}
+
+Layout load_layout(const NetlistFile& file) {
+    LayoutSectionHeader h{};
+    if (!read_header(file, h)) {
+        throw std::runtime_error("Netlist file has no layout for its circuit");
+    }
+    Cursor in{file.section_bytes(NetlistSection::LAYOUT).data + sizeof(h)};
+
+    Layout layout;
+    layout.bounding_box = h.bounding_box;
+    layout.gate_positions.resize(h.num_gates);
+    in.read(layout.gate_positions.data(), h.num_gates);
+    layout.input_positions.resize(h.num_inputs);
+    in.read(layout.input_positions.data(), h.num_inputs);
+    layout.output_positions.resize(h.num_outputs);
+    in.read(layout.output_positions.data(), h.num_outputs);
+
+    std::vector<uint32_t> branch_offsets(size_t{h.num_wires} + 1);
+    in.read(branch_offsets.data(), branch_offsets.size());
+    std::vector<uint32_t> point_offsets(size_t{h.num_branches} + 1);
+    in.read(point_offsets.data(), point_offsets.size());
+    const uint8_t* points = in.at;
+    const uint8_t* lengths = points + size_t{h.num_points} * sizeof(Vec2);
+
+    auto check = [](bool ok) {
+        if (!ok) {
+            throw std::runtime_error("Malformed layout section in netlist file");
+        }
+    };
+    check(branch_offsets.front() == 0 && branch_offsets.back() == h.num_branches);
+    check(point_offsets.front() == 0 && point_offsets.back() == h.num_points);
+
+    layout.wire_paths.resize(h.num_wires);
+    for (size_t w = 0; w < h.num_wires; w++) {
+        const uint32_t first = branch_offsets[w];
+        const uint32_t last = branch_offsets[w + 1];
+        check(first <= last && last <= h.num_branches);
+        auto& branches = layout.wire_paths[w];
+        branches.resize(last - first);
+        for (uint32_t b = first; b < last; b++) {
+            const uint32_t begin = point_offsets[b];
+            const uint32_t end = point_offsets[b + 1];
+            check(begin <= end && end <= h.num_points);
+            WirePath& path = branches[b - first];
+            path.points.resize(end - begin);
+            path.cumulative_lengths.resize(end - begin);
+            Cursor{points + size_t{begin} * sizeof(Vec2)}.read(path.points.data(), end - begin);
+            Cursor{lengths + size_t{begin} * sizeof(float)}.read(path.cumulative_lengths.data(),
+                                                                 end - begin);
+            if (path.cumulative_lengths.empty()) {
+                path.cumulative_lengths.push_back(0.0f); // As build_wire_path() leaves it
+            }
+            path.total_length = path.cumulative_lengths.back();
+        }
+    }
+    return layout;
+}
+
+} // namespace gateflow
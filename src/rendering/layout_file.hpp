@@ -0,0 +1,36 @@
+#pragma once
+
+/// @file layout_file.hpp
+/// @brief Stores a Layout as the layout section of a netlist file
+///
+/// The section is a flat block of 32-bit fields: a count header and the
+/// bounding box, then gate rects, I/O positions, per-wire branch offsets,
+/// per-branch point offsets, the points and their cumulative lengths. It is
+/// id-indexed like Layout itself, so it only fits the circuit it was
+/// computed for (see has_layout_for()).
+
+#include "rendering/layout_engine.hpp"
+#include "simulation/netlist_file.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace gateflow {
+
+/// Version of the section encoding and of the layout it records. Bump it
+/// whenever compute_layout() places things differently, so stored layouts
+/// are recomputed instead of shown stale.
+inline constexpr uint32_t LAYOUT_SECTION_VERSION = 1;
+
+/// Encodes a layout as a NetlistSaveOptions::layout payload
+[[nodiscard]] std::vector<uint8_t> serialize_layout(const Layout& layout);
+
+/// True if @p file has a current-version layout section sized for its own
+/// gates, wires and I/O
+[[nodiscard]] bool has_layout_for(const NetlistFile& file);
+
+/// Decodes the layout section of @p file.
+/// @throws std::runtime_error if the file has no layout or it is malformed
+[[nodiscard]] Layout load_layout(const NetlistFile& file);
+
+} // namespace gateflow
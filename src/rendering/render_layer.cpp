@@ -0,0 +1,70 @@
+/// @file render_layer.cpp
+/// @brief RenderTexture-backed static layers with premultiplied-alpha painting
+
+#include "rendering/render_layer.hpp"
+
+#include "timing/frame_profiler.hpp"
+
+#include <rlgl.h>
+
+namespace gateflow {
+
+RenderLayer::~RenderLayer() { release(); }
+
+void RenderLayer::release() {
+    if (target_.id != 0) {
+        UnloadRenderTexture(target_);
+    }
+    target_ = {};
+    width_ = 0;
+    height_ = 0;
+    valid_ = false;
+}
+
+bool RenderLayer::begin_paint(int width, int height) {
+    if (target_.id == 0 || width_ != width || height_ != height) {
+        release();
+        if (width <= 0 || height <= 0) {
+            return false;
+        }
+        target_ = LoadRenderTexture(width, height);
+        if (!IsRenderTextureReady(target_)) {
+            target_ = {};
+            return false;
+        }
+        width_ = width;
+        height_ = height;
+    }
+    valid_ = false;
+
+    BeginTextureMode(target_);
+    ClearBackground(BLANK);
+    // Colour is blended as usual but stored premultiplied, and alpha
+    // accumulates as 1 - (1 - a_src)(1 - a_dst), so draw() can composite the
+    // texture with BLEND_ALPHA_PREMULTIPLY without darkening soft edges.
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE,
+                              RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    return true;
+}
+
+void RenderLayer::end_paint() {
+    EndBlendMode();
+    EndTextureMode();
+    valid_ = true;
+    paints_++;
+}
+
+void RenderLayer::draw() const {
+    if (!valid_) {
+        return;
+    }
+    // Render textures are stored bottom-up
+    Rectangle source = {0.0f, 0.0f, static_cast<float>(width_), -static_cast<float>(height_)};
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTextureRec(target_.texture, source, {0.0f, 0.0f}, WHITE);
+    EndBlendMode();
+    GATEFLOW_PROFILE_DRAW_CALLS(1);
+}
+
+} // namespace gateflow
@@ -0,0 +1,58 @@
+/// @file render_layer.hpp
+/// @brief Off-screen render target for parts of the frame that rarely change
+///
+/// A layer is painted once into a screen-sized RenderTexture and then drawn
+/// as a single textured quad each frame, until the owner invalidates it (new
+/// circuit, new inputs, new view) or the screen size changes. Painting uses
+/// premultiplied alpha, so transparent parts (label layers over live content)
+/// composite exactly as if they had been drawn directly.
+
+#pragma once
+
+#include <raylib.h>
+
+#include <cstddef>
+
+namespace gateflow {
+
+class RenderLayer {
+  public:
+    RenderLayer() = default;
+    ~RenderLayer();
+
+    RenderLayer(const RenderLayer&) = delete;
+    RenderLayer& operator=(const RenderLayer&) = delete;
+
+    /// Marks the painting stale; is_valid() is false until the next end_paint()
+    void invalidate() { valid_ = false; }
+
+    /// True if the layer holds a current painting for a @p width x @p height screen
+    [[nodiscard]] bool is_valid(int width, int height) const {
+        return valid_ && width_ == width && height_ == height;
+    }
+
+    /// Redirects drawing into the layer, cleared to transparent, (re)creating
+    /// the texture if the size changed. Returns false, drawing nothing, if
+    /// the texture cannot be created; the caller then draws to the screen.
+    bool begin_paint(int width, int height);
+
+    /// Ends drawing started by a successful begin_paint(); the layer is valid
+    void end_paint();
+
+    /// Draws the painting at the screen origin
+    void draw() const;
+
+    /// begin_paint()/end_paint() pairs completed so far
+    [[nodiscard]] size_t paints() const { return paints_; }
+
+  private:
+    void release();
+
+    RenderTexture2D target_{};
+    int width_ = 0;
+    int height_ = 0;
+    bool valid_ = false;
+    size_t paints_ = 0;
+};
+
+} // namespace gateflow
@@ -0,0 +1,164 @@
+/// @file spatial_index.cpp
+/// @brief Grid construction (CSR per cell), area queries and point hit-tests
+
+#include "rendering/spatial_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace gateflow {
+
+namespace {
+
+constexpr uint32_t MAX_CELLS_PER_AXIS = 4096;
+
+/// Sorts (cell, id) pairs, drops duplicates and packs them as CSR
+void pack(std::vector<std::pair<uint32_t, uint32_t>>& entries, size_t num_cells,
+          std::vector<uint32_t>& offsets, std::vector<uint32_t>& ids) {
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+    offsets.assign(num_cells + 1, 0);
+    ids.resize(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        offsets[entries[i].first + 1]++;
+        ids[i] = entries[i].second;
+    }
+    for (size_t c = 0; c < num_cells; c++) {
+        offsets[c + 1] += offsets[c];
+    }
+}
+
+bool overlaps(const Rect& a, const Rect& b) {
+    return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h && b.y <= a.y + a.h;
+}
+
+} // namespace
+
+SpatialIndex::SpatialIndex(const Layout& layout, float cell_size)
+    : bounds_(layout.bounding_box), num_wires_(layout.wire_paths.size()),
+      gate_rects_(layout.gate_positions) {
+    if (cell_size <= 0.0f) {
+        float area = std::max(bounds_.w * bounds_.h, 1.0f);
+        cell_size = std::sqrt(area / static_cast<float>(std::max<size_t>(gate_rects_.size(), 1)));
+    }
+    // Keep the grid bounded for degenerate boxes
+    cell_size = std::max({cell_size, bounds_.w / MAX_CELLS_PER_AXIS,
+                          bounds_.h / MAX_CELLS_PER_AXIS, 1e-3f});
+    cell_size_ = cell_size;
+    cols_ = std::max(1u, static_cast<uint32_t>(std::ceil(bounds_.w / cell_size_)));
+    rows_ = std::max(1u, static_cast<uint32_t>(std::ceil(bounds_.h / cell_size_)));
+
+    std::vector<std::pair<uint32_t, uint32_t>> entries;
+    auto insert = [&](float x0, float y0, float x1, float y1, uint32_t id) {
+        uint32_t c0, r0, c1, r1;
+        cell_range(x0, y0, x1, y1, c0, r0, c1, r1);
+        for (uint32_t r = r0; r <= r1; r++) {
+            for (uint32_t c = c0; c <= c1; c++) {
+                entries.emplace_back(r * cols_ + c, id);
+            }
+        }
+    };
+
+    for (uint32_t g = 0; g < gate_rects_.size(); g++) {
+        const Rect& r = gate_rects_[g];
+        insert(r.x, r.y, r.x + r.w, r.y + r.h, g);
+    }
+    pack(entries, num_cells(), gate_cells_, gate_ids_);
+
+    entries.clear();
+    for (uint32_t w = 0; w < layout.wire_paths.size(); w++) {
+        for (const WirePath& path : layout.wire_paths[w]) {
+            for (size_t i = 0; i + 1 < path.points.size(); i++) {
+                const Vec2 a = path.points[i];
+                const Vec2 b = path.points[i + 1];
+                insert(std::min(a.x, b.x), std::min(a.y, b.y), std::max(a.x, b.x),
+                       std::max(a.y, b.y), w);
+            }
+        }
+    }
+    pack(entries, num_cells(), wire_cells_, wire_ids_);
+}
+
+void SpatialIndex::cell_range(float x0, float y0, float x1, float y1, uint32_t& c0, uint32_t& r0,
+                              uint32_t& c1, uint32_t& r1) const {
+    auto cell = [this](float v, float origin, uint32_t count) {
+        float f = std::floor((v - origin) / cell_size_);
+        return static_cast<uint32_t>(std::clamp(f, 0.0f, static_cast<float>(count - 1)));
+    };
+    c0 = cell(x0, bounds_.x, cols_);
+    c1 = cell(x1, bounds_.x, cols_);
+    r0 = cell(y0, bounds_.y, rows_);
+    r1 = cell(y1, bounds_.y, rows_);
+}
+
+void SpatialIndex::query(const Rect& area, VisibleSet& out) const {
+    out.gates_.clear();
+    out.wires_.clear();
+    if (!overlaps(area, bounds_)) {
+        return;
+    }
+    out.gate_marks_.resize(gate_rects_.size(), 0);
+    out.wire_marks_.resize(num_wires_, 0);
+    if (++out.stamp_ == 0) {
+        // Stamp wrapped: forget every old mark
+        std::fill(out.gate_marks_.begin(), out.gate_marks_.end(), 0);
+        std::fill(out.wire_marks_.begin(), out.wire_marks_.end(), 0);
+        out.stamp_ = 1;
+    }
+    const uint32_t stamp = out.stamp_;
+
+    uint32_t c0, r0, c1, r1;
+    cell_range(area.x, area.y, area.x + area.w, area.y + area.h, c0, r0, c1, r1);
+    for (uint32_t r = r0; r <= r1; r++) {
+        for (uint32_t c = c0; c <= c1; c++) {
+            const uint32_t cell = r * cols_ + c;
+            for (uint32_t i = gate_cells_[cell]; i < gate_cells_[cell + 1]; i++) {
+                const uint32_t g = gate_ids_[i];
+                if (out.gate_marks_[g] != stamp && overlaps(gate_rects_[g], area)) {
+                    out.gate_marks_[g] = stamp;
+                    out.gates_.push_back(g);
+                }
+            }
+            for (uint32_t i = wire_cells_[cell]; i < wire_cells_[cell + 1]; i++) {
+                const uint32_t w = wire_ids_[i];
+                if (out.wire_marks_[w] != stamp) {
+                    out.wire_marks_[w] = stamp;
+                    out.wires_.push_back(w);
+                }
+            }
+        }
+    }
+    // Id order is draw order, so culled drawing overlaps exactly like a full draw
+    std::sort(out.gates_.begin(), out.gates_.end());
+    std::sort(out.wires_.begin(), out.wires_.end());
+}
+
+uint32_t SpatialIndex::gate_at(Vec2 point) const {
+    uint32_t c0, r0, c1, r1;
+    cell_range(point.x, point.y, point.x, point.y, c0, r0, c1, r1);
+    const uint32_t cell = r0 * cols_ + c0;
+    uint32_t hit = NO_GATE;
+    // Cell entries ascend by id, so the last match is the topmost gate
+    for (uint32_t i = gate_cells_[cell]; i < gate_cells_[cell + 1]; i++) {
+        const uint32_t g = gate_ids_[i];
+        const Rect& r = gate_rects_[g];
+        // Same edges as CheckCollisionPointRec; a clamped outside point fails here
+        if (point.x >= r.x && point.x < r.x + r.w && point.y >= r.y && point.y < r.y + r.h) {
+            hit = g;
+        }
+    }
+    return hit;
+}
+
+MemoryUsage SpatialIndex::memory_usage() const {
+    MemoryUsage usage;
+    usage.add_vector("gate cells", gate_rects_);
+    usage.add_vector("gate cells", gate_cells_);
+    usage.add_vector("gate cells", gate_ids_);
+    usage.add_vector("wire cells", wire_cells_);
+    usage.add_vector("wire cells", wire_ids_);
+    return usage;
+}
+
+} // namespace gateflow
@@ -0,0 +1,83 @@
+/// @file spatial_index.hpp
+/// @brief Uniform grid over a layout's gates and wires, for culling and hit-testing
+///
+/// The grid covers the layout's bounding box. Each cell lists the gates
+/// whose rect overlaps it and the wires with a segment whose bounding box
+/// overlaps it, so a query only visits the cells under the view. Results
+/// are conservative for wires (a wire can be reported when its segment's
+/// box, not the segment itself, meets the area) and exact for gates.
+/// Point hit-tests (gate_at()) visit a single cell.
+
+#pragma once
+
+#include "rendering/layout_engine.hpp"
+#include "simulation/memory_usage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gateflow {
+
+/// gate_at() result when no gate is under the point
+inline constexpr uint32_t NO_GATE = UINT32_MAX;
+
+/// Ids found by SpatialIndex::query(), each once. Reusable across frames
+/// without reallocating.
+class VisibleSet {
+  public:
+    /// Gate ids in ascending order
+    [[nodiscard]] const std::vector<uint32_t>& gates() const { return gates_; }
+    /// Wire ids in ascending order
+    [[nodiscard]] const std::vector<uint32_t>& wires() const { return wires_; }
+
+  private:
+    friend class SpatialIndex;
+
+    std::vector<uint32_t> gates_;
+    std::vector<uint32_t> wires_;
+    std::vector<uint32_t> gate_marks_; ///< Per gate id: stamp_ of the last query that saw it
+    std::vector<uint32_t> wire_marks_; ///< Per wire id
+    uint32_t stamp_ = 0;
+};
+
+class SpatialIndex {
+  public:
+    /// Indexes every gate rect and routed wire segment of @p layout. A
+    /// @p cell_size <= 0 picks one giving about one gate per cell.
+    explicit SpatialIndex(const Layout& layout, float cell_size = 0.0f);
+
+    /// Collects the gates overlapping @p area and the wires that may cross it.
+    void query(const Rect& area, VisibleSet& out) const;
+
+    /// Topmost (highest-id, drawn last) gate whose rect contains @p point,
+    /// in logical units, or NO_GATE.
+    [[nodiscard]] uint32_t gate_at(Vec2 point) const;
+
+    [[nodiscard]] float cell_size() const { return cell_size_; }
+    [[nodiscard]] size_t num_cells() const { return size_t{cols_} * rows_; }
+    /// Gate plus wire entries over all cells
+    [[nodiscard]] size_t num_entries() const { return gate_ids_.size() + wire_ids_.size(); }
+
+    /// Heap memory by category: "gate cells" (rects and the gate grid) and
+    /// "wire cells" (the wire grid)
+    [[nodiscard]] MemoryUsage memory_usage() const;
+
+  private:
+    /// Index range of the cells overlapping [x0, x1] x [y0, y1], clamped to the grid
+    void cell_range(float x0, float y0, float x1, float y1, uint32_t& c0, uint32_t& r0,
+                    uint32_t& c1, uint32_t& r1) const;
+
+    Rect bounds_;
+    float cell_size_ = 1.0f;
+    uint32_t cols_ = 1;
+    uint32_t rows_ = 1;
+    size_t num_wires_ = 0;
+    std::vector<Rect> gate_rects_;     ///< Per gate id, for the exact gate test
+    std::vector<uint32_t> gate_cells_; ///< CSR offsets, num_cells() + 1
+    std::vector<uint32_t> gate_ids_;
+    std::vector<uint32_t> wire_cells_; ///< CSR offsets, num_cells() + 1
+    std::vector<uint32_t> wire_ids_;
+};
+
+} // namespace gateflow
@@ -0,0 +1,30 @@
+/// @file viewport.cpp
+/// @brief Pan/zoom view math
+
+#include "rendering/viewport.hpp"
+
+#include <algorithm>
+
+namespace gateflow {
+
+Rect visible_area(float scale, Vector2 offset, Rectangle screen) {
+    if (scale <= 0.0f) {
+        return {};
+    }
+    return {(screen.x - offset.x) / scale, (screen.y - offset.y) / scale, screen.width / scale,
+            screen.height / scale};
+}
+
+void zoom_about(float& scale, Vector2& offset, Vector2 anchor, float factor, float min_scale,
+                float max_scale) {
+    float next = std::clamp(scale * factor, min_scale, max_scale);
+    if (next == scale || scale <= 0.0f) {
+        return;
+    }
+    // The logical point under the anchor, (anchor - offset) / scale, is kept fixed
+    float ratio = next / scale;
+    offset = {anchor.x - (anchor.x - offset.x) * ratio, anchor.y - (anchor.y - offset.y) * ratio};
+    scale = next;
+}
+
+} // namespace gateflow
@@ -0,0 +1,33 @@
+/// @file viewport.hpp
+/// @brief Pan/zoom view math and the level-of-detail threshold
+///
+/// The renderers map logical layout units to pixels as
+/// `screen = logical * scale + offset`. These helpers move that view (zoom
+/// about a fixed screen point, keep it in range) and invert it to find the
+/// logical area a screen rectangle shows, for culling.
+
+#pragma once
+
+#include "rendering/layout_engine.hpp"
+
+#include <raylib.h>
+
+namespace gateflow {
+
+/// Pixels per logical unit below which gates are drawn as column blocks and
+/// per-gate text (gate labels, I/O labels, carry and arrival labels) is skipped.
+/// At this scale a gate is 20 px tall, about the height of its label.
+inline constexpr float DETAIL_MIN_SCALE = 10.0f;
+
+/// True if a view at @p scale draws individual gates and their text
+[[nodiscard]] inline bool is_detailed(float scale) { return scale >= DETAIL_MIN_SCALE; }
+
+/// Logical-unit area shown by the screen rectangle @p screen
+[[nodiscard]] Rect visible_area(float scale, Vector2 offset, Rectangle screen);
+
+/// Multiplies @p scale by @p factor, clamped to [min_scale, max_scale], and
+/// moves @p offset so the logical point under @p anchor stays under it.
+void zoom_about(float& scale, Vector2& offset, Vector2 anchor, float factor, float min_scale,
+                float max_scale);
+
+} // namespace gateflow
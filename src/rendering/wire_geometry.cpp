@@ -0,0 +1,181 @@
+/// @file wire_geometry.cpp
+/// @brief Tessellates layout wire paths into cached screen-space segments
+
+#include "rendering/wire_geometry.hpp"
+
+#include "simulation/gate.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gateflow {
+
+namespace {
+
+/// Converts a logical-unit vec2 to screen-space
+Vector2 to_screen(Vec2 v, float scale, Vector2 offset) {
+    return {v.x * scale + offset.x, v.y * scale + offset.y};
+}
+
+} // namespace
+
+Vec2 lerp_along_path(const WirePath& path, float t) {
+    if (path.points.empty()) {
+        return {0.0f, 0.0f};
+    }
+    if (t <= 0.0f || path.total_length <= 0.0f || path.points.size() < 2) {
+        return path.points.front();
+    }
+    if (t >= 1.0f) {
+        return path.points.back();
+    }
+
+    float target_dist = t * path.total_length;
+
+    // First waypoint at or past the target ends the segment containing it
+    auto it = std::lower_bound(path.cumulative_lengths.begin() + 1, path.cumulative_lengths.end(),
+                               target_dist);
+    if (it == path.cumulative_lengths.end()) {
+        return path.points.back();
+    }
+    size_t i = static_cast<size_t>(it - path.cumulative_lengths.begin()) - 1;
+
+    float seg_start = path.cumulative_lengths[i];
+    float seg_len = path.cumulative_lengths[i + 1] - seg_start;
+    float frac = (seg_len > 0.001f) ? (target_dist - seg_start) / seg_len : 0.0f;
+    float dx = path.points[i + 1].x - path.points[i].x;
+    float dy = path.points[i + 1].y - path.points[i].y;
+    return {path.points[i].x + dx * frac, path.points[i].y + dy * frac};
+}
+
+bool is_carry_wire(const Wire* wire) {
+    const Gate* src = wire->get_source();
+    if (src == nullptr) {
+        return false;
+    }
+
+    // Full-adder carry outputs are driven by OR gates in this architecture.
+    if (src->get_type() == GateType::OR) {
+        return true;
+    }
+
+    // Bit 0 carry from half-adder is AND -> (XOR, AND) in next stage.
+    if (src->get_type() == GateType::AND) {
+        bool has_xor_dest = false;
+        bool has_and_dest = false;
+        for (const Gate* dest : wire->get_destinations()) {
+            if (dest->get_type() == GateType::XOR) {
+                has_xor_dest = true;
+            } else if (dest->get_type() == GateType::AND) {
+                has_and_dest = true;
+            }
+        }
+        return has_xor_dest && has_and_dest;
+    }
+
+    return false;
+}
+
+bool WireGeometry::update(const Circuit& circuit, const Layout& layout, float scale,
+                          Vector2 offset) {
+    if (layout_ == &layout && scale_ == scale && offset_.x == offset.x && offset_.y == offset.y) {
+        return false;
+    }
+    layout_ = &layout;
+    scale_ = scale;
+    offset_ = offset;
+    rebuild(circuit, layout);
+    rebuilds_++;
+    return true;
+}
+
+void WireGeometry::rebuild(const Circuit& circuit, const Layout& layout) {
+    wires_.assign(circuit.wires().size(), WireShape{});
+    branches_.clear();
+    segments_.clear();
+    joints_.clear();
+    carry_wires_.clear();
+
+    for (const Wire* wire : circuit.wires()) {
+        const auto& paths = layout.wire_branches(wire);
+        WireShape& shape = wires_[wire->get_id()];
+        shape.first_branch = static_cast<uint32_t>(branches_.size());
+        shape.carry = !paths.empty() && is_carry_wire(wire);
+        if (shape.carry) {
+            carry_wires_.push_back(wire->get_id());
+        }
+
+        for (const WirePath& path : paths) {
+            // A lone point has no segment to draw
+            if (path.points.size() < 2) {
+                continue;
+            }
+            WireBranchGeometry branch{};
+            branch.first_segment = static_cast<uint32_t>(segments_.size());
+            branch.first_joint = static_cast<uint32_t>(joints_.size());
+            branch.length = path.total_length;
+            branch.midpoint = to_screen(lerp_along_path(path, 0.5f), scale_, offset_);
+
+            for (size_t i = 0; i + 1 < path.points.size(); i++) {
+                WireSegment seg{};
+                seg.from = to_screen(path.points[i], scale_, offset_);
+                seg.to = to_screen(path.points[i + 1], scale_, offset_);
+                float dx = seg.to.x - seg.from.x;
+                float dy = seg.to.y - seg.from.y;
+                float len = std::sqrt(dx * dx + dy * dy);
+                if (len > 0.0f) {
+                    seg.normal = {-dy / len, dx / len};
+                }
+                seg.start = path.cumulative_lengths[i];
+                seg.end = path.cumulative_lengths[i + 1];
+                segments_.push_back(seg);
+            }
+            for (size_t i = 1; i + 1 < path.points.size(); i++) {
+                joints_.push_back(to_screen(path.points[i], scale_, offset_));
+            }
+
+            branch.end_segment = static_cast<uint32_t>(segments_.size());
+            branch.end_joint = static_cast<uint32_t>(joints_.size());
+            branches_.push_back(branch);
+        }
+        shape.end_branch = static_cast<uint32_t>(branches_.size());
+    }
+}
+
+uint32_t WireGeometry::segment_at(const WireBranchGeometry& branch, float distance) const {
+    auto first = segments_.begin() + branch.first_segment;
+    auto last = segments_.begin() + branch.end_segment;
+    auto it = std::lower_bound(first, last, distance,
+                               [](const WireSegment& seg, float d) { return seg.end < d; });
+    return static_cast<uint32_t>(it - segments_.begin());
+}
+
+Vector2 WireGeometry::point_at(const WireBranchGeometry& branch, float distance) const {
+    if (branch.first_segment == branch.end_segment) {
+        return {0.0f, 0.0f};
+    }
+    if (distance <= 0.0f || branch.length <= 0.0f) {
+        return segments_[branch.first_segment].from;
+    }
+    uint32_t i = segment_at(branch, distance);
+    if (i == branch.end_segment) {
+        return segments_[i - 1].to;
+    }
+    const WireSegment& seg = segments_[i];
+    float seg_len = seg.end - seg.start;
+    float frac = (seg_len > 0.001f) ? (distance - seg.start) / seg_len : 0.0f;
+    return {seg.from.x + (seg.to.x - seg.from.x) * frac,
+            seg.from.y + (seg.to.y - seg.from.y) * frac};
+}
+
+MemoryUsage WireGeometry::memory_usage() const {
+    MemoryUsage usage;
+    usage.add_vector("wire shapes", wires_);
+    usage.add_vector("wire shapes", branches_);
+    usage.add_vector("wire shapes", carry_wires_);
+    usage.add_vector("segments", segments_);
+    usage.add_vector("joints", joints_);
+    return usage;
+}
+
+} // namespace gateflow
@@ -0,0 +1,111 @@
+/// @file wire_geometry.hpp
+/// @brief Screen-space wire segments, tessellated once per layout, scale and offset.
+///
+/// A layout's wire polylines never change between rebuilds, and the view
+/// only changes on refit. WireGeometry converts every branch into
+/// screen-space segments with precomputed unit normals, the waypoints used
+/// for joint dots, and the carry classification of each wire. draw_wires()
+/// then only picks colours and thicknesses per wire and emits the cached
+/// segments into one rlgl batch.
+
+#pragma once
+
+#include "rendering/layout_engine.hpp"
+#include "simulation/circuit.hpp"
+#include "simulation/memory_usage.hpp"
+
+#include <raylib.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gateflow {
+
+/// Interpolates a position along a precomputed wire path at fraction [0, 1].
+/// The segment is found by binary search over cumulative_lengths.
+[[nodiscard]] Vec2 lerp_along_path(const WirePath& path, float t);
+
+/// One straight piece of a branch, in screen space
+struct WireSegment {
+    Vector2 from;
+    Vector2 to;
+    Vector2 normal; ///< Unit perpendicular in screen space; zero if the segment is degenerate
+    float start;    ///< Logical distance along the branch where the segment begins
+    float end;      ///< Logical distance where it ends
+};
+
+/// One routed branch: a run of segments and interior waypoints
+struct WireBranchGeometry {
+    uint32_t first_segment;
+    uint32_t end_segment;
+    uint32_t first_joint;
+    uint32_t end_joint;
+    float length;     ///< Logical length (WirePath::total_length)
+    Vector2 midpoint; ///< Screen position halfway along the branch
+};
+
+/// Branches of one wire, and whether it is drawn as a carry
+struct WireShape {
+    uint32_t first_branch = 0;
+    uint32_t end_branch = 0;
+    bool carry = false;
+};
+
+/// True for the carry outputs of the adder layouts: full-adder OR outputs,
+/// and the half-adder AND output feeding the next stage's XOR and AND
+[[nodiscard]] bool is_carry_wire(const Wire* wire);
+
+class WireGeometry {
+  public:
+    /// Re-tessellates if the layout, scale or offset differ from the last
+    /// call. Returns true if it rebuilt.
+    bool update(const Circuit& circuit, const Layout& layout, float scale, Vector2 offset);
+
+    /// Forgets the cached key, so the next update() rebuilds (e.g. after the
+    /// layout it was built from is replaced in place)
+    void invalidate() { layout_ = nullptr; }
+
+    /// Shape of a wire by id (empty if the wire has no routed branches)
+    [[nodiscard]] const WireShape& wire(uint32_t id) const {
+        static const WireShape none;
+        return id < wires_.size() ? wires_[id] : none;
+    }
+    [[nodiscard]] const std::vector<WireShape>& wires() const { return wires_; }
+    [[nodiscard]] const std::vector<WireBranchGeometry>& branches() const { return branches_; }
+    [[nodiscard]] const std::vector<WireSegment>& segments() const { return segments_; }
+    [[nodiscard]] const std::vector<Vector2>& joints() const { return joints_; }
+    /// Ids of the routed carry wires, in wire list order
+    [[nodiscard]] const std::vector<uint32_t>& carry_wires() const { return carry_wires_; }
+
+    /// Screen position at a logical @p distance along a branch, clamped to
+    /// its ends (binary search over the segments)
+    [[nodiscard]] Vector2 point_at(const WireBranchGeometry& branch, float distance) const;
+
+    /// Index of the first segment of @p branch ending after @p distance
+    /// (end_segment if the distance is past the end)
+    [[nodiscard]] uint32_t segment_at(const WireBranchGeometry& branch, float distance) const;
+
+    /// Number of times update() has re-tessellated
+    [[nodiscard]] size_t rebuilds() const { return rebuilds_; }
+
+    /// Heap memory by category: "wire shapes" (per-wire and per-branch
+    /// ranges, carry list), "segments" and "joints"
+    [[nodiscard]] MemoryUsage memory_usage() const;
+
+  private:
+    void rebuild(const Circuit& circuit, const Layout& layout);
+
+    const Layout* layout_ = nullptr;
+    float scale_ = 0.0f;
+    Vector2 offset_ = {0.0f, 0.0f};
+    size_t rebuilds_ = 0;
+
+    std::vector<WireShape> wires_;            ///< Per wire id
+    std::vector<WireBranchGeometry> branches_; ///< All branches, wire by wire
+    std::vector<WireSegment> segments_;        ///< All segments, branch by branch
+    std::vector<Vector2> joints_;              ///< Interior waypoints, branch by branch
+    std::vector<uint32_t> carry_wires_;
+};
+
+} // namespace gateflow
@@ -4,7 +4,11 @@
 #include "rendering/wire_renderer.hpp"
 
 #include "rendering/app_font.hpp"
+#include "rendering/viewport.hpp"
 #include "simulation/gate.hpp"
+#include "timing/frame_profiler.hpp"
+
+#include <rlgl.h>
 
 #include <algorithm>
 #include <cmath>
@@ -22,49 +26,33 @@ const Color CARRY_ACTIVE_COLOR = {245, 190, 70, 255};
 const Color CARRY_INACTIVE_COLOR = {120, 95, 50, 255};
 const Color CARRY_PENDING_COLOR = {70, 55, 35, 255};
 const Color CARRY_SIGNAL_GLOW = {255, 220, 120, 255};
+const Color CRITICAL_WIRE_COLOR = {255, 80, 160, 200}; // Magenta overlay
+const Color WIRE_HAZARD_COLOR = {255, 120, 40, 255};   // Orange flash at a glitch
 constexpr float WIRE_INACTIVE_THICKNESS = 1.5f;
 constexpr float WIRE_ACTIVE_THICKNESS = 3.0f;
 constexpr float WIRE_PENDING_THICKNESS = 1.0f;
 constexpr float SIGNAL_PULSE_RADIUS = 5.0f;
 constexpr float CARRY_THICKNESS_SCALE = 2.3f;
 constexpr float CARRY_PULSE_RADIUS_SCALE = 1.6f;
+constexpr float CRITICAL_WIRE_THICKNESS = 2.5f;
+
+/// Linearly interpolate between two colors
+Color lerp_color(Color a, Color b, float t) {
+    t = std::clamp(t, 0.0f, 1.0f);
+    return {static_cast<unsigned char>(a.r + static_cast<int>((b.r - a.r) * t)),
+            static_cast<unsigned char>(a.g + static_cast<int>((b.g - a.g) * t)),
+            static_cast<unsigned char>(a.b + static_cast<int>((b.b - a.b) * t)),
+            static_cast<unsigned char>(a.a + static_cast<int>((b.a - a.a) * t))};
+}
 
 /// Converts a logical-unit vec2 to screen-space
 Vector2 to_screen(Vec2 v, float scale, Vector2 offset) {
     return {v.x * scale + offset.x, v.y * scale + offset.y};
 }
 
-/// Interpolate a position along a precomputed wire path at fraction [0, 1].
-Vec2 lerp_along_path(const WirePath& path, float t) {
-    if (path.points.empty()) {
-        return {0.0f, 0.0f};
-    }
-    if (t <= 0.0f || path.total_length <= 0.0f || path.points.size() < 2) {
-        return path.points.front();
-    }
-    if (t >= 1.0f) {
-        return path.points.back();
-    }
-
-    float target_dist = t * path.total_length;
-
-    for (size_t i = 0; i + 1 < path.points.size(); i++) {
-        float seg_start = path.cumulative_lengths[i];
-        float seg_end = path.cumulative_lengths[i + 1];
-        if (target_dist <= seg_end) {
-            float seg_len = seg_end - seg_start;
-            float frac = (seg_len > 0.001f) ? (target_dist - seg_start) / seg_len : 0.0f;
-            float dx = path.points[i + 1].x - path.points[i].x;
-            float dy = path.points[i + 1].y - path.points[i].y;
-            return {path.points[i].x + dx * frac, path.points[i].y + dy * frac};
-        }
-    }
-
-    return path.points.back();
-}
-
 void draw_polyline(const std::vector<Vec2>& points, float scale, Vector2 offset, float thickness,
                    Color color) {
+    GATEFLOW_PROFILE_DRAW_CALLS(points.size() - 1);
     for (size_t i = 0; i + 1 < points.size(); i++) {
         Vector2 from = to_screen(points[i], scale, offset);
         Vector2 to = to_screen(points[i + 1], scale, offset);
@@ -72,53 +60,81 @@ void draw_polyline(const std::vector<Vec2>& points, float scale, Vector2 offset,
     }
 }
 
-bool is_carry_wire(const Wire* wire) {
-    const Gate* src = wire->get_source();
-    if (src == nullptr) {
-        return false;
-    }
+/// Unit circles for the triangle-fan dots, closed (last vertex = first)
+constexpr int JOINT_SIDES = 8;
+constexpr int PULSE_SIDES = 16;
 
-    // Full-adder carry outputs are driven by OR gates in this architecture.
-    if (src->get_type() == GateType::OR) {
-        return true;
-    }
+template <int Sides> struct UnitCircle {
+    Vector2 points[Sides + 1];
 
-    // Bit 0 carry from half-adder is AND -> (XOR, AND) in next stage.
-    if (src->get_type() == GateType::AND) {
-        bool has_xor_dest = false;
-        bool has_and_dest = false;
-        for (const Gate* dest : wire->get_destinations()) {
-            if (dest->get_type() == GateType::XOR) {
-                has_xor_dest = true;
-            } else if (dest->get_type() == GateType::AND) {
-                has_and_dest = true;
-            }
+    UnitCircle() {
+        for (int i = 0; i <= Sides; i++) {
+            float angle = 2.0f * PI * static_cast<float>(i % Sides) / static_cast<float>(Sides);
+            points[i] = {std::cos(angle), std::sin(angle)};
         }
-        return has_xor_dest && has_and_dest;
     }
+};
+
+const UnitCircle<JOINT_SIDES> JOINT_CIRCLE;
+const UnitCircle<PULSE_SIDES> PULSE_CIRCLE;
+
+// Triangles are emitted counter-clockwise on screen (y down), as raylib's
+// own shapes are, so they survive its default back-face culling.
+
+/// Emits a segment from @p from to @p to as two triangles, @p half_width to
+/// either side (the quad DrawLineEx draws)
+void emit_segment(Vector2 from, Vector2 to, Vector2 normal, float half_width) {
+    float nx = normal.x * half_width;
+    float ny = normal.y * half_width;
+    rlVertex2f(from.x + nx, from.y + ny);
+    rlVertex2f(to.x + nx, to.y + ny);
+    rlVertex2f(to.x - nx, to.y - ny);
+
+    rlVertex2f(from.x + nx, from.y + ny);
+    rlVertex2f(to.x - nx, to.y - ny);
+    rlVertex2f(from.x - nx, from.y - ny);
+}
 
-    return false;
+void emit_segment(const WireSegment& seg, float thickness) {
+    emit_segment(seg.from, seg.to, seg.normal, thickness * 0.5f);
+}
+
+template <int Sides>
+void emit_dot(Vector2 center, float radius, const UnitCircle<Sides>& circle) {
+    for (int i = 0; i < Sides; i++) {
+        rlVertex2f(center.x, center.y);
+        rlVertex2f(center.x + circle.points[i + 1].x * radius,
+                   center.y + circle.points[i + 1].y * radius);
+        rlVertex2f(center.x + circle.points[i].x * radius, center.y + circle.points[i].y * radius);
+    }
 }
 
+void set_color(Color c) { rlColor4ub(c.r, c.g, c.b, c.a); }
+
 } // namespace
 
 void draw_wires(const Circuit& circuit, const Layout& layout, const AnimationState& anim,
-                float scale, Vector2 offset) {
-    for (auto& wire_ptr : circuit.wires()) {
-        const Wire* wire = wire_ptr.get();
-        auto it = layout.wire_paths.find(wire);
-        if (it == layout.wire_paths.end()) {
-            continue;
-        }
-
-        const auto& branches = it->second;
-        if (branches.empty()) {
+                WireGeometry& geometry, const std::vector<uint32_t>& wire_ids, float scale,
+                Vector2 offset, const RenderEffects& effects) {
+    geometry.update(circuit, layout, scale, offset);
+    const bool detailed = is_detailed(scale);
+    const std::vector<WireBranchGeometry>& all_branches = geometry.branches();
+    const std::vector<WireSegment>& segments = geometry.segments();
+    const std::vector<Vector2>& joints = geometry.joints();
+
+    // Every wire goes into one triangle batch; rlgl flushes it on its own
+    // if the vertex buffer fills, at a triangle boundary.
+    rlBegin(RL_TRIANGLES);
+    for (uint32_t id : wire_ids) {
+        const Wire* wire = circuit.wires()[id];
+        const WireShape& shape = geometry.wire(id);
+        if (shape.first_branch == shape.end_branch) {
             continue;
         }
 
         const WireAnim& wa = anim.wire_anim(wire);
         bool active = wire->get_value();
-        bool carry_wire = is_carry_wire(wire);
+        bool carry_wire = shape.carry;
 
         Color color;
         float thickness;
@@ -126,67 +142,50 @@ void draw_wires(const Circuit& circuit, const Layout& layout, const AnimationSta
         if (!wa.resolved) {
             if (wa.signal_progress > 0.0f) {
                 // Signal is traveling along this wire — draw the resolved portion
-                // in the active/inactive color and the rest as pending
-
-                // Draw the resolved portion on top
+                // in the active/inactive color over the full branch drawn as pending
                 Color resolved_color = active ? WIRE_ACTIVE_COLOR : WIRE_INACTIVE_COLOR;
                 float resolved_thickness = active ? WIRE_ACTIVE_THICKNESS : WIRE_INACTIVE_THICKNESS;
                 Color pending_color = WIRE_PENDING_COLOR;
                 Color pulse_color = WIRE_SIGNAL_GLOW;
+                float pending_thickness = WIRE_PENDING_THICKNESS;
+                float pulse_radius = SIGNAL_PULSE_RADIUS;
 
                 if (carry_wire) {
                     resolved_color = active ? CARRY_ACTIVE_COLOR : CARRY_INACTIVE_COLOR;
                     resolved_thickness *= CARRY_THICKNESS_SCALE;
                     pending_color = CARRY_PENDING_COLOR;
                     pulse_color = CARRY_SIGNAL_GLOW;
+                    pending_thickness *= CARRY_THICKNESS_SCALE;
+                    pulse_radius *= CARRY_PULSE_RADIUS_SCALE;
                 }
 
-                for (const WirePath& branch : branches) {
-                    if (branch.points.size() < 2) {
-                        continue;
+                for (uint32_t b = shape.first_branch; b < shape.end_branch; b++) {
+                    const WireBranchGeometry& branch = all_branches[b];
+
+                    set_color(pending_color);
+                    for (uint32_t i = branch.first_segment; i < branch.end_segment; i++) {
+                        emit_segment(segments[i], pending_thickness);
                     }
 
-                    // Draw the full branch as pending first
-                    float pending_thickness =
-                        carry_wire ? (WIRE_PENDING_THICKNESS * CARRY_THICKNESS_SCALE)
-                                   : WIRE_PENDING_THICKNESS;
-                    draw_polyline(branch.points, scale, offset, pending_thickness, pending_color);
-
-                    // Draw segments up to the signal position
-                    float target_dist = wa.signal_progress * branch.total_length;
-
-                    for (size_t i = 0; i + 1 < branch.points.size(); i++) {
-                        float seg_start = branch.cumulative_lengths[i];
-                        float seg_end = branch.cumulative_lengths[i + 1];
-
-                        if (seg_end <= target_dist) {
-                            // Full segment is resolved
-                            Vector2 from = to_screen(branch.points[i], scale, offset);
-                            Vector2 to = to_screen(branch.points[i + 1], scale, offset);
-                            DrawLineEx(from, to, resolved_thickness, resolved_color);
-                        } else if (seg_start < target_dist) {
-                            // Partial segment
-                            float seg_len = seg_end - seg_start;
-                            float frac =
-                                (seg_len > 0.001f) ? (target_dist - seg_start) / seg_len : 0.0f;
-                            float dx = branch.points[i + 1].x - branch.points[i].x;
-                            float dy = branch.points[i + 1].y - branch.points[i].y;
-                            Vec2 mid = {
-                                branch.points[i].x + dx * frac,
-                                branch.points[i].y + dy * frac,
-                            };
-                            Vector2 from = to_screen(branch.points[i], scale, offset);
-                            Vector2 to = to_screen(mid, scale, offset);
-                            DrawLineEx(from, to, resolved_thickness, resolved_color);
-                        }
+                    // Segments before the wavefront are resolved; the one it is
+                    // on is drawn up to the wavefront
+                    float target_dist = wa.signal_progress * branch.length;
+                    uint32_t front = geometry.segment_at(branch, target_dist);
+                    set_color(resolved_color);
+                    for (uint32_t i = branch.first_segment; i < front; i++) {
+                        emit_segment(segments[i], resolved_thickness);
+                    }
+                    Vector2 pulse = geometry.point_at(branch, target_dist);
+                    if (front < branch.end_segment && segments[front].start < target_dist) {
+                        emit_segment(segments[front].from, pulse, segments[front].normal,
+                                     resolved_thickness * 0.5f);
                     }
 
-                    // Draw signal pulse dot at the wavefront for each branch
-                    Vec2 pulse_pos = lerp_along_path(branch, wa.signal_progress);
-                    Vector2 pulse_screen = to_screen(pulse_pos, scale, offset);
-                    DrawCircleV(pulse_screen,
-                                SIGNAL_PULSE_RADIUS * (carry_wire ? CARRY_PULSE_RADIUS_SCALE : 1.0f),
-                                pulse_color);
+                    // Signal pulse dot at the wavefront
+                    if (effects.pulse_glows) {
+                        set_color(pulse_color);
+                        emit_dot(pulse, pulse_radius, PULSE_CIRCLE);
+                    }
                 }
 
                 continue; // Skip the normal drawing below
@@ -208,28 +207,76 @@ void draw_wires(const Circuit& circuit, const Layout& layout, const AnimationSta
             }
         }
 
-        for (const WirePath& branch : branches) {
-            if (branch.points.size() < 2) {
-                continue;
-            }
+        // A glitch flashes the whole wire, pending or not, at full thickness
+        if (wa.hazard > 0.0f) {
+            color = lerp_color(color, WIRE_HAZARD_COLOR, wa.hazard);
+            const float flash = WIRE_ACTIVE_THICKNESS * (carry_wire ? CARRY_THICKNESS_SCALE : 1.0f);
+            thickness = std::max(thickness, flash * wa.hazard);
+        }
 
-            // Draw polyline segments
-            draw_polyline(branch.points, scale, offset, thickness, color);
+        // A wire's branches are contiguous, so its segments and joints are too
+        set_color(color);
+        const uint32_t first_segment = all_branches[shape.first_branch].first_segment;
+        const uint32_t end_segment = all_branches[shape.end_branch - 1].end_segment;
+        for (uint32_t i = first_segment; i < end_segment; i++) {
+            emit_segment(segments[i], thickness);
+        }
 
-            // Draw small dot at each waypoint for visual clarity (only for resolved wires)
-            if (wa.resolved) {
-                for (size_t i = 1; i + 1 < branch.points.size(); i++) {
-                    Vector2 pt = to_screen(branch.points[i], scale, offset);
-                    DrawCircleV(pt, thickness * 0.8f, color);
-                }
+        // Small dot at each waypoint for visual clarity (only for resolved wires)
+        if (wa.resolved && detailed) {
+            const uint32_t first_joint = all_branches[shape.first_branch].first_joint;
+            const uint32_t end_joint = all_branches[shape.end_branch - 1].end_joint;
+            for (uint32_t i = first_joint; i < end_joint; i++) {
+                emit_dot(joints[i], thickness * 0.8f, JOINT_CIRCLE);
+            }
+        }
+    }
+    rlEnd();
+    GATEFLOW_PROFILE_DRAW_CALLS(1);
 
-                if (carry_wire) {
-                    Vec2 mid = lerp_along_path(branch, 0.5f);
-                    Vector2 smid = to_screen(mid, scale, offset);
-                    DrawAppText("C", static_cast<int>(smid.x + 2), static_cast<int>(smid.y - 10), 12,
-                             CARRY_ACTIVE_COLOR);
+    // Carry labels go on top of every wire
+    if (!detailed) {
+        return;
+    }
+    const Rectangle screen = {0.0f, 0.0f, static_cast<float>(GetScreenWidth()),
+                              static_cast<float>(GetScreenHeight())};
+    for (uint32_t id : geometry.carry_wires()) {
+        if (!anim.wire_anim(circuit.wires()[id]).resolved) {
+            continue;
+        }
+        const WireShape& shape = geometry.wire(id);
+        for (uint32_t b = shape.first_branch; b < shape.end_branch; b++) {
+            Vector2 mid = all_branches[b].midpoint;
+            if (!CheckCollisionPointRec(mid, screen)) {
+                continue;
+            }
+            DrawAppText("C", static_cast<int>(mid.x + 2), static_cast<int>(mid.y - 10), 12,
+                        CARRY_ACTIVE_COLOR);
+            GATEFLOW_PROFILE_DRAW_CALLS(1);
+        }
+    }
+}
+
+void draw_critical_wires(const Layout& layout, const TimingAnalysis& timing, float scale,
+                         Vector2 offset) {
+    const CriticalPath& path = timing.critical_path();
+    for (size_t i = 0; i < path.wires.size(); i++) {
+        const std::vector<WirePath>& branches = layout.wire_branches(path.wires[i]);
+        if (i < path.gates.size()) {
+            // Branches are routed in destination order
+            const auto& dests = path.wires[i]->get_destinations();
+            for (size_t k = 0; k < dests.size() && k < branches.size(); k++) {
+                if (dests[k] == path.gates[i]) {
+                    draw_polyline(branches[k].points, scale, offset, CRITICAL_WIRE_THICKNESS,
+                                  CRITICAL_WIRE_COLOR);
+                    break;
                 }
             }
+        } else {
+            for (const WirePath& branch : branches) {
+                draw_polyline(branch.points, scale, offset, CRITICAL_WIRE_THICKNESS,
+                              CRITICAL_WIRE_COLOR);
+            }
         }
     }
 }
@@ -5,21 +5,44 @@
 
 #include "rendering/animation_state.hpp"
 #include "rendering/layout_engine.hpp"
+#include "rendering/wire_geometry.hpp"
 #include "simulation/circuit.hpp"
+#include "timing/frame_pacer.hpp"
+#include "timing/static_timing.hpp"
 
 #include <raylib.h>
 
+#include <cstdint>
+#include <vector>
+
 namespace gateflow {
 
 /// Draws all wires with animation state (signal travel, resolved/unresolved).
 /// Wires carrying 0 are thin dark gray; wires carrying 1 are thick bright green.
 /// Unresolved wires are dimmed. Signal pulses travel along wires as they resolve.
-/// @param circuit The circuit whose wires are drawn
+/// Segments come from @p geometry, re-tessellated only when the layout or view
+/// changes, and are emitted as one rlgl triangle batch. Waypoint dots and
+/// carry labels are only drawn when the view is detailed (see is_detailed()).
+/// @param circuit  The circuit whose wires are drawn
+/// @param layout   Precomputed wire paths
+/// @param anim     Current animation state for signal travel
+/// @param geometry Screen-space wire cache for this layout (updated as needed)
+/// @param wire_ids Ids of the wires to draw, in draw order (e.g. the visible ones)
+/// @param scale    Pixels per logical unit
+/// @param offset   Screen-space offset (for camera/viewport)
+/// @param effects  Optional effects to draw (pulse_glows)
+void draw_wires(const Circuit& circuit, const Layout& layout, const AnimationState& anim,
+                WireGeometry& geometry, const std::vector<uint32_t>& wire_ids, float scale,
+                Vector2 offset, const RenderEffects& effects = {});
+
+/// Overlays the critical path's wires: for each wire on the path, the branch
+/// leading to the next gate of the path (every branch of the final output
+/// wire). Drawn over draw_wires().
 /// @param layout  Precomputed wire paths
-/// @param anim    Current animation state for signal travel
+/// @param timing  Timing analysis providing the critical path
 /// @param scale   Pixels per logical unit
 /// @param offset  Screen-space offset (for camera/viewport)
-void draw_wires(const Circuit& circuit, const Layout& layout, const AnimationState& anim,
-                float scale, Vector2 offset);
+void draw_critical_wires(const Layout& layout, const TimingAnalysis& timing, float scale,
+                         Vector2 offset);
 
 } // namespace gateflow
@@ -0,0 +1,193 @@
+#pragma once
+
+/// @file arena.hpp
+/// @brief Chunked object arena and pooled pointer lists backing Circuit storage
+///
+/// Gate and wire objects are placed in fixed-size chunks instead of one heap
+/// block each, so building and tearing down a circuit costs a handful of
+/// allocations and consecutive ids sit next to each other in memory. Their
+/// variable-length pointer lists (gate inputs, wire destinations) are
+/// carved out of a shared pool in power-of-two blocks.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gateflow {
+
+/// Append-only storage for T with stable addresses.
+/// Objects are destroyed together when the arena is destroyed.
+template <typename T, size_t ChunkSize = 1024> class ChunkedArena {
+  public:
+    ChunkedArena() = default;
+    ~ChunkedArena() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < size_; i++) {
+                (*this)[i].~T();
+            }
+        }
+    }
+
+    ChunkedArena(const ChunkedArena&) = delete;
+    ChunkedArena& operator=(const ChunkedArena&) = delete;
+
+    /// Constructs a new object at the end of the arena
+    template <typename... Args> T* create(Args&&... args) {
+        if (size_ == chunks_.size() * ChunkSize) {
+            chunks_.push_back(std::make_unique<Slot[]>(ChunkSize));
+        }
+        void* where = chunks_[size_ / ChunkSize][size_ % ChunkSize].bytes;
+        T* obj = new (where) T(std::forward<Args>(args)...);
+        size_++;
+        return obj;
+    }
+
+    [[nodiscard]] size_t size() const { return size_; }
+
+    /// Bytes held by the chunks and the chunk table
+    [[nodiscard]] size_t heap_bytes() const {
+        return chunks_.size() * ChunkSize * sizeof(Slot) +
+               chunks_.capacity() * sizeof(std::unique_ptr<Slot[]>);
+    }
+
+    /// Heap blocks behind heap_bytes()
+    [[nodiscard]] size_t heap_allocations() const {
+        return chunks_.size() + (chunks_.capacity() > 0 ? 1 : 0);
+    }
+
+    [[nodiscard]] T& operator[](size_t i) {
+        return *std::launder(reinterpret_cast<T*>(chunks_[i / ChunkSize][i % ChunkSize].bytes));
+    }
+
+  private:
+    struct Slot {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    size_t size_ = 0;
+};
+
+/// Hands out blocks of T* with power-of-two capacities from shared chunks.
+/// Released blocks are kept on per-capacity free lists for reuse.
+template <typename T> class PointerListPool {
+  public:
+    /// Returns a block with room for 2^capacity_log2 pointers
+    T** allocate(uint32_t capacity_log2) {
+        std::vector<T**>& free_list = free_[capacity_log2];
+        if (!free_list.empty()) {
+            T** block = free_list.back();
+            free_list.pop_back();
+            return block;
+        }
+
+        const size_t capacity = size_t{1} << capacity_log2;
+        if (capacity > CHUNK_SLOTS) {
+            chunks_.push_back(std::make_unique<T*[]>(capacity));
+            chunk_slots_ += capacity;
+            return chunks_.back().get();
+        }
+        if (chunk_used_ + capacity > CHUNK_SLOTS) {
+            chunks_.push_back(std::make_unique<T*[]>(CHUNK_SLOTS));
+            chunk_slots_ += CHUNK_SLOTS;
+            current_ = chunks_.back().get();
+            chunk_used_ = 0;
+        }
+        T** block = current_ + chunk_used_;
+        chunk_used_ += capacity;
+        return block;
+    }
+
+    /// Returns a block obtained from allocate() with the same capacity_log2
+    void release(T** block, uint32_t capacity_log2) { free_[capacity_log2].push_back(block); }
+
+    /// Bytes held by the chunks (handed out or not), the chunk table and the free lists
+    [[nodiscard]] size_t heap_bytes() const {
+        size_t bytes = chunk_slots_ * sizeof(T*) + chunks_.capacity() * sizeof(chunks_[0]);
+        for (const std::vector<T**>& free_list : free_) {
+            bytes += free_list.capacity() * sizeof(T**);
+        }
+        return bytes;
+    }
+
+    /// Heap blocks behind heap_bytes()
+    [[nodiscard]] size_t heap_allocations() const {
+        size_t count = chunks_.size() + (chunks_.capacity() > 0 ? 1 : 0);
+        for (const std::vector<T**>& free_list : free_) {
+            count += free_list.capacity() > 0 ? 1 : 0;
+        }
+        return count;
+    }
+
+  private:
+    static constexpr size_t CHUNK_SLOTS = 4096;
+
+    std::vector<std::unique_ptr<T*[]>> chunks_;
+    size_t chunk_slots_ = 0; ///< Pointer slots across chunks_
+    T** current_ = nullptr; ///< Chunk that small blocks are carved from
+    size_t chunk_used_ = CHUNK_SLOTS;
+    std::array<std::vector<T**>, 32> free_;
+};
+
+/// Growable list of T* whose storage lives in a PointerListPool.
+/// Read access mirrors std::vector; mutation takes the owning pool.
+template <typename T> class PooledList {
+  public:
+    using const_iterator = T* const*;
+
+    [[nodiscard]] const_iterator begin() const { return data_; }
+    [[nodiscard]] const_iterator end() const { return data_ + size_; }
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] T* operator[](size_t i) const { return data_[i]; }
+    [[nodiscard]] T* front() const { return data_[0]; }
+    [[nodiscard]] T* back() const { return data_[size_ - 1]; }
+
+    void push_back(T* value, PointerListPool<T>& pool) {
+        if (data_ == nullptr || size_ == (uint32_t{1} << capacity_log2_)) {
+            grow(pool);
+        }
+        data_[size_++] = value;
+    }
+
+    /// Removes the first occurrence of value, keeping the order of the rest
+    void erase_one(T* value) {
+        for (uint32_t i = 0; i < size_; i++) {
+            if (data_[i] == value) {
+                for (uint32_t j = i + 1; j < size_; j++) {
+                    data_[j - 1] = data_[j];
+                }
+                size_--;
+                return;
+            }
+        }
+    }
+
+    /// Empties the list, keeping its block for reuse
+    void clear() { size_ = 0; }
+
+  private:
+    void grow(PointerListPool<T>& pool) {
+        const uint32_t new_log2 = data_ == nullptr ? 1 : capacity_log2_ + 1;
+        T** block = pool.allocate(new_log2);
+        for (uint32_t i = 0; i < size_; i++) {
+            block[i] = data_[i];
+        }
+        if (data_ != nullptr) {
+            pool.release(data_, capacity_log2_);
+        }
+        data_ = block;
+        capacity_log2_ = new_log2;
+    }
+
+    T** data_ = nullptr;
+    uint32_t size_ = 0;
+    uint32_t capacity_log2_ = 0;
+};
+
+} // namespace gateflow
@@ -0,0 +1,59 @@
+/// @file background_job.cpp
+/// @brief BackgroundJob thread start, completion flag and error hand-over
+
+#include "simulation/background_job.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace gateflow {
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define GATEFLOW_HAS_THREADS 0
+#else
+#define GATEFLOW_HAS_THREADS 1
+#endif
+
+BackgroundJob::~BackgroundJob() {
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void BackgroundJob::start(std::function<void()> fn) {
+    if (active_) {
+        throw std::logic_error("BackgroundJob::start: previous job not finished");
+    }
+    active_ = true;
+    error_ = nullptr;
+    done_.store(false, std::memory_order_relaxed);
+
+    auto run = [this, fn = std::move(fn)] {
+        try {
+            fn();
+        } catch (...) {
+            error_ = std::current_exception();
+        }
+        done_.store(true, std::memory_order_release);
+    };
+#if GATEFLOW_HAS_THREADS
+    thread_ = std::thread(std::move(run));
+#else
+    run();
+#endif
+}
+
+void BackgroundJob::finish() {
+    if (!active_) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    active_ = false;
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+} // namespace gateflow
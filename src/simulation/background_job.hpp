@@ -0,0 +1,50 @@
+#pragma once
+
+/// @file background_job.hpp
+/// @brief One function run on its own thread, polled for completion from a frame loop
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
+
+namespace gateflow {
+
+/// Runs a single function off the calling thread so a frame loop can keep
+/// drawing while it works, then check done() once per frame instead of
+/// blocking on it. Results are handed over through whatever @p fn captures;
+/// finish() makes them visible to the caller.
+///
+/// Without thread support (an Emscripten build without pthreads) start()
+/// runs the function to completion before returning, as ThreadPool does.
+class BackgroundJob {
+  public:
+    BackgroundJob() = default;
+    /// Waits for a running function; any exception it threw is dropped
+    ~BackgroundJob();
+
+    BackgroundJob(const BackgroundJob&) = delete;
+    BackgroundJob& operator=(const BackgroundJob&) = delete;
+
+    /// Runs @p fn in the background.
+    /// @throws std::logic_error if a previous job has not been finished
+    void start(std::function<void()> fn);
+
+    /// True between start() and finish()
+    [[nodiscard]] bool active() const { return active_; }
+
+    /// True once the function has returned (or thrown); never blocks
+    [[nodiscard]] bool done() const { return done_.load(std::memory_order_acquire); }
+
+    /// Waits for the function, then rethrows what it threw, if anything.
+    /// Does nothing if no job is active.
+    void finish();
+
+  private:
+    std::thread thread_;
+    std::atomic<bool> done_{false};
+    std::exception_ptr error_;
+    bool active_ = false;
+};
+
+} // namespace gateflow
@@ -1,30 +1,106 @@
 /// @file circuit.cpp
-/// @brief Circuit construction, topological sort (Kahn's algorithm), and propagation
+/// @brief Circuit construction, topological sort (Kahn's algorithm), and compiled propagation
 
 #include "simulation/circuit.hpp"
 
+#include "simulation/lane_simulator.hpp"
+
 #include <algorithm>
-#include <queue>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <utility>
 
 namespace gateflow {
 
-Gate* Circuit::add_gate(GateType type) {
-    gates_.push_back(std::make_unique<Gate>(next_gate_id_++, type));
-    return gates_.back().get();
+namespace {
+
+/// Compile-time (type, arity) of a run's kernel; Arity 0 = "3 or more"
+template <GateType T, size_t A> struct KernelTag {
+    static constexpr GateType type = T;
+    static constexpr size_t arity = A;
+};
+
+/// Calls @p fn with the KernelTag matching @p run, so the loop inside fn is
+/// instantiated per (type, arity) instead of switching per gate.
+template <typename Fn> void dispatch_kernel(const GateRun& run, Fn&& fn) {
+    const bool binary = run.arity == 2;
+    switch (run.type) {
+    case GateType::NOT:
+        fn(KernelTag<GateType::NOT, 1>{});
+        return;
+    case GateType::BUFFER:
+        fn(KernelTag<GateType::BUFFER, 1>{});
+        return;
+    case GateType::AND:
+        binary ? fn(KernelTag<GateType::AND, 2>{}) : fn(KernelTag<GateType::AND, 0>{});
+        return;
+    case GateType::NAND:
+        binary ? fn(KernelTag<GateType::NAND, 2>{}) : fn(KernelTag<GateType::NAND, 0>{});
+        return;
+    case GateType::OR:
+        binary ? fn(KernelTag<GateType::OR, 2>{}) : fn(KernelTag<GateType::OR, 0>{});
+        return;
+    case GateType::XOR:
+        binary ? fn(KernelTag<GateType::XOR, 2>{}) : fn(KernelTag<GateType::XOR, 0>{});
+        return;
+    }
+}
+
+/// Appends a bus after checking it fits @p ports and its name is new
+void add_bus(std::vector<Bus>& buses, std::string name, size_t first, size_t width, size_t ports,
+             const char* kind) {
+    if (width == 0 || first > ports || width > ports - first) {
+        throw std::invalid_argument(std::string(kind) + " bus " + name + " [" +
+                                    std::to_string(first) + ", +" + std::to_string(width) +
+                                    ") does not fit " + std::to_string(ports) + " ports");
+    }
+    for (const Bus& bus : buses) {
+        if (bus.name == name) {
+            throw std::invalid_argument(std::string(kind) + " bus " + name + " already exists");
+        }
+    }
+    buses.push_back({std::move(name), first, width});
+}
+
+/// Index of the bus called @p name
+size_t find_bus(const std::vector<Bus>& buses, const std::string& name, const char* kind) {
+    for (size_t i = 0; i < buses.size(); i++) {
+        if (buses[i].name == name) {
+            return i;
+        }
+    }
+    throw std::invalid_argument(std::string("No ") + kind + " bus named " + name);
+}
+
+} // namespace
+
+Gate* Circuit::add_gate(GateType type, uint32_t instance) {
+    if (instance != NO_INSTANCE && instance >= instance_modules_.size()) {
+        throw std::invalid_argument("add_gate() given unknown instance " +
+                                    std::to_string(instance));
+    }
+    finalized_ = false;
+    gates_.push_back(storage_->gate_arena.create(next_gate_id_++, type, storage_->input_lists));
+    gate_instances_.push_back(instance);
+    return gates_.back();
+}
+
+uint32_t Circuit::add_instance(std::string module) {
+    instance_modules_.push_back(std::move(module));
+    return static_cast<uint32_t>(instance_modules_.size() - 1);
 }
 
 Wire* Circuit::add_wire() {
-    wires_.push_back(std::make_unique<Wire>(next_wire_id_++));
-    return wires_.back().get();
+    finalized_ = false;
+    wires_.push_back(storage_->wire_arena.create(next_wire_id_++, storage_->destination_lists));
+    return wires_.back();
 }
 
 void Circuit::connect(Wire* wire, Gate* source, Gate* destination) {
     if (wire == nullptr) {
         throw std::invalid_argument("connect() requires a non-null wire");
     }
+    finalized_ = false;
 
     if (source != nullptr) {
         if (wire->get_source() != nullptr && wire->get_source() != source) {
@@ -42,6 +118,12 @@ void Circuit::connect(Wire* wire, Gate* source, Gate* destination) {
     }
 }
 
+void Circuit::reserve(size_t gates, size_t wires) {
+    gates_.reserve(gates);
+    gate_instances_.reserve(gates);
+    wires_.reserve(wires);
+}
+
 void Circuit::mark_input(Wire* wire) {
     input_wires_.push_back(wire);
 }
@@ -50,51 +132,119 @@ void Circuit::mark_output(Wire* wire) {
     output_wires_.push_back(wire);
 }
 
-void Circuit::finalize() {
-    validate_connectivity();
+std::unique_ptr<Circuit> Circuit::clone() const {
+    auto copy = std::make_unique<Circuit>();
+    copy->reserve(gates_.size(), wires_.size());
+
+    // Ids are dense, so creating in id order reproduces every id
+    copy->instance_modules_ = instance_modules_;
+    copy->input_buses_ = input_buses_;
+    copy->output_buses_ = output_buses_;
+    for (const Gate* gate : gates_) {
+        Gate* g = copy->add_gate(gate->get_type(), instance_of(gate));
+        g->set_state(gate->get_state());
+        g->set_dirty(gate->is_dirty());
+    }
+    for (const Wire* wire : wires_) {
+        Wire* w = copy->add_wire();
+        w->set_value(wire->get_previous_value());
+        w->set_value(wire->get_value());
+    }
 
-    // Kahn's algorithm for topological sort
-    // in-degree = number of input wires whose source is another gate
-    std::unordered_map<Gate*, int> in_degree;
-    for (auto& gate : gates_) {
-        in_degree[gate.get()] = 0;
+    // Links are copied list by list, since input order matters for layout
+    for (const Gate* gate : gates_) {
+        Gate* g = copy->gates_[gate->get_id()];
+        if (const Wire* out = gate->get_output()) {
+            g->set_output(copy->wires_[out->get_id()]);
+        }
+        for (const Wire* input : gate->get_inputs()) {
+            g->add_input(copy->wires_[input->get_id()]);
+        }
+    }
+    for (const Wire* wire : wires_) {
+        Wire* w = copy->wires_[wire->get_id()];
+        if (const Gate* src = wire->get_source()) {
+            w->set_source(copy->gates_[src->get_id()]);
+        }
+        for (const Gate* dest : wire->get_destinations()) {
+            w->add_destination(copy->gates_[dest->get_id()]);
+        }
+    }
+    for (const Wire* wire : input_wires_) {
+        copy->input_wires_.push_back(copy->wires_[wire->get_id()]);
+    }
+    for (const Wire* wire : output_wires_) {
+        copy->output_wires_.push_back(copy->wires_[wire->get_id()]);
     }
 
-    // Count in-degrees: for each gate, count how many of its input wires
-    // come from another gate (have a non-null source)
-    for (auto& gate : gates_) {
-        for (Wire* input_wire : gate->get_inputs()) {
-            if (input_wire->get_source() != nullptr) {
-                in_degree[gate.get()]++;
-            }
+    if (finalized_) {
+        copy->topo_order_.reserve(topo_order_.size());
+        for (const Gate* gate : topo_order_) {
+            copy->topo_order_.push_back(copy->gates_[gate->get_id()]);
+        }
+        copy->compiled_ = compiled_;
+        copy->wire_values_ = wire_values_;
+        copy->gate_states_ = gate_states_;
+        copy->packed_values_ = packed_values_;
+        copy->settle_wires_.reserve(settle_wires_.size());
+        for (const Wire* wire : settle_wires_) {
+            copy->settle_wires_.push_back(copy->wires_[wire->get_id()]);
         }
+        copy->slot_dirty_ = slot_dirty_;
+        copy->dirty_levels_ = dirty_levels_;
+        copy->dirty_count_ = dirty_count_;
+        copy->dirty_min_level_ = dirty_min_level_;
+        copy->full_pass_pending_ = full_pass_pending_;
+        copy->finalized_ = true;
     }
+    if (thread_pool_) {
+        copy->set_parallelism(thread_pool_->concurrency(), min_parallel_level_slots_);
+    }
+    return copy;
+}
 
-    // Seed the queue with gates that have all primary-input feeds (in_degree 0)
-    std::queue<Gate*> ready;
-    for (auto& gate : gates_) {
-        if (in_degree[gate.get()] == 0) {
-            ready.push(gate.get());
+void Circuit::finalize() {
+    validate_structure();
+
+    // Builders and passes that emit each gate after its sources already
+    // number gates in a topological order; levelize that directly
+    if (ids_are_topological()) {
+        topo_order_ = gates_;
+        compiled_ = compile_netlist(topo_order_, gates_.size(), wires_.size());
+        adopt_compiled();
+        return;
+    }
+
+    // Kahn's algorithm for topological sort over an id-indexed degree array.
+    // in-degree = number of input wires whose source is another gate
+    std::vector<uint32_t> in_degree(gates_.size(), 0);
+    for (const Gate* gate : gates_) {
+        for (const Wire* input_wire : gate->get_inputs()) {
+            if (input_wire->get_source() != nullptr) {
+                in_degree[gate->get_id()]++;
+            }
         }
     }
 
+    // topo_order_ doubles as the FIFO queue: [head, size) are ready but not
+    // yet expanded. Seed it with gates fed only by primary inputs.
     topo_order_.clear();
     topo_order_.reserve(gates_.size());
+    for (Gate* gate : gates_) {
+        if (in_degree[gate->get_id()] == 0) {
+            topo_order_.push_back(gate);
+        }
+    }
 
-    while (!ready.empty()) {
-        Gate* current = ready.front();
-        ready.pop();
-        topo_order_.push_back(current);
-
+    for (size_t head = 0; head < topo_order_.size(); head++) {
         // For each gate that depends on current's output wire
-        Wire* out = current->get_output();
+        Wire* out = topo_order_[head]->get_output();
         if (out == nullptr) {
             continue;
         }
         for (Gate* dest : out->get_destinations()) {
-            in_degree[dest]--;
-            if (in_degree[dest] == 0) {
-                ready.push(dest);
+            if (--in_degree[dest->get_id()] == 0) {
+                topo_order_.push_back(dest);
             }
         }
     }
@@ -103,74 +253,159 @@ void Circuit::finalize() {
         throw std::runtime_error("Circuit contains a cycle — topological sort failed");
     }
 
-    finalized_ = true;
+    // Levelize into the compiled form, and expose the same order through
+    // topological_order() so both views agree.
+    compiled_ = compile_netlist(topo_order_, gates_.size(), wires_.size());
+    adopt_compiled();
 }
 
-void Circuit::validate_connectivity() const {
-    // For each gate input occurrence, the corresponding wire destination list
-    // must include the same number of occurrences for that gate.
-    for (const auto& gate_ptr : gates_) {
-        const Gate* gate = gate_ptr.get();
-
-        // Validate output link consistency.
-        if (const Wire* out = gate->get_output(); out != nullptr) {
-            if (out->get_source() != gate) {
-                throw std::runtime_error("Inconsistent output link: gate output wire source mismatch");
-            }
-        }
+void Circuit::finalize(CompiledNetlist compiled) {
+    validate_structure();
+    validate_compiled_netlist(compiled, gates_, wires_.size());
+    compiled_ = std::move(compiled);
+    adopt_compiled();
+}
 
-        std::unordered_map<const Wire*, int> input_counts;
+bool Circuit::ids_are_topological() const {
+    for (const Gate* gate : gates_) {
         for (const Wire* input_wire : gate->get_inputs()) {
-            if (input_wire == nullptr) {
-                throw std::runtime_error("Inconsistent connectivity: gate has null input wire");
+            const Gate* src = input_wire->get_source();
+            if (src != nullptr && src->get_id() >= gate->get_id()) {
+                return false;
             }
-            input_counts[input_wire]++;
         }
+    }
+    return true;
+}
 
-        for (const auto& [wire, required_count] : input_counts) {
-            int actual_count = 0;
-            for (const Gate* dest : wire->get_destinations()) {
-                if (dest == gate) {
-                    actual_count++;
-                }
-            }
-            if (actual_count < required_count) {
-                throw std::runtime_error(
-                    "Inconsistent connectivity: gate input not mirrored in wire destinations");
-            }
+void Circuit::validate_structure() const {
+    validate_connectivity();
+
+    // Arity is checked once here so the propagation loop never has to
+    for (const Gate* gate : gates_) {
+        const size_t count = gate->get_inputs().size();
+        validate_arity(gate->get_type(), count);
+        if (count > MAX_GATE_INPUTS) {
+            throw std::runtime_error("Gate " + std::to_string(gate->get_id()) + " has " +
+                                     std::to_string(count) + " inputs; at most " +
+                                     std::to_string(MAX_GATE_INPUTS) + " are supported");
         }
     }
+}
+
+void Circuit::adopt_compiled() {
+    topo_order_.resize(compiled_.num_gates());
+    for (size_t slot = 0; slot < compiled_.num_gates(); slot++) {
+        topo_order_[slot] = gates_[compiled_.gate_ids[slot]];
+    }
+
+    // Seed compiled state from the objects (inputs may already be set)
+    wire_values_.resize(wires_.size());
+    for (size_t i = 0; i < wires_.size(); i++) {
+        wire_values_[i] = wires_[i]->get_value() ? 1 : 0;
+    }
+    gate_states_.resize(compiled_.num_gates());
+    settle_wires_.clear();
+    packed_values_.assign(wires_.size(), LaneBlock<1>{});
+
+    // Everything is dirty until the first pass has evaluated each gate once.
+    // That pass walks every slot in order, so the per-level buckets start
+    // empty instead of being filled with every slot.
+    slot_dirty_.assign(compiled_.num_gates(), 1);
+    dirty_levels_.assign(compiled_.num_levels(), {});
+    for (size_t slot = 0; slot < compiled_.num_gates(); slot++) {
+        gate_states_[slot] = topo_order_[slot]->get_state() ? 1 : 0;
+        topo_order_[slot]->set_dirty(true);
+    }
+    dirty_count_ = 0;
+    dirty_min_level_ = 0;
+    full_pass_pending_ = true;
 
-    // For each wire link, verify the inverse link exists.
-    for (const auto& wire_ptr : wires_) {
-        const Wire* wire = wire_ptr.get();
+    finalized_ = true;
+}
 
+void Circuit::validate_connectivity() const {
+    // Every link must point at an object owned by this circuit, so the id
+    // can index the flat arrays below.
+    auto owns_gate = [this](const Gate* gate) {
+        return gate != nullptr && gate->get_id() < gates_.size() && gates_[gate->get_id()] == gate;
+    };
+    auto owns_wire = [this](const Wire* wire) {
+        return wire != nullptr && wire->get_id() < wires_.size() && wires_[wire->get_id()] == wire;
+    };
+
+    // Output/source links are one-to-one and checked from both sides.
+    for (const Gate* gate : gates_) {
+        if (const Wire* out = gate->get_output(); out != nullptr) {
+            if (!owns_wire(out) || out->get_source() != gate) {
+                throw std::runtime_error("Inconsistent output link: gate output wire source mismatch");
+            }
+        }
+    }
+    for (const Wire* wire : wires_) {
         if (const Gate* src = wire->get_source(); src != nullptr) {
-            if (src->get_output() != wire) {
+            if (!owns_gate(src) || src->get_output() != wire) {
                 throw std::runtime_error("Inconsistent connectivity: wire source gate does not point back to wire");
             }
         }
+    }
 
-        std::unordered_map<const Gate*, int> dest_counts;
-        for (const Gate* dest : wire->get_destinations()) {
-            if (dest == nullptr) {
-                throw std::runtime_error("Inconsistent connectivity: wire has null destination gate");
+    // Input/destination links form a multiset of (wire, gate) pairs that
+    // both sides must list identically. Bucket the gate side by wire id
+    // (counting sort), then compare each wire's destinations against its
+    // bucket with a per-gate counter that is zeroed again after each wire.
+    std::vector<uint32_t> reader_offsets(wires_.size() + 1, 0);
+    for (const Gate* gate : gates_) {
+        for (const Wire* input_wire : gate->get_inputs()) {
+            if (!owns_wire(input_wire)) {
+                throw std::runtime_error("Inconsistent connectivity: gate has a null or foreign input wire");
             }
-            dest_counts[dest]++;
+            reader_offsets[input_wire->get_id() + 1]++;
+        }
+    }
+    for (size_t w = 0; w < wires_.size(); w++) {
+        reader_offsets[w + 1] += reader_offsets[w];
+    }
+    std::vector<uint32_t> readers(reader_offsets.back());
+    std::vector<uint32_t> cursor(reader_offsets.begin(), reader_offsets.end() - 1);
+    for (const Gate* gate : gates_) {
+        for (const Wire* input_wire : gate->get_inputs()) {
+            readers[cursor[input_wire->get_id()]++] = gate->get_id();
         }
+    }
 
-        for (const auto& [dest_gate, required_count] : dest_counts) {
-            int actual_count = 0;
-            for (const Wire* gate_input : dest_gate->get_inputs()) {
-                if (gate_input == wire) {
-                    actual_count++;
-                }
+    std::vector<int32_t> balance(gates_.size(), 0);
+    for (const Wire* wire : wires_) {
+        const uint32_t begin = reader_offsets[wire->get_id()];
+        const uint32_t end = reader_offsets[wire->get_id() + 1];
+        for (const Gate* dest : wire->get_destinations()) {
+            if (!owns_gate(dest)) {
+                throw std::runtime_error("Inconsistent connectivity: wire has a null or foreign destination gate");
+            }
+            balance[dest->get_id()]++;
+        }
+        for (uint32_t i = begin; i < end; i++) {
+            balance[readers[i]]--;
+        }
+        // Any gate left unbalanced was listed more often on one side
+        for (uint32_t i = begin; i < end; i++) {
+            if (balance[readers[i]] < 0) {
+                throw std::runtime_error(
+                    "Inconsistent connectivity: gate input not mirrored in wire destinations");
+            }
+            if (balance[readers[i]] > 0) {
+                throw std::runtime_error(
+                    "Inconsistent connectivity: wire destination not mirrored in gate inputs");
             }
-            if (actual_count < required_count) {
+        }
+        for (const Gate* dest : wire->get_destinations()) {
+            if (balance[dest->get_id()] != 0) {
                 throw std::runtime_error(
                     "Inconsistent connectivity: wire destination not mirrored in gate inputs");
             }
         }
+        // Every counter touched was zero or the check threw, so the array is
+        // already clean for the next wire.
     }
 }
 
@@ -178,44 +413,218 @@ void Circuit::set_input(size_t index, bool value) {
     if (index >= input_wires_.size()) {
         throw std::out_of_range("Input index out of range");
     }
-    input_wires_[index]->set_value(value);
+    write_input(input_wires_[index], value);
+}
+
+void Circuit::write_input(Wire* wire, bool value) {
+    wire->set_value(value);
+    if (finalized_) {
+        const uint32_t id = wire->get_id();
+        const uint8_t v = value ? 1 : 0;
+        if (wire_values_[id] != v) {
+            wire_values_[id] = v;
+            mark_readers_dirty(id);
+        }
+    }
+}
+
+void Circuit::add_input_bus(std::string name, size_t first, size_t width) {
+    add_bus(input_buses_, std::move(name), first, width, input_wires_.size(), "Input");
+}
+
+void Circuit::add_output_bus(std::string name, size_t first, size_t width) {
+    add_bus(output_buses_, std::move(name), first, width, output_wires_.size(), "Output");
+}
+
+size_t Circuit::find_input_bus(const std::string& name) const {
+    return find_bus(input_buses_, name, "input");
+}
+
+size_t Circuit::find_output_bus(const std::string& name) const {
+    return find_bus(output_buses_, name, "output");
+}
+
+void Circuit::set_bus(size_t bus, uint64_t value) {
+    if (bus >= input_buses_.size()) {
+        throw std::out_of_range("Input bus index out of range");
+    }
+    const Bus& b = input_buses_[bus];
+    for (size_t i = 0; i < b.width; i++) {
+        write_input(input_wires_[b.first + i], i < 64 && ((value >> i) & 1) != 0);
+    }
+}
+
+uint64_t Circuit::read_bus(size_t bus) const {
+    if (bus >= output_buses_.size()) {
+        throw std::out_of_range("Output bus index out of range");
+    }
+    const Bus& b = output_buses_[bus];
+    uint64_t value = 0;
+    for (size_t i = 0; i < std::min<size_t>(b.width, 64); i++) {
+        value |= uint64_t{output_wires_[b.first + i]->get_value()} << i;
+    }
+    return value;
+}
+
+void Circuit::set_inputs(const uint64_t* words) {
+    for (size_t i = 0; i < input_wires_.size(); i++) {
+        write_input(input_wires_[i], ((words[i / 64] >> (i % 64)) & 1) != 0);
+    }
+}
+
+void Circuit::read_outputs(uint64_t* words) const {
+    const size_t count = (output_wires_.size() + 63) / 64;
+    std::fill(words, words + count, uint64_t{0});
+    for (size_t i = 0; i < output_wires_.size(); i++) {
+        words[i / 64] |= uint64_t{output_wires_[i]->get_value()} << (i % 64);
+    }
+}
+
+void Circuit::mark_dirty(uint32_t slot) {
+    if (slot_dirty_[slot] != 0) {
+        return;
+    }
+    slot_dirty_[slot] = 1;
+    topo_order_[slot]->set_dirty(true);
+
+    const size_t level = compiled_.gate_levels[compiled_.gate_ids[slot]];
+    if (dirty_count_ == 0 || level < dirty_min_level_) {
+        dirty_min_level_ = level;
+    }
+    dirty_levels_[level].push_back(slot);
+    dirty_count_++;
+}
+
+void Circuit::mark_readers_dirty(uint32_t wire_id) {
+    const CompiledNetlist& net = compiled_;
+    for (uint32_t k = net.fanout_offsets[wire_id]; k < net.fanout_offsets[wire_id + 1]; k++) {
+        mark_dirty(net.fanout_slots[k]);
+    }
 }
 
 PropagationResult Circuit::propagate() {
+    PropagationResult result;
+    propagate(result);
+    return result;
+}
+
+template <GateType Type, size_t Arity, bool WakeReaders>
+void Circuit::evaluate_slot(uint32_t slot, PropagationResult& result) {
+    const CompiledNetlist& net = compiled_;
+    Gate* gate = topo_order_[slot];
+    slot_dirty_[slot] = 0;
+    gate->set_dirty(false);
+
+    // Gather input values into a bitmask (fan-in <= 64, checked by finalize)
+    const uint32_t first = net.input_offsets[slot];
+    const uint8_t* values = wire_values_.data();
+    const uint32_t* in = net.input_wires.data() + first;
+    uint64_t mask = 0;
+    size_t count = Arity;
+    if constexpr (Arity == 1) {
+        mask = values[in[0]];
+    } else if constexpr (Arity == 2) {
+        mask = values[in[0]] | (uint64_t{values[in[1]]} << 1);
+    } else {
+        count = net.input_offsets[slot + 1] - first;
+        for (size_t k = 0; k < count; k++) {
+            mask |= uint64_t{values[in[k]]} << k;
+        }
+    }
+
+    bool new_state = evaluate_fixed<Type, Arity>(mask, count);
+    bool old_state = gate_states_[slot] != 0;
+    gate_states_[slot] = new_state ? 1 : 0;
+
+    // Update the output wire; only a real change wakes its readers
+    uint32_t out = net.outputs[slot];
+    if (out != NO_WIRE && (wire_values_[out] != 0) != new_state) {
+        wire_values_[out] = new_state ? 1 : 0;
+        Wire* out_wire = wires_[out];
+        out_wire->set_value(new_state);
+        result.changed_wires.push_back(out_wire);
+        if constexpr (WakeReaders) {
+            mark_readers_dirty(out);
+        }
+    }
+
+    if (new_state != old_state) {
+        gate->set_state(new_state);
+        result.changed_gates.push_back(gate);
+    }
+}
+
+void Circuit::evaluate_run(const GateRun& run, PropagationResult& result) {
+    dispatch_kernel(run, [&](auto tag) {
+        using Tag = decltype(tag);
+        for (uint32_t slot = run.begin; slot < run.end; slot++) {
+            evaluate_slot<Tag::type, Tag::arity, false>(slot, result);
+        }
+    });
+}
+
+const uint32_t* Circuit::evaluate_dirty_run(const GateRun& run, const uint32_t* first,
+                                            const uint32_t* last, PropagationResult& result) {
+    dispatch_kernel(run, [&](auto tag) {
+        using Tag = decltype(tag);
+        for (; first != last && *first < run.end; ++first) {
+            evaluate_slot<Tag::type, Tag::arity, true>(*first, result);
+        }
+    });
+    return first;
+}
+
+void Circuit::propagate(PropagationResult& result) {
     if (!finalized_) {
         throw std::runtime_error("Circuit must be finalized before propagation");
     }
 
-    PropagationResult result;
+    result.changed_gates.clear();
+    result.changed_wires.clear();
+    result.gates_evaluated = 0;
 
-    for (Gate* gate : topo_order_) {
-        // Gather current input values from this gate's input wires
-        std::vector<bool> input_values;
-        input_values.reserve(gate->get_inputs().size());
-        for (Wire* w : gate->get_inputs()) {
-            input_values.push_back(w->get_value());
+    // Wires that changed on the previous pass still report value_changed();
+    // settle them so only this pass's changes are visible afterwards.
+    for (Wire* w : settle_wires_) {
+        w->set_value(w->get_value());
+    }
+
+    // After finalize() every slot is dirty: evaluate them all in slot order.
+    // No reader needs waking, since each is visited later in the same pass.
+    if (full_pass_pending_) {
+        full_pass_pending_ = false;
+        for (const GateRun& run : compiled_.runs) {
+            evaluate_run(run, result);
         }
+        result.gates_evaluated = compiled_.num_gates();
+    }
 
-        bool new_state = evaluate(gate->get_type(), input_values);
-        bool old_state = gate->get_state();
-        gate->set_state(new_state);
-        gate->set_dirty(false);
-
-        // Update the output wire
-        Wire* out = gate->get_output();
-        if (out != nullptr) {
-            out->set_value(new_state);
-            if (out->value_changed()) {
-                result.changed_wires.push_back(out);
+    // Readers of a gate sit at strictly higher levels, so marking during the
+    // walk never touches the bucket being processed.
+    for (size_t level = dirty_min_level_; dirty_count_ > 0; level++) {
+        std::vector<uint32_t>& bucket = dirty_levels_[level];
+        if (bucket.empty()) {
+            continue;
+        }
+        // Slot order keeps the result identical to a full pass, and groups
+        // the bucket by run so each run's kernel is dispatched once
+        std::sort(bucket.begin(), bucket.end());
+
+        const uint32_t* it = bucket.data();
+        const uint32_t* end = it + bucket.size();
+        for (uint32_t r = compiled_.level_runs[level]; it != end; r++) {
+            const GateRun& run = compiled_.runs[r];
+            if (*it < run.end) {
+                it = evaluate_dirty_run(run, it, end, result);
             }
         }
 
-        if (new_state != old_state) {
-            result.changed_gates.push_back(gate);
-        }
+        result.gates_evaluated += bucket.size();
+        dirty_count_ -= bucket.size();
+        bucket.clear();
     }
 
-    return result;
+    settle_wires_ = result.changed_wires;
 }
 
 bool Circuit::get_output(size_t index) const {
@@ -225,4 +634,132 @@ bool Circuit::get_output(size_t index) const {
     return output_wires_[index]->get_value();
 }
 
+void Circuit::set_input_packed(size_t index, uint64_t lanes) {
+    if (index >= input_wires_.size()) {
+        throw std::out_of_range("Input index out of range");
+    }
+    if (!finalized_) {
+        throw std::runtime_error("Circuit must be finalized before packed simulation");
+    }
+    packed_values_[input_wires_[index]->get_id()].words[0] = lanes;
+}
+
+void Circuit::propagate_packed() {
+    if (!finalized_) {
+        throw std::runtime_error("Circuit must be finalized before propagation");
+    }
+
+    if (thread_pool_) {
+        propagate_lanes(compiled_, packed_values_.data(), *thread_pool_, min_parallel_level_slots_);
+    } else {
+        propagate_lanes(compiled_, packed_values_.data());
+    }
+}
+
+void Circuit::set_parallelism(size_t threads, size_t min_level_slots) {
+    min_parallel_level_slots_ = std::max<size_t>(min_level_slots, 1);
+    thread_pool_.reset();
+    if (threads != 1) {
+        thread_pool_ = std::make_unique<ThreadPool>(threads);
+        if (thread_pool_->concurrency() == 1) {
+            thread_pool_.reset(); // No thread support, or a single-core host
+        }
+    }
+}
+
+uint64_t Circuit::get_output_packed(size_t index) const {
+    if (index >= output_wires_.size()) {
+        throw std::out_of_range("Output index out of range");
+    }
+    if (!finalized_) {
+        throw std::runtime_error("Circuit must be finalized before packed simulation");
+    }
+    return packed_values_[output_wires_[index]->get_id()].words[0];
+}
+
+uint64_t Circuit::structural_hash() const {
+    // FNV-1a over 32-bit fields; a sentinel stands in for missing endpoints
+    constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+    constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    uint64_t hash = FNV_OFFSET;
+    auto mix = [&hash](uint32_t value) {
+        for (int byte = 0; byte < 4; byte++) {
+            hash ^= (value >> (byte * 8)) & 0xFFu;
+            hash *= FNV_PRIME;
+        }
+    };
+
+    mix(static_cast<uint32_t>(gates_.size()));
+    mix(static_cast<uint32_t>(wires_.size()));
+    for (const Gate* gate : gates_) {
+        mix(static_cast<uint32_t>(gate->get_type()));
+        mix(static_cast<uint32_t>(gate->get_inputs().size()));
+        for (const Wire* input : gate->get_inputs()) {
+            mix(input->get_id());
+        }
+        const Wire* output = gate->get_output();
+        mix(output != nullptr ? output->get_id() : NONE);
+    }
+    mix(static_cast<uint32_t>(input_wires_.size()));
+    for (const Wire* wire : input_wires_) {
+        mix(wire->get_id());
+    }
+    mix(static_cast<uint32_t>(output_wires_.size()));
+    for (const Wire* wire : output_wires_) {
+        mix(wire->get_id());
+    }
+    return hash;
+}
+
+MemoryUsage Circuit::memory_usage() const {
+    MemoryUsage usage;
+    usage.add("gates", storage_->gate_arena.heap_bytes(), storage_->gate_arena.heap_allocations());
+    usage.add("wires", storage_->wire_arena.heap_bytes(), storage_->wire_arena.heap_allocations());
+    usage.add("gate inputs", storage_->input_lists.heap_bytes(),
+              storage_->input_lists.heap_allocations());
+    usage.add("wire destinations", storage_->destination_lists.heap_bytes(),
+              storage_->destination_lists.heap_allocations());
+
+    usage.add("netlist", sizeof(Storage), 1);
+    usage.add_vector("netlist", gates_);
+    usage.add_vector("netlist", wires_);
+    usage.add_vector("netlist", input_wires_);
+    usage.add_vector("netlist", output_wires_);
+    usage.add_vector("netlist", topo_order_);
+    usage.add_vector("netlist", gate_instances_);
+    usage.add_vector("netlist", instance_modules_);
+    for (const std::string& module : instance_modules_) {
+        usage.add_string("netlist", module);
+    }
+    for (const std::vector<Bus>* buses : {&input_buses_, &output_buses_}) {
+        usage.add_vector("netlist", *buses);
+        for (const Bus& bus : *buses) {
+            usage.add_string("netlist", bus.name);
+        }
+    }
+
+    const CompiledNetlist& net = compiled_;
+    usage.add_vector("compiled netlist", net.types);
+    usage.add_vector("compiled netlist", net.gate_ids);
+    usage.add_vector("compiled netlist", net.outputs);
+    usage.add_vector("compiled netlist", net.input_offsets);
+    usage.add_vector("compiled netlist", net.input_wires);
+    usage.add_vector("compiled netlist", net.level_offsets);
+    usage.add_vector("compiled netlist", net.gate_levels);
+    usage.add_vector("compiled netlist", net.runs);
+    usage.add_vector("compiled netlist", net.level_runs);
+    usage.add_vector("compiled netlist", net.fanout_offsets);
+    usage.add_vector("compiled netlist", net.fanout_slots);
+
+    usage.add_vector("signal state", wire_values_);
+    usage.add_vector("signal state", gate_states_);
+    usage.add_vector("signal state", packed_values_);
+    usage.add_vector("signal state", settle_wires_);
+    usage.add_vector("signal state", slot_dirty_);
+    usage.add_nested("signal state", dirty_levels_);
+    return usage;
+}
+
 } // namespace gateflow
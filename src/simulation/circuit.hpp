@@ -3,11 +3,17 @@
 /// @file circuit.hpp
 /// @brief Circuit model — owns gates and wires, provides topological propagation
 
+#include "simulation/arena.hpp"
+#include "simulation/compiled_netlist.hpp"
 #include "simulation/gate.hpp"
+#include "simulation/lane_block.hpp"
+#include "simulation/memory_usage.hpp"
+#include "simulation/thread_pool.hpp"
 #include "simulation/wire.hpp"
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace gateflow {
@@ -16,6 +22,15 @@ namespace gateflow {
 struct PropagationResult {
     std::vector<Gate*> changed_gates;
     std::vector<Wire*> changed_wires;
+    size_t gates_evaluated = 0; ///< Dirty gates re-evaluated (activity, not circuit size)
+};
+
+/// A named run of consecutive primary inputs or outputs, least significant
+/// bit first (bit i is port first + i)
+struct Bus {
+    std::string name;
+    size_t first = 0;
+    size_t width = 0;
 };
 
 /// A circuit is a directed acyclic graph of gates and wires.
@@ -28,6 +43,13 @@ struct PropagationResult {
 ///   5. Call finalize() to compute topological order
 ///
 /// After finalization, call set_input() and propagate() to simulate.
+/// Propagation runs over the levelized CompiledNetlist built by finalize();
+/// the Gate/Wire objects are kept in sync for rendering and inspection.
+/// It is event-driven: set_input() marks the changed wire's readers dirty,
+/// and propagate() only re-evaluates dirty gates, level by level, marking a
+/// gate's readers in turn only when its output actually changes. The first
+/// pass after finalize() evaluates every gate.
+/// Adding gates, wires or connections clears the finalized state.
 class Circuit {
   public:
     Circuit() = default;
@@ -38,8 +60,17 @@ class Circuit {
     Circuit(Circuit&&) = default;
     Circuit& operator=(Circuit&&) = default;
 
+    /// Instance of gates that belong to no module instance
+    static constexpr uint32_t NO_INSTANCE = UINT32_MAX;
+
     /// Creates a new gate in this circuit and returns a non-owning pointer
-    Gate* add_gate(GateType type);
+    /// @param instance Module instance the gate belongs to (see add_instance())
+    /// @throws std::invalid_argument if @p instance is not NO_INSTANCE or an instance id
+    Gate* add_gate(GateType type, uint32_t instance = NO_INSTANCE);
+
+    /// Registers an instance of the module named @p module and returns its
+    /// id (dense, from 0). Gates join it through add_gate(); see instantiate().
+    uint32_t add_instance(std::string module);
 
     /// Creates a new wire in this circuit and returns a non-owning pointer
     Wire* add_wire();
@@ -50,51 +81,253 @@ class Circuit {
     /// @param destination The gate receiving this wire
     void connect(Wire* wire, Gate* source, Gate* destination);
 
+    /// Reserves room for @p gates gates and @p wires wires in total, for
+    /// passes that know the size of the circuit they emit
+    void reserve(size_t gates, size_t wires);
+
     /// Marks a wire as a primary input (ordered; index matters for bit position)
     void mark_input(Wire* wire);
 
     /// Marks a wire as a primary output (ordered; index matters for bit position)
     void mark_output(Wire* wire);
 
-    /// Computes topological order. Must be called after all connections are made.
-    /// @throws std::runtime_error if the circuit contains a cycle
+    /// Deep-copies the circuit: gates, wires and their connections (by id,
+    /// in the same order), module instances, buses, signal values, and — if
+    /// finalized — the compiled netlist and pending dirty state, so the copy
+    /// needs no finalize().
+    /// A thread pool is not shared: the copy gets its own with the same settings.
+    [[nodiscard]] std::unique_ptr<Circuit> clone() const;
+
+    /// Computes topological order and builds the compiled netlist.
+    /// Must be called after all connections are made. When gate ids already
+    /// are a topological order (every builder and pass here emits gates after
+    /// their sources), id order is used and the sort is skipped.
+    /// @throws std::invalid_argument if a gate has the wrong number of inputs for its type
+    /// @throws std::runtime_error if the circuit contains a cycle, or a gate has
+    ///         more than MAX_GATE_INPUTS inputs
     void finalize();
 
+    /// Finalizes with a compiled netlist built earlier for this exact
+    /// structure (e.g. one stored in a netlist file), skipping the sort and
+    /// levelization. The netlist is checked against the gates with
+    /// validate_compiled_netlist() before it is adopted.
+    /// @throws std::invalid_argument as finalize() does
+    /// @throws std::runtime_error as finalize() does, or if @p compiled does
+    ///         not match the circuit
+    void finalize(CompiledNetlist compiled);
+
     /// Sets the value of the i-th primary input wire
     void set_input(size_t index, bool value);
 
-    /// Evaluates all gates in topological order, propagating signals from
-    /// inputs to outputs. Returns which gates/wires changed.
+    /// Re-evaluates the dirty gates in level order, propagating changed
+    /// signals from inputs to outputs. Returns which gates/wires changed,
+    /// in slot order — the same lists a full evaluation would produce.
     [[nodiscard]] PropagationResult propagate();
 
+    /// Same as propagate(), but fills a caller-owned result. Its vectors are
+    /// cleared and reused, so repeated passes allocate nothing once their
+    /// capacity has grown to the circuit's activity.
+    void propagate(PropagationResult& result);
+
     /// Read the value of the i-th primary output wire
     [[nodiscard]] bool get_output(size_t index) const;
 
+    // --- Word-level I/O ---
+    //
+    // Buses group ports into numbers, so an N-bit operand is set or read in
+    // one call instead of N set_input()/get_output() calls. They behave
+    // exactly like the per-bit calls (only changed inputs mark readers dirty).
+
+    /// Names primary inputs [first, first + width) as a bus
+    /// @throws std::invalid_argument if the range is empty or past num_inputs(),
+    ///         or an input bus of that name exists
+    void add_input_bus(std::string name, size_t first, size_t width);
+
+    /// Names primary outputs [first, first + width) as a bus
+    /// @throws std::invalid_argument as add_input_bus() does, for outputs
+    void add_output_bus(std::string name, size_t first, size_t width);
+
+    /// Index of the input bus called @p name, for the index overloads
+    /// @throws std::invalid_argument if there is none
+    [[nodiscard]] size_t find_input_bus(const std::string& name) const;
+    /// Index of the output bus called @p name
+    /// @throws std::invalid_argument if there is none
+    [[nodiscard]] size_t find_output_bus(const std::string& name) const;
+
+    /// Sets an input bus to the low bits of @p value (bits past 64 are 0;
+    /// bits of @p value past the width are ignored)
+    /// @throws std::out_of_range for an unknown bus index
+    void set_bus(size_t bus, uint64_t value);
+    void set_bus(const std::string& name, uint64_t value) { set_bus(find_input_bus(name), value); }
+
+    /// The low 64 bits of an output bus
+    /// @throws std::out_of_range for an unknown bus index
+    [[nodiscard]] uint64_t read_bus(size_t bus) const;
+    [[nodiscard]] uint64_t read_bus(const std::string& name) const {
+        return read_bus(find_output_bus(name));
+    }
+
+    /// Sets every primary input from a bit array: input i is bit i % 64 of
+    /// @p words[i / 64], so @p words holds (num_inputs() + 63) / 64 words
+    void set_inputs(const uint64_t* words);
+
+    /// Writes every primary output into a bit array laid out as set_inputs()'s
+    /// (num_outputs() bits; bits past them in the last word are 0)
+    void read_outputs(uint64_t* words) const;
+
+    [[nodiscard]] const std::vector<Bus>& input_buses() const { return input_buses_; }
+    [[nodiscard]] const std::vector<Bus>& output_buses() const { return output_buses_; }
+
+    // --- Bit-parallel (64-lane) simulation ---
+    //
+    // Each wire carries a 64-bit word; bit k is the wire's value in input
+    // vector k. One propagate_packed() pass therefore simulates 64 vectors.
+    // Packed state is independent of the scalar set_input()/propagate() state
+    // and does not touch the Gate/Wire objects. For wider blocks, see
+    // LaneSimulator in lane_simulator.hpp.
+
+    /// Sets the 64 lanes of the i-th primary input wire
+    void set_input_packed(size_t index, uint64_t lanes);
+
+    /// Evaluates all gates in level order over the packed wire words
+    void propagate_packed();
+
+    /// Reads the 64 lanes of the i-th primary output wire
+    [[nodiscard]] uint64_t get_output_packed(size_t index) const;
+
+    // --- Parallel evaluation ---
+    //
+    // Gates within a level are independent, so the full-pass packed and lane
+    // paths can split large levels across threads. The scalar propagate()
+    // stays serial: it only visits the few gates an edit disturbs.
+
+    /// Default minimum level size (in gates) worth splitting across threads
+    static constexpr size_t DEFAULT_PARALLEL_LEVEL_SLOTS = 4096;
+
+    /// Gives the circuit a thread pool for propagate_packed() and for every
+    /// LaneSimulator on this circuit. Levels smaller than @p min_level_slots
+    /// still run serially, so small circuits pay no synchronization cost.
+    /// @param threads Total threads including the caller; 0 = hardware
+    ///        concurrency, 1 = serial (drops the pool)
+    void set_parallelism(size_t threads, size_t min_level_slots = DEFAULT_PARALLEL_LEVEL_SLOTS);
+
+    /// The pool set by set_parallelism(), or nullptr when serial
+    [[nodiscard]] ThreadPool* thread_pool() const { return thread_pool_.get(); }
+    [[nodiscard]] size_t min_parallel_level_slots() const { return min_parallel_level_slots_; }
+
     // --- Accessors ---
-    [[nodiscard]] const std::vector<std::unique_ptr<Gate>>& gates() const { return gates_; }
-    [[nodiscard]] const std::vector<std::unique_ptr<Wire>>& wires() const { return wires_; }
-    [[nodiscard]] std::vector<std::unique_ptr<Gate>>& gates() { return gates_; }
-    [[nodiscard]] std::vector<std::unique_ptr<Wire>>& wires() { return wires_; }
+    /// All gates, indexed by id (storage is owned by the circuit's arena)
+    [[nodiscard]] const std::vector<Gate*>& gates() const { return gates_; }
+    /// All wires, indexed by id (storage is owned by the circuit's arena)
+    [[nodiscard]] const std::vector<Wire*>& wires() const { return wires_; }
     [[nodiscard]] const std::vector<Wire*>& input_wires() const { return input_wires_; }
     [[nodiscard]] const std::vector<Wire*>& output_wires() const { return output_wires_; }
+    /// Gates in level order (a valid topological order; see CompiledNetlist)
     [[nodiscard]] const std::vector<Gate*>& topological_order() const { return topo_order_; }
+    /// Levelized index-based netlist (empty until finalize())
+    [[nodiscard]] const CompiledNetlist& compiled() const { return compiled_; }
+    [[nodiscard]] bool is_finalized() const { return finalized_; }
     [[nodiscard]] size_t num_inputs() const { return input_wires_.size(); }
     [[nodiscard]] size_t num_outputs() const { return output_wires_.size(); }
 
+    /// Module instance a gate was added to, or NO_INSTANCE
+    [[nodiscard]] uint32_t instance_of(const Gate* gate) const {
+        return gate_instances_[gate->get_id()];
+    }
+    [[nodiscard]] size_t num_instances() const { return instance_modules_.size(); }
+    /// Module name of an instance (as passed to add_instance())
+    [[nodiscard]] const std::string& instance_module(uint32_t instance) const {
+        return instance_modules_[instance];
+    }
+
+    /// Hash of the circuit's structure: gate types, connections and the
+    /// ordered input/output wires, all by id. Signal values are excluded, so
+    /// two circuits built the same way hash equal regardless of their state.
+    [[nodiscard]] uint64_t structural_hash() const;
+
+    /// Heap memory by category: "gates" and "wires" (the object arenas),
+    /// "gate inputs" and "wire destinations" (the pooled pointer lists),
+    /// "netlist" (id, I/O, order, instance and bus tables), "compiled
+    /// netlist" (the CompiledNetlist arrays) and "signal state" (scalar,
+    /// packed and dirty-tracking state). The thread pool is not counted.
+    [[nodiscard]] MemoryUsage memory_usage() const;
+
   private:
     /// Validates bidirectional connectivity invariants between gates and wires.
     /// @throws std::runtime_error if an inconsistent link is found.
     void validate_connectivity() const;
 
+    /// True if every gate's driven inputs come from gates with lower ids
+    [[nodiscard]] bool ids_are_topological() const;
+
+    /// Checks connectivity and every gate's arity (the first step of finalize)
+    void validate_structure() const;
+
+    /// Seeds topological_order() and the propagation state from compiled_,
+    /// leaving everything dirty, and marks the circuit finalized
+    void adopt_compiled();
+
+    /// set_input() without the bounds check
+    void write_input(Wire* wire, bool value);
+
+    /// Queues a slot for re-evaluation on the next propagate()
+    void mark_dirty(uint32_t slot);
+
+    /// Queues every slot reading the given wire id
+    void mark_readers_dirty(uint32_t wire_id);
+
+    /// Evaluates one slot from wire_values_ with the kernel for its run's
+    /// (type, arity), recording changes in @p result. With WakeReaders, a
+    /// changed output queues the slots reading it.
+    template <GateType Type, size_t Arity, bool WakeReaders>
+    void evaluate_slot(uint32_t slot, PropagationResult& result);
+
+    /// Evaluates every slot of a run (full pass), dispatching on its kernel once
+    void evaluate_run(const GateRun& run, PropagationResult& result);
+
+    /// Evaluates the sorted dirty slots in [@p first, @p last) that fall in
+    /// @p run, dispatching once. Returns the first slot past the run.
+    const uint32_t* evaluate_dirty_run(const GateRun& run, const uint32_t* first,
+                                       const uint32_t* last, PropagationResult& result);
+
     uint32_t next_gate_id_ = 0;
     uint32_t next_wire_id_ = 0;
 
-    std::vector<std::unique_ptr<Gate>> gates_;
-    std::vector<std::unique_ptr<Wire>> wires_;
+    /// Backing storage for gates, wires and their pointer lists. Held by
+    /// pointer so addresses survive moves of the Circuit.
+    struct Storage {
+        ChunkedArena<Gate> gate_arena;
+        ChunkedArena<Wire> wire_arena;
+        PointerListPool<Wire> input_lists;
+        PointerListPool<Gate> destination_lists;
+    };
+
+    std::unique_ptr<Storage> storage_ = std::make_unique<Storage>();
+    std::vector<Gate*> gates_;
+    std::vector<Wire*> wires_;
     std::vector<Wire*> input_wires_;
     std::vector<Wire*> output_wires_;
     std::vector<Gate*> topo_order_;
+    std::vector<uint32_t> gate_instances_;      ///< Module instance per gate id
+    std::vector<std::string> instance_modules_; ///< Module name per instance id
+    std::vector<Bus> input_buses_;
+    std::vector<Bus> output_buses_;
     bool finalized_ = false;
+
+    // --- Compiled simulation state (built by finalize) ---
+    CompiledNetlist compiled_;
+    std::vector<uint8_t> wire_values_; ///< Current value per wire id
+    std::vector<uint8_t> gate_states_; ///< Current output state per slot
+    std::vector<LaneBlock<1>> packed_values_; ///< 64-lane value per wire id
+    std::vector<Wire*> settle_wires_;  ///< Wires changed last pass (previous_value to settle)
+    std::vector<uint8_t> slot_dirty_;  ///< Pending re-evaluation per slot
+    std::vector<std::vector<uint32_t>> dirty_levels_; ///< Dirty slots bucketed by level
+    size_t dirty_count_ = 0;           ///< Total slots across dirty_levels_
+    size_t dirty_min_level_ = 0;       ///< Lowest level with a dirty slot (if any)
+    bool full_pass_pending_ = false;   ///< Next propagate() evaluates every slot
+
+    std::unique_ptr<ThreadPool> thread_pool_; ///< Optional; see set_parallelism()
+    size_t min_parallel_level_slots_ = DEFAULT_PARALLEL_LEVEL_SLOTS;
 };
 
 } // namespace gateflow
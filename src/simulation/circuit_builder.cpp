@@ -3,10 +3,121 @@
 
 #include "simulation/circuit_builder.hpp"
 
+#include "simulation/module.hpp"
+#include "simulation/nand_decompose.hpp"
+
+#include <algorithm>
+#include <initializer_list>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace gateflow {
 
+namespace {
+
+/// Adds a gate reading @p inputs and returns its new output wire
+Wire* add_gate_output(Circuit& circuit, GateType type, std::initializer_list<Wire*> inputs) {
+    Gate* gate = circuit.add_gate(type);
+    for (Wire* input : inputs) {
+        circuit.connect(input, nullptr, gate);
+    }
+    Wire* out = circuit.add_wire();
+    circuit.connect(out, gate, nullptr);
+    return out;
+}
+
+/// Operand inputs and per-bit propagate (A XOR B) / generate (A AND B) signals
+/// shared by the carry-lookahead style adders
+struct AdderBits {
+    std::vector<Wire*> p;
+    std::vector<Wire*> g;
+};
+
+/// Adds A[0..bits-1] and B[0..bits-1] as inputs 0..2*bits-1, then one XOR and
+/// one AND per bit position
+AdderBits add_operands(Circuit& circuit, int bits, const char* name) {
+    if (bits < 1) {
+        throw std::invalid_argument(std::string(name) + " requires at least 1 bit");
+    }
+    std::vector<Wire*> a_wires(bits);
+    std::vector<Wire*> b_wires(bits);
+    for (int i = 0; i < bits; i++) {
+        a_wires[i] = circuit.add_wire();
+        circuit.mark_input(a_wires[i]);
+    }
+    for (int i = 0; i < bits; i++) {
+        b_wires[i] = circuit.add_wire();
+        circuit.mark_input(b_wires[i]);
+    }
+
+    AdderBits ab;
+    ab.p.resize(bits);
+    ab.g.resize(bits);
+    for (int i = 0; i < bits; i++) {
+        ab.p[i] = add_gate_output(circuit, GateType::XOR, {a_wires[i], b_wires[i]});
+        ab.g[i] = add_gate_output(circuit, GateType::AND, {a_wires[i], b_wires[i]});
+    }
+    return ab;
+}
+
+/// Builds a parallel-prefix adder from a list of (high, low) prefix cells.
+///
+/// Each bit i starts with the group (g_i, p_i) covering bit i alone. A cell
+/// (i, j) with j < i merges bit j's group into bit i's:
+///   G_i = G_i OR (P_i AND G_j),   P_i = P_i AND P_j
+/// The group propagate is only built while the merged group has not reached
+/// bit 0 yet — once it has, G_i is the carry into bit i+1 and P_i is dead.
+/// The cells must leave every group reaching bit 0.
+std::unique_ptr<Circuit> build_prefix_adder(int bits, const char* name,
+                                            const std::vector<std::pair<int, int>>& cells) {
+    auto circuit = std::make_unique<Circuit>();
+    AdderBits ab = add_operands(*circuit, bits, name);
+
+    std::vector<Wire*> group_g = ab.g;
+    std::vector<Wire*> group_p = ab.p;
+    std::vector<int> lowest(bits); // Lowest bit covered by each group
+    for (int i = 0; i < bits; i++) {
+        lowest[i] = i;
+    }
+
+    for (auto [i, j] : cells) {
+        Wire* carried = add_gate_output(*circuit, GateType::AND, {group_p[i], group_g[j]});
+        group_g[i] = add_gate_output(*circuit, GateType::OR, {group_g[i], carried});
+        if (lowest[j] > 0) {
+            group_p[i] = add_gate_output(*circuit, GateType::AND, {group_p[i], group_p[j]});
+        }
+        lowest[i] = lowest[j];
+    }
+
+    // Sum[i] = p_i XOR carry-in, where the carry into bit i is G[i-1..0]
+    circuit->mark_output(ab.p[0]);
+    for (int i = 1; i < bits; i++) {
+        circuit->mark_output(add_gate_output(*circuit, GateType::XOR, {ab.p[i], group_g[i - 1]}));
+    }
+    circuit->mark_output(group_g[bits - 1]); // index bits = carry-out
+    add_adder_buses(*circuit);
+
+    circuit->finalize();
+    return circuit;
+}
+
+} // namespace
+
+void add_adder_buses(Circuit& circuit) {
+    const size_t bits = circuit.num_inputs() / 2;
+    if (bits == 0 || circuit.num_inputs() != 2 * bits || circuit.num_outputs() != bits + 1) {
+        throw std::invalid_argument("Adder buses need 2N inputs and N + 1 outputs, got " +
+                                    std::to_string(circuit.num_inputs()) + " and " +
+                                    std::to_string(circuit.num_outputs()));
+    }
+    circuit.add_input_bus("A", 0, bits);
+    circuit.add_input_bus("B", bits, bits);
+    circuit.add_output_bus("Sum", 0, bits);
+    circuit.add_output_bus("Cout", bits, 1);
+}
+
 std::unique_ptr<Circuit> build_half_adder() {
     auto circuit = std::make_unique<Circuit>();
 
@@ -24,12 +135,11 @@ std::unique_ptr<Circuit> build_half_adder() {
     Wire* wire_sum = circuit->add_wire();
     Wire* wire_carry = circuit->add_wire();
 
-    // Connect inputs to XOR gate
+    // Fan A and B in to both gates, A first
     circuit->connect(wire_a, nullptr, xor_gate);
-    circuit->connect(wire_b, nullptr, and_gate);
-    // Also fan-in A and B to both gates
     circuit->connect(wire_b, nullptr, xor_gate);
     circuit->connect(wire_a, nullptr, and_gate);
+    circuit->connect(wire_b, nullptr, and_gate);
 
     // Connect gate outputs
     circuit->connect(wire_sum, xor_gate, nullptr);
@@ -98,11 +208,19 @@ std::unique_ptr<Circuit> build_full_adder() {
     return circuit;
 }
 
-std::unique_ptr<Circuit> build_ripple_carry_adder(int bits) {
+std::unique_ptr<Circuit> build_ripple_carry_adder(int bits, bool nand_only) {
     if (bits < 1) {
         throw std::invalid_argument("Ripple-carry adder requires at least 1 bit");
     }
 
+    // One definition per cell, shared by every instance
+    std::unique_ptr<Circuit> half_adder = build_half_adder();
+    std::unique_ptr<Circuit> full_adder = build_full_adder();
+    if (nand_only) {
+        decompose_to_nand(*half_adder);
+        decompose_to_nand(*full_adder);
+    }
+
     auto circuit = std::make_unique<Circuit>();
 
     // Create input wires: A[0..bits-1], B[0..bits-1]
@@ -118,67 +236,18 @@ std::unique_ptr<Circuit> build_ripple_carry_adder(int bits) {
         circuit->mark_input(b_wires[i]); // indices bits..2*bits-1
     }
 
-    // Build chain of full adders
+    // Chain of adder instances, one per bit: bit 0 is a half adder (no
+    // carry-in), every later bit a full adder fed by the previous carry
     std::vector<Wire*> sum_wires(bits);
-    Wire* carry_in = nullptr; // First adder has no carry-in (implicitly 0)
+    Wire* carry_in = nullptr;
 
     for (int i = 0; i < bits; i++) {
-        if (i == 0) {
-            // First bit: use a half adder (no carry-in)
-            Gate* xor_gate = circuit->add_gate(GateType::XOR);
-            Gate* and_gate = circuit->add_gate(GateType::AND);
-
-            Wire* sum_out = circuit->add_wire();
-            Wire* carry_out = circuit->add_wire();
-
-            circuit->connect(a_wires[i], nullptr, xor_gate);
-            circuit->connect(b_wires[i], nullptr, xor_gate);
-            circuit->connect(a_wires[i], nullptr, and_gate);
-            circuit->connect(b_wires[i], nullptr, and_gate);
-            circuit->connect(sum_out, xor_gate, nullptr);
-            circuit->connect(carry_out, and_gate, nullptr);
-
-            sum_wires[i] = sum_out;
-            carry_in = carry_out;
-        } else {
-            // Subsequent bits: full adder with carry chain
-            // Half adder 1: A[i] XOR B[i], A[i] AND B[i]
-            Gate* xor1 = circuit->add_gate(GateType::XOR);
-            Gate* and1 = circuit->add_gate(GateType::AND);
-            Wire* xor1_out = circuit->add_wire();
-            Wire* and1_out = circuit->add_wire();
-
-            circuit->connect(a_wires[i], nullptr, xor1);
-            circuit->connect(b_wires[i], nullptr, xor1);
-            circuit->connect(a_wires[i], nullptr, and1);
-            circuit->connect(b_wires[i], nullptr, and1);
-            circuit->connect(xor1_out, xor1, nullptr);
-            circuit->connect(and1_out, and1, nullptr);
-
-            // Half adder 2: (A XOR B) XOR Cin, (A XOR B) AND Cin
-            Gate* xor2 = circuit->add_gate(GateType::XOR);
-            Gate* and2 = circuit->add_gate(GateType::AND);
-            Wire* sum_out = circuit->add_wire();
-            Wire* and2_out = circuit->add_wire();
-
-            circuit->connect(xor1_out, nullptr, xor2);
-            circuit->connect(carry_in, nullptr, xor2);
-            circuit->connect(xor1_out, nullptr, and2);
-            circuit->connect(carry_in, nullptr, and2);
-            circuit->connect(sum_out, xor2, nullptr);
-            circuit->connect(and2_out, and2, nullptr);
-
-            // OR gate: carry-out
-            Gate* or_gate = circuit->add_gate(GateType::OR);
-            Wire* carry_out = circuit->add_wire();
-
-            circuit->connect(and1_out, nullptr, or_gate);
-            circuit->connect(and2_out, nullptr, or_gate);
-            circuit->connect(carry_out, or_gate, nullptr);
-
-            sum_wires[i] = sum_out;
-            carry_in = carry_out;
-        }
+        std::vector<Wire*> outs =
+            i == 0 ? instantiate(*circuit, *half_adder, "half_adder", {a_wires[i], b_wires[i]})
+                   : instantiate(*circuit, *full_adder, "full_adder",
+                                 {a_wires[i], b_wires[i], carry_in});
+        sum_wires[i] = outs[0];
+        carry_in = outs[1];
     }
 
     // Mark outputs: Sum[0..bits-1], then final carry-out
@@ -186,9 +255,103 @@ std::unique_ptr<Circuit> build_ripple_carry_adder(int bits) {
         circuit->mark_output(sum_wires[i]);
     }
     circuit->mark_output(carry_in); // index bits = carry-out (8th bit for 7-bit adder)
+    add_adder_buses(*circuit);
 
     circuit->finalize();
     return circuit;
 }
 
+std::unique_ptr<Circuit> build_kogge_stone_adder(int bits) {
+    // Stage d merges every bit i >= d with bit i - d
+    std::vector<std::pair<int, int>> cells;
+    for (int d = 1; d < bits; d *= 2) {
+        for (int i = bits - 1; i >= d; i--) {
+            cells.emplace_back(i, i - d);
+        }
+    }
+    return build_prefix_adder(bits, "Kogge-Stone adder", cells);
+}
+
+std::unique_ptr<Circuit> build_brent_kung_adder(int bits) {
+    std::vector<std::pair<int, int>> cells;
+    // Up-sweep: bit i = k*2d - 1 gathers the 2d bits ending at i
+    int top = 1;
+    for (int d = 1; d < bits; d *= 2) {
+        for (int i = 2 * d - 1; i < bits; i += 2 * d) {
+            cells.emplace_back(i, i - d);
+        }
+        top = d;
+    }
+    // Down-sweep: fill in the bits between the tree's completed groups
+    for (int d = top / 2; d >= 1; d /= 2) {
+        for (int i = 3 * d - 1; i < bits; i += 2 * d) {
+            cells.emplace_back(i, i - d);
+        }
+    }
+    return build_prefix_adder(bits, "Brent-Kung adder", cells);
+}
+
+std::unique_ptr<Circuit> build_carry_select_adder(int bits, int block_bits) {
+    if (block_bits < 1) {
+        throw std::invalid_argument("Carry-select block size must be at least 1 bit");
+    }
+    auto circuit = std::make_unique<Circuit>();
+    AdderBits ab = add_operands(*circuit, bits, "Carry-select adder");
+    Circuit& c = *circuit;
+
+    // One ripple step given the carry into bit i; returns the carry out
+    auto ripple = [&](int i, Wire* carry) {
+        Wire* carried = add_gate_output(c, GateType::AND, {ab.p[i], carry});
+        return add_gate_output(c, GateType::OR, {ab.g[i], carried});
+    };
+
+    std::vector<Wire*> sum_wires(bits);
+
+    // First block: a plain ripple chain with carry-in 0
+    const int first_end = std::min(block_bits, bits);
+    sum_wires[0] = ab.p[0];
+    Wire* carry = ab.g[0];
+    for (int i = 1; i < first_end; i++) {
+        sum_wires[i] = add_gate_output(c, GateType::XOR, {ab.p[i], carry});
+        carry = ripple(i, carry);
+    }
+
+    for (int start = first_end; start < bits; start += block_bits) {
+        const int end = std::min(start + block_bits, bits);
+
+        // Bit `start` sees the block carry-in directly: no select needed
+        sum_wires[start] = add_gate_output(c, GateType::XOR, {ab.p[start], carry});
+
+        // Speculative carries out of bit `start` for carry-in 0 and 1
+        Wire* carry0 = ab.g[start];
+        Wire* carry1 = add_gate_output(c, GateType::OR, {ab.g[start], ab.p[start]});
+        Wire* not_carry = (end - start > 1) ? add_gate_output(c, GateType::NOT, {carry}) : nullptr;
+
+        for (int i = start + 1; i < end; i++) {
+            Wire* sum0 = add_gate_output(c, GateType::XOR, {ab.p[i], carry0});
+            Wire* sum1 = add_gate_output(c, GateType::XOR, {ab.p[i], carry1});
+            carry0 = ripple(i, carry0);
+            carry1 = ripple(i, carry1);
+
+            // Sum = carry ? sum1 : sum0
+            Wire* pick1 = add_gate_output(c, GateType::AND, {sum1, carry});
+            Wire* pick0 = add_gate_output(c, GateType::AND, {sum0, not_carry});
+            sum_wires[i] = add_gate_output(c, GateType::OR, {pick1, pick0});
+        }
+
+        // carry1 >= carry0, so the block carry-out is carry0 OR (carry1 AND carry)
+        Wire* selected = add_gate_output(c, GateType::AND, {carry1, carry});
+        carry = add_gate_output(c, GateType::OR, {carry0, selected});
+    }
+
+    for (int i = 0; i < bits; i++) {
+        c.mark_output(sum_wires[i]);
+    }
+    c.mark_output(carry); // index bits = carry-out
+    add_adder_buses(c);
+
+    c.finalize();
+    return circuit;
+}
+
 } // namespace gateflow
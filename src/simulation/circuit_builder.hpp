@@ -9,6 +9,12 @@
 
 namespace gateflow {
 
+/// Names the ports of an N-bit adder laid out like the ones built here:
+/// input buses "A" and "B", output buses "Sum" (N bits) and "Cout" (1 bit).
+/// Every adder builder calls it; use it on adders loaded from files.
+/// @throws std::invalid_argument unless the circuit has 2N inputs and N + 1 outputs
+void add_adder_buses(Circuit& circuit);
+
 /// Builds a half adder circuit.
 /// Inputs: A (index 0), B (index 1)
 /// Outputs: Sum (index 0), Carry (index 1)
@@ -25,6 +31,36 @@ namespace gateflow {
 /// Outputs: Sum[0..N-1] (indices 0..N-1), Carry-out (index N)
 ///
 /// For a 7-bit adder: 14 inputs, 8 outputs (7 sum bits + carry-out)
-[[nodiscard]] std::unique_ptr<Circuit> build_ripple_carry_adder(int bits);
+/// Ports are named with add_adder_buses().
+///
+/// Bit 0 is an instance of build_half_adder() ("half_adder"), every later
+/// bit an instance of build_full_adder() ("full_adder"); see instantiate().
+/// With @p nand_only the two definitions are decomposed to NAND gates once,
+/// before stamping, instead of decomposing every instance afterwards.
+[[nodiscard]] std::unique_ptr<Circuit> build_ripple_carry_adder(int bits, bool nand_only = false);
+
+/// Builds a Kogge-Stone parallel-prefix adder for N-bit inputs.
+/// Same input/output indices as build_ripple_carry_adder().
+///
+/// Every bit combines (generate, propagate) pairs at distances 1, 2, 4, ...,
+/// so the carry network is ceil(log2 N) cells deep at the cost of
+/// O(N log N) gates.
+[[nodiscard]] std::unique_ptr<Circuit> build_kogge_stone_adder(int bits);
+
+/// Builds a Brent-Kung parallel-prefix adder for N-bit inputs.
+/// Same input/output indices as build_ripple_carry_adder().
+///
+/// An up-sweep and a down-sweep tree compute all carries with O(N) cells
+/// in about 2*log2(N) cell levels — fewer gates than Kogge-Stone, roughly
+/// twice the depth.
+[[nodiscard]] std::unique_ptr<Circuit> build_brent_kung_adder(int bits);
+
+/// Builds a carry-select adder for N-bit inputs.
+/// Same input/output indices as build_ripple_carry_adder().
+///
+/// The operands are split into blocks of @p block_bits. Each block after the
+/// first ripples twice, assuming carry-in 0 and 1, and the real carry selects
+/// between the two results, so the carry only ripples through block muxes.
+[[nodiscard]] std::unique_ptr<Circuit> build_carry_select_adder(int bits, int block_bits = 4);
 
 } // namespace gateflow
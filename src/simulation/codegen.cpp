@@ -0,0 +1,174 @@
+/// @file codegen.cpp
+/// @brief Implements straight-line C++ evaluator generation from the compiled netlist
+
+#include "simulation/codegen.hpp"
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace gateflow {
+
+namespace {
+
+bool is_identifier(const std::string& name) {
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0])) != 0) {
+        return false;
+    }
+    for (char c : name) {
+        if (std::isalnum(static_cast<unsigned char>(c)) == 0 && c != '_') {
+            return false;
+        }
+    }
+    return true;
+}
+
+void append_wire(std::string& out, uint32_t wire) {
+    out += 'w';
+    out += std::to_string(wire);
+}
+
+/// "w3 OP w7 OP w9" over the inputs of @p slot
+void append_operands(std::string& out, const CompiledNetlist& net, uint32_t slot,
+                     const char* op) {
+    for (uint32_t k = net.input_offsets[slot]; k < net.input_offsets[slot + 1]; k++) {
+        if (k != net.input_offsets[slot]) {
+            out += op;
+        }
+        append_wire(out, net.input_wires[k]);
+    }
+}
+
+/// The right-hand side for @p slot, matching evaluate_packed()
+void append_expression(std::string& out, const CompiledNetlist& net, uint32_t slot) {
+    switch (net.types[slot]) {
+    case GateType::NOT:
+        out += '~';
+        append_operands(out, net, slot, "");
+        return;
+    case GateType::BUFFER:
+        append_operands(out, net, slot, "");
+        return;
+    case GateType::AND:
+        append_operands(out, net, slot, " & ");
+        return;
+    case GateType::NAND:
+        out += "~(";
+        append_operands(out, net, slot, " & ");
+        out += ')';
+        return;
+    case GateType::OR:
+        append_operands(out, net, slot, " | ");
+        return;
+    case GateType::XOR:
+        append_operands(out, net, slot, " ^ ");
+        return;
+    }
+    throw std::invalid_argument("Unknown gate type");
+}
+
+} // namespace
+
+std::string generate_evaluator(const Circuit& circuit, const std::string& function_name) {
+    if (!circuit.is_finalized()) {
+        throw std::runtime_error("Circuit must be finalized before generating an evaluator");
+    }
+    if (!is_identifier(function_name)) {
+        throw std::invalid_argument("Not a C identifier: \"" + function_name + "\"");
+    }
+    const CompiledNetlist& net = circuit.compiled();
+    const size_t num_wires = circuit.wires().size();
+
+    // Every wire is defined exactly once, before its first reader: by its
+    // driving gate, else by its primary input, else as the constant 0
+    std::vector<uint8_t> driven(num_wires, 0);
+    for (uint32_t out : net.outputs) {
+        if (out != NO_WIRE) {
+            driven[out] = 1;
+        }
+    }
+    std::vector<uint8_t> defined = driven;
+
+    char hash[19];
+    std::snprintf(hash, sizeof(hash), "0x%016llx",
+                  static_cast<unsigned long long>(circuit.structural_hash()));
+
+    std::string src;
+    src.reserve(64 + 32 * net.input_wires.size());
+    src += "// Generated by gateflow from a finalized circuit: " + std::to_string(net.num_gates()) +
+           " gates, " + std::to_string(num_wires) + " wires, " +
+           std::to_string(net.num_levels()) + " levels. Do not edit.\n\n";
+    src += "#include <cstdint>\n\n";
+    src += "extern \"C\" const uint32_t " + function_name +
+           "_num_inputs = " + std::to_string(circuit.num_inputs()) + ";\n";
+    src += "extern \"C\" const uint32_t " + function_name +
+           "_num_outputs = " + std::to_string(circuit.num_outputs()) + ";\n";
+    src += "extern \"C\" const uint64_t " + function_name + "_structural_hash = " + hash +
+           "ull;\n\n";
+    src += "extern \"C\" void " + function_name + "(const uint64_t* in, uint64_t* out) {\n";
+    // Keeps in/out referenced for circuits without inputs or outputs
+    src += "    (void)in;\n    (void)out;\n";
+
+    const std::vector<Wire*>& inputs = circuit.input_wires();
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const uint32_t wire = inputs[i]->get_id();
+        if (!defined[wire]) {
+            defined[wire] = 1;
+            src += "    const uint64_t ";
+            append_wire(src, wire);
+            src += " = in[" + std::to_string(i) + "];\n";
+        }
+    }
+    auto define_constant = [&](uint32_t wire) {
+        if (!defined[wire]) {
+            defined[wire] = 1;
+            src += "    const uint64_t ";
+            append_wire(src, wire);
+            src += " = 0;\n";
+        }
+    };
+    for (uint32_t wire : net.input_wires) {
+        define_constant(wire);
+    }
+    for (const Wire* wire : circuit.output_wires()) {
+        define_constant(wire->get_id());
+    }
+
+    for (size_t level = 0; level < net.num_levels(); level++) {
+        src += "    // Level " + std::to_string(level) + "\n";
+        for (uint32_t slot = net.level_offsets[level]; slot < net.level_offsets[level + 1];
+             slot++) {
+            if (net.outputs[slot] == NO_WIRE) {
+                continue;
+            }
+            src += "    const uint64_t ";
+            append_wire(src, net.outputs[slot]);
+            src += " = ";
+            append_expression(src, net, slot);
+            src += ";\n";
+        }
+    }
+
+    const std::vector<Wire*>& outputs = circuit.output_wires();
+    for (size_t o = 0; o < outputs.size(); o++) {
+        src += "    out[" + std::to_string(o) + "] = ";
+        append_wire(src, outputs[o]->get_id());
+        src += ";\n";
+    }
+    src += "}\n";
+    return src;
+}
+
+void save_evaluator(const Circuit& circuit, const std::string& function_name,
+                    const std::string& path) {
+    const std::string src = generate_evaluator(circuit, function_name);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(src.data(), static_cast<std::streamsize>(src.size()));
+    if (!out) {
+        throw std::runtime_error("Cannot write evaluator source " + path);
+    }
+}
+
+} // namespace gateflow
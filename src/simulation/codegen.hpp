@@ -0,0 +1,46 @@
+#pragma once
+
+/// @file codegen.hpp
+/// @brief Emits a finalized circuit as straight-line C++ over 64-lane words
+///
+/// The generated translation unit defines one extern "C" function per
+/// circuit, holding a single bitwise expression per gate in slot order
+/// (see CompiledNetlist), so the compiler sees every wire as a local
+/// and no netlist is walked at run time:
+///
+///   extern "C" void NAME(const uint64_t* inputs, uint64_t* outputs);
+///
+/// inputs[i] carries 64 vectors of primary input i, one per bit, exactly as
+/// Circuit::set_input_packed(i, ...) would; outputs[o] receives what
+/// Circuit::get_output_packed(o) reads after propagate_packed(). Wires that
+/// are neither driven nor primary inputs read as 0 in every lane.
+///
+/// Alongside it, NAME_num_inputs, NAME_num_outputs (uint32_t) and
+/// NAME_structural_hash (uint64_t) are defined with C linkage, so a caller
+/// that links or loads the code can check it was generated from the circuit
+/// it means to evaluate. The source depends on nothing but <cstdint>, and
+/// builds natively or with Emscripten alike.
+
+#include "simulation/circuit.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace gateflow {
+
+/// Signature of a generated evaluator
+using GeneratedEvaluator = void (*)(const uint64_t* inputs, uint64_t* outputs);
+
+/// Generates the evaluator source for @p circuit.
+/// @param function_name C identifier of the generated function (and prefix of its constants)
+/// @throws std::runtime_error if the circuit is not finalized
+/// @throws std::invalid_argument if @p function_name is not a C identifier
+[[nodiscard]] std::string generate_evaluator(const Circuit& circuit,
+                                             const std::string& function_name);
+
+/// Writes generate_evaluator() to @p path.
+/// @throws std::runtime_error if the file cannot be written
+void save_evaluator(const Circuit& circuit, const std::string& function_name,
+                    const std::string& path);
+
+} // namespace gateflow
@@ -0,0 +1,266 @@
+/// @file compiled_netlist.cpp
+/// @brief Levelization and CSR packing of a circuit's topology
+
+#include "simulation/compiled_netlist.hpp"
+
+#include "simulation/wire.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+
+namespace gateflow {
+
+namespace {
+
+/// Input counts are grouped as 0, 1, 2 and "3 or more" for run sorting
+constexpr size_t ARITY_CLASSES = 4;
+constexpr size_t GATE_TYPES = static_cast<size_t>(GateType::BUFFER) + 1;
+constexpr size_t RUN_CLASSES = GATE_TYPES * ARITY_CLASSES;
+
+uint8_t run_class(const Gate& gate) {
+    size_t arity = std::min(gate.get_inputs().size(), ARITY_CLASSES - 1);
+    return static_cast<uint8_t>(static_cast<size_t>(gate.get_type()) * ARITY_CLASSES + arity);
+}
+
+} // namespace
+
+CompiledNetlist compile_netlist(const std::vector<Gate*>& topo_order, size_t num_gates,
+                                size_t num_wires) {
+    CompiledNetlist net;
+
+    // Longest-path level of every gate, indexed by gate id. A single pass over
+    // the topological order suffices because sources are visited first.
+    // The run class is taken in the same pass so later sorts need not
+    // revisit the gate objects.
+    net.gate_levels.assign(num_gates, 0);
+    std::vector<uint8_t> classes(num_gates);
+    uint32_t max_level = 0;
+    for (const Gate* gate : topo_order) {
+        classes[gate->get_id()] = run_class(*gate);
+        uint32_t level = 0;
+        for (const Wire* input_wire : gate->get_inputs()) {
+            if (const Gate* src = input_wire->get_source(); src != nullptr) {
+                level = std::max(level, net.gate_levels[src->get_id()] + 1);
+            }
+        }
+        net.gate_levels[gate->get_id()] = level;
+        max_level = std::max(max_level, level);
+    }
+
+    // Counting sort by level (stable, so topological order is kept within a level)
+    size_t num_levels = topo_order.empty() ? 0 : static_cast<size_t>(max_level) + 1;
+    net.level_offsets.assign(num_levels + 1, 0);
+    for (const Gate* gate : topo_order) {
+        net.level_offsets[net.gate_levels[gate->get_id()] + 1]++;
+    }
+    for (size_t level = 0; level < num_levels; level++) {
+        net.level_offsets[level + 1] += net.level_offsets[level];
+    }
+
+    std::vector<const Gate*> by_level(topo_order.size());
+    std::vector<uint32_t> cursor(net.level_offsets.begin(), net.level_offsets.end() - 1);
+    for (const Gate* gate : topo_order) {
+        by_level[cursor[net.gate_levels[gate->get_id()]]++] = gate;
+    }
+
+    // Within each level, counting sort by (type, input-count class) so gates
+    // sharing a kernel sit next to each other. Gates within a level are
+    // independent, so any order inside the level stays topological.
+    std::vector<const Gate*> ordered(topo_order.size());
+    std::array<uint32_t, RUN_CLASSES + 1> class_offsets{};
+    for (size_t level = 0; level < num_levels; level++) {
+        const uint32_t begin = net.level_offsets[level];
+        const uint32_t end = net.level_offsets[level + 1];
+
+        class_offsets.fill(0);
+        for (uint32_t i = begin; i < end; i++) {
+            class_offsets[classes[by_level[i]->get_id()] + 1]++;
+        }
+        class_offsets[0] = begin;
+        for (size_t c = 0; c < RUN_CLASSES; c++) {
+            class_offsets[c + 1] += class_offsets[c];
+        }
+        for (uint32_t i = begin; i < end; i++) {
+            ordered[class_offsets[classes[by_level[i]->get_id()]]++] = by_level[i];
+        }
+    }
+
+    // Pack per-slot arrays and the CSR input table
+    const size_t slots = ordered.size();
+    net.types.resize(slots);
+    net.gate_ids.resize(slots);
+    net.outputs.resize(slots);
+    net.input_offsets.resize(slots + 1);
+    net.input_offsets[0] = 0;
+    for (size_t slot = 0; slot < slots; slot++) {
+        net.input_offsets[slot + 1] =
+            net.input_offsets[slot] + static_cast<uint32_t>(ordered[slot]->get_inputs().size());
+    }
+
+    net.input_wires.resize(net.input_offsets[slots]);
+    for (size_t slot = 0; slot < slots; slot++) {
+        const Gate* gate = ordered[slot];
+        net.types[slot] = gate->get_type();
+        net.gate_ids[slot] = gate->get_id();
+        const Wire* out = gate->get_output();
+        net.outputs[slot] = out != nullptr ? out->get_id() : NO_WIRE;
+        uint32_t k = net.input_offsets[slot];
+        for (const Wire* input_wire : gate->get_inputs()) {
+            net.input_wires[k++] = input_wire->get_id();
+        }
+    }
+
+    // Transpose the input table into per-wire fan-out lists. Slots are
+    // visited in ascending order, so each list comes out sorted.
+    net.fanout_offsets.assign(num_wires + 1, 0);
+    for (uint32_t wire : net.input_wires) {
+        net.fanout_offsets[wire + 1]++;
+    }
+    for (size_t w = 0; w < num_wires; w++) {
+        net.fanout_offsets[w + 1] += net.fanout_offsets[w];
+    }
+    net.fanout_slots.resize(net.input_wires.size());
+    std::vector<uint32_t> fanout_cursor(net.fanout_offsets.begin(), net.fanout_offsets.end() - 1);
+    for (uint32_t slot = 0; slot < net.num_gates(); slot++) {
+        for (uint32_t k = net.input_offsets[slot]; k < net.input_offsets[slot + 1]; k++) {
+            net.fanout_slots[fanout_cursor[net.input_wires[k]]++] = slot;
+        }
+    }
+
+    // Split each level into runs of identical type and arity
+    net.runs.reserve(num_levels);
+    net.level_runs.resize(num_levels + 1);
+    for (size_t level = 0; level < num_levels; level++) {
+        net.level_runs[level] = static_cast<uint32_t>(net.runs.size());
+        const uint32_t begin = net.level_offsets[level];
+        const uint32_t end = net.level_offsets[level + 1];
+        for (uint32_t slot = begin; slot < end; slot++) {
+            GateType type = net.types[slot];
+            uint32_t arity = net.input_offsets[slot + 1] - net.input_offsets[slot];
+            if (slot == begin || net.runs.back().type != type || net.runs.back().arity != arity) {
+                net.runs.push_back(GateRun{type, arity, slot, slot + 1});
+            } else {
+                net.runs.back().end = slot + 1;
+            }
+        }
+    }
+    net.level_runs[num_levels] = static_cast<uint32_t>(net.runs.size());
+
+    return net;
+}
+
+void validate_compiled_netlist(const CompiledNetlist& net, const std::vector<Gate*>& gates,
+                               size_t num_wires) {
+    auto fail = [](const std::string& what) {
+        throw std::runtime_error("Compiled netlist does not match the circuit: " + what);
+    };
+    auto is_offset_table = [](const std::vector<uint32_t>& offsets, size_t entries,
+                              size_t payload) {
+        if (offsets.size() != entries + 1 || offsets.front() != 0 || offsets.back() != payload) {
+            return false;
+        }
+        return std::is_sorted(offsets.begin(), offsets.end());
+    };
+
+    const size_t slots = gates.size();
+    if (net.types.size() != slots || net.gate_ids.size() != slots || net.outputs.size() != slots ||
+        net.gate_levels.size() != slots) {
+        fail("per-slot arrays do not cover every gate");
+    }
+    if (!is_offset_table(net.input_offsets, slots, net.input_wires.size())) {
+        fail("input table offsets are malformed");
+    }
+    if (net.level_offsets.empty() ||
+        !is_offset_table(net.level_offsets, net.level_offsets.size() - 1, slots)) {
+        fail("level offsets are malformed");
+    }
+    const size_t num_levels = net.num_levels();
+    if (!is_offset_table(net.level_runs, num_levels, net.runs.size())) {
+        fail("level run offsets are malformed");
+    }
+
+    // Slots must list every gate once, with the gate's own type, output and inputs
+    std::vector<uint8_t> seen(slots, 0);
+    for (size_t slot = 0; slot < slots; slot++) {
+        const uint32_t id = net.gate_ids[slot];
+        if (id >= slots || seen[id] != 0) {
+            fail("slot " + std::to_string(slot) + " does not name a distinct gate");
+        }
+        seen[id] = 1;
+        const Gate* gate = gates[id];
+        const Wire* out = gate->get_output();
+        if (net.types[slot] != gate->get_type() ||
+            net.outputs[slot] != (out != nullptr ? out->get_id() : NO_WIRE)) {
+            fail("slot " + std::to_string(slot) + " disagrees with gate " + std::to_string(id));
+        }
+        uint32_t k = net.input_offsets[slot];
+        if (net.input_offsets[slot + 1] - k != gate->get_inputs().size()) {
+            fail("gate " + std::to_string(id) + " has a different input count");
+        }
+        for (const Wire* input_wire : gate->get_inputs()) {
+            if (net.input_wires[k++] != input_wire->get_id()) {
+                fail("gate " + std::to_string(id) + " has different inputs");
+            }
+        }
+    }
+
+    // Levels: slots sit in their gate's level, and read only from lower ones
+    for (size_t level = 0; level < num_levels; level++) {
+        for (uint32_t slot = net.level_offsets[level]; slot < net.level_offsets[level + 1];
+             slot++) {
+            const Gate* gate = gates[net.gate_ids[slot]];
+            if (net.gate_levels[gate->get_id()] != level) {
+                fail("gate " + std::to_string(gate->get_id()) + " is outside its level");
+            }
+            for (const Wire* input_wire : gate->get_inputs()) {
+                const Gate* src = input_wire->get_source();
+                if (src != nullptr && net.gate_levels[src->get_id()] >= level) {
+                    fail("gate " + std::to_string(gate->get_id()) +
+                         " reads a gate that is not on an earlier level");
+                }
+            }
+        }
+    }
+
+    // Runs tile each level in slot order with one kernel each
+    for (size_t level = 0; level < num_levels; level++) {
+        uint32_t next = net.level_offsets[level];
+        for (uint32_t r = net.level_runs[level]; r < net.level_runs[level + 1]; r++) {
+            const GateRun& run = net.runs[r];
+            if (run.begin != next || run.end <= run.begin ||
+                run.end > net.level_offsets[level + 1]) {
+                fail("run " + std::to_string(r) + " does not tile its level");
+            }
+            for (uint32_t slot = run.begin; slot < run.end; slot++) {
+                if (net.types[slot] != run.type ||
+                    net.input_offsets[slot + 1] - net.input_offsets[slot] != run.arity) {
+                    fail("run " + std::to_string(r) + " mixes gate kinds");
+                }
+            }
+            next = run.end;
+        }
+        if (next != net.level_offsets[level + 1]) {
+            fail("level " + std::to_string(level) + " is not covered by its runs");
+        }
+    }
+
+    // The fan-out table must be the transpose compile_netlist() produces
+    if (!is_offset_table(net.fanout_offsets, num_wires, net.input_wires.size()) ||
+        net.fanout_slots.size() != net.input_wires.size()) {
+        fail("fan-out offsets are malformed");
+    }
+    std::vector<uint32_t> cursor(net.fanout_offsets.begin(), net.fanout_offsets.end() - 1);
+    for (uint32_t slot = 0; slot < slots; slot++) {
+        for (uint32_t k = net.input_offsets[slot]; k < net.input_offsets[slot + 1]; k++) {
+            const uint32_t wire = net.input_wires[k];
+            if (cursor[wire] >= net.fanout_offsets[wire + 1] ||
+                net.fanout_slots[cursor[wire]++] != slot) {
+                fail("fan-out of wire " + std::to_string(wire) + " is not the input transpose");
+            }
+        }
+    }
+}
+
+} // namespace gateflow
@@ -0,0 +1,73 @@
+#pragma once
+
+/// @file compiled_netlist.hpp
+/// @brief Levelized, index-based (struct-of-arrays) form of a finalized circuit
+
+#include "simulation/gate.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace gateflow {
+
+/// Sentinel output index for a gate that drives no wire
+inline constexpr uint32_t NO_WIRE = UINT32_MAX;
+
+/// A maximal span of consecutive slots within one level whose gates share a
+/// type and input count, so a single kernel can evaluate the whole span.
+struct GateRun {
+    GateType type;
+    uint32_t arity; ///< Input count of every gate in the run
+    uint32_t begin; ///< First slot
+    uint32_t end;   ///< One past the last slot
+};
+
+/// Flat snapshot of a circuit's topology, built by Circuit::finalize().
+///
+/// Gates are stored in level order: every gate at level L comes after every
+/// gate at level L-1, so iterating slots front to back is a valid
+/// topological order. A "slot" is a gate's position in that order.
+/// Within a level, gates are grouped by type and input count (see GateRun).
+/// Wires are referenced by id, so per-wire arrays are indexed directly by
+/// Wire::get_id() and no pointer is followed during evaluation.
+struct CompiledNetlist {
+    std::vector<GateType> types;         ///< Gate type per slot
+    std::vector<uint32_t> gate_ids;      ///< Gate id per slot
+    std::vector<uint32_t> outputs;       ///< Output wire id per slot (NO_WIRE if none)
+    std::vector<uint32_t> input_offsets; ///< Inputs of slot s: [input_offsets[s], input_offsets[s+1])
+    std::vector<uint32_t> input_wires;   ///< Input wire ids, packed per slot (CSR payload)
+    std::vector<uint32_t> level_offsets; ///< Slots of level L: [level_offsets[L], level_offsets[L+1])
+    std::vector<uint32_t> gate_levels;   ///< Level per gate id (0 = fed only by primary inputs)
+    std::vector<GateRun> runs;           ///< Same-type spans covering all slots, in slot order
+    std::vector<uint32_t> level_runs;    ///< Runs of level L: [level_runs[L], level_runs[L+1])
+    std::vector<uint32_t> fanout_offsets; ///< Readers of wire w: [fanout_offsets[w], fanout_offsets[w+1])
+    std::vector<uint32_t> fanout_slots;   ///< Slots reading each wire, ascending (CSR payload)
+
+    [[nodiscard]] size_t num_gates() const { return types.size(); }
+    [[nodiscard]] size_t num_levels() const {
+        return level_offsets.empty() ? 0 : level_offsets.size() - 1;
+    }
+};
+
+/// Builds the levelized form from a topological gate order.
+/// Gate ids must be dense (0..num_gates-1), as assigned by Circuit::add_gate().
+/// @param topo_order Gates in any valid topological order
+/// @param num_gates  Total number of gates in the circuit
+/// @param num_wires  Total number of wires in the circuit (ids 0..num_wires-1)
+[[nodiscard]] CompiledNetlist compile_netlist(const std::vector<Gate*>& topo_order,
+                                              size_t num_gates, size_t num_wires);
+
+/// Checks that @p net is a valid compiled form of @p gates, as compile_netlist()
+/// would accept it: every per-slot array agrees with the gate objects, each
+/// gate's sourced inputs come from strictly lower levels, the runs tile every
+/// level with matching type and arity, and the fan-out table is the exact
+/// transpose of the input table. Used to adopt a stored netlist without
+/// re-levelizing it (see Circuit::finalize(CompiledNetlist)).
+/// @param net       Compiled netlist to check
+/// @param gates     The circuit's gates, indexed by id
+/// @param num_wires Total number of wires in the circuit
+/// @throws std::runtime_error describing the first mismatch
+void validate_compiled_netlist(const CompiledNetlist& net, const std::vector<Gate*>& gates,
+                               size_t num_wires);
+
+} // namespace gateflow
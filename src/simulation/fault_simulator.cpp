@@ -0,0 +1,245 @@
+/// @file fault_simulator.cpp
+/// @brief Implements batch-parallel stuck-at fault simulation with fault dropping
+
+#include "simulation/fault_simulator.hpp"
+
+#include "simulation/lane_simulator.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace gateflow {
+
+namespace {
+
+using Block = FaultSimulator::Block;
+
+bool any_lane(const Block& b) {
+    uint64_t bits = 0;
+    for (uint64_t word : b.words) {
+        bits |= word;
+    }
+    return bits != 0;
+}
+
+/// Index of the lowest set lane; @p b must have one
+size_t first_lane(const Block& b) {
+    size_t word = 0;
+    while (b.words[word] == 0) {
+        word++;
+    }
+    size_t bit = 0;
+    while (((b.words[word] >> bit) & 1) == 0) {
+        bit++;
+    }
+    return 64 * word + bit;
+}
+
+bool has_lane(const Block& b, size_t lane) {
+    return ((b.words[lane / 64] >> (lane % 64)) & 1) != 0;
+}
+
+/// Lanes [0, count) set
+Block lanes_below(size_t count) {
+    Block b{};
+    for (size_t i = 0; i < Block::WORDS; i++) {
+        if (count >= 64 * (i + 1)) {
+            b.words[i] = ~uint64_t{0};
+        } else if (count > 64 * i) {
+            b.words[i] = (uint64_t{1} << (count - 64 * i)) - 1;
+        }
+    }
+    return b;
+}
+
+} // namespace
+
+FaultSimulator::FaultSimulator(const Circuit& circuit) : circuit_(&circuit) {
+    if (!circuit.is_finalized()) {
+        throw std::runtime_error("Circuit must be finalized before fault simulation");
+    }
+    const CompiledNetlist& net = circuit.compiled();
+    inputs_.assign(circuit.num_inputs(), Block{});
+    good_.assign(circuit.wires().size(), Block{});
+    faulty_ = good_;
+    is_output_.assign(circuit.wires().size(), 0);
+    for (const Wire* wire : circuit.output_wires()) {
+        is_output_[wire->get_id()] = 1;
+    }
+
+    gate_slot_.resize(net.num_gates());
+    detected_.assign(2 * net.num_gates(), UNDETECTED);
+    for (uint32_t slot = 0; slot < net.num_gates(); slot++) {
+        const uint32_t id = net.gate_ids[slot];
+        gate_slot_[id] = slot;
+    }
+    for (uint32_t id = 0; id < net.num_gates(); id++) {
+        if (net.outputs[gate_slot_[id]] != NO_WIRE) {
+            remaining_.push_back(2 * id);
+            remaining_.push_back(2 * id + 1);
+        }
+    }
+    num_faults_ = remaining_.size();
+    scheduled_.assign(net.num_gates(), 0);
+}
+
+void FaultSimulator::add_vector(const std::vector<bool>& inputs) {
+    if (inputs.size() != inputs_.size()) {
+        throw std::invalid_argument("Expected " + std::to_string(inputs_.size()) +
+                                    " input values, got " + std::to_string(inputs.size()));
+    }
+    const size_t word = queued_ / 64;
+    const uint64_t bit = uint64_t{1} << (queued_ % 64);
+    for (size_t i = 0; i < inputs.size(); i++) {
+        if (inputs[i]) {
+            inputs_[i].words[word] |= bit;
+        }
+    }
+    end_vector();
+}
+
+void FaultSimulator::add_vector(const uint64_t* words) {
+    const size_t word = queued_ / 64;
+    const uint64_t bit = uint64_t{1} << (queued_ % 64);
+    for (size_t i = 0; i < inputs_.size(); i++) {
+        if (((words[i / 64] >> (i % 64)) & 1) != 0) {
+            inputs_[i].words[word] |= bit;
+        }
+    }
+    end_vector();
+}
+
+void FaultSimulator::end_vector() {
+    if (++queued_ == Block::LANES) {
+        run_batch(queued_);
+    }
+}
+
+void FaultSimulator::flush() {
+    if (queued_ > 0) {
+        run_batch(queued_);
+    }
+}
+
+void FaultSimulator::run_batch(size_t count) {
+    const CompiledNetlist& net = circuit_->compiled();
+    const std::vector<Wire*>& input_wires = circuit_->input_wires();
+    for (size_t i = 0; i < inputs_.size(); i++) {
+        good_[input_wires[i]->get_id()] = inputs_[i];
+        inputs_[i] = Block{};
+    }
+    if (ThreadPool* pool = circuit_->thread_pool()) {
+        propagate_lanes(net, good_.data(), *pool, circuit_->min_parallel_level_slots());
+    } else {
+        propagate_lanes(net, good_.data());
+    }
+    faulty_ = good_;
+
+    // Fault dropping: detected faults leave remaining_ for later batches
+    const Block valid = lanes_below(count);
+    size_t kept = 0;
+    for (uint32_t fault : remaining_) {
+        const Block detect = propagate_fault(fault, valid);
+        if (any_lane(detect)) {
+            detected_[fault] = static_cast<int64_t>(vectors_ + first_lane(detect));
+        } else {
+            remaining_[kept++] = fault;
+        }
+    }
+    remaining_.resize(kept);
+
+    vectors_ += count;
+    queued_ = 0;
+}
+
+Block FaultSimulator::propagate_fault(uint32_t fault, const Block& valid) {
+    const CompiledNetlist& net = circuit_->compiled();
+    const uint32_t site = net.outputs[gate_slot_[fault / 2]];
+    const Block stuck = (fault & 1) != 0 ? lane_not(Block{}) : Block{};
+
+    // Lanes where the stuck value differs from the fault-free one activate the fault
+    const Block activated = lane_and(lane_xor(stuck, good_[site]), valid);
+    if (!any_lane(activated)) {
+        return Block{};
+    }
+    // No vector before the first activating one can detect the fault, so
+    // once that one does, the rest of the cone cannot change the answer
+    const size_t earliest = first_lane(activated);
+
+    Block detect{};
+    // Marks @p wire faulty with @p value; false once the earliest lane is detected
+    auto change = [&](uint32_t wire, const Block& value, const Block& diff) {
+        faulty_[wire] = value;
+        touched_.push_back(wire);
+        if (is_output_[wire]) {
+            detect = lane_or(detect, diff);
+            if (has_lane(detect, earliest)) {
+                return false;
+            }
+        }
+        for (uint32_t k = net.fanout_offsets[wire]; k < net.fanout_offsets[wire + 1]; k++) {
+            const uint32_t reader = net.fanout_slots[k];
+            if (!scheduled_[reader]) {
+                scheduled_[reader] = 1;
+                events_.push(reader);
+            }
+        }
+        return true;
+    };
+
+    if (change(site, stuck, activated)) {
+        // Readers have higher slots than their sources, so every slot pops
+        // after all of its changed inputs
+        while (!events_.empty()) {
+            const uint32_t slot = events_.top();
+            events_.pop();
+            scheduled_[slot] = 0;
+            const uint32_t out = net.outputs[slot];
+            if (out == NO_WIRE) {
+                continue;
+            }
+            const Block value = evaluate_lane_slot(net, slot, faulty_.data());
+            const Block diff = lane_and(lane_xor(value, good_[out]), valid);
+            if (any_lane(diff) && !change(out, value, diff)) {
+                break;
+            }
+        }
+    }
+
+    // Back to the fault-free state for the next fault
+    while (!events_.empty()) {
+        scheduled_[events_.top()] = 0;
+        events_.pop();
+    }
+    for (uint32_t wire : touched_) {
+        faulty_[wire] = good_[wire];
+    }
+    touched_.clear();
+    return detect;
+}
+
+int64_t FaultSimulator::detecting_vector(const Gate* gate, bool stuck_value) const {
+    const uint32_t id = gate->get_id();
+    if (id >= gate_slot_.size() || circuit_->gates()[id] != gate) {
+        return UNDETECTED;
+    }
+    return detected_[2 * id + (stuck_value ? 1 : 0)];
+}
+
+std::vector<StuckAtFault> FaultSimulator::undetected_faults() const {
+    std::vector<StuckAtFault> faults;
+    faults.reserve(remaining_.size());
+    for (uint32_t fault : remaining_) {
+        faults.push_back({circuit_->gates()[fault / 2], (fault & 1) != 0});
+    }
+    return faults;
+}
+
+double FaultSimulator::coverage() const {
+    if (num_faults_ == 0) {
+        return 1.0;
+    }
+    return static_cast<double>(num_detected()) / static_cast<double>(num_faults_);
+}
+
+} // namespace gateflow
@@ -0,0 +1,110 @@
+#pragma once
+
+/// @file fault_simulator.hpp
+/// @brief Parallel-pattern single-fault propagation for stuck-at faults on gate outputs
+
+#include "simulation/circuit.hpp"
+#include "simulation/lane_block.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace gateflow {
+
+/// A gate output stuck at a constant value
+struct StuckAtFault {
+    const Gate* gate;
+    bool stuck_value;
+};
+
+/// Grades a vector set against every stuck-at-0 and stuck-at-1 fault on the
+/// output of every gate that drives a wire.
+///
+/// Vectors are simulated NativeLaneBlock::LANES at a time. Each batch runs
+/// the fault-free circuit once over the lane kernels; then, for every fault
+/// still undetected, the stuck value is forced onto the gate's output wire
+/// and only the gates in its fan-out cone whose lanes actually differ from
+/// the fault-free values are re-evaluated, in slot order. A fault is
+/// detected by a vector when some primary output differs in its lane, and
+/// is dropped from later batches once detected.
+///
+/// The circuit must outlive the simulator and must not be modified while it
+/// is in use. Its scalar and packed state are not touched.
+class FaultSimulator {
+  public:
+    using Block = NativeLaneBlock;
+
+    /// No vector detected the fault
+    static constexpr int64_t UNDETECTED = -1;
+
+    /// @throws std::runtime_error if the circuit is not finalized
+    explicit FaultSimulator(const Circuit& circuit);
+
+    /// Queues one input vector (one value per primary input, index 0 first).
+    /// A full batch of Block::LANES vectors is simulated right away.
+    /// @throws std::invalid_argument if @p inputs is not num_inputs() long
+    void add_vector(const std::vector<bool>& inputs);
+
+    /// Same, from a bit array laid out as Circuit::set_inputs() reads it
+    /// (input i is bit i % 64 of @p words[i / 64]; (num_inputs + 63) / 64 words)
+    void add_vector(const uint64_t* words);
+
+    /// Simulates the vectors queued since the last full batch. Call before
+    /// reading results if the vector count is not a multiple of Block::LANES.
+    void flush();
+
+    /// Index (in add_vector() order) of the first vector that detects the
+    /// fault, or UNDETECTED. Gates that drive no wire, or belong to another
+    /// circuit, are never detected.
+    [[nodiscard]] int64_t detecting_vector(const Gate* gate, bool stuck_value) const;
+
+    [[nodiscard]] bool is_detected(const Gate* gate, bool stuck_value) const {
+        return detecting_vector(gate, stuck_value) != UNDETECTED;
+    }
+
+    /// Faults not detected by any simulated vector, by gate id then value
+    [[nodiscard]] std::vector<StuckAtFault> undetected_faults() const;
+
+    /// Two per gate that drives a wire
+    [[nodiscard]] size_t num_faults() const { return num_faults_; }
+    [[nodiscard]] size_t num_detected() const { return num_faults_ - remaining_.size(); }
+
+    /// Detected faults as a fraction of num_faults() (1 for a circuit without faults)
+    [[nodiscard]] double coverage() const;
+
+    /// Vectors simulated so far (queued vectors count once flushed)
+    [[nodiscard]] uint64_t vectors() const { return vectors_; }
+
+  private:
+    /// Counts the vector just queued, running the batch once it is full
+    void end_vector();
+
+    /// Simulates the queued batch of @p count vectors and drops the faults it detects
+    void run_batch(size_t count);
+
+    /// Forces one fault onto the batch and propagates it through its cone.
+    /// @return Lanes (masked to @p valid) in which some primary output differs
+    Block propagate_fault(uint32_t fault, const Block& valid);
+
+    const Circuit* circuit_;
+    std::vector<Block> inputs_;       ///< Queued lanes per primary input
+    size_t queued_ = 0;               ///< Vectors waiting in inputs_
+    uint64_t vectors_ = 0;
+    std::vector<Block> good_;         ///< Fault-free lanes per wire id
+    std::vector<Block> faulty_;       ///< good_ with the current fault's effects
+    std::vector<uint32_t> gate_slot_; ///< Slot per gate id
+    std::vector<uint8_t> is_output_;  ///< Per wire id: is a primary output
+    std::vector<int64_t> detected_;   ///< First detecting vector per fault (2 * gate id + value)
+    std::vector<uint32_t> remaining_; ///< Undetected faults, ascending
+    size_t num_faults_ = 0;
+
+    // Scratch for propagate_fault(), reused by every fault
+    std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<>> events_; ///< Slots
+    std::vector<uint8_t> scheduled_;  ///< Per slot: in events_
+    std::vector<uint32_t> touched_;   ///< Wire ids where faulty_ differs from good_
+};
+
+} // namespace gateflow
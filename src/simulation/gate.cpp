@@ -4,27 +4,45 @@
 #include "simulation/gate.hpp"
 
 #include <stdexcept>
+#include <string>
 
 namespace gateflow {
 
-bool evaluate(GateType type, const std::vector<bool>& inputs) {
+void validate_arity(GateType type, size_t count) {
     switch (type) {
     case GateType::NOT:
-        if (inputs.size() != 1) {
+        if (count != 1) {
             throw std::invalid_argument("NOT gate requires exactly 1 input");
         }
-        return !inputs[0];
-
+        return;
     case GateType::BUFFER:
-        if (inputs.size() != 1) {
+        if (count != 1) {
             throw std::invalid_argument("BUFFER gate requires exactly 1 input");
         }
+        return;
+    case GateType::AND:
+    case GateType::NAND:
+    case GateType::OR:
+    case GateType::XOR:
+        if (count < 2) {
+            throw std::invalid_argument(std::string(gate_type_name(type)) +
+                                        " gate requires at least 2 inputs");
+        }
+        return;
+    }
+    throw std::invalid_argument("Unknown gate type");
+}
+
+bool evaluate(GateType type, const std::vector<bool>& inputs) {
+    validate_arity(type, inputs.size());
+    switch (type) {
+    case GateType::NOT:
+        return !inputs[0];
+
+    case GateType::BUFFER:
         return inputs[0];
 
     case GateType::AND:
-        if (inputs.size() < 2) {
-            throw std::invalid_argument("AND gate requires at least 2 inputs");
-        }
         for (bool v : inputs) {
             if (!v) {
                 return false;
@@ -33,9 +51,6 @@ bool evaluate(GateType type, const std::vector<bool>& inputs) {
         return true;
 
     case GateType::NAND:
-        if (inputs.size() < 2) {
-            throw std::invalid_argument("NAND gate requires at least 2 inputs");
-        }
         for (bool v : inputs) {
             if (!v) {
                 return true;
@@ -44,9 +59,6 @@ bool evaluate(GateType type, const std::vector<bool>& inputs) {
         return false;
 
     case GateType::OR:
-        if (inputs.size() < 2) {
-            throw std::invalid_argument("OR gate requires at least 2 inputs");
-        }
         for (bool v : inputs) {
             if (v) {
                 return true;
@@ -54,25 +66,59 @@ bool evaluate(GateType type, const std::vector<bool>& inputs) {
         }
         return false;
 
-    case GateType::XOR:
-        if (inputs.size() < 2) {
-            throw std::invalid_argument("XOR gate requires at least 2 inputs");
+    case GateType::XOR: {
+        bool result = false;
+        for (bool v : inputs) {
+            result ^= v;
         }
-        {
-            bool result = false;
-            for (bool v : inputs) {
-                result ^= v;
-            }
-            return result;
+        return result;
+    }
+    }
+    throw std::invalid_argument("Unknown gate type");
+}
+
+uint64_t evaluate_packed(GateType type, const uint64_t* inputs, size_t count) {
+    validate_arity(type, count);
+    switch (type) {
+    case GateType::NOT:
+        return ~inputs[0];
+
+    case GateType::BUFFER:
+        return inputs[0];
+
+    case GateType::AND:
+    case GateType::NAND: {
+        uint64_t acc = inputs[0];
+        for (size_t i = 1; i < count; i++) {
+            acc &= inputs[i];
+        }
+        return type == GateType::AND ? acc : ~acc;
+    }
+
+    case GateType::OR: {
+        uint64_t acc = inputs[0];
+        for (size_t i = 1; i < count; i++) {
+            acc |= inputs[i];
         }
+        return acc;
+    }
+
+    case GateType::XOR: {
+        uint64_t acc = inputs[0];
+        for (size_t i = 1; i < count; i++) {
+            acc ^= inputs[i];
+        }
+        return acc;
+    }
     }
     throw std::invalid_argument("Unknown gate type");
 }
 
-Gate::Gate(uint32_t id, GateType type) : id_(id), type_(type) {}
+Gate::Gate(uint32_t id, GateType type, PointerListPool<Wire>& input_pool)
+    : id_(id), type_(type), input_pool_(&input_pool) {}
 
 void Gate::add_input(Wire* wire) {
-    inputs_.push_back(wire);
+    inputs_.push_back(wire, *input_pool_);
 }
 
 } // namespace gateflow
@@ -3,6 +3,9 @@
 /// @file gate.hpp
 /// @brief Logic gate model — types, evaluation, and the Gate class
 
+#include "simulation/arena.hpp"
+
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
 #include <vector>
@@ -14,6 +17,9 @@ class Wire; // Forward declaration
 /// Types of logic gates supported by the simulator
 enum class GateType { NAND, AND, OR, XOR, NOT, BUFFER };
 
+/// Number of GateType values, for tables indexed by type
+inline constexpr size_t GATE_TYPE_COUNT = static_cast<size_t>(GateType::BUFFER) + 1;
+
 /// Returns the human-readable name of a gate type
 [[nodiscard]] constexpr std::string_view gate_type_name(GateType type) {
     switch (type) {
@@ -33,26 +39,101 @@ enum class GateType { NAND, AND, OR, XOR, NOT, BUFFER };
     return "UNKNOWN";
 }
 
+/// Largest fan-in the mask-based evaluate_mask() (and so Circuit) supports
+inline constexpr size_t MAX_GATE_INPUTS = 64;
+
+/// Checks that a gate of the given type accepts `count` inputs
+/// (NOT/BUFFER: exactly 1; all others: at least 2).
+/// @throws std::invalid_argument if the input count is wrong for the gate type
+void validate_arity(GateType type, size_t count);
+
 /// Evaluates a logic gate given its type and input values.
 /// This is a pure function with no side effects.
 /// @throws std::invalid_argument if the input count is wrong for the gate type
 [[nodiscard]] bool evaluate(GateType type, const std::vector<bool>& inputs);
 
+/// Bit-parallel evaluation: bit k of each input word is lane k, so one call
+/// evaluates 64 independent input vectors with plain bitwise operations.
+/// @param inputs Pointer to `count` input words
+/// @throws std::invalid_argument if the input count is wrong for the gate type
+[[nodiscard]] uint64_t evaluate_packed(GateType type, const uint64_t* inputs, size_t count);
+
+/// Evaluates a gate from an input bitmask (bit k = input k) without
+/// checking arity or allocating. The caller must have validated the input
+/// count with validate_arity(), and count must not exceed MAX_GATE_INPUTS.
+[[nodiscard]] constexpr bool evaluate_mask(GateType type, uint64_t mask, size_t count) {
+    const uint64_t all = count >= 64 ? ~uint64_t{0} : (uint64_t{1} << count) - 1;
+    switch (type) {
+    case GateType::NOT:
+        return mask == 0;
+    case GateType::BUFFER:
+    case GateType::OR:
+        return mask != 0;
+    case GateType::AND:
+        return mask == all;
+    case GateType::NAND:
+        return mask != all;
+    case GateType::XOR:
+        mask ^= mask >> 32;
+        mask ^= mask >> 16;
+        mask ^= mask >> 8;
+        mask ^= mask >> 4;
+        mask ^= mask >> 2;
+        mask ^= mask >> 1;
+        return (mask & 1) != 0;
+    }
+    return false;
+}
+
+/// Truth table of a 1- or 2-input gate: bit m of the result is the output
+/// for input mask m (bit k = input k), so 2-input gates are a 4-entry LUT.
+/// Built from evaluate_mask(), so both always agree.
+/// @param count 1 for NOT/BUFFER, 2 for the other types
+[[nodiscard]] constexpr uint8_t gate_truth_table(GateType type, size_t count) {
+    uint8_t table = 0;
+    for (uint64_t m = 0; m < (uint64_t{1} << count); m++) {
+        if (evaluate_mask(type, m, count)) {
+            table = static_cast<uint8_t>(table | (1u << m));
+        }
+    }
+    return table;
+}
+
+/// evaluate_mask() with the gate type and arity fixed at compile time, for
+/// kernels instantiated once per (type, arity) run. Arity 1 and 2 index a
+/// constexpr truth table; Arity 0 stands for "3 or more" and takes the
+/// actual input count from @p count.
+template <GateType Type, size_t Arity>
+[[nodiscard]] constexpr bool evaluate_fixed(uint64_t mask, size_t count) {
+    if constexpr (Arity == 1 || Arity == 2) {
+        constexpr uint8_t table = gate_truth_table(Type, Arity);
+        (void)count;
+        return ((table >> mask) & 1u) != 0;
+    } else {
+        return evaluate_mask(Type, mask, count);
+    }
+}
+
 /// Represents a single logic gate in a circuit DAG.
 ///
 /// A gate has typed logic (AND, XOR, etc.), a set of input wires,
 /// a single output wire, and a cached output state.
 class Gate {
   public:
-    /// Construct a gate with a unique ID and type
-    explicit Gate(uint32_t id, GateType type);
+    /// Construct a gate with a unique ID and type. Its input list is
+    /// allocated from @p input_pool, which must outlive the gate.
+    Gate(uint32_t id, GateType type, PointerListPool<Wire>& input_pool);
+
+    // Non-copyable: the input list's storage belongs to the pool
+    Gate(const Gate&) = delete;
+    Gate& operator=(const Gate&) = delete;
 
     [[nodiscard]] uint32_t get_id() const { return id_; }
     [[nodiscard]] GateType get_type() const { return type_; }
     [[nodiscard]] bool get_state() const { return state_; }
     [[nodiscard]] bool is_dirty() const { return dirty_; }
     [[nodiscard]] Wire* get_output() const { return output_; }
-    [[nodiscard]] const std::vector<Wire*>& get_inputs() const { return inputs_; }
+    [[nodiscard]] const PooledList<Wire>& get_inputs() const { return inputs_; }
 
     void set_state(bool state) { state_ = state; }
     void set_dirty(bool dirty) { dirty_ = dirty; }
@@ -68,7 +149,8 @@ class Gate {
   private:
     uint32_t id_;
     GateType type_;
-    std::vector<Wire*> inputs_;
+    PointerListPool<Wire>* input_pool_;
+    PooledList<Wire> inputs_;
     Wire* output_ = nullptr;
     bool state_ = false;
     bool dirty_ = true;
@@ -0,0 +1,146 @@
+#pragma once
+
+/// @file lane_block.hpp
+/// @brief Fixed-width blocks of simulation lanes and their bitwise gate kernels
+///
+/// A LaneBlock<W> holds W 64-bit words, i.e. 64*W independent input vectors
+/// for one wire. The generic kernels are plain word loops (the scalar
+/// fallback); where the target supports it, the native width is specialised
+/// with SIMD intrinsics. NATIVE_LANE_WORDS picks the widest block the
+/// compile target has registers for:
+///   - AVX2 (-mavx2, GATEFLOW_ENABLE_AVX2)             -> 4 words, 256 lanes
+///   - WASM SIMD128 (-msimd128, GATEFLOW_EMSCRIPTEN_ENABLE_SIMD) -> 2 words, 128 lanes
+///   - otherwise                                       -> 1 word, 64 lanes
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#endif
+
+namespace gateflow {
+
+#if defined(__AVX2__)
+inline constexpr size_t NATIVE_LANE_WORDS = 4;
+#elif defined(__wasm_simd128__)
+inline constexpr size_t NATIVE_LANE_WORDS = 2;
+#else
+inline constexpr size_t NATIVE_LANE_WORDS = 1;
+#endif
+
+/// W words of lanes for a single wire. Bit k of words[j] is lane 64*j + k.
+template <size_t W> struct alignas(W * sizeof(uint64_t)) LaneBlock {
+    static constexpr size_t WORDS = W;
+    static constexpr size_t LANES = 64 * W;
+
+    uint64_t words[W];
+};
+
+/// The widest block the current compile target evaluates in one operation
+using NativeLaneBlock = LaneBlock<NATIVE_LANE_WORDS>;
+
+// --- Generic (scalar fallback) kernels ---
+
+template <size_t W> inline LaneBlock<W> lane_and(const LaneBlock<W>& a, const LaneBlock<W>& b) {
+    LaneBlock<W> r;
+    for (size_t i = 0; i < W; i++) {
+        r.words[i] = a.words[i] & b.words[i];
+    }
+    return r;
+}
+
+template <size_t W> inline LaneBlock<W> lane_or(const LaneBlock<W>& a, const LaneBlock<W>& b) {
+    LaneBlock<W> r;
+    for (size_t i = 0; i < W; i++) {
+        r.words[i] = a.words[i] | b.words[i];
+    }
+    return r;
+}
+
+template <size_t W> inline LaneBlock<W> lane_xor(const LaneBlock<W>& a, const LaneBlock<W>& b) {
+    LaneBlock<W> r;
+    for (size_t i = 0; i < W; i++) {
+        r.words[i] = a.words[i] ^ b.words[i];
+    }
+    return r;
+}
+
+template <size_t W> inline LaneBlock<W> lane_not(const LaneBlock<W>& a) {
+    LaneBlock<W> r;
+    for (size_t i = 0; i < W; i++) {
+        r.words[i] = ~a.words[i];
+    }
+    return r;
+}
+
+template <size_t W> inline LaneBlock<W> lane_nand(const LaneBlock<W>& a, const LaneBlock<W>& b) {
+    return lane_not(lane_and(a, b));
+}
+
+// --- Native specialisations ---
+
+#if defined(__AVX2__)
+
+namespace detail {
+inline __m256i load256(const LaneBlock<4>& a) {
+    return _mm256_load_si256(reinterpret_cast<const __m256i*>(a.words));
+}
+inline LaneBlock<4> store256(__m256i v) {
+    LaneBlock<4> r;
+    _mm256_store_si256(reinterpret_cast<__m256i*>(r.words), v);
+    return r;
+}
+} // namespace detail
+
+template <> inline LaneBlock<4> lane_and(const LaneBlock<4>& a, const LaneBlock<4>& b) {
+    return detail::store256(_mm256_and_si256(detail::load256(a), detail::load256(b)));
+}
+template <> inline LaneBlock<4> lane_or(const LaneBlock<4>& a, const LaneBlock<4>& b) {
+    return detail::store256(_mm256_or_si256(detail::load256(a), detail::load256(b)));
+}
+template <> inline LaneBlock<4> lane_xor(const LaneBlock<4>& a, const LaneBlock<4>& b) {
+    return detail::store256(_mm256_xor_si256(detail::load256(a), detail::load256(b)));
+}
+template <> inline LaneBlock<4> lane_not(const LaneBlock<4>& a) {
+    return detail::store256(_mm256_xor_si256(detail::load256(a), _mm256_set1_epi64x(-1)));
+}
+template <> inline LaneBlock<4> lane_nand(const LaneBlock<4>& a, const LaneBlock<4>& b) {
+    __m256i both = _mm256_and_si256(detail::load256(a), detail::load256(b));
+    return detail::store256(_mm256_xor_si256(both, _mm256_set1_epi64x(-1)));
+}
+
+#elif defined(__wasm_simd128__)
+
+namespace detail {
+inline v128_t load128(const LaneBlock<2>& a) {
+    return wasm_v128_load(a.words);
+}
+inline LaneBlock<2> store128(v128_t v) {
+    LaneBlock<2> r;
+    wasm_v128_store(r.words, v);
+    return r;
+}
+} // namespace detail
+
+template <> inline LaneBlock<2> lane_and(const LaneBlock<2>& a, const LaneBlock<2>& b) {
+    return detail::store128(wasm_v128_and(detail::load128(a), detail::load128(b)));
+}
+template <> inline LaneBlock<2> lane_or(const LaneBlock<2>& a, const LaneBlock<2>& b) {
+    return detail::store128(wasm_v128_or(detail::load128(a), detail::load128(b)));
+}
+template <> inline LaneBlock<2> lane_xor(const LaneBlock<2>& a, const LaneBlock<2>& b) {
+    return detail::store128(wasm_v128_xor(detail::load128(a), detail::load128(b)));
+}
+template <> inline LaneBlock<2> lane_not(const LaneBlock<2>& a) {
+    return detail::store128(wasm_v128_not(detail::load128(a)));
+}
+template <> inline LaneBlock<2> lane_nand(const LaneBlock<2>& a, const LaneBlock<2>& b) {
+    return detail::store128(wasm_v128_not(wasm_v128_and(detail::load128(a), detail::load128(b))));
+}
+
+#endif
+
+} // namespace gateflow
@@ -0,0 +1,223 @@
+/// @file lane_simulator.cpp
+/// @brief Run-at-a-time lane kernels and LaneSimulator implementation
+
+#include "simulation/lane_simulator.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace gateflow {
+
+namespace {
+
+template <size_t W, typename Op>
+void binary_run(const CompiledNetlist& net, uint32_t begin, uint32_t end, LaneBlock<W>* values,
+                Op op) {
+    const uint32_t* in = net.input_wires.data();
+    for (uint32_t slot = begin; slot < end; slot++) {
+        const uint32_t k = net.input_offsets[slot];
+        LaneBlock<W> r = op(values[in[k]], values[in[k + 1]]);
+        if (uint32_t out = net.outputs[slot]; out != NO_WIRE) {
+            values[out] = r;
+        }
+    }
+}
+
+/// Folds inputs with @p op, then applies @p finish (NOT for NAND)
+template <size_t W, typename Op, typename Finish>
+void nary_run(const CompiledNetlist& net, uint32_t begin, uint32_t end, LaneBlock<W>* values,
+              Op op, Finish finish) {
+    for (uint32_t slot = begin; slot < end; slot++) {
+        const uint32_t first = net.input_offsets[slot];
+        const uint32_t last = net.input_offsets[slot + 1];
+        LaneBlock<W> acc = values[net.input_wires[first]];
+        for (uint32_t k = first + 1; k < last; k++) {
+            acc = op(acc, values[net.input_wires[k]]);
+        }
+        if (uint32_t out = net.outputs[slot]; out != NO_WIRE) {
+            values[out] = finish(acc);
+        }
+    }
+}
+
+/// Evaluates slots [begin, end) of one run with the run's kernel
+template <size_t W>
+void eval_run(const CompiledNetlist& net, const GateRun& run, uint32_t begin, uint32_t end,
+              LaneBlock<W>* values) {
+    auto op_and = [](const LaneBlock<W>& a, const LaneBlock<W>& b) { return lane_and(a, b); };
+    auto op_or = [](const LaneBlock<W>& a, const LaneBlock<W>& b) { return lane_or(a, b); };
+    auto op_xor = [](const LaneBlock<W>& a, const LaneBlock<W>& b) { return lane_xor(a, b); };
+    auto op_nand = [](const LaneBlock<W>& a, const LaneBlock<W>& b) { return lane_nand(a, b); };
+    auto identity = [](const LaneBlock<W>& a) { return a; };
+    auto invert = [](const LaneBlock<W>& a) { return lane_not(a); };
+
+    switch (run.type) {
+    case GateType::NOT:
+    case GateType::BUFFER:
+        for (uint32_t slot = begin; slot < end; slot++) {
+            const LaneBlock<W>& a = values[net.input_wires[net.input_offsets[slot]]];
+            if (uint32_t out = net.outputs[slot]; out != NO_WIRE) {
+                values[out] = run.type == GateType::NOT ? lane_not(a) : a;
+            }
+        }
+        break;
+
+    case GateType::AND:
+        if (run.arity == 2) {
+            binary_run(net, begin, end, values, op_and);
+        } else {
+            nary_run(net, begin, end, values, op_and, identity);
+        }
+        break;
+    case GateType::NAND:
+        if (run.arity == 2) {
+            binary_run(net, begin, end, values, op_nand);
+        } else {
+            nary_run(net, begin, end, values, op_and, invert);
+        }
+        break;
+    case GateType::OR:
+        if (run.arity == 2) {
+            binary_run(net, begin, end, values, op_or);
+        } else {
+            nary_run(net, begin, end, values, op_or, identity);
+        }
+        break;
+    case GateType::XOR:
+        if (run.arity == 2) {
+            binary_run(net, begin, end, values, op_xor);
+        } else {
+            nary_run(net, begin, end, values, op_xor, identity);
+        }
+        break;
+    }
+}
+
+/// Evaluates slots [lo, hi) of one level, following the level's runs
+template <size_t W>
+void eval_level_range(const CompiledNetlist& net, size_t level, uint32_t lo, uint32_t hi,
+                      LaneBlock<W>* values) {
+    const GateRun* first = net.runs.data() + net.level_runs[level];
+    const GateRun* last = net.runs.data() + net.level_runs[level + 1];
+    // First run ending after lo
+    const GateRun* run = std::upper_bound(first, last, lo, [](uint32_t slot, const GateRun& r) {
+        return slot < r.end;
+    });
+    for (; run != last && run->begin < hi; ++run) {
+        eval_run(net, *run, std::max(lo, run->begin), std::min(hi, run->end), values);
+    }
+}
+
+} // namespace
+
+template <size_t W>
+LaneBlock<W> evaluate_lane_slot(const CompiledNetlist& net, uint32_t slot,
+                                const LaneBlock<W>* values) {
+    const uint32_t first = net.input_offsets[slot];
+    const uint32_t last = net.input_offsets[slot + 1];
+    const GateType type = net.types[slot];
+    LaneBlock<W> acc = values[net.input_wires[first]];
+    for (uint32_t k = first + 1; k < last; k++) {
+        const LaneBlock<W>& in = values[net.input_wires[k]];
+        switch (type) {
+        case GateType::AND:
+        case GateType::NAND:
+            acc = lane_and(acc, in);
+            break;
+        case GateType::OR:
+            acc = lane_or(acc, in);
+            break;
+        case GateType::XOR:
+            acc = lane_xor(acc, in);
+            break;
+        case GateType::NOT:
+        case GateType::BUFFER:
+            break; // Single input
+        }
+    }
+    return type == GateType::NOT || type == GateType::NAND ? lane_not(acc) : acc;
+}
+
+template <size_t W> void propagate_lanes(const CompiledNetlist& net, LaneBlock<W>* values) {
+    for (const GateRun& run : net.runs) {
+        eval_run(net, run, run.begin, run.end, values);
+    }
+}
+
+template <size_t W>
+void propagate_lanes(const CompiledNetlist& net, LaneBlock<W>* values, ThreadPool& pool,
+                     size_t min_parallel_slots) {
+    // Aim for a few chunks per thread so uneven chunks balance out
+    const size_t chunks_per_level = pool.concurrency() * 4;
+
+    for (size_t level = 0; level < net.num_levels(); level++) {
+        const uint32_t begin = net.level_offsets[level];
+        const uint32_t end = net.level_offsets[level + 1];
+        const size_t size = end - begin;
+
+        if (size < min_parallel_slots || pool.concurrency() == 1) {
+            for (uint32_t r = net.level_runs[level]; r < net.level_runs[level + 1]; r++) {
+                const GateRun& run = net.runs[r];
+                eval_run(net, run, run.begin, run.end, values);
+            }
+            continue;
+        }
+
+        // Gates in a level only read wires driven by earlier levels, so
+        // chunks of one level never race; parallel_for is the level barrier.
+        const size_t grain = std::max<size_t>(MIN_PARALLEL_GRAIN, size / chunks_per_level);
+        pool.parallel_for(begin, end, grain, [&](size_t lo, size_t hi) {
+            eval_level_range(net, level, static_cast<uint32_t>(lo), static_cast<uint32_t>(hi),
+                             values);
+        });
+    }
+}
+
+template <size_t W>
+LaneSimulator<W>::LaneSimulator(const Circuit& circuit) : circuit_(&circuit) {
+    if (!circuit.is_finalized()) {
+        throw std::runtime_error("Circuit must be finalized before packed simulation");
+    }
+    values_.assign(circuit.wires().size(), Block{});
+}
+
+template <size_t W> void LaneSimulator<W>::set_input(size_t index, const Block& lanes) {
+    if (index >= circuit_->num_inputs()) {
+        throw std::out_of_range("Input index out of range");
+    }
+    values_[circuit_->input_wires()[index]->get_id()] = lanes;
+}
+
+template <size_t W> void LaneSimulator<W>::propagate() {
+    if (ThreadPool* pool = circuit_->thread_pool()) {
+        propagate_lanes(circuit_->compiled(), values_.data(), *pool,
+                        circuit_->min_parallel_level_slots());
+    } else {
+        propagate_lanes(circuit_->compiled(), values_.data());
+    }
+}
+
+template <size_t W> const LaneBlock<W>& LaneSimulator<W>::get_output(size_t index) const {
+    if (index >= circuit_->num_outputs()) {
+        throw std::out_of_range("Output index out of range");
+    }
+    return values_[circuit_->output_wires()[index]->get_id()];
+}
+
+template void propagate_lanes<1>(const CompiledNetlist&, LaneBlock<1>*);
+template void propagate_lanes<2>(const CompiledNetlist&, LaneBlock<2>*);
+template void propagate_lanes<4>(const CompiledNetlist&, LaneBlock<4>*);
+template void propagate_lanes<1>(const CompiledNetlist&, LaneBlock<1>*, ThreadPool&, size_t);
+template void propagate_lanes<2>(const CompiledNetlist&, LaneBlock<2>*, ThreadPool&, size_t);
+template void propagate_lanes<4>(const CompiledNetlist&, LaneBlock<4>*, ThreadPool&, size_t);
+template LaneBlock<1> evaluate_lane_slot<1>(const CompiledNetlist&, uint32_t,
+                                            const LaneBlock<1>*);
+template LaneBlock<2> evaluate_lane_slot<2>(const CompiledNetlist&, uint32_t,
+                                            const LaneBlock<2>*);
+template LaneBlock<4> evaluate_lane_slot<4>(const CompiledNetlist&, uint32_t,
+                                            const LaneBlock<4>*);
+template class LaneSimulator<1>;
+template class LaneSimulator<2>;
+template class LaneSimulator<4>;
+
+} // namespace gateflow
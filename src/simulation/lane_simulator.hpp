@@ -0,0 +1,85 @@
+#pragma once
+
+/// @file lane_simulator.hpp
+/// @brief Wide bit-parallel simulation over a finalized circuit's compiled netlist
+
+#include "simulation/circuit.hpp"
+#include "simulation/lane_block.hpp"
+#include "simulation/thread_pool.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace gateflow {
+
+/// Evaluates every gate of a compiled netlist over lane blocks indexed by
+/// wire id, one same-type run at a time. Primary-input entries of @p values
+/// are read, every gate-driven entry is overwritten. Gate arity must already
+/// be valid, as Circuit::finalize() guarantees.
+template <size_t W> void propagate_lanes(const CompiledNetlist& net, LaneBlock<W>* values);
+
+/// Evaluates the gate in one slot of @p net over @p values and returns its
+/// output lanes without storing them. For passes that only visit part of a
+/// netlist, such as fault simulation's fan-out cones.
+template <size_t W>
+[[nodiscard]] LaneBlock<W> evaluate_lane_slot(const CompiledNetlist& net, uint32_t slot,
+                                              const LaneBlock<W>* values);
+
+/// Smallest chunk a level is split into for parallel evaluation
+inline constexpr size_t MIN_PARALLEL_GRAIN = 256;
+
+/// Same as propagate_lanes(), but levels of at least @p min_parallel_slots
+/// gates are split into chunks evaluated across @p pool, with a barrier
+/// between levels. Smaller levels run serially on the calling thread.
+template <size_t W>
+void propagate_lanes(const CompiledNetlist& net, LaneBlock<W>* values, ThreadPool& pool,
+                     size_t min_parallel_slots);
+
+/// Simulates 64*W input vectors per pass over a finalized circuit.
+///
+/// Holds its own per-wire lane state, so several simulators (of different
+/// widths) can run against the same circuit without touching its scalar
+/// or packed state. The circuit must outlive the simulator and must not be
+/// modified while it is in use.
+template <size_t W> class LaneSimulator {
+  public:
+    using Block = LaneBlock<W>;
+
+    /// @throws std::runtime_error if the circuit is not finalized
+    explicit LaneSimulator(const Circuit& circuit);
+
+    /// Sets all lanes of the i-th primary input wire
+    void set_input(size_t index, const Block& lanes);
+
+    /// Evaluates all gates over the current input lanes, in parallel if the
+    /// circuit has a thread pool (see Circuit::set_parallelism)
+    void propagate();
+
+    /// Reads all lanes of the i-th primary output wire
+    [[nodiscard]] const Block& get_output(size_t index) const;
+
+  private:
+    const Circuit* circuit_;
+    std::vector<Block> values_; ///< Lane block per wire id
+};
+
+extern template void propagate_lanes<1>(const CompiledNetlist&, LaneBlock<1>*);
+extern template void propagate_lanes<2>(const CompiledNetlist&, LaneBlock<2>*);
+extern template void propagate_lanes<4>(const CompiledNetlist&, LaneBlock<4>*);
+extern template void propagate_lanes<1>(const CompiledNetlist&, LaneBlock<1>*, ThreadPool&, size_t);
+extern template void propagate_lanes<2>(const CompiledNetlist&, LaneBlock<2>*, ThreadPool&, size_t);
+extern template void propagate_lanes<4>(const CompiledNetlist&, LaneBlock<4>*, ThreadPool&, size_t);
+extern template LaneBlock<1> evaluate_lane_slot<1>(const CompiledNetlist&, uint32_t,
+                                                   const LaneBlock<1>*);
+extern template LaneBlock<2> evaluate_lane_slot<2>(const CompiledNetlist&, uint32_t,
+                                                   const LaneBlock<2>*);
+extern template LaneBlock<4> evaluate_lane_slot<4>(const CompiledNetlist&, uint32_t,
+                                                   const LaneBlock<4>*);
+extern template class LaneSimulator<1>;
+extern template class LaneSimulator<2>;
+extern template class LaneSimulator<4>;
+
+/// Simulator at the widest width the compile target supports
+using NativeLaneSimulator = LaneSimulator<NATIVE_LANE_WORDS>;
+
+} // namespace gateflow
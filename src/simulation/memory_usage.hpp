@@ -0,0 +1,103 @@
+#pragma once
+
+/// @file memory_usage.hpp
+/// @brief Heap bytes and allocation counts of a structure, broken down by category
+///
+/// Every long-lived structure (Circuit, Layout, PropagationScheduler,
+/// AnimationState, ...) reports what it holds through memory_usage(). Bytes
+/// are what the structure has allocated, i.e. vector capacities rather than
+/// sizes, excluding allocator overhead and the object itself; allocations
+/// count the heap blocks behind them. Both are computed on demand from the
+/// containers, so nothing is tracked while the structure is in use.
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gateflow {
+
+/// One category of a memory report
+struct MemoryCategory {
+    std::string name;
+    size_t bytes = 0;
+    size_t allocations = 0;
+};
+
+/// Categories in the order first added
+struct MemoryUsage {
+    std::vector<MemoryCategory> categories;
+
+    /// Adds to the category @p name, creating it if needed
+    void add(std::string_view name, size_t bytes, size_t allocations) {
+        for (MemoryCategory& c : categories) {
+            if (c.name == name) {
+                c.bytes += bytes;
+                c.allocations += allocations;
+                return;
+            }
+        }
+        categories.push_back({std::string(name), bytes, allocations});
+    }
+
+    /// Adds a vector's buffer to the category @p name
+    template <typename T> void add_vector(std::string_view name, const std::vector<T>& v) {
+        add(name, v.capacity() * sizeof(T), v.capacity() > 0 ? 1 : 0);
+    }
+
+    /// Adds a string's buffer, if it is too long for the small-string buffer
+    void add_string(std::string_view name, const std::string& s) {
+        const bool on_heap = s.capacity() > std::string().capacity();
+        add(name, on_heap ? s.capacity() + 1 : 0, on_heap ? 1 : 0);
+    }
+
+    /// Adds a vector of vectors: the outer buffer and every inner one
+    template <typename T>
+    void add_nested(std::string_view name, const std::vector<std::vector<T>>& v) {
+        add_vector(name, v);
+        for (const std::vector<T>& inner : v) {
+            add_vector(name, inner);
+        }
+    }
+
+    /// Adds every category of @p other, merging equal names
+    void add_all(const MemoryUsage& other) {
+        for (const MemoryCategory& c : other.categories) {
+            add(c.name, c.bytes, c.allocations);
+        }
+    }
+
+    /// The category @p name, or zeros if there is none
+    [[nodiscard]] MemoryCategory category(std::string_view name) const {
+        for (const MemoryCategory& c : categories) {
+            if (c.name == name) {
+                return c;
+            }
+        }
+        return {std::string(name), 0, 0};
+    }
+
+    [[nodiscard]] size_t total_bytes() const {
+        size_t total = 0;
+        for (const MemoryCategory& c : categories) {
+            total += c.bytes;
+        }
+        return total;
+    }
+
+    [[nodiscard]] size_t total_allocations() const {
+        size_t total = 0;
+        for (const MemoryCategory& c : categories) {
+            total += c.allocations;
+        }
+        return total;
+    }
+};
+
+/// A structure's report under a display name, for tables covering several
+struct NamedMemoryUsage {
+    std::string name;
+    MemoryUsage usage;
+};
+
+} // namespace gateflow
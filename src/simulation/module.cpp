@@ -0,0 +1,57 @@
+/// @file module.cpp
+/// @brief Implements sub-circuit instantiation
+
+#include "simulation/module.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace gateflow {
+
+std::vector<Wire*> instantiate(Circuit& circuit, const Circuit& module, const std::string& name,
+                               const std::vector<Wire*>& inputs) {
+    if (!module.is_finalized()) {
+        throw std::runtime_error("Module " + name + " must be finalized before instantiation");
+    }
+    if (inputs.size() != module.num_inputs()) {
+        throw std::invalid_argument("Module " + name + " expects " +
+                                    std::to_string(module.num_inputs()) + " inputs, got " +
+                                    std::to_string(inputs.size()));
+    }
+
+    // Module wire id -> wire in the circuit: ports map to the caller's wires,
+    // everything else gets a fresh wire
+    std::vector<Wire*> wires(module.wires().size(), nullptr);
+    for (size_t i = 0; i < inputs.size(); i++) {
+        if (inputs[i] == nullptr) {
+            throw std::invalid_argument("Module " + name + " input " + std::to_string(i) +
+                                        " is null");
+        }
+        wires[module.input_wires()[i]->get_id()] = inputs[i];
+    }
+    for (const Wire* wire : module.wires()) {
+        if (wires[wire->get_id()] == nullptr) {
+            wires[wire->get_id()] = circuit.add_wire();
+        }
+    }
+
+    const uint32_t instance = circuit.add_instance(name);
+    for (const Gate* gate : module.gates()) {
+        Gate* copy = circuit.add_gate(gate->get_type(), instance);
+        for (const Wire* input : gate->get_inputs()) {
+            circuit.connect(wires[input->get_id()], nullptr, copy);
+        }
+        if (const Wire* out = gate->get_output()) {
+            circuit.connect(wires[out->get_id()], copy, nullptr);
+        }
+    }
+
+    std::vector<Wire*> outputs;
+    outputs.reserve(module.num_outputs());
+    for (const Wire* wire : module.output_wires()) {
+        outputs.push_back(wires[wire->get_id()]);
+    }
+    return outputs;
+}
+
+} // namespace gateflow
@@ -0,0 +1,32 @@
+#pragma once
+
+/// @file module.hpp
+/// @brief Stamps a finalized sub-circuit into a larger circuit as a tagged instance
+
+#include "simulation/circuit.hpp"
+
+#include <string>
+#include <vector>
+
+namespace gateflow {
+
+/// Copies the gates and internal wires of @p module into @p circuit, wiring
+/// the module's primary inputs to @p inputs, and tags every copied gate with
+/// a new instance of @p name (see Circuit::instance_of()).
+///
+/// The module is the definition: it is built (and, say, decomposed to NAND)
+/// once, then stamped per instance. Gates and wires are created in the
+/// module's id order, so every instance has the module's internal structure,
+/// input order included. @p circuit is left unfinalized.
+///
+/// @param circuit The circuit to add the instance to
+/// @param module  A finalized circuit whose inputs and outputs are the ports
+/// @param name    Module name recorded for the instance
+/// @param inputs  Wires of @p circuit driving the module's inputs, in order
+/// @return The instance's wires for the module's outputs, in order
+/// @throws std::runtime_error if @p module is not finalized
+/// @throws std::invalid_argument if @p inputs does not match the module's inputs
+std::vector<Wire*> instantiate(Circuit& circuit, const Circuit& module, const std::string& name,
+                               const std::vector<Wire*>& inputs);
+
+} // namespace gateflow
@@ -1,167 +1,179 @@
 /// @file nand_decompose.cpp
-/// @brief Replaces all non-NAND gates with NAND-equivalent sub-circuits
+/// @brief Rebuilds a circuit with every gate replaced by its NAND-only equivalent
 
 #include "simulation/nand_decompose.hpp"
 
-#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace gateflow {
 
 namespace {
 
-/// Helper: connect a wire as input to a gate, updating both sides
-void link_input(Wire* wire, Gate* gate) {
-    gate->add_input(wire);
-    wire->add_destination(gate);
+using Wires = std::initializer_list<Wire*>;
+
+/// NAND gates emitted for one gate of @p type with @p inputs inputs
+size_t nand_count(GateType type, size_t inputs) {
+    switch (type) {
+    case GateType::NOT:
+    case GateType::NAND:
+        return 1;
+    case GateType::BUFFER:
+    case GateType::AND:
+        return 2;
+    case GateType::OR:
+        return inputs + 1;
+    case GateType::XOR:
+        return 4 * (inputs - 1);
+    }
+    return 1;
 }
 
-/// Helper: connect a wire as output from a gate, updating both sides
-void link_output(Wire* wire, Gate* gate) {
-    gate->set_output(wire);
-    wire->set_source(gate);
-}
+/// Emits NAND gates into a new circuit, tagged with one instance at a time
+class NandEmitter {
+  public:
+    explicit NandEmitter(Circuit& out) : out_(out) {}
 
-/// Helper: disconnect a gate from all its input wires' destination lists,
-/// then clear the gate's own input list
-void disconnect_inputs(Gate* gate) {
-    for (Wire* w : gate->get_inputs()) {
-        w->remove_destination(gate);
-    }
-    gate->clear_inputs();
-}
+    /// Instance of the gates emitted from now on
+    void set_instance(uint32_t instance) { instance_ = instance; }
 
-} // namespace
+    /// NAND(@p inputs) on a new wire, inside a replacement
+    template <typename Inputs> Wire* inner(const Inputs& inputs) {
+        Wire* wire = out_.add_wire();
+        out_.connect(wire, add(inputs), nullptr);
+        return wire;
+    }
 
-void decompose_to_nand(Circuit& circuit) {
-    // Collect gates to decompose (snapshot the current list; we'll add new gates)
-    std::vector<Gate*> original_gates;
-    for (auto& g : circuit.gates()) {
-        if (g->get_type() != GateType::NAND) {
-            original_gates.push_back(g.get());
+    /// NAND(@p inputs) driving @p output, the replaced gate's wire (if any)
+    template <typename Inputs> void last(const Inputs& inputs, Wire* output) {
+        Gate* gate = add(inputs);
+        if (output != nullptr) {
+            out_.connect(output, gate, nullptr);
         }
     }
 
-    for (Gate* gate : original_gates) {
-        GateType type = gate->get_type();
-        const auto& inputs = gate->get_inputs();
-        Wire* original_output = gate->get_output();
-
-        switch (type) {
-        case GateType::NOT: {
-            // NOT(A) = NAND(A, A)
-            Wire* a = inputs[0];
-            disconnect_inputs(gate);
-            gate->set_type(GateType::NAND);
-            link_input(a, gate);
-            link_input(a, gate);
-            break;
+  private:
+    template <typename Inputs> Gate* add(const Inputs& inputs) {
+        Gate* gate = out_.add_gate(GateType::NAND, instance_);
+        for (Wire* input : inputs) {
+            out_.connect(input, nullptr, gate);
         }
+        return gate;
+    }
 
-        case GateType::BUFFER: {
-            // BUFFER(A) = NAND(NAND(A,A), NAND(A,A))
-            Wire* a = inputs[0];
+    Circuit& out_;
+    uint32_t instance_ = Circuit::NO_INSTANCE;
+};
 
-            disconnect_inputs(gate);
-            gate->set_type(GateType::NAND);
-            link_input(a, gate);
-            link_input(a, gate);
+} // namespace
 
-            Wire* not_out = circuit.add_wire();
-            link_output(not_out, gate);
+void decompose_to_nand(Circuit& circuit) {
+    if (!circuit.is_finalized()) {
+        throw std::runtime_error("Circuit must be finalized before NAND decomposition");
+    }
 
-            Gate* nand2 = circuit.add_gate(GateType::NAND);
-            link_input(not_out, nand2);
-            link_input(not_out, nand2);
-            link_output(original_output, nand2);
-            break;
-        }
+    // Exact sizes: every wire is kept, plus one inner wire per added NAND
+    size_t gates = 0;
+    for (const Gate* gate : circuit.gates()) {
+        gates += nand_count(gate->get_type(), gate->get_inputs().size());
+    }
+    Circuit result;
+    result.reserve(gates, circuit.wires().size() + gates - circuit.gates().size());
+    for (uint32_t i = 0; i < circuit.num_instances(); i++) {
+        (void)result.add_instance(circuit.instance_module(i));
+    }
 
-        case GateType::AND: {
-            // AND(A,B) = NAND(NAND(A,B), NAND(A,B))
-            Wire* a = inputs[0];
-            Wire* b = inputs[1];
+    // New wire per old wire id, created on first use. Primary inputs come
+    // first so they keep the lowest ids; values are carried over.
+    std::vector<Wire*> wire_of(circuit.wires().size(), nullptr);
+    auto wire_for = [&](const Wire* old) {
+        Wire*& w = wire_of[old->get_id()];
+        if (w == nullptr) {
+            w = result.add_wire();
+            w->set_value(old->get_value());
+        }
+        return w;
+    };
+    for (const Wire* wire : circuit.input_wires()) {
+        result.mark_input(wire_for(wire));
+    }
 
-            disconnect_inputs(gate);
-            gate->set_type(GateType::NAND);
-            link_input(a, gate);
-            link_input(b, gate);
+    // One pass in level order: a gate's inputs are emitted before it, so the
+    // new gate ids are a topological order too and need no sort
+    NandEmitter emit(result);
+    std::vector<Wire*> in;
+    std::vector<Wire*> inverted;
+    for (const Gate* gate : circuit.topological_order()) {
+        in.clear();
+        for (const Wire* wire : gate->get_inputs()) {
+            in.push_back(wire_for(wire));
+        }
+        Wire* out = gate->get_output() != nullptr ? wire_for(gate->get_output()) : nullptr;
+        emit.set_instance(circuit.instance_of(gate));
 
-            Wire* nand_out = circuit.add_wire();
-            link_output(nand_out, gate);
+        switch (gate->get_type()) {
+        case GateType::NOT: // NAND(A, A)
+            emit.last(Wires{in[0], in[0]}, out);
+            break;
 
-            Gate* nand2 = circuit.add_gate(GateType::NAND);
-            link_input(nand_out, nand2);
-            link_input(nand_out, nand2);
-            link_output(original_output, nand2);
+        case GateType::BUFFER: { // NAND(NAND(A,A), NAND(A,A))
+            Wire* n = emit.inner(Wires{in[0], in[0]});
+            emit.last(Wires{n, n}, out);
             break;
         }
 
-        case GateType::OR: {
-            // OR(A,B) = NAND(NAND(A,A), NAND(B,B))
-            Wire* a = inputs[0];
-            Wire* b = inputs[1];
-
-            disconnect_inputs(gate);
-            gate->set_type(GateType::NAND);
-            link_input(a, gate);
-            link_input(a, gate);
-
-            Wire* not_a_out = circuit.add_wire();
-            link_output(not_a_out, gate);
-
-            Gate* not_b = circuit.add_gate(GateType::NAND);
-            link_input(b, not_b);
-            link_input(b, not_b);
-            Wire* not_b_out = circuit.add_wire();
-            link_output(not_b_out, not_b);
-
-            Gate* final_nand = circuit.add_gate(GateType::NAND);
-            link_input(not_a_out, final_nand);
-            link_input(not_b_out, final_nand);
-            link_output(original_output, final_nand);
+        case GateType::AND: { // NAND(NAND(A,B), NAND(A,B))
+            Wire* n = emit.inner(in);
+            emit.last(Wires{n, n}, out);
             break;
         }
 
-        case GateType::XOR: {
-            // XOR(A,B) = NAND(NAND(A, NAND(A,B)), NAND(B, NAND(A,B)))
-            Wire* a = inputs[0];
-            Wire* b = inputs[1];
-
-            disconnect_inputs(gate);
-            gate->set_type(GateType::NAND);
-            link_input(a, gate);
-            link_input(b, gate);
-
-            Wire* nand_ab_out = circuit.add_wire();
-            link_output(nand_ab_out, gate);
-
-            Gate* nand_a = circuit.add_gate(GateType::NAND);
-            link_input(a, nand_a);
-            link_input(nand_ab_out, nand_a);
-            Wire* nand_a_out = circuit.add_wire();
-            link_output(nand_a_out, nand_a);
-
-            Gate* nand_b = circuit.add_gate(GateType::NAND);
-            link_input(b, nand_b);
-            link_input(nand_ab_out, nand_b);
-            Wire* nand_b_out = circuit.add_wire();
-            link_output(nand_b_out, nand_b);
-
-            Gate* final_nand = circuit.add_gate(GateType::NAND);
-            link_input(nand_a_out, final_nand);
-            link_input(nand_b_out, final_nand);
-            link_output(original_output, final_nand);
+        case GateType::OR: // NAND(NAND(A,A), NAND(B,B))
+            inverted.clear();
+            for (Wire* wire : in) {
+                inverted.push_back(emit.inner(Wires{wire, wire}));
+            }
+            emit.last(inverted, out);
+            break;
+
+        case GateType::XOR: { // NAND(NAND(A, NAND(A,B)), NAND(B, NAND(A,B))), pairwise
+            Wire* acc = in[0];
+            for (size_t i = 1; i < in.size(); i++) {
+                Wire* ab = emit.inner(Wires{acc, in[i]});
+                Wire* a = emit.inner(Wires{acc, ab});
+                Wire* b = emit.inner(Wires{in[i], ab});
+                if (i + 1 < in.size()) {
+                    acc = emit.inner(Wires{a, b});
+                } else {
+                    emit.last(Wires{a, b}, out);
+                }
+            }
             break;
         }
 
         case GateType::NAND:
+            emit.last(in, out);
             break;
         }
     }
 
-    // Re-finalize to recompute topological order with the new gates
-    circuit.finalize();
+    for (const Wire* wire : circuit.output_wires()) {
+        result.mark_output(wire_for(wire));
+    }
+    for (const Bus& bus : circuit.input_buses()) {
+        result.add_input_bus(bus.name, bus.first, bus.width);
+    }
+    for (const Bus& bus : circuit.output_buses()) {
+        result.add_output_bus(bus.name, bus.first, bus.width);
+    }
+
+    result.finalize();
+    if (const ThreadPool* pool = circuit.thread_pool()) {
+        result.set_parallelism(pool->concurrency(), circuit.min_parallel_level_slots());
+    }
+    circuit = std::move(result);
 }
 
 } // namespace gateflow
@@ -1,7 +1,7 @@
 #pragma once
 
 /// @file nand_decompose.hpp
-/// @brief Decomposes all gates in a circuit into NAND-only equivalents
+/// @brief Rebuilds a circuit with all gates decomposed into NAND-only equivalents
 
 #include "simulation/circuit.hpp"
 
@@ -16,9 +16,17 @@ namespace gateflow {
 ///   OR(A,B)   = NAND(NAND(A,A), NAND(B,B))
 ///   XOR(A,B)  = NAND(NAND(A, NAND(A,B)), NAND(B, NAND(A,B)))
 ///   BUFFER(A) = NAND(NAND(A,A), NAND(A,A))
+/// Wider AND and OR gates use the same rules with every input; wider XOR
+/// gates are chained pairwise from the left.
 ///
-/// The circuit must be finalized before calling this function.
-/// After decomposition, the circuit is re-finalized.
+/// The circuit is rebuilt in one pass over its topological order, like
+/// optimize(): each gate's NANDs are emitted after those of its sources, so
+/// the rebuilt circuit is finalized in id order without a topological sort.
+/// Primary inputs and outputs keep their order, values and buses, and added
+/// gates join the module instance of the gate they replace. Gate and wire
+/// ids are renumbered, so pointers into the old circuit are invalidated.
+///
+/// @throws std::runtime_error if the circuit is not finalized
 void decompose_to_nand(Circuit& circuit);
 
 } // namespace gateflow
@@ -0,0 +1,480 @@
+/// @file netlist_file.cpp
+/// @brief Netlist file writer, mapped reader with bounds validation, and circuit loader
+
+#include "simulation/netlist_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#define GATEFLOW_NETLIST_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gateflow {
+
+// Compiled sections are raw copies of the engine's arrays
+static_assert(std::is_trivially_copyable_v<GateType> && sizeof(GateType) == sizeof(uint32_t));
+static_assert(std::is_trivially_copyable_v<GateRun> && sizeof(GateRun) == 4 * sizeof(uint32_t));
+
+namespace {
+
+constexpr size_t SECTION_ALIGN = 8;
+
+[[noreturn]] void malformed(const std::string& what) {
+    throw std::runtime_error("Malformed netlist file: " + what);
+}
+
+/// Accumulates a file image: header, section table, then aligned sections
+class ImageWriter {
+  public:
+    explicit ImageWriter(size_t section_count) : table_(section_count) {
+        bytes_.resize(sizeof(NetlistFileHeader) + section_count * sizeof(NetlistSectionEntry));
+    }
+
+    template <typename T> void add(NetlistSection id, const T* data, size_t count) {
+        bytes_.resize((bytes_.size() + SECTION_ALIGN - 1) / SECTION_ALIGN * SECTION_ALIGN);
+        NetlistSectionEntry& entry = table_.at(next_++);
+        entry.id = static_cast<uint32_t>(id);
+        entry.element_size = sizeof(T);
+        entry.offset = bytes_.size();
+        entry.count = count;
+        if (count > 0) {
+            bytes_.resize(bytes_.size() + count * sizeof(T));
+            std::memcpy(bytes_.data() + entry.offset, data, count * sizeof(T));
+        }
+    }
+
+    template <typename T> void add(NetlistSection id, const std::vector<T>& values) {
+        add(id, values.data(), values.size());
+    }
+
+    std::vector<uint8_t> finish(NetlistFileHeader header) {
+        header.section_count = static_cast<uint32_t>(next_);
+        std::memcpy(bytes_.data(), &header, sizeof(header));
+        std::memcpy(bytes_.data() + sizeof(header), table_.data(),
+                    next_ * sizeof(NetlistSectionEntry));
+        return std::move(bytes_);
+    }
+
+  private:
+    std::vector<uint8_t> bytes_;
+    std::vector<NetlistSectionEntry> table_;
+    size_t next_ = 0;
+};
+
+} // namespace
+
+std::vector<uint8_t> serialize_netlist(const Circuit& circuit, const NetlistSaveOptions& options) {
+    if (options.include_compiled && !circuit.is_finalized()) {
+        throw std::runtime_error("Circuit must be finalized to store its compiled netlist");
+    }
+
+    const auto& gates = circuit.gates();
+    const auto& wires = circuit.wires();
+    std::vector<uint8_t> types(gates.size());
+    std::vector<uint32_t> gate_outputs(gates.size());
+    std::vector<uint32_t> fanin_offsets(gates.size() + 1, 0);
+    std::vector<uint32_t> fanin_wires;
+    for (const Gate* gate : gates) {
+        types[gate->get_id()] = static_cast<uint8_t>(gate->get_type());
+        const Wire* out = gate->get_output();
+        gate_outputs[gate->get_id()] = out != nullptr ? out->get_id() : NO_WIRE;
+        for (const Wire* input : gate->get_inputs()) {
+            fanin_wires.push_back(input->get_id());
+        }
+        fanin_offsets[gate->get_id() + 1] = static_cast<uint32_t>(fanin_wires.size());
+    }
+    std::vector<uint32_t> fanout_offsets(wires.size() + 1, 0);
+    std::vector<uint32_t> fanout_gates;
+    fanout_gates.reserve(fanin_wires.size());
+    for (const Wire* wire : wires) {
+        for (const Gate* dest : wire->get_destinations()) {
+            fanout_gates.push_back(dest->get_id());
+        }
+        fanout_offsets[wire->get_id() + 1] = static_cast<uint32_t>(fanout_gates.size());
+    }
+    std::vector<uint32_t> inputs;
+    for (const Wire* wire : circuit.input_wires()) {
+        inputs.push_back(wire->get_id());
+    }
+    std::vector<uint32_t> outputs;
+    for (const Wire* wire : circuit.output_wires()) {
+        outputs.push_back(wire->get_id());
+    }
+
+    ImageWriter image(8 + (options.include_compiled ? 11 : 0) + (options.layout.empty() ? 0 : 1));
+    image.add(NetlistSection::GATE_TYPES, types);
+    image.add(NetlistSection::GATE_OUTPUTS, gate_outputs);
+    image.add(NetlistSection::FANIN_OFFSETS, fanin_offsets);
+    image.add(NetlistSection::FANIN_WIRES, fanin_wires);
+    image.add(NetlistSection::FANOUT_OFFSETS, fanout_offsets);
+    image.add(NetlistSection::FANOUT_GATES, fanout_gates);
+    image.add(NetlistSection::INPUTS, inputs);
+    image.add(NetlistSection::OUTPUTS, outputs);
+
+    if (options.include_compiled) {
+        const CompiledNetlist& net = circuit.compiled();
+        image.add(NetlistSection::COMPILED_TYPES, net.types);
+        image.add(NetlistSection::COMPILED_GATE_IDS, net.gate_ids);
+        image.add(NetlistSection::COMPILED_OUTPUTS, net.outputs);
+        image.add(NetlistSection::COMPILED_INPUT_OFFSETS, net.input_offsets);
+        image.add(NetlistSection::COMPILED_INPUT_WIRES, net.input_wires);
+        image.add(NetlistSection::COMPILED_LEVEL_OFFSETS, net.level_offsets);
+        image.add(NetlistSection::COMPILED_GATE_LEVELS, net.gate_levels);
+        image.add(NetlistSection::COMPILED_RUNS, net.runs);
+        image.add(NetlistSection::COMPILED_LEVEL_RUNS, net.level_runs);
+        image.add(NetlistSection::COMPILED_FANOUT_OFFSETS, net.fanout_offsets);
+        image.add(NetlistSection::COMPILED_FANOUT_SLOTS, net.fanout_slots);
+    }
+    if (!options.layout.empty()) {
+        image.add(NetlistSection::LAYOUT, options.layout);
+    }
+
+    NetlistFileHeader header{};
+    std::memcpy(header.magic, NETLIST_FILE_MAGIC, sizeof(header.magic));
+    header.version = NETLIST_FILE_VERSION;
+    header.byte_order = NETLIST_BYTE_ORDER;
+    header.num_gates = static_cast<uint32_t>(gates.size());
+    header.num_wires = static_cast<uint32_t>(wires.size());
+    header.num_inputs = static_cast<uint32_t>(inputs.size());
+    header.num_outputs = static_cast<uint32_t>(outputs.size());
+    header.num_links = static_cast<uint32_t>(fanin_wires.size());
+    return image.finish(header);
+}
+
+void save_netlist(const Circuit& circuit, const std::string& path,
+                  const NetlistSaveOptions& options) {
+    const std::vector<uint8_t> bytes = serialize_netlist(circuit, options);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()),
+              static_cast<std::streamsize>(bytes.size()));
+    if (!out) {
+        throw std::runtime_error("Cannot write netlist file " + path);
+    }
+}
+
+// --- NetlistFile ---
+
+void NetlistFile::Unmapper::operator()(const uint8_t* data) const {
+#ifdef GATEFLOW_NETLIST_MMAP
+    ::munmap(const_cast<uint8_t*>(data), size);
+#else
+    (void)data;
+#endif
+}
+
+NetlistFile NetlistFile::open(const std::string& path) {
+    NetlistFile file;
+#ifdef GATEFLOW_NETLIST_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open netlist file " + path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read netlist file " + path);
+    }
+    const auto size = static_cast<size_t>(info.st_size);
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file referenced
+    if (addr == MAP_FAILED) {
+        throw std::runtime_error("Cannot map netlist file " + path);
+    }
+    file.mapping_ = std::unique_ptr<const uint8_t, Unmapper>(static_cast<const uint8_t*>(addr),
+                                                             Unmapper{size});
+    file.data_ = file.mapping_.get();
+    file.size_ = size;
+#else
+    // One read into one buffer; the views then alias it exactly as a mapping
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot open netlist file " + path);
+    }
+    file.buffer_.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(file.buffer_.data()),
+            static_cast<std::streamsize>(file.buffer_.size()));
+    if (!in) {
+        throw std::runtime_error("Cannot read netlist file " + path);
+    }
+    file.data_ = file.buffer_.data();
+    file.size_ = file.buffer_.size();
+#endif
+    file.validate();
+    return file;
+}
+
+NetlistFile NetlistFile::from_bytes(std::vector<uint8_t> bytes) {
+    NetlistFile file;
+    file.buffer_ = std::move(bytes);
+    file.data_ = file.buffer_.data();
+    file.size_ = file.buffer_.size();
+    file.validate();
+    return file;
+}
+
+const NetlistSectionEntry* NetlistFile::find(NetlistSection id) const {
+    const auto* table =
+        reinterpret_cast<const NetlistSectionEntry*>(data_ + sizeof(NetlistFileHeader));
+    for (uint32_t i = 0; i < header().section_count; i++) {
+        if (table[i].id == static_cast<uint32_t>(id)) {
+            return &table[i];
+        }
+    }
+    return nullptr;
+}
+
+template <typename T> ArrayView<T> NetlistFile::array(NetlistSection id) const {
+    const NetlistSectionEntry* entry = find(id);
+    if (entry == nullptr) {
+        return {};
+    }
+    return {reinterpret_cast<const T*>(data_ + entry->offset), static_cast<size_t>(entry->count)};
+}
+
+ArrayView<uint8_t> NetlistFile::gate_types() const {
+    return array<uint8_t>(NetlistSection::GATE_TYPES);
+}
+
+ArrayView<uint32_t> NetlistFile::gate_outputs() const {
+    return array<uint32_t>(NetlistSection::GATE_OUTPUTS);
+}
+
+ArrayView<uint32_t> NetlistFile::fanin_offsets() const {
+    return array<uint32_t>(NetlistSection::FANIN_OFFSETS);
+}
+
+ArrayView<uint32_t> NetlistFile::fanin_wires() const {
+    return array<uint32_t>(NetlistSection::FANIN_WIRES);
+}
+
+ArrayView<uint32_t> NetlistFile::fanout_offsets() const {
+    return array<uint32_t>(NetlistSection::FANOUT_OFFSETS);
+}
+
+ArrayView<uint32_t> NetlistFile::fanout_gates() const {
+    return array<uint32_t>(NetlistSection::FANOUT_GATES);
+}
+
+ArrayView<uint32_t> NetlistFile::inputs() const {
+    return array<uint32_t>(NetlistSection::INPUTS);
+}
+
+ArrayView<uint32_t> NetlistFile::outputs() const {
+    return array<uint32_t>(NetlistSection::OUTPUTS);
+}
+
+ArrayView<uint8_t> NetlistFile::section_bytes(NetlistSection id) const {
+    const NetlistSectionEntry* entry = find(id);
+    if (entry == nullptr) {
+        return {};
+    }
+    return {data_ + entry->offset, static_cast<size_t>(entry->count * entry->element_size)};
+}
+
+CompiledNetlist NetlistFile::compiled() const {
+    if (!has_compiled()) {
+        throw std::runtime_error("Netlist file has no compiled netlist");
+    }
+    auto copy = [this](NetlistSection id, auto& out) {
+        using T = typename std::decay_t<decltype(out)>::value_type;
+        const ArrayView<T> view = array<T>(id);
+        out.resize(view.size);
+        if (view.size > 0) {
+            std::memcpy(out.data(), view.data, view.size * sizeof(T));
+        }
+    };
+    CompiledNetlist net;
+    copy(NetlistSection::COMPILED_TYPES, net.types);
+    copy(NetlistSection::COMPILED_GATE_IDS, net.gate_ids);
+    copy(NetlistSection::COMPILED_OUTPUTS, net.outputs);
+    copy(NetlistSection::COMPILED_INPUT_OFFSETS, net.input_offsets);
+    copy(NetlistSection::COMPILED_INPUT_WIRES, net.input_wires);
+    copy(NetlistSection::COMPILED_LEVEL_OFFSETS, net.level_offsets);
+    copy(NetlistSection::COMPILED_GATE_LEVELS, net.gate_levels);
+    copy(NetlistSection::COMPILED_RUNS, net.runs);
+    copy(NetlistSection::COMPILED_LEVEL_RUNS, net.level_runs);
+    copy(NetlistSection::COMPILED_FANOUT_OFFSETS, net.fanout_offsets);
+    copy(NetlistSection::COMPILED_FANOUT_SLOTS, net.fanout_slots);
+    return net;
+}
+
+void NetlistFile::validate() const {
+    if (size_ < sizeof(NetlistFileHeader) ||
+        reinterpret_cast<uintptr_t>(data_) % alignof(NetlistSectionEntry) != 0) {
+        malformed("too short for a header");
+    }
+    const NetlistFileHeader& h = header();
+    if (std::memcmp(h.magic, NETLIST_FILE_MAGIC, sizeof(h.magic)) != 0) {
+        malformed("bad magic");
+    }
+    if (h.version != NETLIST_FILE_VERSION) {
+        malformed("unsupported version " + std::to_string(h.version));
+    }
+    if (h.byte_order != NETLIST_BYTE_ORDER) {
+        malformed("written on a host with a different byte order");
+    }
+    if (h.section_count > (size_ - sizeof(NetlistFileHeader)) / sizeof(NetlistSectionEntry)) {
+        malformed("section table past end of file");
+    }
+
+    // Every section lies inside the file, aligned, with the expected element size
+    struct Expected {
+        NetlistSection id;
+        uint32_t element_size;
+        bool required;
+    };
+    constexpr uint32_t U32 = sizeof(uint32_t);
+    const Expected expected[] = {
+        {NetlistSection::GATE_TYPES, 1, true},
+        {NetlistSection::GATE_OUTPUTS, U32, true},
+        {NetlistSection::FANIN_OFFSETS, U32, true},
+        {NetlistSection::FANIN_WIRES, U32, true},
+        {NetlistSection::FANOUT_OFFSETS, U32, true},
+        {NetlistSection::FANOUT_GATES, U32, true},
+        {NetlistSection::INPUTS, U32, true},
+        {NetlistSection::OUTPUTS, U32, true},
+        {NetlistSection::COMPILED_TYPES, sizeof(GateType), false},
+        {NetlistSection::COMPILED_GATE_IDS, U32, false},
+        {NetlistSection::COMPILED_OUTPUTS, U32, false},
+        {NetlistSection::COMPILED_INPUT_OFFSETS, U32, false},
+        {NetlistSection::COMPILED_INPUT_WIRES, U32, false},
+        {NetlistSection::COMPILED_LEVEL_OFFSETS, U32, false},
+        {NetlistSection::COMPILED_GATE_LEVELS, U32, false},
+        {NetlistSection::COMPILED_RUNS, sizeof(GateRun), false},
+        {NetlistSection::COMPILED_LEVEL_RUNS, U32, false},
+        {NetlistSection::COMPILED_FANOUT_OFFSETS, U32, false},
+        {NetlistSection::COMPILED_FANOUT_SLOTS, U32, false},
+        {NetlistSection::LAYOUT, 1, false},
+    };
+    size_t compiled_sections = 0;
+    for (const Expected& e : expected) {
+        const NetlistSectionEntry* entry = find(e.id);
+        const std::string name = "section " + std::to_string(static_cast<uint32_t>(e.id));
+        if (entry == nullptr) {
+            if (e.required) {
+                malformed(name + " is missing");
+            }
+            continue;
+        }
+        if (e.id >= NetlistSection::COMPILED_TYPES &&
+            e.id <= NetlistSection::COMPILED_FANOUT_SLOTS) {
+            compiled_sections++;
+        }
+        if (entry->element_size != e.element_size || entry->offset % SECTION_ALIGN != 0 ||
+            entry->offset > size_ || entry->count > (size_ - entry->offset) / e.element_size) {
+            malformed(name + " has a bad extent");
+        }
+    }
+    if (compiled_sections != 0 && compiled_sections != 11) {
+        malformed("compiled netlist is incomplete");
+    }
+
+    // Structural indices, so load_circuit() never follows one out of range
+    const size_t gates = h.num_gates;
+    const size_t wires = h.num_wires;
+    auto check_offsets = [](ArrayView<uint32_t> offsets, size_t entries,
+                            ArrayView<uint32_t> payload, const char* what) {
+        if (offsets.size != entries + 1 || offsets[0] != 0 || offsets[entries] != payload.size ||
+            !std::is_sorted(offsets.begin(), offsets.end())) {
+            malformed(std::string(what) + " offsets are inconsistent");
+        }
+    };
+    auto check_ids = [](ArrayView<uint32_t> ids, size_t limit, const char* what) {
+        for (uint32_t id : ids) {
+            if (id >= limit) {
+                malformed(std::string(what) + " index out of range");
+            }
+        }
+    };
+
+    if (gate_types().size != gates || gate_outputs().size != gates) {
+        malformed("gate arrays do not match the gate count");
+    }
+    for (uint8_t type : gate_types()) {
+        if (type >= GATE_TYPE_COUNT) {
+            malformed("unknown gate type " + std::to_string(type));
+        }
+    }
+    for (uint32_t wire : gate_outputs()) {
+        if (wire != NO_WIRE && wire >= wires) {
+            malformed("gate output index out of range");
+        }
+    }
+    if (fanin_wires().size != h.num_links || fanout_gates().size != h.num_links) {
+        malformed("link arrays do not match the link count");
+    }
+    check_offsets(fanin_offsets(), gates, fanin_wires(), "fan-in");
+    check_offsets(fanout_offsets(), wires, fanout_gates(), "fan-out");
+    check_ids(fanin_wires(), wires, "fan-in");
+    check_ids(fanout_gates(), gates, "fan-out");
+    if (inputs().size != h.num_inputs || outputs().size != h.num_outputs) {
+        malformed("I/O arrays do not match their counts");
+    }
+    check_ids(inputs(), wires, "input");
+    check_ids(outputs(), wires, "output");
+}
+
+// --- Loading ---
+
+std::unique_ptr<Circuit> load_circuit(const NetlistFile& file) {
+    auto circuit = std::make_unique<Circuit>();
+    const ArrayView<uint8_t> types = file.gate_types();
+    for (uint8_t type : types) {
+        (void)circuit->add_gate(static_cast<GateType>(type));
+    }
+    for (size_t w = 0; w < file.num_wires(); w++) {
+        (void)circuit->add_wire();
+    }
+    const auto& gates = circuit->gates();
+    const auto& wires = circuit->wires();
+
+    // Links are set list by list (as Circuit::clone() does), so both the
+    // input and destination orders come back exactly; finalize() checks
+    // that the two sides agree.
+    const ArrayView<uint32_t> outputs = file.gate_outputs();
+    const ArrayView<uint32_t> fanin_offsets = file.fanin_offsets();
+    const ArrayView<uint32_t> fanin_wires = file.fanin_wires();
+    for (size_t g = 0; g < gates.size(); g++) {
+        if (outputs[g] != NO_WIRE) {
+            gates[g]->set_output(wires[outputs[g]]);
+            if (wires[outputs[g]]->get_source() == nullptr) {
+                wires[outputs[g]]->set_source(gates[g]);
+            }
+        }
+        for (uint32_t k = fanin_offsets[g]; k < fanin_offsets[g + 1]; k++) {
+            gates[g]->add_input(wires[fanin_wires[k]]);
+        }
+    }
+    const ArrayView<uint32_t> fanout_offsets = file.fanout_offsets();
+    const ArrayView<uint32_t> fanout_gates = file.fanout_gates();
+    for (size_t w = 0; w < wires.size(); w++) {
+        for (uint32_t k = fanout_offsets[w]; k < fanout_offsets[w + 1]; k++) {
+            wires[w]->add_destination(gates[fanout_gates[k]]);
+        }
+    }
+    for (uint32_t wire : file.inputs()) {
+        circuit->mark_input(wires[wire]);
+    }
+    for (uint32_t wire : file.outputs()) {
+        circuit->mark_output(wires[wire]);
+    }
+
+    if (file.has_compiled()) {
+        circuit->finalize(file.compiled());
+    } else {
+        circuit->finalize();
+    }
+    return circuit;
+}
+
+} // namespace gateflow
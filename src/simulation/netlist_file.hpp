@@ -0,0 +1,190 @@
+#pragma once
+
+/// @file netlist_file.hpp
+/// @brief Versioned binary netlist format, written from a Circuit and mapped back without parsing
+///
+/// A netlist file is a fixed header, a section table, and one flat array per
+/// section. Every section starts on an 8-byte boundary and holds elements in
+/// the host's native representation, so a mapped (or read) file is used in
+/// place: the reader hands out typed views into the bytes, and the compiled
+/// sections are bulk-copied into a CompiledNetlist without re-levelizing.
+///
+/// Required sections describe the structure by id, in list order:
+///   gate types, gate output wires, gate fan-in (CSR), wire fan-out (CSR),
+///   primary inputs and primary outputs.
+/// Optional sections hold the arrays of the CompiledNetlist (all or none),
+/// and an opaque layout blob owned by the rendering layer (layout_file.hpp).
+///
+/// Files are only readable on a host with the writer's byte order; the
+/// header records it. Signal values are not stored.
+
+#include "simulation/circuit.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gateflow {
+
+inline constexpr char NETLIST_FILE_MAGIC[4] = {'G', 'F', 'N', 'L'};
+inline constexpr uint32_t NETLIST_FILE_VERSION = 1;
+
+/// Written in native byte order; reads back differently on a foreign host
+inline constexpr uint32_t NETLIST_BYTE_ORDER = 0x01020304u;
+
+/// Section ids. Values are part of the format and must not be reused.
+enum class NetlistSection : uint32_t {
+    // Structure (required)
+    GATE_TYPES = 1,     ///< uint8_t GateType per gate id
+    GATE_OUTPUTS = 2,   ///< uint32_t output wire id per gate id (NO_WIRE if none)
+    FANIN_OFFSETS = 3,  ///< uint32_t, num_gates + 1: inputs of gate g in [off[g], off[g+1])
+    FANIN_WIRES = 4,    ///< uint32_t input wire ids, in each gate's input order
+    FANOUT_OFFSETS = 5, ///< uint32_t, num_wires + 1: destinations of wire w
+    FANOUT_GATES = 6,   ///< uint32_t destination gate ids, in each wire's list order
+    INPUTS = 7,         ///< uint32_t primary input wire ids, in bit order
+    OUTPUTS = 8,        ///< uint32_t primary output wire ids, in bit order
+
+    // CompiledNetlist arrays (optional, all or none; same element types)
+    COMPILED_TYPES = 16,
+    COMPILED_GATE_IDS = 17,
+    COMPILED_OUTPUTS = 18,
+    COMPILED_INPUT_OFFSETS = 19,
+    COMPILED_INPUT_WIRES = 20,
+    COMPILED_LEVEL_OFFSETS = 21,
+    COMPILED_GATE_LEVELS = 22,
+    COMPILED_RUNS = 23,
+    COMPILED_LEVEL_RUNS = 24,
+    COMPILED_FANOUT_OFFSETS = 25,
+    COMPILED_FANOUT_SLOTS = 26,
+
+    LAYOUT = 32, ///< Opaque bytes (see layout_file.hpp)
+};
+
+/// File header, at offset 0. The section table follows immediately.
+struct NetlistFileHeader {
+    char magic[4];          ///< NETLIST_FILE_MAGIC
+    uint32_t version;       ///< NETLIST_FILE_VERSION
+    uint32_t byte_order;    ///< NETLIST_BYTE_ORDER as written
+    uint32_t section_count; ///< Entries in the section table
+    uint32_t num_gates;
+    uint32_t num_wires;
+    uint32_t num_inputs;
+    uint32_t num_outputs;
+    uint32_t num_links;     ///< Gate input / wire destination pairs
+    uint32_t reserved[7];   ///< Zero
+};
+static_assert(sizeof(NetlistFileHeader) == 64);
+
+/// One entry of the section table
+struct NetlistSectionEntry {
+    uint32_t id;           ///< NetlistSection value
+    uint32_t element_size; ///< Bytes per element
+    uint64_t offset;       ///< From the start of the file; a multiple of 8
+    uint64_t count;        ///< Elements
+};
+static_assert(sizeof(NetlistSectionEntry) == 24);
+
+/// Read-only view of a contiguous array inside a netlist file
+template <typename T> struct ArrayView {
+    const T* data = nullptr;
+    size_t size = 0;
+
+    [[nodiscard]] bool empty() const { return size == 0; }
+    [[nodiscard]] const T* begin() const { return data; }
+    [[nodiscard]] const T* end() const { return data + size; }
+    [[nodiscard]] const T& operator[](size_t i) const { return data[i]; }
+};
+
+/// What to store besides the structure
+struct NetlistSaveOptions {
+    bool include_compiled = true; ///< Store the CompiledNetlist (circuit must be finalized)
+    std::vector<uint8_t> layout;  ///< Layout section payload; empty = no layout section
+};
+
+/// Encodes a circuit's structure (and the optional sections) as a netlist file image.
+/// @throws std::runtime_error if include_compiled is set and the circuit is not finalized
+[[nodiscard]] std::vector<uint8_t> serialize_netlist(const Circuit& circuit,
+                                                     const NetlistSaveOptions& options = {});
+
+/// Writes serialize_netlist() to @p path.
+/// @throws std::runtime_error if the file cannot be written
+void save_netlist(const Circuit& circuit, const std::string& path,
+                  const NetlistSaveOptions& options = {});
+
+/// A validated netlist file held in memory: memory-mapped natively, or read
+/// into one buffer where mmap is unavailable (e.g. the Emscripten FS).
+///
+/// Opening checks the header, the section table, and that every structural
+/// index is in range, so the views never point outside the file. Nothing is
+/// decoded; the views alias the file bytes and live as long as this object.
+class NetlistFile {
+  public:
+    /// Maps (or reads) and validates a file.
+    /// @throws std::runtime_error if the file cannot be read or is malformed
+    [[nodiscard]] static NetlistFile open(const std::string& path);
+
+    /// Validates an in-memory file image, taking ownership of it.
+    /// @throws std::runtime_error if the image is malformed
+    [[nodiscard]] static NetlistFile from_bytes(std::vector<uint8_t> bytes);
+
+    [[nodiscard]] bool is_mapped() const { return mapping_ != nullptr; }
+    [[nodiscard]] size_t size_bytes() const { return size_; }
+
+    [[nodiscard]] size_t num_gates() const { return header().num_gates; }
+    [[nodiscard]] size_t num_wires() const { return header().num_wires; }
+    [[nodiscard]] size_t num_inputs() const { return header().num_inputs; }
+    [[nodiscard]] size_t num_outputs() const { return header().num_outputs; }
+
+    [[nodiscard]] ArrayView<uint8_t> gate_types() const;
+    [[nodiscard]] ArrayView<uint32_t> gate_outputs() const;
+    [[nodiscard]] ArrayView<uint32_t> fanin_offsets() const;
+    [[nodiscard]] ArrayView<uint32_t> fanin_wires() const;
+    [[nodiscard]] ArrayView<uint32_t> fanout_offsets() const;
+    [[nodiscard]] ArrayView<uint32_t> fanout_gates() const;
+    [[nodiscard]] ArrayView<uint32_t> inputs() const;
+    [[nodiscard]] ArrayView<uint32_t> outputs() const;
+
+    [[nodiscard]] bool has_section(NetlistSection id) const { return find(id) != nullptr; }
+    /// True if the file stores the CompiledNetlist arrays
+    [[nodiscard]] bool has_compiled() const { return has_section(NetlistSection::COMPILED_TYPES); }
+    /// Raw bytes of a section (empty if absent)
+    [[nodiscard]] ArrayView<uint8_t> section_bytes(NetlistSection id) const;
+
+    /// Copies the stored CompiledNetlist (one memcpy per array).
+    /// @throws std::runtime_error if the file has none (see has_compiled())
+    [[nodiscard]] CompiledNetlist compiled() const;
+
+  private:
+    struct Unmapper {
+        size_t size; ///< Bytes mapped
+        void operator()(const uint8_t* data) const;
+    };
+
+    NetlistFile() = default;
+
+    [[nodiscard]] const NetlistFileHeader& header() const {
+        return *reinterpret_cast<const NetlistFileHeader*>(data_);
+    }
+    [[nodiscard]] const NetlistSectionEntry* find(NetlistSection id) const;
+    template <typename T> [[nodiscard]] ArrayView<T> array(NetlistSection id) const;
+
+    /// Checks everything open() promises
+    void validate() const;
+
+    std::unique_ptr<const uint8_t, Unmapper> mapping_; ///< Set when memory-mapped
+    std::vector<uint8_t> buffer_;                      ///< Owned image otherwise
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/// Rebuilds a finalized circuit from a netlist file. Gates and wires keep
+/// their ids and list orders, so structural_hash() and id-indexed data
+/// (such as a stored layout) match the saved circuit. When the file has a
+/// compiled section it is adopted with Circuit::finalize(CompiledNetlist)
+/// instead of sorting again. All signals start at 0.
+/// @throws std::invalid_argument / std::runtime_error as Circuit::finalize() does
+[[nodiscard]] std::unique_ptr<Circuit> load_circuit(const NetlistFile& file);
+
+} // namespace gateflow
@@ -0,0 +1,230 @@
+/// @file optimize.cpp
+/// @brief Structural hashing over the topological order, then liveness and re-emission
+
+#include "simulation/optimize.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace gateflow {
+
+namespace {
+
+constexpr uint32_t NO_SIGNAL = UINT32_MAX;
+constexpr uint32_t NO_NODE = UINT32_MAX;
+
+/// Function of a gate over its input signals. Inverters of any form share
+/// op NOT; the inputs of commutative gates are sorted.
+struct NodeKey {
+    GateType op;
+    std::vector<uint32_t> inputs;
+
+    bool operator==(const NodeKey& other) const {
+        return op == other.op && inputs == other.inputs;
+    }
+};
+
+struct NodeKeyHash {
+    size_t operator()(const NodeKey& key) const {
+        // FNV-1a over the op and input signals
+        uint64_t h = 1469598103934665603ULL;
+        auto mix = [&h](uint64_t v) {
+            h ^= v;
+            h *= 1099511628211ULL;
+        };
+        mix(static_cast<uint64_t>(key.op));
+        for (uint32_t s : key.inputs) {
+            mix(s);
+        }
+        return static_cast<size_t>(h);
+    }
+};
+
+/// A gate of the optimized netlist, before it is emitted
+struct Node {
+    GateType type;                ///< Type to emit (that of the first gate with this key)
+    GateType op;                  ///< Function; NOT for every inverter
+    std::vector<uint32_t> inputs; ///< Input signals as they will be connected
+    uint32_t output;              ///< Signal this node drives
+};
+
+bool is_idempotent(GateType type) {
+    return type == GateType::AND || type == GateType::OR || type == GateType::NAND;
+}
+
+} // namespace
+
+OptimizeStats optimize(Circuit& circuit) {
+    if (!circuit.is_finalized()) {
+        throw std::runtime_error("Circuit must be finalized before optimization");
+    }
+
+    OptimizeStats stats;
+    stats.gates_before = circuit.gates().size();
+    stats.depth_before = circuit.compiled().num_levels();
+
+    // --- Structural hashing ---
+    // A signal is one distinct value: a sourceless wire (primary input or
+    // dangling) or a node output. Every old wire maps to the signal it carries.
+    const std::vector<Wire*>& old_wires = circuit.wires();
+    std::vector<uint32_t> signal_of(old_wires.size(), NO_SIGNAL);
+    std::vector<uint32_t> driver;            // Per signal: node index or NO_NODE
+    std::vector<const Wire*> source_wire;    // Per signal: the sourceless wire, if any
+    for (const Wire* wire : old_wires) {
+        if (wire->get_source() == nullptr) {
+            signal_of[wire->get_id()] = static_cast<uint32_t>(driver.size());
+            driver.push_back(NO_NODE);
+            source_wire.push_back(wire);
+        }
+    }
+
+    std::vector<uint8_t> is_output(old_wires.size(), 0);
+    for (const Wire* wire : circuit.output_wires()) {
+        is_output[wire->get_id()] = 1;
+    }
+
+    std::vector<Node> nodes;
+    nodes.reserve(circuit.gates().size());
+    std::unordered_map<NodeKey, uint32_t, NodeKeyHash> table;
+    table.reserve(circuit.gates().size());
+    std::vector<uint32_t> inputs;
+
+    for (const Gate* gate : circuit.topological_order()) {
+        const Wire* out = gate->get_output();
+        if (out == nullptr) {
+            stats.removed++; // Drives nothing, so it cannot reach an output
+            continue;
+        }
+        const bool keep = is_output[out->get_id()] != 0;
+
+        inputs.clear();
+        for (const Wire* w : gate->get_inputs()) {
+            inputs.push_back(signal_of[w->get_id()]);
+        }
+
+        const GateType type = gate->get_type();
+        NodeKey key{type, inputs};
+        if (type != GateType::NOT && type != GateType::BUFFER) {
+            std::sort(key.inputs.begin(), key.inputs.end());
+        }
+        if (is_idempotent(type)) {
+            key.inputs.erase(std::unique(key.inputs.begin(), key.inputs.end()), key.inputs.end());
+        }
+
+        // Gates that just pass a signal through
+        uint32_t alias = NO_SIGNAL;
+        if (type == GateType::BUFFER) {
+            alias = key.inputs[0];
+        } else if (key.inputs.size() == 1 && type == GateType::NAND) {
+            key.op = GateType::NOT;
+        } else if (key.inputs.size() == 1 && is_idempotent(type)) {
+            alias = key.inputs[0];
+        }
+        if (key.op == GateType::NOT) {
+            const uint32_t d = driver[key.inputs[0]];
+            if (d != NO_NODE && nodes[d].op == GateType::NOT) {
+                alias = nodes[d].inputs[0];
+            }
+        }
+
+        if (!keep && alias != NO_SIGNAL) {
+            signal_of[out->get_id()] = alias;
+            stats.folded++;
+            continue;
+        }
+        if (!keep) {
+            if (auto it = table.find(key); it != table.end()) {
+                signal_of[out->get_id()] = it->second;
+                stats.merged++;
+                continue;
+            }
+        }
+
+        // A new node. Collapsed inputs are used where the arity stays valid.
+        Node node{type, key.op, {}, static_cast<uint32_t>(driver.size())};
+        if (is_idempotent(type) && key.inputs.size() >= 2) {
+            node.inputs = key.inputs;
+        } else {
+            node.inputs = inputs;
+        }
+        signal_of[out->get_id()] = node.output;
+        driver.push_back(static_cast<uint32_t>(nodes.size()));
+        source_wire.push_back(nullptr);
+        table.emplace(std::move(key), node.output);
+        nodes.push_back(std::move(node));
+    }
+
+    // --- Liveness: walk back from the primary outputs ---
+    std::vector<uint8_t> live(nodes.size(), 0);
+    for (const Wire* wire : circuit.output_wires()) {
+        if (uint32_t d = driver[signal_of[wire->get_id()]]; d != NO_NODE) {
+            live[d] = 1;
+        }
+    }
+    // Nodes were created in topological order, so a reverse sweep sees
+    // every reader before the nodes it reads from
+    for (size_t i = nodes.size(); i-- > 0;) {
+        if (live[i] == 0) {
+            stats.removed++;
+            continue;
+        }
+        for (uint32_t s : nodes[i].inputs) {
+            if (uint32_t d = driver[s]; d != NO_NODE) {
+                live[d] = 1;
+            }
+        }
+    }
+
+    // --- Emit the optimized circuit ---
+    Circuit result;
+    std::vector<Wire*> wire_of(driver.size(), nullptr);
+    auto wire_for = [&](uint32_t s) {
+        if (wire_of[s] == nullptr) {
+            wire_of[s] = result.add_wire();
+            if (source_wire[s] != nullptr) {
+                wire_of[s]->set_value(source_wire[s]->get_value());
+            }
+        }
+        return wire_of[s];
+    };
+
+    // Primary inputs first, so they keep the lowest wire ids
+    for (const Wire* wire : circuit.input_wires()) {
+        result.mark_input(wire_for(signal_of[wire->get_id()]));
+    }
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (live[i] == 0) {
+            continue;
+        }
+        Gate* gate = result.add_gate(nodes[i].type);
+        for (uint32_t s : nodes[i].inputs) {
+            result.connect(wire_for(s), nullptr, gate);
+        }
+        result.connect(wire_for(nodes[i].output), gate, nullptr);
+    }
+    for (const Wire* wire : circuit.output_wires()) {
+        result.mark_output(wire_for(signal_of[wire->get_id()]));
+    }
+    // Port order is kept, so the buses carry over as they are
+    for (const Bus& bus : circuit.input_buses()) {
+        result.add_input_bus(bus.name, bus.first, bus.width);
+    }
+    for (const Bus& bus : circuit.output_buses()) {
+        result.add_output_bus(bus.name, bus.first, bus.width);
+    }
+
+    result.finalize();
+    if (const ThreadPool* pool = circuit.thread_pool()) {
+        result.set_parallelism(pool->concurrency(), circuit.min_parallel_level_slots());
+    }
+
+    stats.gates_after = result.gates().size();
+    stats.depth_after = result.compiled().num_levels();
+    circuit = std::move(result);
+    return stats;
+}
+
+} // namespace gateflow
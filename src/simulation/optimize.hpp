@@ -0,0 +1,42 @@
+#pragma once
+
+/// @file optimize.hpp
+/// @brief Structural-hashing netlist optimization (CSE, inversion folding, dead gates)
+
+#include "simulation/circuit.hpp"
+
+#include <cstddef>
+
+namespace gateflow {
+
+/// Gate counts and depths around one optimize() pass
+struct OptimizeStats {
+    size_t gates_before = 0;
+    size_t gates_after = 0;
+    size_t depth_before = 0; ///< Levels in the compiled netlist before the pass
+    size_t depth_after = 0;  ///< Levels after the pass
+    size_t merged = 0;       ///< Gates replaced by an equivalent earlier gate
+    size_t folded = 0;       ///< Buffers, idempotent gates and double inversions bypassed
+    size_t removed = 0;      ///< Remaining gates that could not reach a primary output
+};
+
+/// Rebuilds the circuit with structurally equivalent logic shared.
+///
+/// Gates are visited in topological order and keyed by their function and
+/// (sorted) input signals, AIG-style, so that:
+///   - gates with the same key are merged (e.g. the NAND(A,B) that
+///     decompose_to_nand() emits for both the AND and XOR of a half adder)
+///   - repeated inputs of AND/OR/NAND are collapsed; NAND(A,A) counts as NOT(A)
+///   - BUFFER(A), AND(A,A), OR(A,A) and NOT(NOT(A)) are replaced by A
+///   - gates with no path to a primary output are removed
+/// A gate driving a primary output is always kept, so output wires stay
+/// distinct. Surviving gates keep their type (a NAND-only circuit stays
+/// NAND-only), primary inputs and outputs keep their order, input values and
+/// buses, and gate/wire ids are renumbered densely. Module instances are
+/// dropped. The circuit is re-finalized.
+///
+/// The circuit must be finalized before calling this function.
+/// @throws std::runtime_error if the circuit is not finalized
+OptimizeStats optimize(Circuit& circuit);
+
+} // namespace gateflow
@@ -0,0 +1,102 @@
+/// @file thread_pool.cpp
+/// @brief ThreadPool worker loop and chunk dispatch
+
+#include "simulation/thread_pool.hpp"
+
+#include <algorithm>
+
+namespace gateflow {
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define GATEFLOW_HAS_THREADS 0
+#else
+#define GATEFLOW_HAS_THREADS 1
+#endif
+
+ThreadPool::ThreadPool(size_t threads) {
+#if GATEFLOW_HAS_THREADS
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads - 1);
+    for (size_t i = 1; i < threads; i++) {
+        workers_.emplace_back([this] { worker_loop(); });
+    }
+#else
+    (void)threads;
+#endif
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::dispatch(size_t begin, size_t end, size_t grain, ChunkFn fn, void* ctx) {
+    if (begin >= end) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+
+    // A single chunk, or no workers: run inline and skip the handshake
+    if (workers_.empty() || end - begin <= grain) {
+        fn(ctx, begin, end);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fn_ = fn;
+        ctx_ = ctx;
+        end_ = end;
+        grain_ = grain;
+        next_.store(begin, std::memory_order_relaxed);
+        busy_workers_ = workers_.size();
+        generation_++;
+    }
+    wake_.notify_all();
+
+    run_chunks();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return busy_workers_ == 0; });
+}
+
+void ThreadPool::run_chunks() {
+    for (;;) {
+        const size_t lo = next_.fetch_add(grain_, std::memory_order_relaxed);
+        if (lo >= end_) {
+            return;
+        }
+        fn_(ctx_, lo, std::min(lo + grain_, end_));
+    }
+}
+
+void ThreadPool::worker_loop() {
+    size_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        run_chunks();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--busy_workers_ == 0) {
+            done_.notify_one();
+        }
+    }
+}
+
+} // namespace gateflow
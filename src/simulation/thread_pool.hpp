@@ -0,0 +1,66 @@
+#pragma once
+
+/// @file thread_pool.hpp
+/// @brief Fixed-size worker pool for data-parallel loops with a barrier per call
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gateflow {
+
+/// Runs index ranges across a fixed set of worker threads plus the caller.
+///
+/// parallel_for() splits [begin, end) into chunks of @p grain indices. Every
+/// participating thread claims the next unclaimed chunk until none remain,
+/// so faster threads take over the work of slower ones. The call returns only
+/// once every chunk has finished, which makes each call a barrier.
+///
+/// Without thread support (an Emscripten build without pthreads) the pool
+/// has no workers and parallel_for() runs on the caller.
+class ThreadPool {
+  public:
+    /// @param threads Total threads including the caller; 0 = hardware concurrency
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Number of threads that take part in a parallel_for (workers + caller)
+    [[nodiscard]] size_t concurrency() const { return workers_.size() + 1; }
+
+    /// Calls fn(lo, hi) over disjoint chunks covering [begin, end).
+    /// @p fn must not throw. Not reentrant: one parallel_for at a time.
+    template <typename Fn> void parallel_for(size_t begin, size_t end, size_t grain, Fn&& fn) {
+        auto thunk = [](void* ctx, size_t lo, size_t hi) { (*static_cast<Fn*>(ctx))(lo, hi); };
+        dispatch(begin, end, grain, thunk, &fn);
+    }
+
+  private:
+    using ChunkFn = void (*)(void* ctx, size_t lo, size_t hi);
+
+    void dispatch(size_t begin, size_t end, size_t grain, ChunkFn fn, void* ctx);
+    void run_chunks();
+    void worker_loop();
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_; ///< Signals a new job (or shutdown) to workers
+    std::condition_variable done_; ///< Signals the caller that all workers finished
+    size_t generation_ = 0;        ///< Bumped per job so workers run each job once
+    size_t busy_workers_ = 0;      ///< Workers still inside the current job
+    bool stop_ = false;
+
+    // Current job, published under mutex_ before generation_ is bumped
+    ChunkFn fn_ = nullptr;
+    void* ctx_ = nullptr;
+    size_t end_ = 0;
+    size_t grain_ = 1;
+    std::atomic<size_t> next_{0}; ///< First index of the next unclaimed chunk
+};
+
+} // namespace gateflow
@@ -3,11 +3,10 @@
 
 #include "simulation/wire.hpp"
 
-#include <algorithm>
-
 namespace gateflow {
 
-Wire::Wire(uint32_t id) : id_(id) {}
+Wire::Wire(uint32_t id, PointerListPool<Gate>& destination_pool)
+    : id_(id), destination_pool_(&destination_pool) {}
 
 void Wire::set_value(bool value) {
     previous_value_ = value_;
@@ -15,14 +14,11 @@ void Wire::set_value(bool value) {
 }
 
 void Wire::add_destination(Gate* gate) {
-    destinations_.push_back(gate);
+    destinations_.push_back(gate, *destination_pool_);
 }
 
 void Wire::remove_destination(Gate* gate) {
-    auto it = std::find(destinations_.begin(), destinations_.end(), gate);
-    if (it != destinations_.end()) {
-        destinations_.erase(it);
-    }
+    destinations_.erase_one(gate);
 }
 
 } // namespace gateflow
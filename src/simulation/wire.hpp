@@ -3,8 +3,9 @@
 /// @file wire.hpp
 /// @brief Wire model — connects gate outputs to gate inputs
 
+#include "simulation/arena.hpp"
+
 #include <cstdint>
-#include <vector>
 
 namespace gateflow {
 
@@ -16,14 +17,19 @@ class Gate; // Forward declaration
 /// externally). previous_value is retained for edge detection and animation.
 class Wire {
   public:
-    /// Construct a wire with a unique ID
-    explicit Wire(uint32_t id);
+    /// Construct a wire with a unique ID. Its destination list is allocated
+    /// from @p destination_pool, which must outlive the wire.
+    Wire(uint32_t id, PointerListPool<Gate>& destination_pool);
+
+    // Non-copyable: the destination list's storage belongs to the pool
+    Wire(const Wire&) = delete;
+    Wire& operator=(const Wire&) = delete;
 
     [[nodiscard]] uint32_t get_id() const { return id_; }
     [[nodiscard]] bool get_value() const { return value_; }
     [[nodiscard]] bool get_previous_value() const { return previous_value_; }
     [[nodiscard]] Gate* get_source() const { return source_; }
-    [[nodiscard]] const std::vector<Gate*>& get_destinations() const { return destinations_; }
+    [[nodiscard]] const PooledList<Gate>& get_destinations() const { return destinations_; }
 
     /// Sets the wire's value, saving the old value in previous_value
     void set_value(bool value);
@@ -44,7 +50,8 @@ class Wire {
     bool value_ = false;
     bool previous_value_ = false;
     Gate* source_ = nullptr;
-    std::vector<Gate*> destinations_;
+    PointerListPool<Gate>* destination_pool_;
+    PooledList<Gate> destinations_;
 };
 
 } // namespace gateflow
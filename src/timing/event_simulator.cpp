@@ -0,0 +1,256 @@
+/// @file event_simulator.cpp
+/// @brief Implements the timing-wheel event simulation and its transition record
+
+#include "timing/event_simulator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gateflow {
+
+namespace {
+
+/// A delay in ticks, rounded to the nearest tick
+/// @throws std::invalid_argument if @p delay is out of range
+uint32_t delay_to_ticks(float delay) {
+    const float ticks = delay * static_cast<float>(EventSimulator::TICKS_PER_UNIT);
+    if (!std::isfinite(delay) || delay < 0.0f ||
+        ticks > static_cast<float>(EventSimulator::MAX_DELAY_TICKS)) {
+        throw std::invalid_argument("Gate delay must be finite, non-negative and at most "
+                                    "MAX_DELAY_TICKS ticks");
+    }
+    return static_cast<uint32_t>(std::lround(ticks));
+}
+
+float ticks_to_time(uint64_t ticks) {
+    return static_cast<float>(ticks) / static_cast<float>(EventSimulator::TICKS_PER_UNIT);
+}
+
+} // namespace
+
+EventSimulator::EventSimulator(const Circuit& circuit, const DelayModel& model)
+    : circuit_(&circuit) {
+    if (!circuit.is_finalized()) {
+        throw std::runtime_error("Circuit must be finalized before event simulation");
+    }
+    const CompiledNetlist& net = circuit.compiled();
+    delay_ticks_.resize(net.num_gates());
+    slot_of_.resize(net.num_gates());
+    for (uint32_t slot = 0; slot < net.num_gates(); slot++) {
+        delay_ticks_[slot] = delay_to_ticks(model.delay(net.types[slot]));
+        slot_of_[net.gate_ids[slot]] = slot;
+    }
+    eval_stamp_.assign(net.num_gates(), 0);
+    touch_stamp_.assign(circuit.wires().size(), 0);
+    fit_wheel();
+    settle();
+}
+
+uint32_t EventSimulator::index_of(const Gate* gate) const {
+    const uint32_t id = gate->get_id();
+    if (id >= slot_of_.size() || circuit_->gates()[id] != gate) {
+        throw std::invalid_argument("Gate is not part of the simulated circuit");
+    }
+    return id;
+}
+
+uint32_t EventSimulator::index_of(const Wire* wire) const {
+    const uint32_t id = wire->get_id();
+    if (id >= values_.size() || circuit_->wires()[id] != wire) {
+        throw std::invalid_argument("Wire is not part of the simulated circuit");
+    }
+    return id;
+}
+
+void EventSimulator::set_gate_delay(const Gate* gate, float delay) {
+    delay_ticks_[slot_of_[index_of(gate)]] = delay_to_ticks(delay);
+    fit_wheel();
+}
+
+float EventSimulator::gate_delay(const Gate* gate) const {
+    return ticks_to_time(delay_ticks_[slot_of_[index_of(gate)]]);
+}
+
+void EventSimulator::fit_wheel() {
+    uint32_t horizon = 0;
+    for (uint32_t ticks : delay_ticks_) {
+        horizon = std::max(horizon, ticks);
+    }
+    // Only between runs, when the wheel is empty
+    if (horizon > wheel_.horizon()) {
+        wheel_ = TimingWheel<WireEvent>(horizon);
+    }
+}
+
+bool EventSimulator::evaluate_slot(uint32_t slot) const {
+    const CompiledNetlist& net = circuit_->compiled();
+    const uint32_t begin = net.input_offsets[slot];
+    const uint32_t end = net.input_offsets[slot + 1];
+    uint64_t mask = 0;
+    for (uint32_t k = begin; k < end; k++) {
+        mask |= uint64_t{values_[net.input_wires[k]]} << (k - begin);
+    }
+    return evaluate_mask(net.types[slot], mask, end - begin);
+}
+
+void EventSimulator::record_tick(uint64_t tick) {
+    const float time = ticks_to_time(tick);
+    for (const WireEvent& before : touched_) {
+        const uint32_t w = before.wire;
+        if ((values_[w] != 0) != before.value) {
+            transitions_.push_back({time, w, values_[w] != 0});
+            counts_[w]++;
+            settle_times_[w] = time;
+        }
+    }
+    touched_.clear();
+}
+
+void EventSimulator::clear_record() {
+    const size_t num_wires = circuit_->wires().size();
+    transitions_.clear();
+    counts_.assign(num_wires, 0);
+    settle_times_.assign(num_wires, 0.0f);
+    glitch_count_ = 0;
+    events_processed_ = 0;
+    end_time_ = 0.0f;
+}
+
+void EventSimulator::settle() {
+    const CompiledNetlist& net = circuit_->compiled();
+    const std::vector<Wire*>& inputs = circuit_->input_wires();
+
+    // Undriven wires other than the inputs read as 0, as in the compiled kernels
+    values_.assign(circuit_->wires().size(), 0);
+    input_values_.resize(inputs.size());
+    for (size_t i = 0; i < inputs.size(); i++) {
+        input_values_[i] = inputs[i]->get_value() ? 1 : 0;
+        values_[inputs[i]->get_id()] = input_values_[i];
+    }
+    for (uint32_t slot = 0; slot < net.num_gates(); slot++) {
+        if (net.outputs[slot] != NO_WIRE) {
+            values_[net.outputs[slot]] = evaluate_slot(slot) ? 1 : 0;
+        }
+    }
+    projected_ = values_;
+    wheel_.clear();
+    clear_record();
+}
+
+bool EventSimulator::simulate() {
+    const std::vector<Wire*>& inputs = circuit_->input_wires();
+    bool changed = false;
+    for (size_t i = 0; i < inputs.size() && !changed; i++) {
+        changed = (inputs[i]->get_value() ? 1 : 0) != input_values_[i];
+    }
+    if (!changed) {
+        return false;
+    }
+
+    clear_record();
+    wheel_.clear();
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const uint8_t v = inputs[i]->get_value() ? 1 : 0;
+        const uint32_t id = inputs[i]->get_id();
+        input_values_[i] = v;
+        if (projected_[id] != v) {
+            projected_[id] = v;
+            wheel_.schedule(0, {id, v != 0});
+        }
+    }
+
+    // Each pass applies every event of one tick, then evaluates each gate
+    // reading a changed wire once, so inputs changing together cannot make
+    // a zero-width pulse. Zero-delay outputs land on the same tick and get
+    // another pass. Transitions are recorded once the tick is done, so a
+    // wire that changes and changes back within one tick records nothing.
+    const CompiledNetlist& net = circuit_->compiled();
+    uint64_t current = wheel_.now();
+    tick_serial_++;
+    while (wheel_.advance()) {
+        const uint64_t tick = wheel_.now();
+        if (tick != current) {
+            record_tick(current);
+            current = tick;
+            tick_serial_++;
+        }
+        pass_++;
+        pending_slots_.clear();
+
+        WireEvent event{};
+        while (wheel_.pop(event)) {
+            events_processed_++;
+            const uint8_t v = event.value ? 1 : 0;
+            if (values_[event.wire] == v) {
+                continue;
+            }
+            if (touch_stamp_[event.wire] != tick_serial_) {
+                touch_stamp_[event.wire] = tick_serial_;
+                touched_.push_back({event.wire, values_[event.wire] != 0});
+            }
+            values_[event.wire] = v;
+            for (uint32_t k = net.fanout_offsets[event.wire];
+                 k < net.fanout_offsets[event.wire + 1]; k++) {
+                const uint32_t slot = net.fanout_slots[k];
+                if (eval_stamp_[slot] != pass_) {
+                    eval_stamp_[slot] = pass_;
+                    pending_slots_.push_back(slot);
+                }
+            }
+        }
+
+        // Transport delay: queue a change whenever the output would differ
+        // from what is already queued for it
+        for (uint32_t slot : pending_slots_) {
+            const uint32_t out = net.outputs[slot];
+            if (out == NO_WIRE) {
+                continue;
+            }
+            const uint8_t v = evaluate_slot(slot) ? 1 : 0;
+            if (v != projected_[out]) {
+                projected_[out] = v;
+                wheel_.schedule(tick + delay_ticks_[slot], {out, v != 0});
+            }
+        }
+    }
+
+    record_tick(current);
+
+    glitch_count_ = static_cast<size_t>(
+        std::count_if(counts_.begin(), counts_.end(), [](uint32_t n) { return n > 1; }));
+    end_time_ = transitions_.empty() ? 0.0f : transitions_.back().time;
+    return true;
+}
+
+uint32_t EventSimulator::transition_count(const Wire* wire) const {
+    return counts_[index_of(wire)];
+}
+
+float EventSimulator::settle_time(const Wire* wire) const {
+    return settle_times_[index_of(wire)];
+}
+
+bool EventSimulator::value(const Wire* wire) const {
+    return values_[index_of(wire)] != 0;
+}
+
+MemoryUsage EventSimulator::memory_usage() const {
+    MemoryUsage usage;
+    usage.add_vector("wire state", delay_ticks_);
+    usage.add_vector("wire state", slot_of_);
+    usage.add_vector("wire state", values_);
+    usage.add_vector("wire state", projected_);
+    usage.add_vector("wire state", input_values_);
+    usage.add_vector("wire state", eval_stamp_);
+    usage.add_vector("wire state", pending_slots_);
+    usage.add_vector("wire state", touch_stamp_);
+    usage.add_vector("wire state", touched_);
+    usage.add_vector("wire state", counts_);
+    usage.add_vector("wire state", settle_times_);
+    usage.add("timing wheel", wheel_.heap_bytes(), wheel_.heap_allocations());
+    usage.add_vector("transitions", transitions_);
+    return usage;
+}
+
+} // namespace gateflow
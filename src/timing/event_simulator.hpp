@@ -0,0 +1,149 @@
+/// @file event_simulator.hpp
+/// @brief Event-driven simulation with per-gate delays that records every transition.
+///
+/// Circuit::propagate() and the scheduler's depth and delay time bases only
+/// know each wire's final value. With unequal path delays, a gate can see
+/// its inputs change at different times and switch more than once before it
+/// settles: the sum bits of a ripple-carry adder do this as the carry
+/// ripples past. EventSimulator replays an input change as timed events on
+/// a TimingWheel and keeps each of those transitions. Paired with
+/// PropagationScheduler::use_event_time(), AnimationState uses the record to
+/// flash the wires that glitch.
+///
+/// Delays are transport delays. A gate's output follows its inputs after
+/// its delay, however short the pulse, so every hazard shows up.
+
+#pragma once
+
+#include "simulation/circuit.hpp"
+#include "simulation/memory_usage.hpp"
+#include "timing/static_timing.hpp"
+#include "timing/timing_wheel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gateflow {
+
+/// One change of a wire's value during a run
+struct Transition {
+    float time;    ///< Delay units after the inputs changed
+    uint32_t wire; ///< Wire id
+    bool value;    ///< Value after the change
+};
+
+/// Simulates input changes of a finalized circuit at gate-delay resolution.
+///
+/// Holds its own wire values, starting from the settled state of the
+/// circuit's inputs at construction. Each simulate() run starts from the state
+/// the previous run settled in. The circuit must outlive the simulator and
+/// keep its structure. It is only read: its inputs, never its gate outputs.
+class EventSimulator {
+  public:
+    /// Ticks per delay unit. Gate delays are rounded to this resolution.
+    static constexpr uint32_t TICKS_PER_UNIT = 100;
+
+    /// Longest gate delay in ticks. The wheel has a bucket per tick of the
+    /// longest delay, so this bounds its size.
+    static constexpr uint32_t MAX_DELAY_TICKS = 1u << 20;
+
+    /// Sets every gate's delay from @p model and settles on the circuit's inputs
+    /// @throws std::runtime_error if the circuit is not finalized
+    /// @throws std::invalid_argument if a delay of @p model exceeds MAX_DELAY_TICKS
+    EventSimulator(const Circuit& circuit, const DelayModel& model);
+
+    [[nodiscard]] const Circuit& circuit() const { return *circuit_; }
+
+    /// Overrides one gate's delay. Takes effect from the next simulate().
+    /// @throws std::invalid_argument if the gate is not part of the circuit,
+    ///         or @p delay is negative, not finite or over MAX_DELAY_TICKS
+    void set_gate_delay(const Gate* gate, float delay);
+
+    /// Delay of a gate, after rounding to ticks
+    /// @throws std::invalid_argument if the gate is not part of the circuit
+    [[nodiscard]] float gate_delay(const Gate* gate) const;
+
+    /// Jumps to the settled state of the circuit's current inputs without
+    /// recording anything, and clears the last run
+    void settle();
+
+    /// Switches the primary inputs to the circuit's current input values at
+    /// time 0 and runs until no event is left. If no input changed, nothing
+    /// runs and the previous run's record is kept, so replays see it again.
+    /// @return true if a new run was recorded
+    bool simulate();
+
+    /// Every transition of the last run, ordered by time. Inputs change at 0.
+    [[nodiscard]] const std::vector<Transition>& transitions() const { return transitions_; }
+
+    /// Times the wire changed in the last run
+    [[nodiscard]] uint32_t transition_count(const Wire* wire) const;
+
+    /// Time of the wire's last change in the last run, 0 if it did not change
+    [[nodiscard]] float settle_time(const Wire* wire) const;
+
+    /// Whether the wire changed more than once in the last run, i.e. showed
+    /// a value other than its final one after the inputs changed
+    [[nodiscard]] bool glitched(const Wire* wire) const { return transition_count(wire) > 1; }
+
+    /// Wires that glitched in the last run
+    [[nodiscard]] size_t glitch_count() const { return glitch_count_; }
+
+    /// Time of the last transition of the last run (0 if there was none)
+    [[nodiscard]] float end_time() const { return end_time_; }
+
+    /// Value of a wire once the last run has settled
+    [[nodiscard]] bool value(const Wire* wire) const;
+
+    /// Events processed by the last run (wire updates taken off the wheel)
+    [[nodiscard]] size_t events_processed() const { return events_processed_; }
+
+    /// Heap memory by category: "wire state" (values, delays, per-wire
+    /// counters), "timing wheel" and "transitions"
+    [[nodiscard]] MemoryUsage memory_usage() const;
+
+  private:
+    /// A wire taking a value at the wheel's current tick
+    struct WireEvent {
+        uint32_t wire;
+        bool value;
+    };
+
+    [[nodiscard]] uint32_t index_of(const Gate* gate) const;
+    [[nodiscard]] uint32_t index_of(const Wire* wire) const;
+
+    /// Evaluates the gate in @p slot from the current wire values
+    [[nodiscard]] bool evaluate_slot(uint32_t slot) const;
+
+    /// Records the wires touched at @p tick that ended it on a new value
+    void record_tick(uint64_t tick);
+
+    /// Clears the last run's record
+    void clear_record();
+
+    /// Rebuilds the wheel if a delay now exceeds its horizon
+    void fit_wheel();
+
+    const Circuit* circuit_;
+    std::vector<uint32_t> delay_ticks_;   ///< Per slot
+    std::vector<uint32_t> slot_of_;       ///< Slot per gate id
+    std::vector<uint8_t> values_;         ///< Current value per wire id
+    std::vector<uint8_t> projected_;      ///< Value per wire id after its queued events
+    std::vector<uint8_t> input_values_;   ///< Input values the current state settled on
+    std::vector<uint64_t> eval_stamp_;    ///< Per slot: last pass that queued it
+    std::vector<uint32_t> pending_slots_; ///< Slots to evaluate in the current pass
+    std::vector<uint64_t> touch_stamp_;   ///< Per wire id: last tick serial that changed it
+    std::vector<WireEvent> touched_;      ///< Wires changed this tick, with their prior value
+    std::vector<uint32_t> counts_;        ///< Transitions per wire id in the last run
+    std::vector<float> settle_times_;     ///< Last transition time per wire id
+    std::vector<Transition> transitions_;
+    TimingWheel<WireEvent> wheel_{0};
+    uint64_t pass_ = 0;
+    uint64_t tick_serial_ = 0; ///< Bumped per distinct tick processed
+    size_t glitch_count_ = 0;
+    size_t events_processed_ = 0;
+    float end_time_ = 0.0f;
+};
+
+} // namespace gateflow
@@ -0,0 +1,89 @@
+/// @file frame_pacer.cpp
+/// @brief Implements the fixed simulation timestep and the quality governor
+
+#include "timing/frame_pacer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace gateflow {
+
+namespace {
+
+/// Weight of the newest sample in the moving averages
+constexpr float SMOOTHING = 0.1f;
+
+/// Samples are capped at this many budgets, so one stall (a window drag,
+/// a tab switch) moves the averages no more than a few slow frames would
+constexpr float MAX_SAMPLE_BUDGETS = 4.0f;
+
+} // namespace
+
+// --- FixedTimestep ---
+
+FixedTimestep::FixedTimestep(float step, int max_steps) : step_(step), max_steps_(max_steps) {
+    if (!(step > 0.0f)) {
+        throw std::invalid_argument("FixedTimestep step must be positive");
+    }
+    if (max_steps < 1) {
+        throw std::invalid_argument("FixedTimestep max_steps must be at least 1");
+    }
+}
+
+int FixedTimestep::advance(float frame_time) {
+    carry_ += std::max(frame_time, 0.0f);
+    const float limit = step_ * static_cast<float>(max_steps_);
+    if (carry_ >= limit) {
+        dropped_ += static_cast<double>(carry_ - limit);
+        carry_ = 0.0f;
+        return max_steps_;
+    }
+    const int steps = static_cast<int>(carry_ / step_);
+    carry_ = std::max(carry_ - static_cast<float>(steps) * step_, 0.0f);
+    return steps;
+}
+
+// --- QualityGovernor ---
+
+QualityGovernor::QualityGovernor(float budget)
+    : budget_(budget), avg_frame_(budget), avg_work_(budget) {
+    if (!(budget > 0.0f)) {
+        throw std::invalid_argument("QualityGovernor budget must be positive");
+    }
+}
+
+bool QualityGovernor::record(float frame_time, float work_time) {
+    const float cap = MAX_SAMPLE_BUDGETS * budget_;
+    avg_frame_ += SMOOTHING * (std::clamp(frame_time, 0.0f, cap) - avg_frame_);
+    avg_work_ += SMOOTHING * (std::clamp(work_time, 0.0f, cap) - avg_work_);
+
+    over_frames_ = avg_frame_ > OVER_BUDGET * budget_ ? over_frames_ + 1 : 0;
+    spare_frames_ = avg_frame_ <= ON_BUDGET * budget_ && avg_work_ < HEADROOM * budget_
+                        ? spare_frames_ + 1
+                        : 0;
+
+    int level = level_;
+    if (over_frames_ >= DROP_FRAMES && level_ < MAX_LEVEL) {
+        level = level_ + 1;
+    } else if (spare_frames_ >= RESTORE_FRAMES && level_ > 0) {
+        level = level_ - 1;
+    }
+    if (level == level_) {
+        return false;
+    }
+    // Each change has to earn the next one from scratch
+    level_ = level;
+    over_frames_ = 0;
+    spare_frames_ = 0;
+    return true;
+}
+
+RenderEffects QualityGovernor::effects() const {
+    RenderEffects effects;
+    effects.pulse_glows = level_ < 1;
+    effects.gate_accents = level_ < 2;
+    effects.tooltip_tables = level_ < 3;
+    return effects;
+}
+
+} // namespace gateflow
@@ -0,0 +1,113 @@
+/// @file frame_pacer.hpp
+/// @brief Fixed simulation timestep and the frame-budget governor for optional effects.
+///
+/// frame_tick() advances the scheduler and animation in FixedTimestep steps
+/// rather than by the raw frame time, so playback speed does not depend on
+/// the frame rate and one long frame cannot make propagation jump ahead.
+/// QualityGovernor watches the frame times and switches the optional
+/// drawing effects (RenderEffects) off one at a time while frames run over
+/// budget, and back on once there is headroom again.
+
+#pragma once
+
+namespace gateflow {
+
+/// Splits variable frame times into fixed simulation steps.
+/// Time left over is carried to the next frame; time beyond max_steps
+/// steps in one frame is dropped.
+class FixedTimestep {
+  public:
+    /// @param step      Simulated seconds per step (> 0)
+    /// @param max_steps Most steps one frame may run (>= 1)
+    /// @throws std::invalid_argument if either is out of range
+    explicit FixedTimestep(float step, int max_steps);
+
+    /// Adds one frame's elapsed time.
+    /// @return Steps of step() seconds to simulate this frame
+    int advance(float frame_time);
+
+    /// Forgets the carried time, e.g. after the loop has been idle
+    void reset() { carry_ = 0.0f; }
+
+    [[nodiscard]] float step() const { return step_; }
+    [[nodiscard]] int max_steps() const { return max_steps_; }
+
+    /// Carried time as a fraction of a step, in [0, 1)
+    [[nodiscard]] float carry_fraction() const { return carry_ / step_; }
+
+    /// Total time dropped because a frame took longer than max_steps steps
+    [[nodiscard]] double dropped_time() const { return dropped_; }
+
+  private:
+    float step_;
+    int max_steps_;
+    float carry_ = 0.0f;
+    double dropped_ = 0.0;
+};
+
+/// Optional drawing effects. Turning one off changes only how the scene
+/// looks, never what it shows.
+struct RenderEffects {
+    bool pulse_glows = true;    ///< Dots at the wavefront of travelling signals
+    bool gate_accents = true;   ///< Gate-type stripe on every gate body
+    bool tooltip_tables = true; ///< Truth table in the hover tooltip
+
+    friend bool operator==(const RenderEffects& a, const RenderEffects& b) {
+        return a.pulse_glows == b.pulse_glows && a.gate_accents == b.gate_accents &&
+               a.tooltip_tables == b.tooltip_tables;
+    }
+    friend bool operator!=(const RenderEffects& a, const RenderEffects& b) { return !(a == b); }
+};
+
+/// Lowers and raises a quality level from per-frame timings.
+///
+/// Both timings are smoothed with an exponential moving average. While the
+/// frame interval stays over OVER_BUDGET x budget for DROP_FRAMES frames, one
+/// more effect is dropped, in RenderEffects order. One is restored once the
+/// interval is within ON_BUDGET x budget (allowing for vsync jitter) and the
+/// work time (the part of the frame not spent waiting for vsync) stays under
+/// HEADROOM x budget for RESTORE_FRAMES frames. Restoring wants the work
+/// time, because a frame-capped loop spends every frame at the budget even
+/// when it has time to spare. It waits longer than dropping, so the level
+/// does not flap around the limit.
+class QualityGovernor {
+  public:
+    /// Level with every effect off
+    static constexpr int MAX_LEVEL = 3;
+
+    static constexpr float OVER_BUDGET = 1.2f;
+    static constexpr float ON_BUDGET = 1.05f;
+    static constexpr float HEADROOM = 0.5f;
+    static constexpr int DROP_FRAMES = 15;
+    static constexpr int RESTORE_FRAMES = 120;
+
+    /// @param budget Target frame time in seconds (> 0)
+    /// @throws std::invalid_argument if @p budget is not positive
+    explicit QualityGovernor(float budget);
+
+    /// Records one drawn frame.
+    /// @param frame_time Seconds since the previous frame started
+    /// @param work_time  Seconds spent producing this frame, excluding waits
+    /// @return true if the level changed
+    bool record(float frame_time, float work_time);
+
+    /// 0 = every effect on, MAX_LEVEL = every effect off
+    [[nodiscard]] int level() const { return level_; }
+
+    /// The effects enabled at level()
+    [[nodiscard]] RenderEffects effects() const;
+
+    [[nodiscard]] float budget() const { return budget_; }
+    [[nodiscard]] float average_frame_time() const { return avg_frame_; }
+    [[nodiscard]] float average_work_time() const { return avg_work_; }
+
+  private:
+    float budget_;
+    float avg_frame_;
+    float avg_work_;
+    int level_ = 0;
+    int over_frames_ = 0;  ///< Consecutive frames over budget
+    int spare_frames_ = 0; ///< Consecutive frames with headroom
+};
+
+} // namespace gateflow
@@ -0,0 +1,76 @@
+/// @file frame_profiler.cpp
+/// @brief Implements the rolling frame-phase profiler
+
+#include "timing/frame_profiler.hpp"
+
+#include <algorithm>
+
+namespace gateflow {
+
+std::string_view frame_phase_name(FramePhase phase) {
+    switch (phase) {
+    case FramePhase::INPUT:
+        return "Input";
+    case FramePhase::SCHEDULER:
+        return "Scheduler";
+    case FramePhase::ANIMATION:
+        return "Animation";
+    case FramePhase::WIRES:
+        return "Wires";
+    case FramePhase::GATES:
+        return "Gates";
+    case FramePhase::UI:
+        return "UI";
+    }
+    return "?";
+}
+
+void FrameProfiler::begin_frame() {
+    current_.fill(0.0);
+    current_draw_calls_ = 0;
+}
+
+void FrameProfiler::end_frame() {
+    for (size_t p = 0; p < FRAME_PHASE_COUNT; p++) {
+        samples_[p][head_] = static_cast<float>(current_[p]);
+    }
+    head_ = (head_ + 1) % WINDOW;
+    count_ = std::min(count_ + 1, WINDOW);
+    last_draw_calls_ = current_draw_calls_;
+}
+
+void FrameProfiler::add_time(FramePhase phase, double ms) {
+    current_[static_cast<size_t>(phase)] += ms;
+}
+
+PhaseStats FrameProfiler::stats(FramePhase phase) const {
+    PhaseStats out;
+    if (count_ == 0) {
+        return out;
+    }
+
+    // The ring's first count_ entries are valid until it has wrapped once
+    std::array<float, WINDOW> sorted = samples_[static_cast<size_t>(phase)];
+    float* begin = sorted.data();
+    float* end = begin + count_;
+
+    double sum = 0.0;
+    for (const float* s = begin; s != end; ++s) {
+        sum += *s;
+    }
+    out.avg_ms = sum / static_cast<double>(count_);
+    out.min_ms = *std::min_element(begin, end);
+
+    // Nearest-rank p99: the smallest sample >= 99% of the window
+    const size_t rank = (count_ * 99 + 99) / 100 - 1;
+    std::nth_element(begin, begin + rank, end);
+    out.p99_ms = begin[rank];
+    return out;
+}
+
+FrameProfiler& frame_profiler() {
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+} // namespace gateflow
@@ -0,0 +1,112 @@
+/// @file frame_profiler.hpp
+/// @brief Rolling per-phase frame timings and draw-call counts.
+///
+/// frame_tick() brackets each phase (input, scheduler, animation, wires,
+/// gates, UI) with GATEFLOW_PROFILE_PHASE, which records into a window of
+/// recent frames for min/avg/p99 readouts. Instrumentation goes through the
+/// GATEFLOW_PROFILE_* macros only, and they expand to nothing unless the
+/// build sets GATEFLOW_ENABLE_PROFILER (CMake option of the same name).
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace gateflow {
+
+/// Phases of one frame, in the order frame_tick() runs them
+enum class FramePhase : uint8_t { INPUT, SCHEDULER, ANIMATION, WIRES, GATES, UI };
+
+constexpr size_t FRAME_PHASE_COUNT = static_cast<size_t>(FramePhase::UI) + 1;
+
+/// Display name of a phase ("Input", "Scheduler", ...)
+[[nodiscard]] std::string_view frame_phase_name(FramePhase phase);
+
+/// Timing summary of one phase over the recorded window, in milliseconds
+struct PhaseStats {
+    double min_ms = 0.0;
+    double avg_ms = 0.0;
+    double p99_ms = 0.0;
+};
+
+/// Accumulates phase times during a frame and keeps the last WINDOW frames.
+/// A phase entered more than once per frame sums its time.
+class FrameProfiler {
+  public:
+    /// Frames kept per phase (2 seconds at 60 FPS)
+    static constexpr size_t WINDOW = 120;
+
+    /// Starts a new frame: clears the per-frame accumulators
+    void begin_frame();
+
+    /// Commits the current frame's accumulators to the window
+    void end_frame();
+
+    /// Adds @p ms to a phase in the current frame
+    void add_time(FramePhase phase, double ms);
+
+    /// Adds to the current frame's draw-call count
+    void add_draw_calls(uint32_t count) { current_draw_calls_ += count; }
+
+    /// Min/avg/p99 of a phase over the recorded frames (zeros if none)
+    [[nodiscard]] PhaseStats stats(FramePhase phase) const;
+
+    /// Draw calls issued in the last committed frame
+    [[nodiscard]] uint32_t last_draw_calls() const { return last_draw_calls_; }
+
+    /// Frames in the window so far (saturates at WINDOW)
+    [[nodiscard]] size_t frames_recorded() const { return count_; }
+
+  private:
+    std::array<std::array<float, WINDOW>, FRAME_PHASE_COUNT> samples_{}; ///< Ring per phase
+    std::array<double, FRAME_PHASE_COUNT> current_{};
+    size_t head_ = 0;  ///< Next ring slot to write
+    size_t count_ = 0; ///< Valid ring entries
+    uint32_t current_draw_calls_ = 0;
+    uint32_t last_draw_calls_ = 0;
+};
+
+/// The application-wide profiler written by the GATEFLOW_PROFILE_* macros
+FrameProfiler& frame_profiler();
+
+/// Adds the time between construction and destruction to a phase
+class ScopedPhaseTimer {
+  public:
+    explicit ScopedPhaseTimer(FramePhase phase)
+        : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedPhaseTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        frame_profiler().add_time(
+            phase_, std::chrono::duration<double, std::milli>(elapsed).count());
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+  private:
+    FramePhase phase_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace gateflow
+
+#if GATEFLOW_ENABLE_PROFILER
+#define GATEFLOW_PROFILE_CONCAT_INNER(a, b) a##b
+#define GATEFLOW_PROFILE_CONCAT(a, b) GATEFLOW_PROFILE_CONCAT_INNER(a, b)
+/// Times the rest of the enclosing scope as FramePhase::phase
+#define GATEFLOW_PROFILE_PHASE(phase)                                                          \
+    ::gateflow::ScopedPhaseTimer GATEFLOW_PROFILE_CONCAT(gateflow_phase_timer_, __LINE__)(      \
+        ::gateflow::FramePhase::phase)
+#define GATEFLOW_PROFILE_DRAW_CALLS(count)                                                     \
+    ::gateflow::frame_profiler().add_draw_calls(static_cast<uint32_t>(count))
+#define GATEFLOW_PROFILE_BEGIN_FRAME() ::gateflow::frame_profiler().begin_frame()
+#define GATEFLOW_PROFILE_END_FRAME() ::gateflow::frame_profiler().end_frame()
+#else
+#define GATEFLOW_PROFILE_PHASE(phase) ((void)0)
+#define GATEFLOW_PROFILE_DRAW_CALLS(count) ((void)0)
+#define GATEFLOW_PROFILE_BEGIN_FRAME() ((void)0)
+#define GATEFLOW_PROFILE_END_FRAME() ((void)0)
+#endif
@@ -4,61 +4,166 @@
 #include "timing/propagation_scheduler.hpp"
 
 #include <algorithm>
+#include <stdexcept>
 
 namespace gateflow {
 
 PropagationScheduler::PropagationScheduler(const Circuit* circuit) : circuit_(circuit) {
     compute_depths();
+    use_depth_time();
 }
 
 void PropagationScheduler::compute_depths() {
-    gate_depths_.clear();
-    max_depth_ = 0;
-
-    for (const Gate* gate : circuit_->topological_order()) {
-        int max_input_depth = -1;
-        for (const Wire* input_wire : gate->get_inputs()) {
-            const Gate* src = input_wire->get_source();
-            if (src != nullptr) {
-                auto it = gate_depths_.find(src);
-                if (it != gate_depths_.end()) {
-                    max_input_depth = std::max(max_input_depth, it->second);
-                }
-            }
+    const CompiledNetlist& net = circuit_->compiled();
+    const std::vector<Gate*>& order = circuit_->topological_order();
+
+    gate_depths_.assign(net.gate_levels.begin(), net.gate_levels.end());
+    max_depth_ = net.num_levels() > 0 ? static_cast<int>(net.num_levels()) - 1 : 0;
+
+    // topological_order() is in level order, so each depth is one contiguous span
+    depth_gates_.assign(net.num_levels(), {});
+    for (size_t level = 0; level < net.num_levels(); level++) {
+        depth_gates_[level].assign(order.begin() + net.level_offsets[level],
+                                   order.begin() + net.level_offsets[level + 1]);
+    }
+}
+
+void PropagationScheduler::use_depth_time() {
+    gate_start_.assign(gate_depths_.begin(), gate_depths_.end());
+    gate_duration_.assign(gate_depths_.size(), 1.0f);
+    delay_time_ = false;
+    events_ = nullptr;
+    build_resolve_order();
+    end_time_ = static_cast<float>(max_depth_) + 1.0f;
+    max_duration_ = 1.0f;
+    reset();
+}
+
+void PropagationScheduler::use_delay_time(const TimingAnalysis& timing) {
+    if (&timing.circuit() != circuit_) {
+        throw std::invalid_argument("Timing analysis belongs to another circuit");
+    }
+    const std::vector<Gate*>& gates = circuit_->gates();
+    gate_start_.resize(gates.size());
+    gate_duration_.resize(gates.size());
+    for (const Gate* gate : gates) {
+        gate_start_[gate->get_id()] = timing.start_time(gate);
+        gate_duration_[gate->get_id()] = timing.delay(gate);
+    }
+    delay_time_ = true;
+    events_ = nullptr;
+    build_resolve_order();
+    end_time_ = timing.critical_delay();
+    max_duration_ = 0.0f;
+    for (const Gate* gate : gates) {
+        end_time_ = std::max(end_time_, timing.arrival(gate)); // Includes unread gates
+        max_duration_ = std::max(max_duration_, gate_duration_[gate->get_id()]);
+    }
+    reset();
+}
+
+void PropagationScheduler::use_event_time(const EventSimulator& events) {
+    if (&events.circuit() != circuit_) {
+        throw std::invalid_argument("Event simulation belongs to another circuit");
+    }
+    const std::vector<Gate*>& gates = circuit_->gates();
+    gate_start_.resize(gates.size());
+    gate_duration_.resize(gates.size());
+    for (const Gate* gate : gates) {
+        float start = 0.0f;
+        for (const Wire* input : gate->get_inputs()) {
+            start = std::max(start, events.settle_time(input));
         }
-        int depth = max_input_depth + 1;
-        gate_depths_[gate] = depth;
-        max_depth_ = std::max(max_depth_, depth);
+        gate_start_[gate->get_id()] = start;
+        gate_duration_[gate->get_id()] = events.gate_delay(gate);
+    }
+    delay_time_ = true;
+    events_ = &events;
+    build_resolve_order();
+    // A gate's output settles within its delay of its last input change
+    end_time_ = events.end_time();
+    max_duration_ = 0.0f;
+    for (const Gate* gate : gates) {
+        const uint32_t id = gate->get_id();
+        end_time_ = std::max(end_time_, gate_start_[id] + gate_duration_[id]);
+        max_duration_ = std::max(max_duration_, gate_duration_[id]);
     }
+    reset();
+}
+
+void PropagationScheduler::build_resolve_order() {
+    const std::vector<Gate*>& order = circuit_->topological_order();
+    resolve_order_.assign(order.begin(), order.end());
+    if (delay_time_) {
+        // Stable: equal start times keep topological order. In depth time
+        // topological_order() is already sorted by level.
+        std::stable_sort(resolve_order_.begin(), resolve_order_.end(),
+                         [this](const Gate* a, const Gate* b) {
+                             return gate_start_[a->get_id()] < gate_start_[b->get_id()];
+                         });
+    }
+    resolve_times_.resize(resolve_order_.size());
+    for (size_t i = 0; i < resolve_order_.size(); i++) {
+        resolve_times_[i] = gate_start_[resolve_order_[i]->get_id()];
+    }
+}
+
+size_t PropagationScheduler::resolved_count_at(float time) const {
+    if (time < 0.0f) {
+        return 0;
+    }
+    return static_cast<size_t>(std::upper_bound(resolve_times_.begin(), resolve_times_.end(), time) -
+                               resolve_times_.begin());
+}
+
+int64_t PropagationScheduler::index_of(const Gate* gate) const {
+    uint32_t id = gate->get_id();
+    if (id >= gate_depths_.size() || circuit_->gates()[id] != gate) {
+        return -1;
+    }
+    return id;
+}
+
+int PropagationScheduler::depth_of(const Gate* gate) const {
+    int64_t id = index_of(gate);
+    return id < 0 ? -1 : gate_depths_[id];
 }
 
 void PropagationScheduler::tick(float delta_time) {
+    newly_resolved_.clear();
     if (mode_ == PlaybackMode::PAUSED && !step_requested_) {
         return;
     }
 
+    const size_t before = resolved_count_at(current_time_);
+
     if (step_requested_) {
-        // Advance to the next integer depth
-        float target = static_cast<float>(static_cast<int>(current_depth_) + 1);
-        if (current_depth_ < 0.0f) {
-            target = 0.0f;
+        // Advance to the next time a gate resolves (the next integer depth)
+        auto next = std::upper_bound(resolve_times_.begin(), resolve_times_.end(), current_time_);
+        float target = next != resolve_times_.end() ? *next : end_time_;
+        if (current_time_ < 0.0f) {
+            target = 0.0f; // Inputs appear first
         }
-        current_depth_ = std::min(target, static_cast<float>(max_depth_) + 1.0f);
+        current_time_ = std::min(target, end_time_);
         step_requested_ = false;
-        return;
-    }
-
-    // REALTIME mode: advance continuously
-    current_depth_ += speed_ * delta_time;
+    } else {
+        // REALTIME mode: advance continuously
+        current_time_ += speed_ * delta_time;
 
-    // Clamp to slightly past max_depth so all gates are fully resolved
-    if (current_depth_ > static_cast<float>(max_depth_) + 1.0f) {
-        current_depth_ = static_cast<float>(max_depth_) + 1.0f;
+        // Clamp to the end time so all gates are fully resolved
+        if (current_time_ > end_time_) {
+            current_time_ = end_time_;
+        }
     }
+
+    const size_t after = resolved_count_at(current_time_);
+    newly_resolved_.assign(resolve_order_.begin() + static_cast<std::ptrdiff_t>(before),
+                           resolve_order_.begin() + static_cast<std::ptrdiff_t>(after));
 }
 
 void PropagationScheduler::reset() {
-    current_depth_ = -1.0f;
+    current_time_ = -1.0f;
+    newly_resolved_.clear();
     if (mode_ == PlaybackMode::STEP) {
         mode_ = PlaybackMode::PAUSED;
     }
@@ -71,6 +176,32 @@ void PropagationScheduler::step() {
     }
 }
 
+void PropagationScheduler::step_back() {
+    // Latest resolve time strictly before now; none left means before the inputs
+    auto prev = std::lower_bound(resolve_times_.begin(), resolve_times_.end(), current_time_);
+    float target = -1.0f;
+    if (current_time_ > 0.0f) {
+        target = prev != resolve_times_.begin() ? *(prev - 1) : 0.0f;
+    }
+    seek(target);
+    step_requested_ = false;
+    if (mode_ == PlaybackMode::REALTIME) {
+        mode_ = PlaybackMode::PAUSED;
+    }
+}
+
+void PropagationScheduler::seek(float time) {
+    time = std::clamp(time, -1.0f, end_time_);
+    const size_t before = resolved_count_at(current_time_);
+    const size_t after = resolved_count_at(time);
+    current_time_ = time;
+    newly_resolved_.clear();
+    if (after > before) {
+        newly_resolved_.assign(resolve_order_.begin() + static_cast<std::ptrdiff_t>(before),
+                               resolve_order_.begin() + static_cast<std::ptrdiff_t>(after));
+    }
+}
+
 void PropagationScheduler::toggle_pause() {
     if (mode_ == PlaybackMode::PAUSED) {
         mode_ = PlaybackMode::REALTIME;
@@ -80,71 +211,76 @@ void PropagationScheduler::toggle_pause() {
 }
 
 bool PropagationScheduler::is_gate_resolved(const Gate* gate) const {
-    auto it = gate_depths_.find(gate);
-    if (it == gate_depths_.end()) {
+    int64_t id = index_of(gate);
+    if (id < 0) {
         return false;
     }
-    return current_depth_ >= static_cast<float>(it->second);
+    return current_time_ >= gate_start_[id];
 }
 
 bool PropagationScheduler::is_wire_resolved(const Wire* wire) const {
     const Gate* src = wire->get_source();
     if (src == nullptr) {
         // Primary input wires are always resolved (they're set before propagation)
-        return current_depth_ >= 0.0f;
+        return current_time_ >= 0.0f;
     }
     return is_gate_resolved(src);
 }
 
 float PropagationScheduler::gate_resolve_fraction(const Gate* gate) const {
-    auto it = gate_depths_.find(gate);
-    if (it == gate_depths_.end()) {
-        return 0.0f;
-    }
-    float gate_d = static_cast<float>(it->second);
-    if (current_depth_ < gate_d) {
+    int64_t id = index_of(gate);
+    if (id < 0 || current_time_ < gate_start_[id]) {
         return 0.0f; // Not yet resolved
     }
-    // Fraction: how far past the gate's depth we are (clamped to 1.0)
-    // A gate takes 1.0 depth-units to fully "fade in"
-    float fraction = current_depth_ - gate_d;
-    return std::min(fraction, 1.0f);
+    // Fraction: how far through the gate's own duration we are (1 depth unit
+    // in depth time, its delay in delay time), clamped to 1.0
+    const float duration = gate_duration_[id];
+    if (duration <= 0.0f || current_time_ >= end_time_) {
+        return 1.0f; // Every gate has finished by the end time, whatever the rounding
+    }
+    return std::min((current_time_ - gate_start_[id]) / duration, 1.0f);
 }
 
 float PropagationScheduler::wire_signal_progress(const Wire* wire) const {
     const Gate* src = wire->get_source();
     if (src == nullptr) {
         // Primary input wire: resolved as soon as propagation starts
-        if (current_depth_ < 0.0f) {
+        if (current_time_ < 0.0f) {
             return 0.0f;
         }
-        return std::min(current_depth_ + 1.0f, 1.0f);
+        return std::min(current_time_ + 1.0f, 1.0f);
     }
 
-    auto it = gate_depths_.find(src);
-    if (it == gate_depths_.end()) {
-        return 0.0f;
-    }
-    float gate_d = static_cast<float>(it->second);
-    if (current_depth_ < gate_d) {
-        return 0.0f; // Source gate not yet resolved
-    }
-    // Signal travels along the wire during the depth between source and destination
-    // Takes 1.0 depth-units to travel
-    float progress = current_depth_ - gate_d;
-    return std::min(progress, 1.0f);
+    // The signal travels along the wire while its source gate switches
+    return gate_resolve_fraction(src);
 }
 
 int PropagationScheduler::gate_depth(const Gate* gate) const {
-    auto it = gate_depths_.find(gate);
-    if (it == gate_depths_.end()) {
-        return -1;
-    }
-    return it->second;
+    return depth_of(gate);
 }
 
 bool PropagationScheduler::is_complete() const {
-    return current_depth_ >= static_cast<float>(max_depth_) + 1.0f;
+    return current_time_ >= end_time_;
+}
+
+const std::vector<const Gate*>& PropagationScheduler::gates_at_depth(int depth) const {
+    static const std::vector<const Gate*> none;
+    if (depth < 0 || depth >= static_cast<int>(depth_gates_.size())) {
+        return none;
+    }
+    return depth_gates_[depth];
+}
+
+MemoryUsage PropagationScheduler::memory_usage() const {
+    MemoryUsage usage;
+    usage.add_vector("depths", gate_depths_);
+    usage.add_nested("depths", depth_gates_);
+    usage.add_vector("resolve schedule", gate_start_);
+    usage.add_vector("resolve schedule", gate_duration_);
+    usage.add_vector("resolve schedule", resolve_order_);
+    usage.add_vector("resolve schedule", resolve_times_);
+    usage.add_vector("resolve schedule", newly_resolved_);
+    return usage;
 }
 
 } // namespace gateflow
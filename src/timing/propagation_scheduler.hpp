@@ -2,15 +2,31 @@
 /// @brief Manages temporal propagation of signals through a circuit.
 ///
 /// The scheduler computes the topological depth of each gate and advances
-/// a "current depth" each frame. Gates at depth <= current_depth are
-/// "resolved" (their true output is visible). This creates the visual
-/// effect of signals flowing through the circuit over time.
+/// a "current time" each frame. By default time is measured in depths: a
+/// gate at depth d starts resolving at time d and takes one unit, so gates
+/// at depth <= current time are "resolved" (their true output is visible).
+/// With use_delay_time(), each gate instead starts when its inputs arrive
+/// under a TimingAnalysis and takes its own gate delay. With use_event_time(),
+/// starts come from an EventSimulator run instead: a gate starts once its
+/// inputs have made their last transition, so gates off the changed cone are
+/// settled at once and glitching ones wait out their hazards. This creates
+/// the visual effect of signals flowing through the circuit over time.
+///
+/// The resolved set at any time is a prefix of resolve_order(), so the
+/// scheduler's whole state at a depth is one count into it: seek() and
+/// step_back() move to any earlier or later time with a binary search,
+/// without propagating again.
 
 #pragma once
 
 #include "simulation/circuit.hpp"
+#include "simulation/memory_usage.hpp"
+#include "timing/event_simulator.hpp"
+#include "timing/static_timing.hpp"
 
-#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace gateflow {
 
@@ -31,16 +47,54 @@ class PropagationScheduler {
     /// @param circuit Non-owning pointer to the circuit
     explicit PropagationScheduler(const Circuit* circuit);
 
-    /// Advances the propagation by one frame.
+    /// Advances the propagation by one frame. Gates whose depth was crossed
+    /// by this call are available from newly_resolved() afterwards.
     /// @param delta_time Seconds since last frame
     void tick(float delta_time);
 
-    /// Resets propagation to the beginning (depth = -1, nothing resolved)
+    /// Resets propagation to the beginning (time = -1, nothing resolved)
     void reset();
 
-    /// Advances exactly one depth level (for step mode)
+    /// Advances to the next time at which a gate resolves: exactly one
+    /// depth level in depth time (for step mode)
     void step();
 
+    /// Moves back to the previous time at which a gate resolves (exactly one
+    /// depth level in depth time), or from time 0 to before the inputs, and
+    /// pauses playback. Takes effect immediately.
+    void step_back();
+
+    /// Jumps to @p time, clamped to [-1, end_time()], in either direction.
+    /// Moving forward lists the gates passed in newly_resolved(), as tick()
+    /// does; moving back clears it. The playback mode is unchanged.
+    void seek(float time);
+
+    // --- Time base ---
+
+    /// Replays propagation in the analysis' delay time: a gate resolves at
+    /// its start_time() and fades in / drives its output over its delay.
+    /// Resets playback.
+    /// @throws std::invalid_argument if @p timing analyzed another circuit
+    void use_delay_time(const TimingAnalysis& timing);
+
+    /// Replays the last run of @p events: a gate resolves at the latest
+    /// settle_time() of its inputs and takes its gate delay, and the end time
+    /// is the run's last transition. The time axis is delay time, so
+    /// uses_delay_time() is true as well. Call again after each
+    /// EventSimulator::simulate() that records a new run. Resets playback.
+    /// @throws std::invalid_argument if @p events simulates another circuit
+    void use_event_time(const EventSimulator& events);
+
+    /// Back to one unit per depth level (the default). Resets playback.
+    void use_depth_time();
+
+    /// Whether the time axis is delay time rather than depth
+    [[nodiscard]] bool uses_delay_time() const { return delay_time_; }
+
+    /// The simulation replayed by use_event_time(), or nullptr in the other
+    /// time bases. It must outlive its use here.
+    [[nodiscard]] const EventSimulator* events() const { return events_; }
+
     // --- Mode control ---
     void set_mode(PlaybackMode mode) { mode_ = mode; }
     [[nodiscard]] PlaybackMode mode() const { return mode_; }
@@ -48,8 +102,8 @@ class PropagationScheduler {
     /// Toggle between REALTIME and PAUSED
     void toggle_pause();
 
-    // --- Speed control ---
-    void set_speed(float depths_per_second) { speed_ = depths_per_second; }
+    // --- Speed control (time units per second: depths, or delay units) ---
+    void set_speed(float units_per_second) { speed_ = units_per_second; }
     [[nodiscard]] float speed() const { return speed_; }
 
     // --- Query ---
@@ -74,8 +128,13 @@ class PropagationScheduler {
     /// The topological depth of a gate (0 = directly connected to inputs)
     [[nodiscard]] int gate_depth(const Gate* gate) const;
 
-    /// Current propagation depth (fractional for smooth animation)
-    [[nodiscard]] float current_depth() const { return current_depth_; }
+    /// Current propagation time (fractional for smooth animation).
+    /// In depth time this is the current depth.
+    [[nodiscard]] float current_time() const { return current_time_; }
+
+    /// Time at which every gate has fully resolved: max_depth() + 1 in
+    /// depth time, the critical delay in delay time
+    [[nodiscard]] float end_time() const { return end_time_; }
 
     /// Maximum depth in the circuit
     [[nodiscard]] int max_depth() const { return max_depth_; }
@@ -83,15 +142,64 @@ class PropagationScheduler {
     /// Whether propagation has reached all gates
     [[nodiscard]] bool is_complete() const;
 
+    /// Gates at the given depth, in topological order (empty if out of range)
+    [[nodiscard]] const std::vector<const Gate*>& gates_at_depth(int depth) const;
+
+    /// Gates that became resolved during the most recent tick() or forward
+    /// seek(), in resolve_order(). Cleared by every tick() and by reset().
+    [[nodiscard]] const std::vector<const Gate*>& newly_resolved() const { return newly_resolved_; }
+
+    /// Every gate in the order it resolves: by start time, then topological
+    /// order (in depth time, depth by depth)
+    [[nodiscard]] const std::vector<const Gate*>& resolve_order() const { return resolve_order_; }
+
+    /// Resolve time of each resolve_order() gate (non-decreasing)
+    [[nodiscard]] const std::vector<float>& resolve_times() const { return resolve_times_; }
+
+    /// Longest fade/travel time of any gate: 1 in depth time, the slowest
+    /// gate delay in delay time. A gate that resolved more than this long ago
+    /// has finished switching.
+    [[nodiscard]] float max_gate_duration() const { return max_duration_; }
+
+    /// Number of leading resolve_order() gates resolved at the current time
+    [[nodiscard]] size_t resolved_count() const { return resolved_count_at(current_time_); }
+
+    /// Heap memory by category: "depths" (gate_depths and the per-depth gate
+    /// lists) and "resolve schedule" (start times, durations, resolve order)
+    [[nodiscard]] MemoryUsage memory_usage() const;
+
   private:
-    /// Computes the longest-path depth from any input for each gate
+    /// Copies the compiled netlist's levels (longest path from any input)
+    /// into id-indexed depths and per-depth gate lists
     void compute_depths();
 
+    /// Sorts gates into resolve_order() by gate_start_ and sets end_time_
+    void build_resolve_order();
+
+    /// Resolved gates at time @p time: a prefix length of resolve_order_
+    [[nodiscard]] size_t resolved_count_at(float time) const;
+
+    /// Depth per gate id, or -1 for a gate not in this circuit
+    [[nodiscard]] int depth_of(const Gate* gate) const;
+
+    /// Id of a gate, or -1 for a gate not in this circuit
+    [[nodiscard]] int64_t index_of(const Gate* gate) const;
+
     const Circuit* circuit_;
-    std::unordered_map<const Gate*, int> gate_depths_;
+    const EventSimulator* events_ = nullptr; ///< Set in event time only
+    std::vector<int> gate_depths_;                      ///< Depth per gate id
+    std::vector<std::vector<const Gate*>> depth_gates_; ///< Gates per depth
+    std::vector<float> gate_start_;                     ///< Resolve time per gate id
+    std::vector<float> gate_duration_;                  ///< Fade/travel time per gate id
+    std::vector<const Gate*> resolve_order_;
+    std::vector<float> resolve_times_;                  ///< gate_start_ of resolve_order_
+    std::vector<const Gate*> newly_resolved_;
     int max_depth_ = 0;
-    float current_depth_ = -1.0f; // Start before depth 0 so nothing is resolved
-    float speed_ = 1.0f;          // Depths per second (user-adjustable)
+    float end_time_ = 1.0f;
+    float max_duration_ = 1.0f;
+    float current_time_ = -1.0f; // Start before time 0 so nothing is resolved
+    float speed_ = 1.0f;         // Time units per second (user-adjustable)
+    bool delay_time_ = false;
     PlaybackMode mode_ = PlaybackMode::REALTIME;
     bool step_requested_ = false;
 };
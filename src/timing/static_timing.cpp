@@ -0,0 +1,182 @@
+/// @file static_timing.cpp
+/// @brief Arrival/required-time propagation and critical-path extraction
+
+#include "timing/static_timing.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gateflow {
+
+DelayModel DelayModel::unit() {
+    DelayModel model;
+    model.delays_.fill(1.0f);
+    return model;
+}
+
+DelayModel DelayModel::typical() {
+    DelayModel model;
+    model.set_delay(GateType::NOT, 0.7f);
+    model.set_delay(GateType::NAND, 1.0f);
+    model.set_delay(GateType::AND, 1.4f);
+    model.set_delay(GateType::OR, 1.6f);
+    model.set_delay(GateType::XOR, 2.2f);
+    model.set_delay(GateType::BUFFER, 0.9f);
+    return model;
+}
+
+void DelayModel::set_delay(GateType type, float delay) {
+    if (!std::isfinite(delay) || delay < 0.0f) {
+        throw std::invalid_argument("Gate delay must be a finite, non-negative number");
+    }
+    delays_[static_cast<size_t>(type)] = delay;
+}
+
+TimingAnalysis::TimingAnalysis(const Circuit& circuit, const DelayModel& model)
+    : circuit_(&circuit), model_(model) {
+    if (!circuit.is_finalized()) {
+        throw std::runtime_error("Circuit must be finalized before timing analysis");
+    }
+    compute_arrivals();
+    extract_critical_path();
+    compute_required();
+}
+
+void TimingAnalysis::compute_arrivals() {
+    gate_arrival_.assign(circuit_->gates().size(), 0.0f);
+    wire_arrival_.assign(circuit_->wires().size(), 0.0f);
+
+    // Topological order: every input wire's arrival is final before its reader
+    for (const Gate* gate : circuit_->topological_order()) {
+        float latest = 0.0f;
+        for (const Wire* input : gate->get_inputs()) {
+            latest = std::max(latest, wire_arrival_[input->get_id()]);
+        }
+        const float arrival = latest + model_.delay(gate->get_type());
+        gate_arrival_[gate->get_id()] = arrival;
+        if (const Wire* out = gate->get_output(); out != nullptr) {
+            wire_arrival_[out->get_id()] = arrival;
+        }
+    }
+}
+
+void TimingAnalysis::extract_critical_path() {
+    critical_gate_.assign(circuit_->gates().size(), 0);
+    critical_wire_.assign(circuit_->wires().size(), 0);
+    path_ = {};
+
+    // Latest primary output; the first one wins a tie
+    const Wire* wire = nullptr;
+    for (const Wire* out : circuit_->output_wires()) {
+        if (wire == nullptr || wire_arrival_[out->get_id()] > wire_arrival_[wire->get_id()]) {
+            wire = out;
+        }
+    }
+    if (wire == nullptr) {
+        return;
+    }
+    path_.delay = wire_arrival_[wire->get_id()];
+
+    // Walk back through the latest-arriving input of each gate
+    while (wire != nullptr) {
+        path_.wires.push_back(wire);
+        critical_wire_[wire->get_id()] = 1;
+        const Gate* gate = wire->get_source();
+        if (gate == nullptr) {
+            break;
+        }
+        path_.gates.push_back(gate);
+        critical_gate_[gate->get_id()] = 1;
+
+        const Wire* latest = nullptr;
+        for (const Wire* input : gate->get_inputs()) {
+            if (latest == nullptr || wire_arrival_[input->get_id()] > wire_arrival_[latest->get_id()]) {
+                latest = input;
+            }
+        }
+        wire = latest;
+    }
+    std::reverse(path_.gates.begin(), path_.gates.end());
+    std::reverse(path_.wires.begin(), path_.wires.end());
+}
+
+void TimingAnalysis::compute_required() {
+    const float critical = path_.delay;
+    gate_required_.assign(circuit_->gates().size(), critical);
+
+    std::vector<uint8_t> is_output(circuit_->wires().size(), 0);
+    for (const Wire* out : circuit_->output_wires()) {
+        is_output[out->get_id()] = 1;
+    }
+
+    // Reverse topological order: every reader's required time is final first
+    const std::vector<Gate*>& order = circuit_->topological_order();
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        const Gate* gate = *it;
+        const Wire* out = gate->get_output();
+        if (out == nullptr || out->get_destinations().empty()) {
+            continue; // Unconstrained: required at the critical delay
+        }
+        float required = is_output[out->get_id()] != 0 ? critical : INFINITY;
+        for (const Gate* reader : out->get_destinations()) {
+            required = std::min(required, gate_required_[reader->get_id()] -
+                                              model_.delay(reader->get_type()));
+        }
+        gate_required_[gate->get_id()] = required;
+    }
+}
+
+uint32_t TimingAnalysis::index_of(const Gate* gate) const {
+    const uint32_t id = gate->get_id();
+    if (id >= gate_arrival_.size() || circuit_->gates()[id] != gate) {
+        throw std::invalid_argument("Gate is not part of the analyzed circuit");
+    }
+    return id;
+}
+
+uint32_t TimingAnalysis::index_of(const Wire* wire) const {
+    const uint32_t id = wire->get_id();
+    if (id >= wire_arrival_.size() || circuit_->wires()[id] != wire) {
+        throw std::invalid_argument("Wire is not part of the analyzed circuit");
+    }
+    return id;
+}
+
+float TimingAnalysis::delay(const Gate* gate) const {
+    (void)index_of(gate);
+    return model_.delay(gate->get_type());
+}
+
+float TimingAnalysis::arrival(const Gate* gate) const {
+    return gate_arrival_[index_of(gate)];
+}
+
+float TimingAnalysis::arrival(const Wire* wire) const {
+    return wire_arrival_[index_of(wire)];
+}
+
+float TimingAnalysis::start_time(const Gate* gate) const {
+    return gate_arrival_[index_of(gate)] - model_.delay(gate->get_type());
+}
+
+float TimingAnalysis::required(const Gate* gate) const {
+    return gate_required_[index_of(gate)];
+}
+
+float TimingAnalysis::slack(const Gate* gate) const {
+    const uint32_t id = index_of(gate);
+    return gate_required_[id] - gate_arrival_[id];
+}
+
+bool TimingAnalysis::on_critical_path(const Gate* gate) const {
+    const uint32_t id = gate->get_id();
+    return id < critical_gate_.size() && circuit_->gates()[id] == gate && critical_gate_[id] != 0;
+}
+
+bool TimingAnalysis::on_critical_path(const Wire* wire) const {
+    const uint32_t id = wire->get_id();
+    return id < critical_wire_.size() && circuit_->wires()[id] == wire && critical_wire_[id] != 0;
+}
+
+} // namespace gateflow
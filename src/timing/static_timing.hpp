@@ -0,0 +1,121 @@
+/// @file static_timing.hpp
+/// @brief Static timing analysis with per-gate-type delays.
+///
+/// PropagationScheduler's depth treats every gate as one unit of delay.
+/// TimingAnalysis instead weights each gate by a DelayModel and computes,
+/// per gate, the arrival time of its output, the required time and the
+/// slack, plus the critical path through the circuit. The scheduler can
+/// replay propagation on this delay time axis (use_delay_time()).
+
+#pragma once
+
+#include "simulation/circuit.hpp"
+
+#include <array>
+#include <vector>
+
+namespace gateflow {
+
+/// Propagation delay of each gate type, in arbitrary time units
+class DelayModel {
+  public:
+    /// Every gate takes 1 unit, so arrival times are depth + 1
+    [[nodiscard]] static DelayModel unit();
+
+    /// Rough static-CMOS ratios normalised to a 2-input NAND = 1.0:
+    /// NOT 0.7, NAND 1.0, AND 1.4 (NAND + inverter), OR 1.6, XOR 2.2,
+    /// BUFFER 0.9
+    [[nodiscard]] static DelayModel typical();
+
+    /// Delay of one gate of the given type
+    [[nodiscard]] float delay(GateType type) const { return delays_[static_cast<size_t>(type)]; }
+
+    /// Overrides the delay of one gate type.
+    /// @throws std::invalid_argument if @p delay is negative or not finite
+    void set_delay(GateType type, float delay);
+
+  private:
+    std::array<float, GATE_TYPE_COUNT> delays_{};
+};
+
+/// Longest input-to-output path, in signal order. wires[0] is the primary
+/// input (or sourceless wire) it starts from, wires[i + 1] is the output of
+/// gates[i], and wires.back() is a primary output.
+struct CriticalPath {
+    std::vector<const Gate*> gates;
+    std::vector<const Wire*> wires;
+    float delay = 0.0f; ///< Arrival time at the path's primary output
+};
+
+/// Arrival times, required times, slack and the critical path of a
+/// finalized circuit under a DelayModel.
+///
+/// Arrival of a gate = latest arrival among its input wires + its delay;
+/// sourceless wires arrive at 0. Every primary output (and every gate with
+/// no reader) is required at the critical delay, and a gate is required by
+/// the earliest of its readers' required times minus their delays.
+/// Slack = required - arrival, 0 along the critical path.
+///
+/// The analysis is a snapshot of the circuit's structure: rebuild it after
+/// the circuit changes. Lookups are indexed by gate/wire id.
+class TimingAnalysis {
+  public:
+    /// Runs the analysis. The circuit must outlive this object.
+    /// @throws std::runtime_error if the circuit is not finalized
+    TimingAnalysis(const Circuit& circuit, const DelayModel& model);
+
+    [[nodiscard]] const Circuit& circuit() const { return *circuit_; }
+    [[nodiscard]] const DelayModel& model() const { return model_; }
+
+    /// Delay of one gate under the model
+    /// @throws std::invalid_argument if the gate is not part of the circuit
+    [[nodiscard]] float delay(const Gate* gate) const;
+
+    /// Time the gate's output settles
+    /// @throws std::invalid_argument if the gate is not part of the circuit
+    [[nodiscard]] float arrival(const Gate* gate) const;
+
+    /// Time the wire's value settles (0 for a sourceless wire)
+    /// @throws std::invalid_argument if the wire is not part of the circuit
+    [[nodiscard]] float arrival(const Wire* wire) const;
+
+    /// Time the gate's inputs have all settled: arrival minus its delay
+    /// @throws std::invalid_argument if the gate is not part of the circuit
+    [[nodiscard]] float start_time(const Gate* gate) const;
+
+    /// Latest time the gate's output may settle without delaying any output
+    /// @throws std::invalid_argument if the gate is not part of the circuit
+    [[nodiscard]] float required(const Gate* gate) const;
+
+    /// required() - arrival(); 0 on the critical path
+    /// @throws std::invalid_argument if the gate is not part of the circuit
+    [[nodiscard]] float slack(const Gate* gate) const;
+
+    /// Latest arrival over all primary outputs
+    [[nodiscard]] float critical_delay() const { return path_.delay; }
+
+    [[nodiscard]] const CriticalPath& critical_path() const { return path_; }
+
+    /// Whether the gate/wire is on critical_path() (false for foreign ones)
+    [[nodiscard]] bool on_critical_path(const Gate* gate) const;
+    [[nodiscard]] bool on_critical_path(const Wire* wire) const;
+
+  private:
+    [[nodiscard]] uint32_t index_of(const Gate* gate) const;
+    [[nodiscard]] uint32_t index_of(const Wire* wire) const;
+
+    void compute_arrivals();
+    void extract_critical_path();
+    void compute_required();
+
+    const Circuit* circuit_;
+    DelayModel model_;
+    std::vector<float> gate_arrival_;   ///< Per gate id
+    std::vector<float> gate_required_;  ///< Per gate id
+    std::vector<float> wire_arrival_;   ///< Per wire id
+    std::vector<uint8_t> critical_gate_; ///< Per gate id: 1 = on the critical path
+    std::vector<uint8_t> critical_wire_; ///< Per wire id: 1 = on the critical path
+    CriticalPath path_;
+};
+
+} // namespace gateflow
@@ -0,0 +1,136 @@
+/// @file timing_wheel.hpp
+/// @brief Bucketed event queue over integer ticks with O(1) insert and pop
+///
+/// A timing wheel is a ring of buckets, one per tick. When no event is ever
+/// scheduled more than horizon() ticks ahead of now(), as in a simulation whose
+/// longest gate delay is known, every pending event fits in one turn of the
+/// ring. Scheduling then just appends to a bucket and popping takes from the
+/// front of one, with no comparisons and no heap. Events live in one node
+/// array, chained per bucket and recycled through a free list, so a running
+/// wheel stops allocating once it holds the most events it ever queues.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace gateflow {
+
+/// FIFO per tick: events scheduled for the same tick pop in insertion order,
+/// including ones scheduled for now() while that tick is being drained.
+template <typename T> class TimingWheel {
+  public:
+    /// @param horizon Farthest ahead of now() an event may be scheduled, in ticks
+    explicit TimingWheel(uint64_t horizon) : horizon_(horizon) {
+        size_t buckets = 1;
+        while (buckets <= horizon) {
+            buckets <<= 1;
+        }
+        mask_ = buckets - 1;
+        heads_.assign(buckets, NONE);
+        tails_.assign(buckets, NONE);
+    }
+
+    /// Queues @p payload for tick @p tick
+    /// @throws std::out_of_range if @p tick is before now() or past now() + horizon()
+    void schedule(uint64_t tick, const T& payload) {
+        if (tick < now_ || tick - now_ > horizon_) {
+            throw std::out_of_range("TimingWheel event outside [now, now + horizon]");
+        }
+        uint32_t node = free_;
+        if (node != NONE) {
+            free_ = nodes_[node].next;
+            nodes_[node] = {payload, NONE};
+        } else {
+            node = static_cast<uint32_t>(nodes_.size());
+            nodes_.push_back({payload, NONE});
+        }
+        const size_t b = tick & mask_;
+        if (tails_[b] == NONE) {
+            heads_[b] = node;
+        } else {
+            nodes_[tails_[b]].next = node;
+        }
+        tails_[b] = node;
+        size_++;
+    }
+
+    /// Moves now() forward to the earliest tick with a queued event.
+    /// Skipping empty buckets costs one step per tick passed, at most horizon().
+    /// @return false (leaving now() unchanged) if nothing is queued
+    bool advance() {
+        if (size_ == 0) {
+            return false;
+        }
+        while (heads_[now_ & mask_] == NONE) {
+            now_++;
+        }
+        return true;
+    }
+
+    /// Takes the next event queued for now(), if any
+    bool pop(T& payload) {
+        const size_t b = now_ & mask_;
+        const uint32_t node = heads_[b];
+        if (node == NONE) {
+            return false;
+        }
+        payload = nodes_[node].payload;
+        heads_[b] = nodes_[node].next;
+        if (heads_[b] == NONE) {
+            tails_[b] = NONE;
+        }
+        nodes_[node].next = free_;
+        free_ = node;
+        size_--;
+        return true;
+    }
+
+    /// Drops every queued event and moves now() back to tick 0. Keeps the
+    /// node storage for reuse.
+    void clear() {
+        heads_.assign(heads_.size(), NONE);
+        tails_.assign(tails_.size(), NONE);
+        free_ = NONE;
+        for (uint32_t n = static_cast<uint32_t>(nodes_.size()); n-- > 0;) {
+            nodes_[n].next = free_;
+            free_ = n;
+        }
+        size_ = 0;
+        now_ = 0;
+    }
+
+    [[nodiscard]] uint64_t now() const { return now_; }
+    [[nodiscard]] uint64_t horizon() const { return horizon_; }
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_t buckets() const { return heads_.size(); }
+
+    /// Bytes allocated for buckets and nodes (capacity, not size)
+    [[nodiscard]] size_t heap_bytes() const {
+        return (heads_.capacity() + tails_.capacity()) * sizeof(uint32_t) +
+               nodes_.capacity() * sizeof(Node);
+    }
+    [[nodiscard]] size_t heap_allocations() const { return nodes_.capacity() > 0 ? 3 : 2; }
+
+  private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Node {
+        T payload;
+        uint32_t next; ///< Next node in the bucket or free list
+    };
+
+    uint64_t horizon_;
+    size_t mask_ = 0;             ///< Bucket count - 1 (a power of two)
+    std::vector<uint32_t> heads_; ///< First node per bucket
+    std::vector<uint32_t> tails_; ///< Last node per bucket, for FIFO appends
+    std::vector<Node> nodes_;
+    uint32_t free_ = NONE;
+    size_t size_ = 0;
+    uint64_t now_ = 0;
+};
+
+} // namespace gateflow
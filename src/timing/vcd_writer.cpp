@@ -0,0 +1,186 @@
+/// @file vcd_writer.cpp
+/// @brief VCD header, identifier codes and buffered per-vector change output
+
+#include "timing/vcd_writer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gateflow {
+
+namespace {
+
+constexpr size_t BUFFER_BYTES = 64 * 1024;
+
+/// Printable VCD identifier for a wire id: base 94 over '!'..'~'
+std::string identifier_code(uint32_t id) {
+    std::string code;
+    do {
+        code.push_back(static_cast<char>('!' + id % 94));
+        id /= 94;
+    } while (id > 0);
+    return code;
+}
+
+} // namespace
+
+VcdWriter::VcdWriter(const Circuit& circuit, const std::string& path)
+    : VcdWriter(circuit, nullptr, path) {}
+
+VcdWriter::VcdWriter(const TimingAnalysis& timing, const std::string& path)
+    : VcdWriter(timing.circuit(), &timing, path) {}
+
+VcdWriter::VcdWriter(const Circuit& circuit, const TimingAnalysis* timing, const std::string& path)
+    : circuit_(&circuit), path_(path), delay_time_(timing != nullptr) {
+    if (!circuit.is_finalized()) {
+        throw std::runtime_error("VcdWriter: circuit must be finalized");
+    }
+
+    const size_t num_wires = circuit.wires().size();
+    offsets_.assign(num_wires, 0);
+    codes_.resize(num_wires);
+    dumped_.assign(num_wires, 0);
+    uint64_t latest = 0;
+    for (const Wire* wire : circuit.wires()) {
+        const uint32_t id = wire->get_id();
+        codes_[id] = identifier_code(id);
+        uint64_t offset = 0;
+        if (timing != nullptr) {
+            offset = static_cast<uint64_t>(
+                std::llround(static_cast<double>(timing->arrival(wire)) * DELAY_TICKS));
+        } else if (const Gate* src = wire->get_source(); src != nullptr) {
+            offset = circuit.compiled().gate_levels[src->get_id()] + 1;
+        }
+        offsets_[id] = offset;
+        latest = std::max(latest, offset);
+    }
+    // Leave a gap after the last change so consecutive vectors read apart
+    span_ = latest + (delay_time_ ? DELAY_TICKS : 1);
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        throw std::runtime_error("VcdWriter: cannot open " + path);
+    }
+    buffer_.reserve(BUFFER_BYTES + 4096);
+    write_header();
+}
+
+VcdWriter::~VcdWriter() {
+    try {
+        close();
+    } catch (const std::exception&) {
+        // Destructors must not throw; close() reports errors to callers that ask
+    }
+}
+
+void VcdWriter::write_header() {
+    buffer_ += "$version gateflow $end\n";
+    buffer_ += delay_time_ ? "$timescale 10 ps $end\n" : "$timescale 1 ns $end\n";
+    buffer_ += "$scope module gateflow $end\n";
+
+    std::vector<std::string> names(codes_.size());
+    for (size_t i = 0; i < circuit_->output_wires().size(); i++) {
+        names[circuit_->output_wires()[i]->get_id()] = "out" + std::to_string(i);
+    }
+    for (size_t i = 0; i < circuit_->input_wires().size(); i++) {
+        names[circuit_->input_wires()[i]->get_id()] = "in" + std::to_string(i);
+    }
+    for (uint32_t id = 0; id < codes_.size(); id++) {
+        const std::string name = names[id].empty() ? "w" + std::to_string(id) : names[id];
+        buffer_ += "$var wire 1 " + codes_[id] + " " + name + " $end\n";
+    }
+    buffer_ += "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n";
+    for (const Wire* wire : circuit_->wires()) {
+        const uint32_t id = wire->get_id();
+        dumped_[id] = wire->get_value() ? 1 : 0;
+        put_change(id, wire->get_value());
+        maybe_flush();
+    }
+    buffer_ += "$end\n";
+}
+
+void VcdWriter::put_change(uint32_t id, bool value) {
+    buffer_.push_back(value ? '1' : '0');
+    buffer_ += codes_[id];
+    buffer_.push_back('\n');
+}
+
+void VcdWriter::record(const PropagationResult& result) {
+    if (file_ == nullptr) {
+        throw std::runtime_error("VcdWriter: record() after close()");
+    }
+
+    pending_.clear();
+    for (const Wire* wire : circuit_->input_wires()) {
+        pending_.emplace_back(0, wire->get_id());
+    }
+    for (const Wire* wire : result.changed_wires) {
+        pending_.emplace_back(offsets_[wire->get_id()], wire->get_id());
+    }
+    // Levels come out in order, but arrival times interleave across levels
+    std::sort(pending_.begin(), pending_.end());
+
+    vectors_++;
+    const uint64_t start = vectors_ * span_;
+    uint64_t stamped = UINT64_MAX;
+    for (const auto& [offset, id] : pending_) {
+        const uint8_t value = circuit_->wires()[id]->get_value() ? 1 : 0;
+        if (value == dumped_[id]) {
+            continue; // Unchanged input, or a wire listed twice
+        }
+        if (offset != stamped) {
+            stamped = offset;
+            buffer_.push_back('#');
+            buffer_ += std::to_string(start + offset);
+            buffer_.push_back('\n');
+        }
+        dumped_[id] = value;
+        put_change(id, value != 0);
+        changes_++;
+    }
+    maybe_flush();
+}
+
+void VcdWriter::maybe_flush() {
+    if (buffer_.size() >= BUFFER_BYTES) {
+        flush();
+    }
+}
+
+void VcdWriter::flush() {
+    if (file_ == nullptr || buffer_.empty()) {
+        return;
+    }
+    const size_t written = std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+    const bool complete = written == buffer_.size();
+    buffer_.clear();
+    if (!complete) {
+        throw std::runtime_error("VcdWriter: write to " + path_ + " failed");
+    }
+}
+
+void VcdWriter::close() {
+    if (file_ == nullptr) {
+        return;
+    }
+    // Mark the end of the last window so viewers show its final values
+    buffer_.push_back('#');
+    buffer_ += std::to_string((vectors_ + 1) * span_);
+    buffer_.push_back('\n');
+
+    std::FILE* file = file_;
+    try {
+        flush();
+    } catch (...) {
+        file_ = nullptr;
+        std::fclose(file);
+        throw;
+    }
+    file_ = nullptr;
+    if (std::fclose(file) != 0) {
+        throw std::runtime_error("VcdWriter: closing " + path_ + " failed");
+    }
+}
+
+} // namespace gateflow
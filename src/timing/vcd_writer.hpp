@@ -0,0 +1,94 @@
+/// @file vcd_writer.hpp
+/// @brief Streams propagation history to a Value Change Dump (VCD) file
+///
+/// Each recorded propagation pass is one vector and gets its own window of
+/// trace time, vector_span() long. Within the window, primary inputs change
+/// at its start and every other wire at its offset: in depth time the level
+/// of its source gate plus one (1 ns per level), in delay time its
+/// TimingAnalysis::arrival() (1 ns per delay unit, 10 ps resolution), so
+/// waveform viewers show the same ordering the scheduler animates. Only
+/// PropagationResult::changed_wires and the primary inputs are visited per
+/// vector, and output goes through a fixed-size buffer, so memory does not
+/// grow with the number of vectors.
+
+#pragma once
+
+#include "simulation/circuit.hpp"
+#include "timing/static_timing.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gateflow {
+
+class VcdWriter {
+  public:
+    /// Trace ticks per delay unit in delay time (the $timescale is 10 ps)
+    static constexpr uint64_t DELAY_TICKS = 100;
+
+    /// Opens @p path and writes the header and the circuit's current values
+    /// (usually its settled state before the first vector), in depth time.
+    /// Inputs are named in<i>, outputs out<i>, other wires w<id>.
+    /// @throws std::runtime_error if the circuit is not finalized or the
+    ///         file cannot be opened
+    VcdWriter(const Circuit& circuit, const std::string& path);
+
+    /// Same, in the delay time of @p timing
+    VcdWriter(const TimingAnalysis& timing, const std::string& path);
+
+    /// Flushes and closes; write errors are ignored here (call close() to see them)
+    ~VcdWriter();
+
+    VcdWriter(const VcdWriter&) = delete;
+    VcdWriter& operator=(const VcdWriter&) = delete;
+
+    /// Appends the pass that produced @p result (plus any input changes
+    /// since the last record) as the next vector.
+    /// @throws std::runtime_error on a write error or after close()
+    void record(const PropagationResult& result);
+
+    /// Writes the buffered text to the file
+    /// @throws std::runtime_error on a write error
+    void flush();
+
+    /// Flushes and closes the file. Further record() calls throw.
+    /// @throws std::runtime_error on a write error
+    void close();
+
+    /// Trace time of one vector's window, in ticks
+    [[nodiscard]] uint64_t vector_span() const { return span_; }
+    /// Vectors recorded so far. Vector n starts at (n + 1) * vector_span();
+    /// the initial values occupy the window at time 0.
+    [[nodiscard]] uint64_t vectors() const { return vectors_; }
+    /// Value changes written so far, excluding the initial values
+    [[nodiscard]] uint64_t changes() const { return changes_; }
+    [[nodiscard]] bool delay_time() const { return delay_time_; }
+
+  private:
+    VcdWriter(const Circuit& circuit, const TimingAnalysis* timing, const std::string& path);
+
+    void write_header();
+    /// Appends "<value><code>\n" for wire @p id
+    void put_change(uint32_t id, bool value);
+    /// Writes the buffer out once it exceeds BUFFER_BYTES
+    void maybe_flush();
+
+    const Circuit* circuit_;
+    std::FILE* file_ = nullptr;
+    std::string path_;
+    std::string buffer_;
+    bool delay_time_ = false;
+    uint64_t span_ = 1;
+    uint64_t vectors_ = 0;
+    uint64_t changes_ = 0;
+    std::vector<uint64_t> offsets_;    ///< Per wire id: ticks into a vector's window
+    std::vector<std::string> codes_;   ///< Per wire id: VCD identifier code
+    std::vector<uint8_t> dumped_;      ///< Per wire id: last value written
+    std::vector<std::pair<uint64_t, uint32_t>> pending_; ///< (offset, wire id) of one vector
+};
+
+} // namespace gateflow
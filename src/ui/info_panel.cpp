@@ -24,7 +24,6 @@ constexpr float EXPL_LINE_GAP = 3.0f;
 constexpr float EXPL_PARAGRAPH_GAP = 4.0f;
 constexpr float EXPL_SCROLL_SPEED = 22.0f;
 constexpr float EXPL_SCROLL_SMOOTHING = 0.18f;
-constexpr int NUM_BITS = 7;
 
 const Color BG_COLOR = {35, 35, 42, 230};
 const Color BORDER_COLOR = {70, 70, 85, 255};
@@ -39,6 +38,7 @@ const Color EXPL_LABEL_COLOR = {200, 200, 220, 255};
 const Color EXPL_TEXT_COLOR = {190, 190, 205, 255};
 const Color CARRY_OK_COLOR = {90, 220, 120, 255};
 const Color CARRY_PENDING_COLOR = {220, 200, 120, 255};
+const Color CRITICAL_COLOR = {255, 80, 160, 255}; // Matches the critical-path overlay
 
 /// Draws wrapped text and returns consumed height.
 float draw_wrapped_text(const std::string& text, float x, float y, float max_width, int font_size,
@@ -130,8 +130,7 @@ float measure_wrapped_text_ex(const std::string& text, float max_width, float fo
 
 std::vector<const Wire*> collect_carry_wires(const Circuit& circuit) {
     std::vector<const Wire*> carries;
-    for (const auto& wire_ptr : circuit.wires()) {
-        const Wire* wire = wire_ptr.get();
+    for (const Wire* wire : circuit.wires()) {
         const Gate* src = wire->get_source();
         if (src == nullptr) {
             continue;
@@ -170,9 +169,19 @@ std::vector<const Wire*> collect_carry_wires(const Circuit& circuit) {
     return carries;
 }
 
+/// Depth the propagation has roughly reached. In delay time, the elapsed
+/// fraction of the end time is mapped onto the depth range.
+int approximate_depth(const PropagationScheduler& scheduler) {
+    if (!scheduler.uses_delay_time() || scheduler.end_time() <= 0.0f) {
+        return static_cast<int>(scheduler.current_time());
+    }
+    float fraction = scheduler.current_time() / scheduler.end_time();
+    return static_cast<int>(fraction * static_cast<float>(scheduler.max_depth() + 1));
+}
+
 std::string whats_happening_now(const PropagationScheduler& scheduler, int input_a, int input_b,
                                 int result) {
-    if (scheduler.current_depth() < 0.0f) {
+    if (scheduler.current_time() < 0.0f) {
         return "Enter two numbers (0-99) and press Run. Signals will enter each bit column and start addition at Bit 0.";
     }
 
@@ -181,7 +190,7 @@ std::string whats_happening_now(const PropagationScheduler& scheduler, int input
                std::to_string(result) + ". All sum bits and carries are now stable.";
     }
 
-    int depth = static_cast<int>(scheduler.current_depth());
+    int depth = approximate_depth(scheduler);
     int approx_bit = std::min(6, std::max(0, depth / 3));
     if (depth <= 1) {
         return "Bit 0 is resolving: XOR computes the sum bit, AND computes the first carry.";
@@ -193,14 +202,14 @@ std::string whats_happening_now(const PropagationScheduler& scheduler, int input
 
 /// Generate a human-readable status message based on current propagation depth
 std::string propagation_status(const PropagationScheduler& scheduler) {
-    if (scheduler.current_depth() < 0.0f) {
+    if (scheduler.current_time() < 0.0f) {
         return "Ready — press Run or Space to start";
     }
     if (scheduler.is_complete()) {
         return "Propagation complete";
     }
 
-    int depth = static_cast<int>(scheduler.current_depth());
+    int depth = approximate_depth(scheduler);
     int max_d = scheduler.max_depth();
 
     // The carry chain in a 7-bit RCA goes through depths roughly:
@@ -210,19 +219,39 @@ std::string propagation_status(const PropagationScheduler& scheduler) {
         approx_bit = 6;
     }
 
+    // Progress as depth levels, or as time when replaying gate delays
+    char progress[48];
+    if (scheduler.uses_delay_time()) {
+        std::snprintf(progress, sizeof(progress), "[t %.1f/%.1f]",
+                      static_cast<double>(scheduler.current_time()),
+                      static_cast<double>(scheduler.end_time()));
+    } else {
+        std::snprintf(progress, sizeof(progress), "[%d/%d]", depth, max_d);
+    }
+
     char buf[128];
     if (depth <= 1) {
-        std::snprintf(buf, sizeof(buf), "Processing bit 0 (least significant)... [%d/%d]", depth,
-                      max_d);
+        std::snprintf(buf, sizeof(buf), "Processing bit 0 (least significant)... %s", progress);
     } else {
-        std::snprintf(buf, sizeof(buf), "Carry propagating through bit %d... [%d/%d]", approx_bit,
-                      depth, max_d);
+        std::snprintf(buf, sizeof(buf), "Carry propagating through bit %d... %s", approx_bit,
+                      progress);
     }
     return buf;
 }
 
 } // namespace
 
+size_t adder_width(const Circuit& circuit) { return circuit.num_inputs() / 2; }
+
+size_t result_display_bits(const Circuit& circuit) {
+    return std::min(adder_width(circuit), MAX_RESULT_BITS);
+}
+
+const Wire* adder_carry_out(const Circuit& circuit) {
+    const std::vector<Wire*>& outputs = circuit.output_wires();
+    return outputs.size() > adder_width(circuit) ? outputs.back() : nullptr;
+}
+
 float draw_info_panel(const Circuit& circuit, const PropagationScheduler& scheduler, int input_a,
                       int input_b, int result, float panel_x, float panel_y, float panel_w) {
     const auto& sc = ui_scale();
@@ -258,13 +287,15 @@ float draw_info_panel(const Circuit& circuit, const PropagationScheduler& schedu
     DrawAppText("RESULT", static_cast<int>(cx), static_cast<int>(cy), FONT_SIZE, TEXT_COLOR);
     cy += ROW_HEIGHT + 4.0f;
 
-    // Weighted binary columns
-    const int weights[NUM_BITS] = {64, 32, 16, 8, 4, 2, 1};
+    // Weighted binary columns, narrowed if the widest readout would not fit
+    const int num_bits = static_cast<int>(result_display_bits(circuit));
     float bit_x0 = cx + 56.0f;
-    float bit_step = 28.0f;
+    float bit_step = num_bits > 0 ? std::min(28.0f, (panel_w - 2.0f * PADDING - 104.0f) /
+                                                        static_cast<float>(num_bits))
+                                  : 28.0f;
 
-    for (int i = 0; i < NUM_BITS; i++) {
-        std::string w = std::to_string(weights[i]);
+    for (int i = 0; i < num_bits; i++) {
+        std::string w = std::to_string(1 << (num_bits - 1 - i));
         DrawAppText(w.c_str(), static_cast<int>(bit_x0 + i * bit_step), static_cast<int>(cy),
                  FONT_SIZE_SMALL, LABEL_COLOR);
     }
@@ -272,8 +303,8 @@ float draw_info_panel(const Circuit& circuit, const PropagationScheduler& schedu
 
     auto draw_bits_row = [&](const char* row_label, int value, bool output_row) {
         DrawAppText(row_label, static_cast<int>(cx), static_cast<int>(cy), FONT_SIZE, LABEL_COLOR);
-        for (int i = 0; i < NUM_BITS; i++) {
-            int bit_idx = NUM_BITS - 1 - i;
+        for (int i = 0; i < num_bits; i++) {
+            int bit_idx = num_bits - 1 - i;
             bool bit_val = ((value >> bit_idx) & 1) != 0;
             bool resolved = true;
             if (output_row && bit_idx < static_cast<int>(circuit.output_wires().size())) {
@@ -288,7 +319,7 @@ float draw_info_panel(const Circuit& circuit, const PropagationScheduler& schedu
 
         if (!output_row || scheduler.is_complete()) {
             std::string dec = "= " + std::to_string(value);
-            DrawAppText(dec.c_str(), static_cast<int>(bit_x0 + NUM_BITS * bit_step + 8),
+            DrawAppText(dec.c_str(), static_cast<int>(bit_x0 + static_cast<float>(num_bits) * bit_step + 8),
                      static_cast<int>(cy), FONT_SIZE, TEXT_COLOR);
         }
         cy += ROW_HEIGHT;
@@ -305,7 +336,8 @@ float draw_info_panel(const Circuit& circuit, const PropagationScheduler& schedu
     draw_bits_row("S:", result, true);
 
     bool cout_resolved = scheduler.is_complete();
-    bool cout_val = circuit.get_output(NUM_BITS);
+    const Wire* cout_wire = adder_carry_out(circuit);
+    bool cout_val = cout_wire != nullptr && cout_wire->get_value();
     std::string cout_txt = std::string("Cout: ") + (cout_resolved ? (cout_val ? "1" : "0") : "-");
     DrawAppText(cout_txt.c_str(), static_cast<int>(cx), static_cast<int>(cy), FONT_SIZE,
              cout_resolved ? (cout_val ? BIT_RESOLVED_ONE : BIT_RESOLVED_ZERO) : BIT_PENDING);
@@ -322,7 +354,9 @@ float draw_info_panel(const Circuit& circuit, const PropagationScheduler& schedu
         const Color CARRY_GRAY   = {110, 110, 130, 255};
         const Color CARRY_DIM    = {55, 55, 65, 255};
         float dot_cy = cy + static_cast<float>(FONT_SIZE_SMALL) / 2.0f;
-        for (size_t i = 0; i < carries.size(); i++) {
+        // One dot per displayed bit column
+        const size_t num_dots = std::min(carries.size(), static_cast<size_t>(num_bits));
+        for (size_t i = 0; i < num_dots; i++) {
             bool resolved = scheduler.is_wire_resolved(carries[i]);
             bool val = carries[i]->get_value();
             Color dot_color = !resolved ? CARRY_DIM
@@ -594,4 +628,143 @@ float draw_explanation_panel(float panel_x, float panel_y, float panel_w,
     return panel_h;
 }
 
+float draw_timing_panel(const TimingAnalysis& timing, const PropagationScheduler& scheduler,
+                        float panel_x, float panel_y, float panel_w) {
+    const auto& sc = ui_scale();
+    const float PADDING = sc.padding;
+    const float ROW_HEIGHT = sc.row_height;
+    const int FONT_SIZE = sc.font_normal;
+    const int FONT_SIZE_SMALL = sc.font_small;
+    constexpr float BAR_H = 8.0f;
+
+    // Title, path summary, time base, segment bar
+    const float panel_h = PADDING * 2.0f + ROW_HEIGHT * 3.0f + BAR_H;
+    DrawRectangleRec({panel_x, panel_y, panel_w, panel_h}, BG_COLOR);
+    DrawRectangleLinesEx({panel_x, panel_y, panel_w, panel_h}, 1.0f, BORDER_COLOR);
+
+    float cx = panel_x + PADDING;
+    float cy = panel_y + PADDING;
+    const CriticalPath& path = timing.critical_path();
+
+    DrawAppText("CRITICAL PATH (C)", static_cast<int>(cx), static_cast<int>(cy), FONT_SIZE,
+                CRITICAL_COLOR);
+    cy += ROW_HEIGHT;
+
+    char buf[96];
+    std::snprintf(buf, sizeof(buf), "%zu gates, delay %.1f (NAND = %.1f)", path.gates.size(),
+                  static_cast<double>(path.delay),
+                  static_cast<double>(timing.model().delay(GateType::NAND)));
+    DrawAppText(buf, static_cast<int>(cx), static_cast<int>(cy), FONT_SIZE_SMALL, TEXT_COLOR);
+    cy += ROW_HEIGHT;
+
+    if (const EventSimulator* events = scheduler.events()) {
+        std::snprintf(buf, sizeof(buf), "Event-driven, %zu glitching wires (T)",
+                      events->glitch_count());
+    } else {
+        std::snprintf(buf, sizeof(buf), "%s",
+                      scheduler.uses_delay_time() ? "Animating in gate-delay time (T)"
+                                                  : "Animating one depth per step (T)");
+    }
+    DrawAppText(buf, static_cast<int>(cx), static_cast<int>(cy), FONT_SIZE_SMALL, LABEL_COLOR);
+    cy += ROW_HEIGHT;
+
+    // One segment per path gate, widths proportional to gate delay
+    const float bar_w = panel_w - 2.0f * PADDING;
+    float sx = cx;
+    for (const Gate* gate : path.gates) {
+        const float w = path.delay > 0.0f ? bar_w * timing.delay(gate) / path.delay : 0.0f;
+        Color c = scheduler.is_gate_resolved(gate) ? CRITICAL_COLOR : BIT_PENDING;
+        DrawRectangleRec({sx, cy, std::max(w - 1.0f, 1.0f), BAR_H}, c);
+        sx += w;
+    }
+
+    return panel_h;
+}
+
+#if GATEFLOW_ENABLE_PROFILER
+float draw_profiler_overlay(const Circuit& circuit, const FrameProfiler& profiler,
+                            const std::vector<NamedMemoryUsage>& memory, float x, float y) {
+    const auto& sc = ui_scale();
+    const int font = sc.font_tiny;
+    const float line_h = static_cast<float>(font) + 4.0f;
+    const float pad = sc.padding * 0.6f;
+    const float col_w = static_cast<float>(MeasureAppText("00.000", font)) + 8.0f;
+    const float name_w = static_cast<float>(MeasureAppText("Wire geometry", font)) + 12.0f;
+
+    // Header, counts, column titles, one row per phase; then column titles,
+    // one row per structure and the total
+    const float w = pad * 2.0f + name_w + col_w * 3.0f;
+    const float memory_rows = memory.empty() ? 0.0f : 2.0f + static_cast<float>(memory.size());
+    const float h =
+        pad * 2.0f + line_h * (3.0f + static_cast<float>(FRAME_PHASE_COUNT) + memory_rows);
+    DrawRectangleRec({x, y, w, h}, BG_COLOR);
+    DrawRectangleLinesEx({x, y, w, h}, 1.0f, BORDER_COLOR);
+
+    char buf[96];
+    float cx = x + pad;
+    float cy = y + pad;
+
+    std::snprintf(buf, sizeof(buf), "PROFILER (F3)  %d FPS", GetFPS());
+    DrawAppText(buf, static_cast<int>(cx), static_cast<int>(cy), font, TEXT_COLOR);
+    cy += line_h;
+
+    std::snprintf(buf, sizeof(buf), "%zu gates  %zu wires  %u draws", circuit.gates().size(),
+                  circuit.wires().size(), profiler.last_draw_calls());
+    DrawAppText(buf, static_cast<int>(cx), static_cast<int>(cy), font, LABEL_COLOR);
+    cy += line_h;
+
+    const char* headers[] = {"min", "avg", "p99"};
+    for (int c = 0; c < 3; c++) {
+        DrawAppText(headers[c], static_cast<int>(cx + name_w + col_w * static_cast<float>(c)),
+                    static_cast<int>(cy), font, LABEL_COLOR);
+    }
+    cy += line_h;
+
+    for (size_t p = 0; p < FRAME_PHASE_COUNT; p++) {
+        const auto phase = static_cast<FramePhase>(p);
+        const PhaseStats st = profiler.stats(phase);
+        DrawAppText(std::string(frame_phase_name(phase)).c_str(), static_cast<int>(cx),
+                    static_cast<int>(cy), font, TEXT_COLOR);
+        const double values[] = {st.min_ms, st.avg_ms, st.p99_ms};
+        for (int c = 0; c < 3; c++) {
+            std::snprintf(buf, sizeof(buf), "%.3f", values[c]);
+            DrawAppText(buf, static_cast<int>(cx + name_w + col_w * static_cast<float>(c)),
+                        static_cast<int>(cy), font, c == 2 ? STATUS_COLOR : TEXT_COLOR);
+        }
+        cy += line_h;
+    }
+
+    if (memory.empty()) {
+        return h;
+    }
+    const char* memory_headers[] = {"KB", "allocs"};
+    for (int c = 0; c < 2; c++) {
+        DrawAppText(memory_headers[c],
+                    static_cast<int>(cx + name_w + col_w * static_cast<float>(c)),
+                    static_cast<int>(cy), font, LABEL_COLOR);
+    }
+    cy += line_h;
+
+    size_t total_bytes = 0;
+    size_t total_allocations = 0;
+    auto memory_row = [&](const char* name, size_t bytes, size_t allocations, Color color) {
+        DrawAppText(name, static_cast<int>(cx), static_cast<int>(cy), font, color);
+        std::snprintf(buf, sizeof(buf), "%.1f", static_cast<double>(bytes) / 1024.0);
+        DrawAppText(buf, static_cast<int>(cx + name_w), static_cast<int>(cy), font, color);
+        std::snprintf(buf, sizeof(buf), "%zu", allocations);
+        DrawAppText(buf, static_cast<int>(cx + name_w + col_w), static_cast<int>(cy), font, color);
+        cy += line_h;
+    };
+    for (const NamedMemoryUsage& entry : memory) {
+        total_bytes += entry.usage.total_bytes();
+        total_allocations += entry.usage.total_allocations();
+        memory_row(entry.name.c_str(), entry.usage.total_bytes(), entry.usage.total_allocations(),
+                   TEXT_COLOR);
+    }
+    memory_row("Total", total_bytes, total_allocations, STATUS_COLOR);
+
+    return h;
+}
+#endif
+
 } // namespace gateflow
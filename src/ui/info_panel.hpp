@@ -4,12 +4,32 @@
 #pragma once
 
 #include "simulation/circuit.hpp"
+#include "simulation/memory_usage.hpp"
+#include "timing/frame_profiler.hpp"
 #include "timing/propagation_scheduler.hpp"
+#include "timing/static_timing.hpp"
 
 #include <raylib.h>
 
+#include <cstddef>
+#include <vector>
+
 namespace gateflow {
 
+/// Most result bits the info panel shows. The UI's operands are 0-99, so
+/// their sum fits; the higher sum bits of a wider adder stay 0.
+inline constexpr size_t MAX_RESULT_BITS = 8;
+
+/// Operand width of an adder whose inputs are A then B: num_inputs() / 2
+[[nodiscard]] size_t adder_width(const Circuit& circuit);
+
+/// Result bits the info panel shows: the adder width, at most MAX_RESULT_BITS
+[[nodiscard]] size_t result_display_bits(const Circuit& circuit);
+
+/// The adder's carry-out, its last output after the adder_width() sum bits.
+/// nullptr if the circuit has no output past the sum bits.
+[[nodiscard]] const Wire* adder_carry_out(const Circuit& circuit);
+
 /// Draws the information panel showing:
 /// - Binary representation of A, B, and the result (bits highlight as they resolve)
 /// - Decimal result (appears when propagation completes)
@@ -40,4 +60,30 @@ float draw_explanation_panel(float panel_x, float panel_y, float panel_w,
                              const PropagationScheduler& scheduler, int input_a, int input_b,
                              int result, float available_h);
 
+/// Draws the critical-path panel: path length and delay under the timing
+/// model, the time base the scheduler animates in, and one segment per path
+/// gate that lights up as the signal reaches it.
+/// @param timing    Timing analysis of the visualized circuit
+/// @param scheduler The propagation scheduler (for resolution and time base)
+/// @param panel_x   Left edge of panel in screen coords
+/// @param panel_y   Top edge of panel in screen coords
+/// @param panel_w   Width of the panel
+/// @return Rendered panel height.
+float draw_timing_panel(const TimingAnalysis& timing, const PropagationScheduler& scheduler,
+                        float panel_x, float panel_y, float panel_w);
+
+#if GATEFLOW_ENABLE_PROFILER
+/// Draws the frame profiler overlay: FPS, gate/wire and draw-call counts,
+/// min/avg/p99 milliseconds per frame phase over the profiler window, and
+/// the heap bytes and allocations of each structure in @p memory.
+/// @param circuit  The circuit being visualized (for gate/wire counts)
+/// @param profiler The profiler to read
+/// @param memory   One row per structure, plus a total row
+/// @param x        Left edge of the overlay in screen coords
+/// @param y        Top edge of the overlay in screen coords
+/// @return Rendered overlay height.
+float draw_profiler_overlay(const Circuit& circuit, const FrameProfiler& profiler,
+                            const std::vector<NamedMemoryUsage>& memory, float x, float y);
+#endif
+
 } // namespace gateflow
@@ -246,7 +246,8 @@ InputPanelResult draw_input_panel(UIState& state, float panel_x, float panel_y,
     measure_y += ROW_HEIGHT + ROW_GAP + 4.0f;     // Input B
     measure_y += BUTTON_HEIGHT + ROW_GAP;          // +/- quick adjust row
     measure_y += BUTTON_HEIGHT + ROW_GAP + 4.0f;  // Button row
-    measure_y += ROW_HEIGHT + SLIDER_HEIGHT + ROW_GAP; // Slider block
+    measure_y += ROW_HEIGHT + SLIDER_HEIGHT + ROW_GAP; // Speed slider block
+    measure_y += ROW_HEIGHT + SLIDER_HEIGHT + ROW_GAP; // Time slider block
     measure_y += BUTTON_HEIGHT + ROW_GAP;          // Preset row
     measure_y += BUTTON_HEIGHT;                   // NAND toggle
     result.panel_height = (measure_y + PADDING) - panel_y;
@@ -330,6 +331,13 @@ InputPanelResult draw_input_panel(UIState& state, float panel_x, float panel_y,
     }
     cy += ROW_HEIGHT + SLIDER_HEIGHT + ROW_GAP;
 
+    // Time slider: scrubs through the propagation in either direction
+    if (draw_slider("Time", state.scrub_time, 0.0f, state.scrub_end, state.dragging_scrub, cx, cy,
+                    content_w - 40.0f)) {
+        action.scrubbed = true;
+    }
+    cy += ROW_HEIGHT + SLIDER_HEIGHT + ROW_GAP;
+
     // Educational presets row
     float p_w = (content_w - 2.0f * 4.0f) / 3.0f;
     if (draw_button("99+99", cx, cy, p_w, BUTTON_HEIGHT, BUTTON_BG, BUTTON_BG_HOVER)) {
@@ -20,6 +20,7 @@ struct UIAction {
     bool reset_pressed = false;  ///< Reset propagation to start
     bool nand_toggled = false;   ///< Toggle logical / NAND view
     bool speed_changed = false;  ///< Speed slider was dragged
+    bool scrubbed = false;       ///< Time slider was dragged — seek to scrub_time
 };
 
 /// Result of drawing the input panel.
@@ -35,6 +36,8 @@ struct UIState {
     float speed = 1.0f;
     bool is_running = true;
     bool show_nand = false;
+    float scrub_time = 0.0f; ///< Time slider value; follows playback unless dragged
+    float scrub_end = 1.0f;  ///< Time slider maximum (the scheduler's end time)
 
     // Internal editing state
     bool editing_a = false;
@@ -46,6 +49,7 @@ struct UIState {
 
     // Slider drag state
     bool dragging_speed = false;
+    bool dragging_scrub = false;
 };
 
 /// Draws the input panel and handles mouse/keyboard interaction.
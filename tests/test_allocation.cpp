@@ -0,0 +1,133 @@
+/// @file test_allocation.cpp
+/// @brief Tests that steady-state propagation performs no heap allocations
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/lane_simulator.hpp"
+#include "simulation/nand_decompose.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counting replacement for the global allocator. It applies to the whole
+// test binary, but only the difference across a measured region matters.
+namespace {
+std::atomic<size_t> g_allocations{0};
+
+void* counted_alloc(std::size_t size) noexcept {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+} // namespace
+
+// Every replaceable form is overridden so allocation and deallocation always
+// pair through malloc/free (sanitizers flag mixed pairs).
+void* operator new(std::size_t size) {
+    if (void* p = counted_alloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return counted_alloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return counted_alloc(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+using namespace gateflow;
+
+namespace {
+
+/// Toggles every input on and then off again, propagating after each edit.
+/// The circuit ends in the state it started in, so repeated cycles see the
+/// same activity and need no more buffer capacity than the first.
+void toggle_cycle(Circuit& circuit, PropagationResult& result) {
+    for (int value = 1; value >= 0; value--) {
+        for (size_t i = 0; i < circuit.num_inputs(); i++) {
+            circuit.set_input(i, value != 0);
+            circuit.propagate(result);
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Steady-state propagation does not allocate", "[allocation]") {
+    auto circuit = build_ripple_carry_adder(16);
+    PropagationResult result;
+
+    toggle_cycle(*circuit, result); // warm-up grows every reused buffer
+
+    size_t before = g_allocations.load();
+    toggle_cycle(*circuit, result);
+    size_t after = g_allocations.load();
+    CHECK(after - before == 0);
+}
+
+TEST_CASE("Steady-state NAND propagation does not allocate", "[allocation]") {
+    auto circuit = build_ripple_carry_adder(16);
+    decompose_to_nand(*circuit);
+    PropagationResult result;
+
+    toggle_cycle(*circuit, result);
+
+    size_t before = g_allocations.load();
+    toggle_cycle(*circuit, result);
+    size_t after = g_allocations.load();
+    CHECK(after - before == 0);
+}
+
+TEST_CASE("Packed and lane propagation do not allocate", "[allocation]") {
+    auto circuit = build_ripple_carry_adder(16);
+    NativeLaneSimulator sim(*circuit);
+
+    size_t before = g_allocations.load();
+    for (int pass = 0; pass < 8; pass++) {
+        circuit->set_input_packed(0, static_cast<uint64_t>(pass));
+        circuit->propagate_packed();
+        sim.set_input(0, NativeLaneBlock{});
+        sim.propagate();
+    }
+    size_t after = g_allocations.load();
+    CHECK(after - before == 0);
+}
+
+TEST_CASE("Allocation counter observes heap allocations", "[allocation]") {
+    size_t before = g_allocations.load();
+    auto circuit = build_ripple_carry_adder(2);
+    CHECK(g_allocations.load() > before);
+}
@@ -0,0 +1,153 @@
+/// @file test_animation_state.cpp
+/// @brief Tests that animation state tracks the scheduler and settles when done
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "rendering/animation_state.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/nand_decompose.hpp"
+#include "timing/static_timing.hpp"
+
+using namespace gateflow;
+using Catch::Approx;
+
+namespace {
+
+/// Every gate and wire must agree with the scheduler's own per-element queries
+void check_matches_scheduler(const Circuit& circuit, const AnimationState& anim,
+                             const PropagationScheduler& scheduler) {
+    for (const Gate* gate : circuit.gates()) {
+        REQUIRE(anim.gate_anim(gate).resolved == scheduler.is_gate_resolved(gate));
+    }
+    for (const Wire* wire : circuit.wires()) {
+        const WireAnim& wa = anim.wire_anim(wire);
+        REQUIRE(wa.resolved == scheduler.is_wire_resolved(wire));
+        REQUIRE(wa.signal_progress == Approx(scheduler.wire_signal_progress(wire)));
+    }
+}
+
+} // namespace
+
+TEST_CASE("AnimationState follows the scheduler frame by frame", "[animation]") {
+    auto circuit = build_ripple_carry_adder(4);
+    decompose_to_nand(*circuit);
+    (void)circuit->propagate();
+
+    PropagationScheduler scheduler(circuit.get());
+    AnimationState anim(circuit.get());
+    scheduler.set_speed(3.0f);
+    check_matches_scheduler(*circuit, anim, scheduler);
+
+    // Uneven frame times, including one that skips several depths at once
+    const float frames[] = {0.1f, 0.25f, 0.016f, 1.7f, 0.016f, 0.3f, 0.5f, 2.0f, 5.0f};
+    for (float dt : frames) {
+        scheduler.tick(dt);
+        anim.update(dt, scheduler);
+        check_matches_scheduler(*circuit, anim, scheduler);
+    }
+    CHECK(scheduler.is_complete());
+}
+
+TEST_CASE("AnimationState follows a scheduler in gate-delay time", "[animation]") {
+    auto circuit = build_ripple_carry_adder(4);
+    (void)circuit->propagate();
+    TimingAnalysis timing(*circuit, DelayModel::typical());
+
+    PropagationScheduler scheduler(circuit.get());
+    scheduler.use_delay_time(timing);
+    AnimationState anim(circuit.get());
+    scheduler.set_speed(4.0f);
+
+    // Gates of one depth overlap in time, so several wires are in flight at once
+    const float frames[] = {0.3f, 0.05f, 0.4f, 0.016f, 1.1f, 0.2f, 0.7f, 10.0f};
+    for (float dt : frames) {
+        scheduler.tick(dt);
+        anim.update(dt, scheduler);
+        check_matches_scheduler(*circuit, anim, scheduler);
+    }
+    CHECK(scheduler.is_complete());
+}
+
+TEST_CASE("AnimationState follows seeks in both directions", "[animation]") {
+    auto circuit = build_ripple_carry_adder(4);
+    (void)circuit->propagate();
+    TimingAnalysis timing(*circuit, DelayModel::typical());
+    PropagationScheduler scheduler(circuit.get());
+    scheduler.set_mode(PlaybackMode::PAUSED);
+
+    auto scrub = [&](const float* times, size_t count, float end) {
+        AnimationState anim(circuit.get());
+        for (size_t i = 0; i < count; i++) {
+            scheduler.seek(times[i] * end);
+            anim.update(0.016f, scheduler);
+            check_matches_scheduler(*circuit, anim, scheduler);
+        }
+        // Stepping back from the end un-resolves one depth at a time
+        scheduler.seek(end);
+        anim.update(0.016f, scheduler);
+        while (scheduler.current_time() > -1.0f) {
+            scheduler.step_back();
+            anim.update(0.016f, scheduler);
+            check_matches_scheduler(*circuit, anim, scheduler);
+        }
+    };
+
+    // Fractions of the end time: jumps forward past many gates, back within
+    // a gate's fade, back before the inputs and forward again
+    const float times[] = {0.9f, 0.2f, 0.25f, 0.23f, 1.0f, 0.5f, -0.1f, 0.6f, 0.59f, 0.0f, 0.7f};
+    const size_t count = sizeof(times) / sizeof(times[0]);
+    SECTION("Depth time") { scrub(times, count, scheduler.end_time()); }
+    SECTION("Delay time") {
+        scheduler.use_delay_time(timing);
+        scheduler.set_mode(PlaybackMode::PAUSED);
+        scrub(times, count, scheduler.end_time());
+    }
+}
+
+TEST_CASE("AnimationState shares one pulse across pending gates", "[animation]") {
+    auto circuit = build_ripple_carry_adder(2);
+    PropagationScheduler scheduler(circuit.get());
+    AnimationState anim(circuit.get());
+    scheduler.set_mode(PlaybackMode::PAUSED);
+
+    anim.update(0.2f, scheduler);
+    const GateAnim& first = anim.gate_anim(circuit->gates()[0]);
+    for (const Gate* gate : circuit->gates()) {
+        const GateAnim& ga = anim.gate_anim(gate);
+        CHECK_FALSE(ga.resolved);
+        CHECK(ga.alpha == Approx(first.alpha));
+        CHECK(ga.pulse_phase == Approx(first.pulse_phase));
+    }
+    CHECK(first.alpha >= 0.15f);
+    CHECK(first.alpha <= 0.45f);
+}
+
+TEST_CASE("AnimationState settles once propagation and fades finish", "[animation]") {
+    auto circuit = build_ripple_carry_adder(2);
+    PropagationScheduler scheduler(circuit.get());
+    AnimationState anim(circuit.get());
+    scheduler.set_speed(100.0f);
+
+    scheduler.tick(1.0f); // jumps straight to complete
+    anim.update(0.05f, scheduler);
+    CHECK(scheduler.is_complete());
+    CHECK_FALSE(anim.is_settled()); // gates are still fading in
+
+    for (int frame = 0; frame < 10; frame++) {
+        scheduler.tick(0.05f);
+        anim.update(0.05f, scheduler);
+    }
+    CHECK(anim.is_settled());
+    for (const Gate* gate : circuit->gates()) {
+        CHECK(anim.gate_anim(gate).alpha == Approx(1.0f));
+    }
+
+    // Restarting the scheduler replays from nothing resolved
+    scheduler.reset();
+    anim.update(0.0f, scheduler);
+    CHECK_FALSE(anim.is_settled());
+    for (const Gate* gate : circuit->gates()) {
+        CHECK_FALSE(anim.gate_anim(gate).resolved);
+    }
+}
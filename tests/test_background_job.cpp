@@ -0,0 +1,59 @@
+/// @file test_background_job.cpp
+/// @brief Tests for BackgroundJob completion polling and error hand-over
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/background_job.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace gateflow;
+
+TEST_CASE("Background job result is visible after finish", "[background_job]") {
+    BackgroundJob job;
+    CHECK_FALSE(job.active());
+
+    std::vector<int> result;
+    std::atomic<bool> release{false};
+    job.start([&] {
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+        for (int i = 0; i < 1000; i++) {
+            result.push_back(i);
+        }
+    });
+    CHECK(job.active());
+    CHECK_FALSE(job.done()); // Still waiting for release
+    CHECK_THROWS_AS(job.start([] {}), std::logic_error);
+
+    release = true;
+    while (!job.done()) {
+        std::this_thread::yield();
+    }
+    job.finish();
+    CHECK_FALSE(job.active());
+    CHECK(result.size() == 1000);
+    CHECK(result.back() == 999);
+
+    // Reusable once finished
+    int second = 0;
+    job.start([&] { second = 7; });
+    job.finish();
+    CHECK(second == 7);
+}
+
+TEST_CASE("Background job rethrows from finish", "[background_job]") {
+    BackgroundJob job;
+    job.start([] { throw std::runtime_error("build failed"); });
+    CHECK_THROWS_AS(job.finish(), std::runtime_error);
+    CHECK_FALSE(job.active());
+
+    // The error is reported once
+    job.start([] {});
+    CHECK_NOTHROW(job.finish());
+    CHECK_NOTHROW(job.finish()); // Nothing active
+}
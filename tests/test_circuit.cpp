@@ -4,6 +4,13 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/nand_decompose.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
 
 using namespace gateflow;
 
@@ -168,3 +175,265 @@ TEST_CASE("finalize() rejects inconsistent bidirectional connectivity", "[circui
 
     CHECK_THROWS_AS(circuit.finalize(), std::runtime_error);
 }
+
+TEST_CASE("finalize() rejects one-sided and mismatched fan-out links", "[circuit]") {
+    auto build = [](Circuit& circuit, Gate*& gate, Wire*& in) {
+        in = circuit.add_wire();
+        circuit.mark_input(in);
+        Wire* other = circuit.add_wire();
+        circuit.mark_input(other);
+        Wire* out = circuit.add_wire();
+        circuit.mark_output(out);
+        gate = circuit.add_gate(GateType::AND);
+        circuit.connect(in, nullptr, gate);
+        circuit.connect(other, nullptr, gate);
+        circuit.connect(out, gate, nullptr);
+    };
+
+    SECTION("destination without a matching input") {
+        Circuit circuit;
+        Gate* gate = nullptr;
+        Wire* in = nullptr;
+        build(circuit, gate, in);
+        in->add_destination(gate);
+        CHECK_THROWS_AS(circuit.finalize(), std::runtime_error);
+    }
+    SECTION("input repeated more often than its destination") {
+        Circuit circuit;
+        Gate* gate = nullptr;
+        Wire* in = nullptr;
+        build(circuit, gate, in);
+        gate->add_input(in);
+        CHECK_THROWS_AS(circuit.finalize(), std::runtime_error);
+    }
+    SECTION("repeated links mirrored on both sides are accepted") {
+        Circuit circuit;
+        Gate* gate = nullptr;
+        Wire* in = nullptr;
+        build(circuit, gate, in);
+        circuit.connect(in, nullptr, gate);
+        CHECK_NOTHROW(circuit.finalize());
+    }
+}
+
+TEST_CASE("finalize() handles a single wire fanning out to many gates", "[circuit]") {
+    Circuit circuit;
+    Wire* hub = circuit.add_wire();
+    circuit.mark_input(hub);
+    constexpr int FANOUT = 5000;
+    for (int i = 0; i < FANOUT; i++) {
+        Gate* gate = circuit.add_gate(GateType::NOT);
+        Wire* out = circuit.add_wire();
+        circuit.mark_output(out);
+        circuit.connect(hub, nullptr, gate);
+        circuit.connect(out, gate, nullptr);
+    }
+    circuit.finalize();
+    REQUIRE(circuit.topological_order().size() == static_cast<size_t>(FANOUT));
+
+    (void)circuit.propagate();
+    CHECK(circuit.get_output(0));
+    CHECK(circuit.get_output(FANOUT - 1));
+}
+
+TEST_CASE("Gate and wire addresses stay stable as the circuit grows", "[circuit]") {
+    Circuit circuit;
+    Gate* first_gate = circuit.add_gate(GateType::NOT);
+    Wire* first_wire = circuit.add_wire();
+    circuit.connect(first_wire, nullptr, first_gate);
+
+    // Enough objects to span several arena chunks
+    for (int i = 0; i < 5000; i++) {
+        circuit.add_gate(GateType::BUFFER);
+        circuit.add_wire();
+    }
+
+    CHECK(circuit.gates()[0] == first_gate);
+    CHECK(circuit.wires()[0] == first_wire);
+    CHECK(first_gate->get_inputs().size() == 1);
+    CHECK(first_gate->get_inputs()[0] == first_wire);
+    for (size_t i = 0; i < circuit.gates().size(); i++) {
+        REQUIRE(circuit.gates()[i]->get_id() == i);
+        REQUIRE(circuit.wires()[i]->get_id() == i);
+    }
+
+    // Moving the circuit keeps its objects where they are
+    Circuit moved = std::move(circuit);
+    CHECK(moved.gates()[0] == first_gate);
+    CHECK(first_wire->get_destinations()[0] == first_gate);
+}
+
+TEST_CASE("Pooled pointer lists grow and shrink in order", "[circuit]") {
+    Circuit circuit;
+    Wire* fanout = circuit.add_wire();
+    std::vector<Gate*> readers;
+    for (int i = 0; i < 300; i++) {
+        Gate* g = circuit.add_gate(GateType::BUFFER);
+        circuit.connect(fanout, nullptr, g);
+        readers.push_back(g);
+    }
+
+    const auto& dests = fanout->get_destinations();
+    REQUIRE(dests.size() == readers.size());
+    CHECK(std::equal(dests.begin(), dests.end(), readers.begin()));
+
+    // remove_destination() drops one occurrence and keeps the rest in order
+    fanout->remove_destination(readers[1]);
+    readers.erase(readers.begin() + 1);
+    REQUIRE(fanout->get_destinations().size() == readers.size());
+    CHECK(std::equal(fanout->get_destinations().begin(), fanout->get_destinations().end(),
+                     readers.begin()));
+
+    // A wide gate grows its input list through several capacities
+    Gate* wide = circuit.add_gate(GateType::OR);
+    std::vector<Wire*> inputs;
+    for (int i = 0; i < 40; i++) {
+        Wire* w = circuit.add_wire();
+        circuit.connect(w, nullptr, wide);
+        inputs.push_back(w);
+    }
+    CHECK(std::equal(wide->get_inputs().begin(), wide->get_inputs().end(), inputs.begin(),
+                     inputs.end()));
+}
+
+TEST_CASE("structural_hash depends on structure, not signal values", "[circuit]") {
+    auto build = [](GateType type) {
+        Circuit circuit;
+        Wire* a = circuit.add_wire();
+        Wire* b = circuit.add_wire();
+        Wire* out = circuit.add_wire();
+        circuit.mark_input(a);
+        circuit.mark_input(b);
+        circuit.mark_output(out);
+        Gate* gate = circuit.add_gate(type);
+        circuit.connect(a, nullptr, gate);
+        circuit.connect(b, nullptr, gate);
+        circuit.connect(out, gate, nullptr);
+        circuit.finalize();
+        return circuit;
+    };
+
+    Circuit and1 = build(GateType::AND);
+    Circuit and2 = build(GateType::AND);
+    CHECK(and1.structural_hash() == and2.structural_hash());
+
+    and2.set_input(0, true);
+    and2.set_input(1, true);
+    (void)and2.propagate();
+    CHECK(and1.structural_hash() == and2.structural_hash());
+
+    CHECK(build(GateType::OR).structural_hash() != and1.structural_hash());
+}
+
+TEST_CASE("clone() produces an independent, ready-to-run copy", "[circuit]") {
+    auto original = build_ripple_carry_adder(4);
+    original->set_input(0, true);
+    original->set_input(4, true);
+    (void)original->propagate();
+
+    auto copy = original->clone();
+    REQUIRE(copy->is_finalized());
+    REQUIRE(copy->gates().size() == original->gates().size());
+    REQUIRE(copy->wires().size() == original->wires().size());
+    CHECK(copy->structural_hash() == original->structural_hash());
+    for (size_t i = 0; i < original->wires().size(); i++) {
+        CHECK(copy->wires()[i] != original->wires()[i]);
+        CHECK(copy->wires()[i]->get_value() == original->wires()[i]->get_value());
+    }
+    for (size_t slot = 0; slot < original->topological_order().size(); slot++) {
+        CHECK(copy->topological_order()[slot]->get_id() ==
+              original->topological_order()[slot]->get_id());
+    }
+
+    // Edits to the copy leave the original untouched: 1+1 vs 3+1
+    copy->set_input(1, true);
+    (void)copy->propagate();
+    CHECK(copy->get_output(2));
+    CHECK_FALSE(original->get_output(2));
+    CHECK(original->get_output(1));
+
+    // The copy can be restructured and refinalized on its own
+    decompose_to_nand(*copy);
+    CHECK(copy->structural_hash() != original->structural_hash());
+    CHECK(original->gates().size() == 2 + 3 * 5);
+}
+
+TEST_CASE("clone() of an unfinalized circuit can be finalized", "[circuit]") {
+    Circuit circuit;
+    Wire* in = circuit.add_wire();
+    Wire* out = circuit.add_wire();
+    circuit.mark_input(in);
+    circuit.mark_output(out);
+    Gate* gate = circuit.add_gate(GateType::NOT);
+    circuit.connect(in, nullptr, gate);
+    circuit.connect(out, gate, nullptr);
+
+    auto copy = circuit.clone();
+    CHECK_FALSE(copy->is_finalized());
+    copy->finalize();
+    (void)copy->propagate();
+    CHECK(copy->get_output(0));
+}
+
+TEST_CASE("Buses set and read adder operands as numbers", "[circuit]") {
+    auto circuit = build_ripple_carry_adder(8);
+    REQUIRE(circuit->input_buses().size() == 2);
+    REQUIRE(circuit->output_buses().size() == 2);
+    CHECK(circuit->find_input_bus("B") == 1);
+    CHECK(circuit->output_buses()[1].first == 8);
+
+    circuit->set_bus("A", 200);
+    circuit->set_bus("B", 100);
+    (void)circuit->propagate();
+    CHECK(circuit->read_bus("Sum") == (300 & 0xFF));
+    CHECK(circuit->read_bus("Cout") == 1);
+    for (size_t i = 0; i < 8; i++) {
+        CHECK(circuit->get_output(i) == (((300 >> i) & 1) != 0));
+    }
+
+    // Bits past the width are ignored; only changed inputs re-evaluate
+    circuit->set_bus(0, 200 | 0x100);
+    CHECK(circuit->propagate().gates_evaluated == 0);
+
+    // Clones keep their buses, through decomposition too
+    auto copy = circuit->clone();
+    CHECK(copy->read_bus("Sum") == (300 & 0xFF));
+    decompose_to_nand(*copy);
+    copy->set_bus("B", 55);
+    (void)copy->propagate();
+    CHECK(copy->read_bus("Sum") == 255);
+    CHECK(copy->read_bus("Cout") == 0);
+
+    CHECK_THROWS_AS(circuit->set_bus("Sum", 1), std::invalid_argument);
+    CHECK_THROWS_AS((void)circuit->read_bus("A"), std::invalid_argument);
+    CHECK_THROWS_AS(circuit->set_bus(2, 1), std::out_of_range);
+    CHECK_THROWS_AS(circuit->add_input_bus("A", 0, 1), std::invalid_argument);
+    CHECK_THROWS_AS(circuit->add_input_bus("C", 10, 7), std::invalid_argument);
+    CHECK_THROWS_AS(circuit->add_output_bus("Empty", 0, 0), std::invalid_argument);
+}
+
+TEST_CASE("set_inputs() and read_outputs() move every port as one bit array", "[circuit]") {
+    // 40 + 40 inputs span two words, the 41 outputs one
+    auto packed = build_ripple_carry_adder(40);
+    auto scalar = build_ripple_carry_adder(40);
+    const uint64_t a = 0xF0F0F0F0F0;
+    const uint64_t b = 0x0123456789;
+
+    const uint64_t in[2] = {a | b << 40, b >> 24};
+    packed->set_inputs(in);
+    for (size_t i = 0; i < 40; i++) {
+        scalar->set_input(i, ((a >> i) & 1) != 0);
+        scalar->set_input(40 + i, ((b >> i) & 1) != 0);
+    }
+    (void)packed->propagate();
+    (void)scalar->propagate();
+
+    uint64_t out[2] = {~uint64_t{0}, ~uint64_t{0}};
+    packed->read_outputs(out);
+    CHECK(out[0] == a + b);
+    CHECK(out[1] == ~uint64_t{0}); // Past (41 + 63) / 64 words
+    for (size_t i = 0; i < scalar->num_outputs(); i++) {
+        CHECK(((out[i / 64] >> (i % 64)) & 1) == uint64_t{scalar->get_output(i)});
+    }
+    CHECK(packed->read_bus("Sum") == a + b);
+}
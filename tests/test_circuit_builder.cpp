@@ -6,8 +6,11 @@
 
 #include "simulation/circuit_builder.hpp"
 
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
+#include <memory>
+#include <stdexcept>
 #include <vector>
 
 using namespace gateflow;
@@ -176,3 +179,111 @@ TEST_CASE("4-bit ripple-carry adder", "[builder]") {
     (void)circuit->propagate();
     CHECK(read_adder_output(*circuit, 4) == 15);
 }
+
+// ---------- Fast adders ----------
+
+namespace {
+
+using AdderFactory = std::unique_ptr<Circuit> (*)(int);
+
+std::unique_ptr<Circuit> carry_select_3(int bits) {
+    return build_carry_select_adder(bits, 3);
+}
+
+struct FastAdder {
+    const char* name;
+    AdderFactory build;
+};
+
+const FastAdder FAST_ADDERS[] = {
+    {"kogge-stone", &build_kogge_stone_adder},
+    {"brent-kung", &build_brent_kung_adder},
+    {"carry-select/4", [](int bits) { return build_carry_select_adder(bits); }},
+    {"carry-select/3", &carry_select_3},
+};
+
+/// Sets 64-bit-wide operands (bits <= 64)
+void set_wide_inputs(Circuit& circuit, int bits, uint64_t a, uint64_t b) {
+    for (int i = 0; i < bits; i++) {
+        circuit.set_input(i, ((a >> i) & 1) != 0);
+        circuit.set_input(bits + i, ((b >> i) & 1) != 0);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Fast adders — exhaustive sums up to 6 bits", "[builder]") {
+    const FastAdder& adder = FAST_ADDERS[GENERATE(0, 1, 2, 3)];
+    const int bits = GENERATE(1, 2, 3, 4, 5, 6);
+    auto circuit = adder.build(bits);
+    REQUIRE(circuit->num_inputs() == static_cast<size_t>(2 * bits));
+    REQUIRE(circuit->num_outputs() == static_cast<size_t>(bits + 1));
+
+    for (int a = 0; a < (1 << bits); a++) {
+        for (int b = 0; b < (1 << bits); b++) {
+            set_adder_inputs(*circuit, bits, a, b);
+            (void)circuit->propagate();
+            INFO(adder.name << " " << bits << "-bit: A=" << a << " B=" << b);
+            REQUIRE(read_adder_output(*circuit, bits) == a + b);
+        }
+    }
+}
+
+TEST_CASE("Fast adders — random 64-bit sums", "[builder]") {
+    const FastAdder& adder = FAST_ADDERS[GENERATE(0, 1, 2, 3)];
+    const int bits = GENERATE(33, 64);
+    auto circuit = adder.build(bits);
+    const uint64_t mask = bits == 64 ? ~uint64_t{0} : (uint64_t{1} << bits) - 1;
+
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (int n = 0; n < 50; n++) {
+        const uint64_t a = next() & mask;
+        const uint64_t b = (n == 0) ? (mask - a + 1) & mask : next() & mask; // n = 0: full carry
+        set_wide_inputs(*circuit, bits, a, b);
+        (void)circuit->propagate();
+
+        const uint64_t expected = (a + b) & mask;
+        const bool carry = bits == 64 ? (a + b < a) : (((a + b) >> bits) & 1) != 0;
+        uint64_t sum = 0;
+        for (int i = 0; i < bits; i++) {
+            sum |= uint64_t{circuit->get_output(i)} << i;
+        }
+        INFO(adder.name << " " << bits << "-bit: A=" << a << " B=" << b);
+        CHECK(sum == expected);
+        CHECK(circuit->get_output(bits) == carry);
+    }
+}
+
+TEST_CASE("Parallel-prefix adders have logarithmic depth", "[builder]") {
+    for (int bits : {7, 32, 64}) {
+        const size_t rca = build_ripple_carry_adder(bits)->compiled().num_levels();
+        const size_t ks = build_kogge_stone_adder(bits)->compiled().num_levels();
+        const size_t bk = build_brent_kung_adder(bits)->compiled().num_levels();
+        const size_t csa = build_carry_select_adder(bits)->compiled().num_levels();
+
+        int log2_bits = 0;
+        while ((1 << log2_bits) < bits) {
+            log2_bits++;
+        }
+        INFO(bits << "-bit: rca " << rca << " ks " << ks << " bk " << bk << " csa " << csa);
+        // p/g, then at most two levels per prefix stage, then the sum XOR
+        CHECK(ks <= static_cast<size_t>(2 * log2_bits + 2));
+        CHECK(bk <= static_cast<size_t>(4 * log2_bits + 2));
+        CHECK(ks <= bk);
+        CHECK(bk < rca);
+        CHECK(csa < rca);
+    }
+}
+
+TEST_CASE("Fast adders reject bad widths", "[builder]") {
+    REQUIRE_THROWS_AS(build_kogge_stone_adder(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(build_brent_kung_adder(-1), std::invalid_argument);
+    REQUIRE_THROWS_AS(build_carry_select_adder(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(build_carry_select_adder(8, 0), std::invalid_argument);
+}
@@ -0,0 +1,124 @@
+/// @file test_codegen.cpp
+/// @brief Tests generated straight-line evaluators against propagate_packed()
+///
+/// The eval_* functions are generated by gateflow_cli --emit-cpp at build
+/// time (see tests/CMakeLists.txt) and compiled into this test binary.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/codegen.hpp"
+#include "simulation/nand_decompose.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace gateflow;
+
+#define DECLARE_EVALUATOR(name)                                                                    \
+    extern "C" void name(const uint64_t* in, uint64_t* out);                                       \
+    extern "C" const uint32_t name##_num_inputs;                                                   \
+    extern "C" const uint32_t name##_num_outputs;                                                  \
+    extern "C" const uint64_t name##_structural_hash
+
+DECLARE_EVALUATOR(eval_rca32_nand);
+DECLARE_EVALUATOR(eval_ks16);
+DECLARE_EVALUATOR(eval_csa24);
+
+namespace {
+
+/// Compares @p eval with propagate_packed() on random 64-lane batches
+void check_against_interpreter(Circuit& circuit, GeneratedEvaluator eval, uint32_t num_inputs,
+                               uint32_t num_outputs, uint64_t hash) {
+    // The generated code must come from the same circuit the test built
+    REQUIRE(hash == circuit.structural_hash());
+    REQUIRE(num_inputs == circuit.num_inputs());
+    REQUIRE(num_outputs == circuit.num_outputs());
+
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> in(num_inputs);
+    std::vector<uint64_t> out(num_outputs);
+    for (int batch = 0; batch < 16; batch++) {
+        for (size_t i = 0; i < in.size(); i++) {
+            in[i] = rng();
+            circuit.set_input_packed(i, in[i]);
+        }
+        circuit.propagate_packed();
+        eval(in.data(), out.data());
+        for (size_t o = 0; o < out.size(); o++) {
+            INFO("batch " << batch << " output " << o);
+            CHECK(out[o] == circuit.get_output_packed(o));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Generated evaluators match propagate_packed", "[codegen]") {
+    SECTION("32-bit ripple-carry, NAND") {
+        auto circuit = build_ripple_carry_adder(32);
+        decompose_to_nand(*circuit);
+        check_against_interpreter(*circuit, &eval_rca32_nand, eval_rca32_nand_num_inputs,
+                                  eval_rca32_nand_num_outputs, eval_rca32_nand_structural_hash);
+    }
+    SECTION("16-bit Kogge-Stone") {
+        auto circuit = build_kogge_stone_adder(16);
+        check_against_interpreter(*circuit, &eval_ks16, eval_ks16_num_inputs,
+                                  eval_ks16_num_outputs, eval_ks16_structural_hash);
+    }
+    SECTION("24-bit carry-select") {
+        auto circuit = build_carry_select_adder(24);
+        check_against_interpreter(*circuit, &eval_csa24, eval_csa24_num_inputs,
+                                  eval_csa24_num_outputs, eval_csa24_structural_hash);
+    }
+}
+
+TEST_CASE("generate_evaluator emits one expression per driving gate", "[codegen]") {
+    // out0 = NOT(a XOR b XOR c), out1 = the wire no gate drives, out2 = a
+    Circuit circuit;
+    Wire* a = circuit.add_wire();
+    Wire* b = circuit.add_wire();
+    Wire* c = circuit.add_wire();
+    for (Wire* w : {a, b, c}) {
+        circuit.mark_input(w);
+    }
+    Gate* xor_gate = circuit.add_gate(GateType::XOR);
+    Gate* not_gate = circuit.add_gate(GateType::NOT);
+    Wire* x = circuit.add_wire();
+    Wire* out = circuit.add_wire();
+    Wire* floating = circuit.add_wire();
+    circuit.connect(a, nullptr, xor_gate);
+    circuit.connect(b, nullptr, xor_gate);
+    circuit.connect(c, nullptr, xor_gate);
+    circuit.connect(x, xor_gate, not_gate);
+    circuit.connect(out, not_gate, nullptr);
+    circuit.mark_output(out);
+    circuit.mark_output(floating);
+    circuit.mark_output(a);
+
+    CHECK_THROWS_AS(generate_evaluator(circuit, "f"), std::runtime_error);
+    circuit.finalize();
+    CHECK_THROWS_AS(generate_evaluator(circuit, "2f"), std::invalid_argument);
+    CHECK_THROWS_AS(generate_evaluator(circuit, "f-g"), std::invalid_argument);
+
+    const std::string src = generate_evaluator(circuit, "f");
+    CHECK(src.find("extern \"C\" void f(const uint64_t* in, uint64_t* out) {") !=
+          std::string::npos);
+    CHECK(src.find("extern \"C\" const uint32_t f_num_inputs = 3;") != std::string::npos);
+    CHECK(src.find("extern \"C\" const uint32_t f_num_outputs = 3;") != std::string::npos);
+    CHECK(src.find("const uint64_t w0 = in[0];") != std::string::npos);
+    CHECK(src.find("const uint64_t w2 = in[2];") != std::string::npos);
+    CHECK(src.find("const uint64_t w5 = 0;") != std::string::npos);
+    CHECK(src.find("const uint64_t w3 = w0 ^ w1 ^ w2;") != std::string::npos);
+    CHECK(src.find("const uint64_t w4 = ~w3;") != std::string::npos);
+    CHECK(src.find("out[0] = w4;") != std::string::npos);
+    CHECK(src.find("out[1] = w5;") != std::string::npos);
+    CHECK(src.find("out[2] = w0;") != std::string::npos);
+    // Gates come in level order, so the XOR is defined before the NOT reads it
+    CHECK(src.find("w3 = ") < src.find("w4 = "));
+}
@@ -0,0 +1,300 @@
+/// @file test_event_simulator.cpp
+/// @brief Tests for the timing wheel, event-driven simulation, event time and hazard flashes
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "rendering/animation_state.hpp"
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "timing/event_simulator.hpp"
+#include "timing/propagation_scheduler.hpp"
+#include "timing/timing_wheel.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace gateflow;
+using Catch::Approx;
+
+namespace {
+
+/// in ─┬─ NOT ─ AND ─ out   out = in AND NOT in: 0 when settled, but a rising
+///     └────────┘            input reaches the AND before the NOT's falling edge
+Circuit build_static_hazard() {
+    Circuit c;
+    Wire* in = c.add_wire();
+    Wire* inverted = c.add_wire();
+    Wire* out = c.add_wire();
+    c.mark_input(in);
+    c.mark_output(out);
+    Gate* not_gate = c.add_gate(GateType::NOT);
+    Gate* and_gate = c.add_gate(GateType::AND);
+    c.connect(in, nullptr, not_gate);
+    c.connect(inverted, not_gate, and_gate);
+    c.connect(in, nullptr, and_gate);
+    c.connect(out, and_gate, nullptr);
+    c.finalize();
+    return c;
+}
+
+/// Checks that the simulator settled on the circuit's own propagated values
+void check_settled_values(const EventSimulator& events, const Circuit& circuit) {
+    size_t mismatches = 0;
+    for (const Wire* wire : circuit.wires()) {
+        mismatches += events.value(wire) == wire->get_value() ? 0 : 1;
+    }
+    CHECK(mismatches == 0);
+}
+
+} // namespace
+
+TEST_CASE("TimingWheel pops in tick order and FIFO within a tick", "[event]") {
+    TimingWheel<int> wheel(10);
+    CHECK(wheel.buckets() == 16);
+    CHECK(wheel.empty());
+    CHECK_FALSE(wheel.advance());
+
+    wheel.schedule(7, 70);
+    wheel.schedule(3, 30);
+    wheel.schedule(3, 31);
+    wheel.schedule(10, 100);
+    CHECK(wheel.size() == 4);
+    CHECK_THROWS_AS(wheel.schedule(11, 0), std::out_of_range);
+
+    int value = 0;
+    std::vector<int> popped;
+    std::vector<uint64_t> ticks;
+    while (wheel.advance()) {
+        while (wheel.pop(value)) {
+            popped.push_back(value);
+            ticks.push_back(wheel.now());
+            // Zero-delay follow-up lands on the tick being drained
+            if (value == 30) {
+                wheel.schedule(wheel.now(), 32);
+            }
+        }
+    }
+    CHECK(popped == std::vector<int>{30, 31, 32, 70, 100});
+    CHECK(ticks == std::vector<uint64_t>{3, 3, 3, 7, 10});
+    CHECK(wheel.now() == 10);
+
+    // Past now() is rejected; the ring wraps for later ticks
+    CHECK_THROWS_AS(wheel.schedule(9, 0), std::out_of_range);
+    wheel.schedule(20, 200);
+    wheel.schedule(12, 120);
+    REQUIRE(wheel.advance());
+    REQUIRE(wheel.pop(value));
+    CHECK(value == 120);
+    REQUIRE(wheel.advance());
+    CHECK(wheel.now() == 20);
+    REQUIRE(wheel.pop(value));
+    CHECK(value == 200);
+
+    wheel.schedule(25, 250);
+    wheel.clear();
+    CHECK(wheel.empty());
+    CHECK(wheel.now() == 0);
+}
+
+TEST_CASE("EventSimulator records a static hazard and settles", "[event]") {
+    Circuit circuit = build_static_hazard();
+    const Wire* in = circuit.input_wires()[0];
+    const Wire* out = circuit.output_wires()[0];
+    EventSimulator events(circuit, DelayModel::typical());
+    CHECK_FALSE(events.value(out));
+
+    // Nothing changed: no run
+    CHECK_FALSE(events.simulate());
+    CHECK(events.transitions().empty());
+
+    circuit.set_input(0, true);
+    REQUIRE(events.simulate());
+    // in rises at 0; AND (1.4) sees 1 AND 1 until the NOT (0.7) falls
+    REQUIRE(events.transitions().size() == 4);
+    CHECK(events.transition_count(in) == 1);
+    CHECK(events.transition_count(out) == 2);
+    CHECK(events.glitched(out));
+    CHECK_FALSE(events.glitched(in));
+    CHECK(events.glitch_count() == 1);
+    CHECK(events.settle_time(out) == Approx(0.7f + 1.4f));
+    CHECK(events.end_time() == Approx(0.7f + 1.4f));
+    CHECK_FALSE(events.value(out));
+    for (size_t i = 1; i < events.transitions().size(); i++) {
+        CHECK(events.transitions()[i - 1].time <= events.transitions()[i].time);
+    }
+
+    // A replay without an input change keeps the record
+    CHECK_FALSE(events.simulate());
+    CHECK(events.transition_count(out) == 2);
+
+    // Falling input: the AND turns off first, so no hazard
+    circuit.set_input(0, false);
+    REQUIRE(events.simulate());
+    CHECK(events.transition_count(out) == 0);
+    CHECK(events.glitch_count() == 0);
+
+    // Equal arms: the AND sees both inputs change on the same tick
+    events.set_gate_delay(circuit.gates()[0], 0.0f);
+    CHECK(events.gate_delay(circuit.gates()[0]) == 0.0f);
+    circuit.set_input(0, true);
+    REQUIRE(events.simulate());
+    CHECK(events.transition_count(out) == 0);
+}
+
+TEST_CASE("EventSimulator validates its circuit and delays", "[event]") {
+    Circuit unfinalized;
+    CHECK_THROWS_AS(EventSimulator(unfinalized, DelayModel::unit()), std::runtime_error);
+
+    Circuit circuit = build_static_hazard();
+    Circuit other = build_static_hazard();
+    EventSimulator events(circuit, DelayModel::unit());
+    const Gate* gate = circuit.gates()[0];
+    CHECK_THROWS_AS(events.set_gate_delay(gate, -1.0f), std::invalid_argument);
+    CHECK_THROWS_AS(events.set_gate_delay(gate, std::numeric_limits<float>::infinity()),
+                    std::invalid_argument);
+    CHECK_THROWS_AS(events.set_gate_delay(gate, 1e6f), std::invalid_argument);
+    CHECK_THROWS_AS(events.set_gate_delay(other.gates()[0], 1.0f), std::invalid_argument);
+    CHECK_THROWS_AS(events.value(other.wires()[0]), std::invalid_argument);
+
+    // Longer delays grow the wheel between runs
+    events.set_gate_delay(gate, 12.5f);
+    CHECK(events.gate_delay(gate) == Approx(12.5f));
+    circuit.set_input(0, true);
+    REQUIRE(events.simulate());
+    CHECK(events.settle_time(circuit.wires()[1]) == Approx(12.5f));
+}
+
+TEST_CASE("EventSimulator settles on the propagated values of adders", "[event]") {
+    std::mt19937 rng(7);
+    for (const bool nand : {false, true}) {
+        INFO("nand=" << nand);
+        auto circuit = build_ripple_carry_adder(16, nand);
+        EventSimulator events(*circuit, DelayModel::typical());
+        for (int run = 0; run < 20; run++) {
+            for (size_t i = 0; i < circuit->num_inputs(); i++) {
+                circuit->set_input(i, (rng() & 1) != 0);
+            }
+            (void)circuit->propagate();
+            (void)events.simulate();
+            check_settled_values(events, *circuit);
+        }
+    }
+
+    auto ks = build_kogge_stone_adder(16);
+    EventSimulator events(*ks, DelayModel::unit());
+    for (int run = 0; run < 20; run++) {
+        for (size_t i = 0; i < ks->num_inputs(); i++) {
+            ks->set_input(i, (rng() & 1) != 0);
+        }
+        (void)ks->propagate();
+        (void)events.simulate();
+        check_settled_values(events, *ks);
+    }
+}
+
+TEST_CASE("Ripple-carry sum bits toggle as the carry passes", "[event]") {
+    // A = 0 -> all ones, B = 0 -> 1: every propagate signal rises at once,
+    // then the carry ripples up and clears the sum bits one by one
+    constexpr int BITS = 8;
+    auto circuit = build_ripple_carry_adder(BITS);
+    EventSimulator events(*circuit, DelayModel::typical());
+    for (int i = 0; i < BITS; i++) {
+        circuit->set_input(static_cast<size_t>(i), true);
+    }
+    circuit->set_input(BITS, true);
+    (void)circuit->propagate();
+    REQUIRE(events.simulate());
+    check_settled_values(events, *circuit);
+
+    size_t glitching_sums = 0;
+    for (int i = 1; i < BITS; i++) {
+        const Wire* sum = circuit->output_wires()[static_cast<size_t>(i)];
+        CHECK_FALSE(events.value(sum));
+        glitching_sums += events.glitched(sum) ? 1 : 0;
+    }
+    CHECK(glitching_sums == BITS - 1);
+    CHECK(events.glitch_count() >= glitching_sums);
+    CHECK(events.memory_usage().category("transitions").bytes >=
+          events.transitions().size() * sizeof(Transition));
+}
+
+TEST_CASE("PropagationScheduler replays an event-driven run", "[event][scheduler]") {
+    Circuit circuit = build_static_hazard();
+    EventSimulator events(circuit, DelayModel::typical());
+    circuit.set_input(0, true);
+    REQUIRE(events.simulate());
+
+    PropagationScheduler scheduler(&circuit);
+    scheduler.use_event_time(events);
+    CHECK(scheduler.uses_delay_time());
+    CHECK(scheduler.events() == &events);
+
+    // The NOT starts at 0; the AND once the NOT's output has settled
+    const Gate* not_gate = circuit.gates()[0];
+    const Gate* and_gate = circuit.gates()[1];
+    CHECK(scheduler.resolve_order().front() == not_gate);
+    CHECK(scheduler.resolve_times()[1] == Approx(0.7f));
+    CHECK(scheduler.end_time() == Approx(0.7f + 1.4f));
+    scheduler.seek(0.5f);
+    CHECK(scheduler.is_gate_resolved(not_gate));
+    CHECK_FALSE(scheduler.is_gate_resolved(and_gate));
+
+    Circuit other = build_static_hazard();
+    EventSimulator foreign(other, DelayModel::unit());
+    CHECK_THROWS_AS(scheduler.use_event_time(foreign), std::invalid_argument);
+
+    scheduler.use_depth_time();
+    CHECK(scheduler.events() == nullptr);
+}
+
+TEST_CASE("AnimationState flashes glitching wires in event time", "[event][animation]") {
+    Circuit circuit = build_static_hazard();
+    const Wire* out = circuit.output_wires()[0];
+    const Wire* inverted = circuit.wires()[1];
+    EventSimulator events(circuit, DelayModel::typical());
+    circuit.set_input(0, true);
+    REQUIRE(events.simulate());
+
+    PropagationScheduler scheduler(&circuit);
+    scheduler.use_event_time(events);
+    AnimationState anim(&circuit);
+
+    // out rises at 1.4 (the glitch) and falls back at 2.1
+    scheduler.seek(1.0f);
+    anim.update(0.0f, scheduler);
+    CHECK(anim.wire_anim(out).hazard == 0.0f);
+    scheduler.seek(1.5f);
+    anim.update(0.01f, scheduler);
+    CHECK(anim.wire_anim(out).hazard == 1.0f);
+    CHECK(anim.wire_anim(inverted).hazard == 0.0f); // Changes once
+    CHECK_FALSE(anim.is_settled());
+
+    // The flash fades in real time while the scheduler is at the end
+    scheduler.seek(scheduler.end_time());
+    anim.update(0.2f, scheduler);
+    CHECK(anim.wire_anim(out).hazard < 1.0f);
+    CHECK(anim.wire_anim(out).hazard > 0.0f);
+    for (int frame = 0; frame < 60 && !anim.is_settled(); frame++) {
+        anim.update(0.1f, scheduler);
+    }
+    CHECK(anim.is_settled());
+    CHECK(anim.wire_anim(out).hazard == 0.0f);
+
+    // Seeking back before the glitch lets it flash again
+    scheduler.seek(1.0f);
+    anim.update(0.0f, scheduler);
+    scheduler.seek(1.5f);
+    anim.update(0.0f, scheduler);
+    CHECK(anim.wire_anim(out).hazard == 1.0f);
+
+    // Other time bases never flash
+    scheduler.use_delay_time(TimingAnalysis(circuit, DelayModel::typical()));
+    anim.reset();
+    scheduler.seek(scheduler.end_time());
+    anim.update(0.0f, scheduler);
+    CHECK(anim.wire_anim(out).hazard == 0.0f);
+}
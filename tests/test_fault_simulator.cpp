@@ -0,0 +1,178 @@
+/// @file test_fault_simulator.cpp
+/// @brief Tests stuck-at fault detection against a scalar fault-injection reference
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/fault_simulator.hpp"
+#include "simulation/nand_decompose.hpp"
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace gateflow;
+
+namespace {
+
+/// Primary outputs with @p faulty's output forced to @p stuck (nullptr = fault-free),
+/// evaluated gate by gate in topological order
+std::vector<bool> simulate_scalar(const Circuit& circuit, const std::vector<bool>& inputs,
+                                  const Gate* faulty, bool stuck) {
+    std::vector<bool> values(circuit.wires().size(), false);
+    for (size_t i = 0; i < inputs.size(); i++) {
+        values[circuit.input_wires()[i]->get_id()] = inputs[i];
+    }
+    std::vector<bool> in;
+    for (const Gate* gate : circuit.topological_order()) {
+        in.clear();
+        for (const Wire* wire : gate->get_inputs()) {
+            in.push_back(values[wire->get_id()]);
+        }
+        if (const Wire* out = gate->get_output(); out != nullptr) {
+            values[out->get_id()] = gate == faulty ? stuck : evaluate(gate->get_type(), in);
+        }
+    }
+    std::vector<bool> outputs;
+    for (const Wire* wire : circuit.output_wires()) {
+        outputs.push_back(values[wire->get_id()]);
+    }
+    return outputs;
+}
+
+/// The bits of @p value, one per input
+std::vector<bool> to_bits(uint64_t value, size_t count) {
+    std::vector<bool> bits(count);
+    for (size_t i = 0; i < count; i++) {
+        bits[i] = ((value >> i) & 1) != 0;
+    }
+    return bits;
+}
+
+} // namespace
+
+TEST_CASE("FaultSimulator finds the first detecting vector of every fault", "[fault]") {
+    auto circuit = build_ripple_carry_adder(4);
+    decompose_to_nand(*circuit);
+
+    // Not a multiple of any lane width, so the last batch is partial
+    std::vector<std::vector<bool>> vectors;
+    std::mt19937 rng(7);
+    for (int i = 0; i < 300; i++) {
+        vectors.push_back(to_bits(rng(), circuit->num_inputs()));
+    }
+
+    FaultSimulator sim(*circuit);
+    for (const auto& v : vectors) {
+        sim.add_vector(v);
+    }
+    sim.flush();
+    CHECK(sim.vectors() == vectors.size());
+    CHECK(sim.num_faults() == 2 * circuit->gates().size());
+
+    size_t detected = 0;
+    for (const Gate* gate : circuit->gates()) {
+        for (bool stuck : {false, true}) {
+            int64_t expected = FaultSimulator::UNDETECTED;
+            for (size_t i = 0; i < vectors.size() && expected < 0; i++) {
+                if (simulate_scalar(*circuit, vectors[i], gate, stuck) !=
+                    simulate_scalar(*circuit, vectors[i], nullptr, false)) {
+                    expected = static_cast<int64_t>(i);
+                }
+            }
+            INFO("gate " << gate->get_id() << " stuck-at-" << stuck);
+            CHECK(sim.detecting_vector(gate, stuck) == expected);
+            detected += expected >= 0 ? 1 : 0;
+        }
+    }
+    CHECK(sim.num_detected() == detected);
+    CHECK(sim.undetected_faults().size() == sim.num_faults() - detected);
+}
+
+TEST_CASE("FaultSimulator reports redundant faults as undetected", "[fault]") {
+    // out = a OR (a AND b): the AND is absorbed, so its stuck-at-0 never shows
+    Circuit circuit;
+    Wire* a = circuit.add_wire();
+    Wire* b = circuit.add_wire();
+    circuit.mark_input(a);
+    circuit.mark_input(b);
+    Gate* and_gate = circuit.add_gate(GateType::AND);
+    Gate* or_gate = circuit.add_gate(GateType::OR);
+    Wire* and_out = circuit.add_wire();
+    Wire* out = circuit.add_wire();
+    circuit.mark_output(out);
+    circuit.connect(a, nullptr, and_gate);
+    circuit.connect(b, nullptr, and_gate);
+    circuit.connect(a, nullptr, or_gate);
+    circuit.connect(and_out, and_gate, or_gate);
+    circuit.connect(out, or_gate, nullptr);
+    circuit.finalize();
+
+    FaultSimulator sim(circuit);
+    for (uint64_t v = 0; v < 4; v++) {
+        sim.add_vector(to_bits(v, 2));
+    }
+    CHECK(sim.vectors() == 0); // Still queued
+    sim.flush();
+    CHECK(sim.vectors() == 4);
+
+    CHECK(sim.detecting_vector(or_gate, false) == 1);  // a=1, b=0
+    CHECK(sim.detecting_vector(or_gate, true) == 0);   // a=0, b=0
+    CHECK(sim.detecting_vector(and_gate, true) == 0);  // a=0 lets the AND through
+    CHECK_FALSE(sim.is_detected(and_gate, false));     // needs a=1, which masks it
+    REQUIRE(sim.undetected_faults().size() == 1);
+    CHECK(sim.undetected_faults()[0].gate == and_gate);
+    CHECK_FALSE(sim.undetected_faults()[0].stuck_value);
+    CHECK(sim.coverage() == 0.75);
+
+    CHECK_THROWS_AS(sim.add_vector({true}), std::invalid_argument);
+    Circuit open;
+    CHECK_THROWS_AS(FaultSimulator(open), std::runtime_error);
+}
+
+TEST_CASE("FaultSimulator grades every fault of a 32-bit NAND adder", "[fault]") {
+    auto circuit = build_ripple_carry_adder(32);
+    decompose_to_nand(*circuit);
+
+    FaultSimulator sim(*circuit);
+    std::mt19937_64 rng(2024);
+    std::vector<bool> v(circuit->num_inputs());
+    for (int i = 0; i < 2048; i++) {
+        const uint64_t bits = rng();
+        for (size_t k = 0; k < v.size(); k++) {
+            v[k] = ((bits >> k) & 1) != 0;
+        }
+        sim.add_vector(v);
+    }
+    sim.flush();
+
+    CHECK(sim.num_faults() == 2 * circuit->gates().size());
+    CHECK(sim.coverage() == 1.0); // The decomposed adder has no redundant gates
+}
+
+TEST_CASE("FaultSimulator takes vectors as packed input bits", "[fault]") {
+    auto circuit = build_ripple_carry_adder(40); // 80 inputs: two words per vector
+    FaultSimulator by_bool(*circuit);
+    FaultSimulator by_word(*circuit);
+
+    std::mt19937_64 rng(11);
+    for (int i = 0; i < 100; i++) {
+        const uint64_t words[2] = {rng(), rng() & 0xFFFF};
+        std::vector<bool> bits(circuit->num_inputs());
+        for (size_t k = 0; k < bits.size(); k++) {
+            bits[k] = ((words[k / 64] >> (k % 64)) & 1) != 0;
+        }
+        by_bool.add_vector(bits);
+        by_word.add_vector(words);
+    }
+    by_bool.flush();
+    by_word.flush();
+
+    CHECK(by_word.num_detected() == by_bool.num_detected());
+    for (const Gate* gate : circuit->gates()) {
+        CHECK(by_word.detecting_vector(gate, false) == by_bool.detecting_vector(gate, false));
+        CHECK(by_word.detecting_vector(gate, true) == by_bool.detecting_vector(gate, true));
+    }
+}
@@ -0,0 +1,117 @@
+/// @file test_frame_pacer.cpp
+/// @brief Tests FixedTimestep's step accounting and QualityGovernor's drop/restore hysteresis
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "timing/frame_pacer.hpp"
+
+#include <stdexcept>
+
+using namespace gateflow;
+using Catch::Approx;
+
+namespace {
+
+constexpr float BUDGET = 1.0f / 60.0f;
+
+/// Records @p frames identical frames; returns how many changed the level
+int record_frames(QualityGovernor& governor, int frames, float frame_time, float work_time) {
+    int changes = 0;
+    for (int i = 0; i < frames; i++) {
+        changes += governor.record(frame_time, work_time) ? 1 : 0;
+    }
+    return changes;
+}
+
+} // namespace
+
+TEST_CASE("FixedTimestep carries partial steps and drops overlong frames", "[pacer]") {
+    // Binary fractions, so the arithmetic is exact
+    FixedTimestep clock(0.25f, 4);
+    CHECK(clock.advance(0.625f) == 2);
+    CHECK(clock.carry_fraction() == 0.5f);
+    CHECK(clock.advance(0.125f) == 1);
+    CHECK(clock.carry_fraction() == 0.0f);
+    CHECK(clock.advance(0.0f) == 0);
+    CHECK(clock.advance(-1.0f) == 0);
+
+    // A 10 s stall advances one frame's worth of steps, not 40
+    CHECK(clock.advance(10.0f) == 4);
+    CHECK(clock.dropped_time() == Approx(9.0));
+    CHECK(clock.carry_fraction() == 0.0f);
+
+    CHECK(clock.advance(0.125f) == 0);
+    clock.reset();
+    CHECK(clock.advance(0.125f) == 0); // The first half step was forgotten
+
+    CHECK_THROWS_AS(FixedTimestep(0.0f, 4), std::invalid_argument);
+    CHECK_THROWS_AS(FixedTimestep(0.25f, 0), std::invalid_argument);
+}
+
+TEST_CASE("FixedTimestep simulates the same time at any frame rate", "[pacer]") {
+    for (float fps : {30.0f, 60.0f, 75.0f, 144.0f}) {
+        FixedTimestep clock(1.0f / 120.0f, 8);
+        int steps = 0;
+        for (int frame = 0; frame < static_cast<int>(fps) * 2; frame++) {
+            steps += clock.advance(1.0f / fps);
+        }
+        INFO(fps << " FPS");
+        CHECK(steps >= 239);
+        CHECK(steps <= 240);
+    }
+}
+
+TEST_CASE("QualityGovernor drops effects in order under sustained load", "[pacer]") {
+    QualityGovernor governor(BUDGET);
+    CHECK(governor.level() == 0);
+    CHECK(governor.effects() == RenderEffects{});
+
+    // A single stall does not count as load
+    CHECK_FALSE(governor.record(1.0f, 1.0f));
+    record_frames(governor, 60, BUDGET, BUDGET * 0.9f);
+    CHECK(governor.level() == 0);
+
+    // At 30 FPS every effect goes, one per DROP_FRAMES-long stretch
+    CHECK(record_frames(governor, 20, 2 * BUDGET, 2 * BUDGET) == 1);
+    CHECK(governor.level() == 1);
+    RenderEffects effects = governor.effects();
+    CHECK_FALSE(effects.pulse_glows);
+    CHECK(effects.gate_accents);
+    CHECK(effects.tooltip_tables);
+
+    record_frames(governor, 200, 2 * BUDGET, 2 * BUDGET);
+    CHECK(governor.level() == QualityGovernor::MAX_LEVEL);
+    effects = governor.effects();
+    CHECK_FALSE(effects.pulse_glows);
+    CHECK_FALSE(effects.gate_accents);
+    CHECK_FALSE(effects.tooltip_tables);
+    CHECK(governor.average_frame_time() == Approx(2 * BUDGET).epsilon(0.01));
+}
+
+TEST_CASE("QualityGovernor restores effects only with work-time headroom", "[pacer]") {
+    QualityGovernor governor(BUDGET);
+    record_frames(governor, 200, 2 * BUDGET, 2 * BUDGET);
+    REQUIRE(governor.level() == QualityGovernor::MAX_LEVEL);
+
+    // GPU-bound: little CPU work, but frames still arrive late
+    record_frames(governor, 600, 1.5f * BUDGET, 0.2f * BUDGET);
+    CHECK(governor.level() == QualityGovernor::MAX_LEVEL);
+
+    // Capped at the budget with 80% of it spent working: no headroom to spend
+    record_frames(governor, 600, BUDGET, 0.8f * BUDGET);
+    CHECK(governor.level() == QualityGovernor::MAX_LEVEL);
+
+    // Capped at the budget with time to spare: one effect back per stretch
+    const int stretch = QualityGovernor::RESTORE_FRAMES + 30;
+    CHECK(record_frames(governor, stretch, BUDGET, 0.2f * BUDGET) == 1);
+    CHECK(governor.level() == QualityGovernor::MAX_LEVEL - 1);
+    CHECK(governor.effects().tooltip_tables);
+    CHECK_FALSE(governor.effects().gate_accents);
+
+    record_frames(governor, 3 * stretch, BUDGET, 0.2f * BUDGET);
+    CHECK(governor.level() == 0);
+    CHECK(governor.effects() == RenderEffects{});
+
+    CHECK_THROWS_AS(QualityGovernor(0.0f), std::invalid_argument);
+}
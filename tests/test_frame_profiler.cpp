@@ -0,0 +1,82 @@
+/// @file test_frame_profiler.cpp
+/// @brief Tests FrameProfiler's rolling min/avg/p99 and per-frame accumulation
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "timing/frame_profiler.hpp"
+
+using namespace gateflow;
+using Catch::Approx;
+
+namespace {
+
+void record_frame(FrameProfiler& profiler, FramePhase phase, double ms) {
+    profiler.begin_frame();
+    profiler.add_time(phase, ms);
+    profiler.end_frame();
+}
+
+} // namespace
+
+TEST_CASE("FrameProfiler reports zeros before any frame", "[profiler]") {
+    FrameProfiler profiler;
+    PhaseStats st = profiler.stats(FramePhase::GATES);
+    REQUIRE(profiler.frames_recorded() == 0);
+    REQUIRE(st.min_ms == 0.0);
+    REQUIRE(st.avg_ms == 0.0);
+    REQUIRE(st.p99_ms == 0.0);
+}
+
+TEST_CASE("FrameProfiler computes min, avg and p99 per phase", "[profiler]") {
+    FrameProfiler profiler;
+    // 1..100 ms: p99 by nearest rank is the 99th smallest sample
+    for (int ms = 100; ms >= 1; ms--) {
+        record_frame(profiler, FramePhase::WIRES, ms);
+    }
+
+    PhaseStats wires = profiler.stats(FramePhase::WIRES);
+    REQUIRE(wires.min_ms == Approx(1.0));
+    REQUIRE(wires.avg_ms == Approx(50.5));
+    REQUIRE(wires.p99_ms == Approx(99.0));
+
+    // Other phases saw zero time in every frame
+    PhaseStats ui = profiler.stats(FramePhase::UI);
+    REQUIRE(ui.avg_ms == 0.0);
+    REQUIRE(ui.p99_ms == 0.0);
+}
+
+TEST_CASE("FrameProfiler keeps only the last WINDOW frames", "[profiler]") {
+    FrameProfiler profiler;
+    for (size_t i = 0; i < FrameProfiler::WINDOW; i++) {
+        record_frame(profiler, FramePhase::INPUT, 50.0);
+    }
+    for (size_t i = 0; i < FrameProfiler::WINDOW; i++) {
+        record_frame(profiler, FramePhase::INPUT, 2.0);
+    }
+
+    REQUIRE(profiler.frames_recorded() == FrameProfiler::WINDOW);
+    PhaseStats st = profiler.stats(FramePhase::INPUT);
+    REQUIRE(st.min_ms == Approx(2.0));
+    REQUIRE(st.p99_ms == Approx(2.0));
+}
+
+TEST_CASE("FrameProfiler sums repeated phases and draw calls within a frame", "[profiler]") {
+    FrameProfiler profiler;
+    profiler.begin_frame();
+    profiler.add_time(FramePhase::GATES, 1.5);
+    profiler.add_time(FramePhase::GATES, 2.5);
+    profiler.add_draw_calls(10);
+    profiler.add_draw_calls(5);
+    REQUIRE(profiler.last_draw_calls() == 0); // Not committed yet
+    profiler.end_frame();
+
+    REQUIRE(profiler.stats(FramePhase::GATES).avg_ms == Approx(4.0));
+    REQUIRE(profiler.last_draw_calls() == 15);
+
+    // A new frame starts from zero
+    profiler.begin_frame();
+    profiler.end_frame();
+    REQUIRE(profiler.last_draw_calls() == 0);
+    REQUIRE(profiler.stats(FramePhase::GATES).min_ms == 0.0);
+}
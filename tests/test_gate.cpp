@@ -5,6 +5,8 @@
 
 #include "simulation/gate.hpp"
 
+#include <vector>
+
 using namespace gateflow;
 
 // ---------- NOT gate ----------
@@ -89,6 +91,50 @@ TEST_CASE("Gate evaluation rejects invalid input counts", "[gate]") {
     CHECK_THROWS_AS(evaluate(GateType::XOR, {false}), std::invalid_argument);
 }
 
+// ---------- Bit-parallel evaluation ----------
+
+TEST_CASE("Packed evaluation matches scalar evaluation lane by lane", "[gate]") {
+    struct Case {
+        GateType type;
+        size_t arity;
+    };
+    const Case cases[] = {
+        {GateType::NOT, 1}, {GateType::BUFFER, 1}, {GateType::AND, 2}, {GateType::AND, 3},
+        {GateType::NAND, 2}, {GateType::NAND, 3}, {GateType::OR, 2},   {GateType::OR, 3},
+        {GateType::XOR, 2},  {GateType::XOR, 3},
+    };
+
+    for (const auto& [type, arity] : cases) {
+        // Lane k holds input combination (k mod 2^arity), so every row is covered
+        uint64_t words[3] = {};
+        for (size_t lane = 0; lane < 64; lane++) {
+            for (size_t i = 0; i < arity; i++) {
+                words[i] |= static_cast<uint64_t>((lane >> i) & 1) << lane;
+            }
+        }
+
+        uint64_t packed = evaluate_packed(type, words, arity);
+        for (size_t lane = 0; lane < 64; lane++) {
+            std::vector<bool> inputs;
+            for (size_t i = 0; i < arity; i++) {
+                inputs.push_back(((words[i] >> lane) & 1) != 0);
+            }
+            INFO(gate_type_name(type) << " arity=" << arity << " lane=" << lane);
+            CHECK((((packed >> lane) & 1) != 0) == evaluate(type, inputs));
+        }
+    }
+}
+
+TEST_CASE("Packed evaluation rejects invalid input counts", "[gate]") {
+    const uint64_t words[2] = {0, 0};
+    CHECK_THROWS_AS(evaluate_packed(GateType::NOT, words, 2), std::invalid_argument);
+    CHECK_THROWS_AS(evaluate_packed(GateType::BUFFER, words, 0), std::invalid_argument);
+    CHECK_THROWS_AS(evaluate_packed(GateType::AND, words, 1), std::invalid_argument);
+    CHECK_THROWS_AS(evaluate_packed(GateType::NAND, words, 1), std::invalid_argument);
+    CHECK_THROWS_AS(evaluate_packed(GateType::OR, words, 1), std::invalid_argument);
+    CHECK_THROWS_AS(evaluate_packed(GateType::XOR, words, 1), std::invalid_argument);
+}
+
 // ---------- Gate type name ----------
 
 TEST_CASE("Gate type names", "[gate]") {
@@ -99,3 +145,76 @@ TEST_CASE("Gate type names", "[gate]") {
     CHECK(gate_type_name(GateType::NOT) == "NOT");
     CHECK(gate_type_name(GateType::BUFFER) == "BUFFER");
 }
+
+TEST_CASE("Mask evaluation matches scalar evaluation", "[gate]") {
+    const GateType types[] = {GateType::AND, GateType::NAND, GateType::OR, GateType::XOR};
+    for (GateType type : types) {
+        for (size_t arity = 2; arity <= 5; arity++) {
+            for (uint64_t mask = 0; mask < (uint64_t{1} << arity); mask++) {
+                std::vector<bool> inputs;
+                for (size_t i = 0; i < arity; i++) {
+                    inputs.push_back(((mask >> i) & 1) != 0);
+                }
+                CHECK(evaluate_mask(type, mask, arity) == evaluate(type, inputs));
+            }
+        }
+    }
+    for (uint64_t mask = 0; mask < 2; mask++) {
+        CHECK(evaluate_mask(GateType::NOT, mask, 1) == evaluate(GateType::NOT, {mask != 0}));
+        CHECK(evaluate_mask(GateType::BUFFER, mask, 1) == evaluate(GateType::BUFFER, {mask != 0}));
+    }
+
+    // Full 64-input fan-in
+    CHECK(evaluate_mask(GateType::AND, ~uint64_t{0}, 64) == true);
+    CHECK(evaluate_mask(GateType::NAND, ~uint64_t{0} >> 1, 64) == true);
+    CHECK(evaluate_mask(GateType::XOR, ~uint64_t{0}, 64) == false);
+}
+
+TEST_CASE("Arity validation matches the evaluators", "[gate]") {
+    CHECK_NOTHROW(validate_arity(GateType::NOT, 1));
+    CHECK_NOTHROW(validate_arity(GateType::XOR, 3));
+    CHECK_THROWS_AS(validate_arity(GateType::BUFFER, 2), std::invalid_argument);
+    CHECK_THROWS_AS(validate_arity(GateType::OR, 1), std::invalid_argument);
+}
+
+namespace {
+
+/// Checks evaluate_fixed<Type, Arity> against the reference evaluate() for
+/// every input combination of @p count inputs
+template <GateType Type, size_t Arity> void check_fixed_kernel(size_t count) {
+    for (uint64_t mask = 0; mask < (uint64_t{1} << count); mask++) {
+        std::vector<bool> inputs;
+        for (size_t i = 0; i < count; i++) {
+            inputs.push_back(((mask >> i) & 1) != 0);
+        }
+        CHECK(evaluate_fixed<Type, Arity>(mask, count) == evaluate(Type, inputs));
+    }
+}
+
+} // namespace
+
+TEST_CASE("Truth tables are known at compile time", "[gate]") {
+    // Bit m is the output for input mask m
+    STATIC_REQUIRE(gate_truth_table(GateType::AND, 2) == 0b1000);
+    STATIC_REQUIRE(gate_truth_table(GateType::NAND, 2) == 0b0111);
+    STATIC_REQUIRE(gate_truth_table(GateType::OR, 2) == 0b1110);
+    STATIC_REQUIRE(gate_truth_table(GateType::XOR, 2) == 0b0110);
+    STATIC_REQUIRE(gate_truth_table(GateType::NOT, 1) == 0b01);
+    STATIC_REQUIRE(gate_truth_table(GateType::BUFFER, 1) == 0b10);
+    STATIC_REQUIRE(evaluate_fixed<GateType::XOR, 2>(0b01, 2));
+}
+
+TEST_CASE("Fixed-arity kernels match the reference evaluate()", "[gate]") {
+    check_fixed_kernel<GateType::NOT, 1>(1);
+    check_fixed_kernel<GateType::BUFFER, 1>(1);
+    check_fixed_kernel<GateType::AND, 2>(2);
+    check_fixed_kernel<GateType::NAND, 2>(2);
+    check_fixed_kernel<GateType::OR, 2>(2);
+    check_fixed_kernel<GateType::XOR, 2>(2);
+    for (size_t count = 3; count <= 6; count++) {
+        check_fixed_kernel<GateType::AND, 0>(count);
+        check_fixed_kernel<GateType::NAND, 0>(count);
+        check_fixed_kernel<GateType::OR, 0>(count);
+        check_fixed_kernel<GateType::XOR, 0>(count);
+    }
+}
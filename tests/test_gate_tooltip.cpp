@@ -0,0 +1,94 @@
+/// @file test_gate_tooltip.cpp
+/// @brief Tests for the hover tooltip text and its per-gate cache
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "rendering/gate_tooltip.hpp"
+#include "simulation/circuit.hpp"
+
+using namespace gateflow;
+
+namespace {
+
+/// Two inputs into an XOR and an AND, and a NOT on the first input
+struct SmallCircuit {
+    Circuit circuit;
+    Gate* xor_gate = nullptr;
+    Gate* and_gate = nullptr;
+    Gate* not_gate = nullptr;
+
+    SmallCircuit() {
+        Wire* a = circuit.add_wire();
+        Wire* b = circuit.add_wire();
+        circuit.mark_input(a);
+        circuit.mark_input(b);
+        xor_gate = circuit.add_gate(GateType::XOR);
+        and_gate = circuit.add_gate(GateType::AND);
+        not_gate = circuit.add_gate(GateType::NOT);
+        for (Gate* g : {xor_gate, and_gate, not_gate}) {
+            circuit.connect(a, nullptr, g);
+        }
+        circuit.connect(b, nullptr, xor_gate);
+        circuit.connect(b, nullptr, and_gate);
+        for (Gate* g : {xor_gate, and_gate, not_gate}) {
+            Wire* out = circuit.add_wire();
+            circuit.mark_output(out);
+            circuit.connect(out, g, nullptr);
+        }
+        circuit.finalize();
+    }
+
+    void apply(bool a, bool b) {
+        circuit.set_input(0, a);
+        circuit.set_input(1, b);
+        (void)circuit.propagate();
+    }
+};
+
+} // namespace
+
+TEST_CASE("Tooltip shows values and highlights the current row", "[gate_tooltip]") {
+    SmallCircuit c;
+    c.apply(false, true);
+
+    GateTooltip xor_tip = build_gate_tooltip(*c.xor_gate);
+    CHECK(xor_tip.title == "XOR gate");
+    CHECK(xor_tip.io == "in: 0, 1   out: 1");
+    REQUIRE(xor_tip.rows.size() == 4);
+    for (size_t i = 0; i < xor_tip.rows.size(); i++) {
+        CHECK(xor_tip.rows[i].second == (i == 1));
+    }
+    CHECK(xor_tip.rows[1].first == "0,1 -> 1");
+
+    GateTooltip not_tip = build_gate_tooltip(*c.not_gate);
+    CHECK(not_tip.title == "NOT gate");
+    CHECK(not_tip.io == "in: 0   out: 1");
+    REQUIRE(not_tip.rows.size() == 2);
+    CHECK(not_tip.rows[0].second);
+    CHECK_FALSE(not_tip.rows[1].second);
+}
+
+TEST_CASE("Tooltip cache rebuilds only when the gate's values change", "[gate_tooltip]") {
+    SmallCircuit c;
+    c.apply(false, false);
+
+    GateTooltipCache cache;
+    CHECK(cache.get(*c.xor_gate).io == "in: 0, 0   out: 0");
+    CHECK(cache.get(*c.xor_gate).io == "in: 0, 0   out: 0");
+    CHECK(cache.builds() == 1);
+
+    // b feeds XOR and AND but not NOT
+    CHECK(cache.get(*c.not_gate).io == "in: 0   out: 1");
+    CHECK(cache.builds() == 2);
+    c.apply(false, true);
+    CHECK(cache.get(*c.not_gate).io == "in: 0   out: 1");
+    CHECK(cache.builds() == 2);
+    CHECK(cache.get(*c.xor_gate).io == "in: 0, 1   out: 1");
+    CHECK(cache.builds() == 3);
+    CHECK(cache.get(*c.and_gate).rows[1].second);
+    CHECK(cache.builds() == 4);
+
+    cache.clear();
+    CHECK(cache.get(*c.xor_gate).io == "in: 0, 1   out: 1");
+    CHECK(cache.builds() == 5);
+}
@@ -0,0 +1,49 @@
+/// @file test_info_panel.cpp
+/// @brief Tests for the info panel's readout of adders of any width
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "ui/info_panel.hpp"
+
+#include <cstdint>
+
+using namespace gateflow;
+
+TEST_CASE("Info panel reads the carry-out of narrow and wide adders", "[ui]") {
+    for (const bool nand : {false, true}) {
+        INFO("nand=" << nand);
+
+        // 3 bits: 7 + 1 overflows into the carry-out
+        auto narrow = build_ripple_carry_adder(3, nand);
+        CHECK(adder_width(*narrow) == 3);
+        CHECK(result_display_bits(*narrow) == 3);
+        const Wire* narrow_cout = adder_carry_out(*narrow);
+        REQUIRE(narrow_cout == narrow->output_wires().back());
+        narrow->set_bus("A", 7);
+        narrow->set_bus("B", 1);
+        (void)narrow->propagate();
+        CHECK(narrow_cout->get_value());
+        CHECK(narrow->read_bus("Sum") == 0);
+
+        // 16 bits: 99 + 99 sets Sum[7], not the carry-out
+        auto wide = build_ripple_carry_adder(16, nand);
+        CHECK(adder_width(*wide) == 16);
+        CHECK(result_display_bits(*wide) == MAX_RESULT_BITS);
+        const Wire* wide_cout = adder_carry_out(*wide);
+        REQUIRE(wide_cout == wide->output_wires()[16]);
+        wide->set_bus("A", 99);
+        wide->set_bus("B", 99);
+        (void)wide->propagate();
+        CHECK_FALSE(wide_cout->get_value());
+        CHECK(wide->get_output(7));
+        CHECK(wide->read_bus("Sum") == 198);
+        CHECK(wide->read_bus("Sum") < (uint64_t{1} << MAX_RESULT_BITS));
+    }
+
+    // No output past the sum bits
+    Circuit empty;
+    CHECK(adder_width(empty) == 0);
+    CHECK(adder_carry_out(empty) == nullptr);
+}
@@ -1,11 +1,15 @@
 /// @file test_layout_engine.cpp
-/// @brief Tests for layout determinism and wire fan-out routing coverage
+/// @brief Tests for layout determinism, wire fan-out routing and pins, and the layout cache
 
 #include <catch2/catch_test_macros.hpp>
 
+#include "rendering/layout_cache.hpp"
 #include "rendering/layout_engine.hpp"
 #include "simulation/circuit.hpp"
 #include "simulation/circuit_builder.hpp"
+#include "simulation/nand_decompose.hpp"
+
+#include <algorithm>
 
 using namespace gateflow;
 
@@ -40,8 +44,7 @@ TEST_CASE("Layout routes one branch per wire destination", "[layout]") {
     Circuit circuit = build_fanout_circuit();
     Layout layout = compute_layout(circuit);
 
-    for (const auto& wire_ptr : circuit.wires()) {
-        const Wire* wire = wire_ptr.get();
+    for (const Wire* wire : circuit.wires()) {
         const auto& dests = wire->get_destinations();
 
         int expected_branches = 0;
@@ -53,19 +56,95 @@ TEST_CASE("Layout routes one branch per wire destination", "[layout]") {
             expected_branches = static_cast<int>(dests.size());
         }
 
-        auto it = layout.wire_paths.find(wire);
-        int actual_branches = (it == layout.wire_paths.end()) ? 0 : static_cast<int>(it->second.size());
+        const auto& branches = layout.wire_branches(wire);
+        int actual_branches = static_cast<int>(branches.size());
 
         INFO("Wire id=" << wire->get_id());
         CHECK(actual_branches == expected_branches);
 
-        if (it != layout.wire_paths.end()) {
-            for (const WirePath& branch : it->second) {
-                CHECK(branch.points.size() >= 2);
-                CHECK(branch.cumulative_lengths.size() == branch.points.size());
-                CHECK(branch.total_length >= 0.0f);
+        for (const WirePath& branch : branches) {
+            CHECK(branch.points.size() >= 2);
+            CHECK(branch.cumulative_lengths.size() == branch.points.size());
+            CHECK(branch.total_length >= 0.0f);
+        }
+    }
+}
+
+TEST_CASE("Layout ends each branch at its destination's input pin", "[layout]") {
+    Circuit circuit;
+    Wire* a = circuit.add_wire();
+    Wire* b = circuit.add_wire();
+    Wire* out1 = circuit.add_wire();
+    Wire* out2 = circuit.add_wire();
+    circuit.mark_input(a);
+    circuit.mark_input(b);
+    circuit.mark_output(out1);
+    circuit.mark_output(out2);
+
+    // and1 reads b then a; and2 reads a twice
+    Gate* and1 = circuit.add_gate(GateType::AND);
+    Gate* and2 = circuit.add_gate(GateType::AND);
+    circuit.connect(b, nullptr, and1);
+    circuit.connect(a, nullptr, and1);
+    circuit.connect(a, nullptr, and2);
+    circuit.connect(a, nullptr, and2);
+    circuit.connect(out1, and1, nullptr);
+    circuit.connect(out2, and2, nullptr);
+    circuit.finalize();
+
+    const Layout layout = compute_layout(circuit);
+    const Rect& r1 = *layout.gate_rect(and1);
+    const Rect& r2 = *layout.gate_rect(and2);
+    const float pin0 = r1.h / 3.0f;
+    const float pin1 = r1.h * 2.0f / 3.0f;
+
+    // Branches follow a's destination order: and1, and2, and2
+    const auto& a_branches = layout.wire_branches(a);
+    REQUIRE(a_branches.size() == 3);
+    CHECK(a_branches[0].points.back().y == r1.y + pin1);
+    CHECK(a_branches[1].points.back().y == r2.y + pin0); // Both go to the first matching pin
+    CHECK(a_branches[2].points.back().y == r2.y + pin0);
+    REQUIRE(layout.wire_branches(b).size() == 1);
+    CHECK(layout.wire_branches(b)[0].points.back().y == r1.y + pin0);
+
+    // Inputs start at their input positions, outputs end at theirs
+    CHECK(a_branches[0].points.front().x == layout.input_positions[0].x);
+    CHECK(a_branches[0].points.front().y == layout.input_positions[0].y);
+    CHECK(layout.wire_branches(b)[0].points.front().y == layout.input_positions[1].y);
+    REQUIRE(layout.wire_branches(out2).size() == 1);
+    CHECK(layout.wire_branches(out2)[0].points.back().y == layout.output_positions[1].y);
+}
+
+TEST_CASE("Parallel routing produces the serial layout", "[layout]") {
+    for (const bool nand : {false, true}) {
+        INFO("nand=" << nand);
+        auto circuit = build_ripple_carry_adder(512, nand);
+        const Layout serial = compute_layout(*circuit);
+        circuit->set_parallelism(4);
+        const Layout parallel = compute_layout(*circuit);
+
+        REQUIRE(parallel.wire_paths.size() == serial.wire_paths.size());
+        const auto same_point = [](const Vec2& l, const Vec2& r) {
+            return l.x == r.x && l.y == r.y;
+        };
+        size_t mismatches = 0;
+        for (size_t w = 0; w < serial.wire_paths.size(); w++) {
+            const auto& want = serial.wire_paths[w];
+            const auto& got = parallel.wire_paths[w];
+            if (got.size() != want.size()) {
+                mismatches++;
+                continue;
+            }
+            for (size_t i = 0; i < want.size(); i++) {
+                const bool same =
+                    got[i].points.size() == want[i].points.size() &&
+                    got[i].total_length == want[i].total_length &&
+                    std::equal(want[i].points.begin(), want[i].points.end(), got[i].points.begin(),
+                               same_point);
+                mismatches += same ? 0 : 1;
             }
         }
+        CHECK(mismatches == 0);
     }
 }
 
@@ -83,3 +162,119 @@ TEST_CASE("Layout is deterministic for same circuit", "[layout]") {
     CHECK(a.gate_positions.size() == b.gate_positions.size());
     CHECK(a.wire_paths.size() == b.wire_paths.size());
 }
+
+TEST_CASE("Layout is indexed by gate and wire id", "[layout]") {
+    auto circuit = build_ripple_carry_adder(4);
+    Layout layout = compute_layout(*circuit);
+
+    REQUIRE(layout.gate_positions.size() == circuit->gates().size());
+    REQUIRE(layout.wire_paths.size() == circuit->wires().size());
+    for (const Gate* gate : circuit->gates()) {
+        const Rect* rect = layout.gate_rect(gate);
+        REQUIRE(rect != nullptr);
+        CHECK(rect == &layout.gate_positions[gate->get_id()]);
+        CHECK(rect->w > 0.0f);
+    }
+}
+
+TEST_CASE("Small fast adders are not laid out as ripple-carry adders", "[layout]") {
+    // A 4-bit carry-select adder has exactly the 17 gates of a 4-bit RCA
+    auto circuit = build_carry_select_adder(4);
+    REQUIRE(circuit->gates().size() == build_ripple_carry_adder(4)->gates().size());
+    Layout layout = compute_layout(*circuit);
+
+    // The generic layout gives each compiled level its own column
+    const CompiledNetlist& net = circuit->compiled();
+    const auto& order = circuit->topological_order();
+    for (size_t level = 0; level < net.num_levels(); level++) {
+        const float col_x = layout.gate_rect(order[net.level_offsets[level]])->x;
+        for (uint32_t slot = net.level_offsets[level]; slot < net.level_offsets[level + 1]; slot++) {
+            CHECK(layout.gate_rect(order[slot])->x == col_x);
+        }
+    }
+}
+
+TEST_CASE("LayoutCache reuses layouts for identical structures", "[layout]") {
+    LayoutCache cache;
+
+    auto logical = build_ripple_carry_adder(4);
+    const Layout& first = cache.get(*logical);
+    CHECK(cache.misses() == 1);
+
+    // A fresh build with different inputs has the same structure
+    auto again = build_ripple_carry_adder(4);
+    again->set_input(0, true);
+    (void)again->propagate();
+    const Layout& second = cache.get(*again);
+    CHECK(&second == &first);
+    CHECK(cache.hits() == 1);
+
+    // NAND decomposition changes the structure, so it gets its own entry
+    auto nand = build_ripple_carry_adder(4);
+    decompose_to_nand(*nand);
+    const Layout& nand_layout = cache.get(*nand);
+    CHECK(&nand_layout != &first);
+    CHECK(nand_layout.gate_positions.size() == nand->gates().size());
+    CHECK(cache.size() == 2);
+
+    // Toggling back hits the original entry
+    CHECK(&cache.get(*logical) == &first);
+    CHECK(cache.misses() == 2);
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+}
+
+TEST_CASE("Gate blocks group an adder layout into one column per bit", "[layout]") {
+    auto circuit = build_ripple_carry_adder(5);
+    Layout layout = compute_layout(*circuit);
+    GateBlocks blocks = compute_gate_blocks(layout);
+
+    REQUIRE(blocks.size() == 5);
+    REQUIRE(blocks.offsets.size() == blocks.size() + 1);
+    CHECK(blocks.offsets.back() == circuit->gates().size());
+
+    // Bit 0 is the half adder; every other column is a full adder
+    CHECK(blocks.offsets[1] - blocks.offsets[0] == 2);
+    for (size_t b = 1; b < blocks.size(); b++) {
+        CHECK(blocks.offsets[b + 1] - blocks.offsets[b] == 5);
+        CHECK(blocks.bounds[b].x < blocks.bounds[b - 1].x); // Right to left
+    }
+
+    // Each block's bounds contain its gates
+    for (size_t b = 0; b < blocks.size(); b++) {
+        const Rect& box = blocks.bounds[b];
+        for (uint32_t i = blocks.offsets[b]; i < blocks.offsets[b + 1]; i++) {
+            const Rect& r = layout.gate_positions[blocks.gates[i]];
+            CHECK(r.x >= box.x);
+            CHECK(r.y >= box.y);
+            CHECK(r.x + r.w <= box.x + box.w);
+            CHECK(r.y + r.h <= box.y + box.h);
+        }
+    }
+}
+
+TEST_CASE("Instance blocks follow the adder's cells where the layout keeps them apart",
+          "[layout]") {
+    auto circuit = build_ripple_carry_adder(5);
+    Layout layout = compute_layout(*circuit);
+    GateBlocks columns = compute_gate_blocks(layout);
+    GateBlocks instances = compute_instance_blocks(*circuit, layout);
+
+    // The ripple-carry layout gives each cell its own column
+    REQUIRE(instances.size() == 5);
+    CHECK(instances.offsets == columns.offsets);
+    CHECK(instances.gates == columns.gates);
+    for (size_t b = 0; b < instances.size(); b++) {
+        CHECK(instances.bounds[b].x == columns.bounds[b].x);
+        CHECK(instances.bounds[b].w == columns.bounds[b].w);
+    }
+
+    // The generic layout interleaves a NAND adder's cells along the carry chain
+    auto nand = build_ripple_carry_adder(5, true);
+    CHECK(compute_instance_blocks(*nand, compute_layout(*nand)).size() == 0);
+
+    // Circuits without instances have no instance blocks
+    auto ks = build_kogge_stone_adder(4);
+    CHECK(compute_instance_blocks(*ks, compute_layout(*ks)).size() == 0);
+}
@@ -0,0 +1,115 @@
+/// @file test_memory_usage.cpp
+/// @brief Tests MemoryUsage bookkeeping and the memory_usage() reports of the per-circuit structures
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "rendering/animation_state.hpp"
+#include "rendering/layout_engine.hpp"
+#include "rendering/spatial_index.hpp"
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/memory_usage.hpp"
+#include "simulation/nand_decompose.hpp"
+#include "timing/propagation_scheduler.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace gateflow;
+
+TEST_CASE("MemoryUsage merges categories and counts capacity", "[memory]") {
+    MemoryUsage usage;
+    std::vector<uint32_t> v;
+    usage.add_vector("empty", v); // No buffer yet
+    v.reserve(10);
+    v.push_back(1);
+    usage.add_vector("ids", v);
+    usage.add("ids", 8, 1);
+    std::vector<std::vector<float>> nested(3);
+    nested[1].resize(4);
+    usage.add_nested("nested", nested);
+
+    REQUIRE(usage.categories.size() == 3);
+    CHECK(usage.category("empty").bytes == 0);
+    CHECK(usage.category("empty").allocations == 0);
+    CHECK(usage.category("ids").bytes == 10 * sizeof(uint32_t) + 8);
+    CHECK(usage.category("ids").allocations == 2);
+    CHECK(usage.category("nested").bytes ==
+          nested.capacity() * sizeof(std::vector<float>) + nested[1].capacity() * sizeof(float));
+    CHECK(usage.category("nested").allocations == 2);
+    CHECK(usage.category("missing").bytes == 0);
+
+    MemoryUsage other;
+    other.add("ids", 100, 1);
+    other.add("more", 5, 1);
+    usage.add_all(other);
+    CHECK(usage.categories.size() == 4);
+    CHECK(usage.category("ids").bytes == 10 * sizeof(uint32_t) + 108);
+    CHECK(usage.total_bytes() == usage.category("ids").bytes + usage.category("nested").bytes + 5);
+    CHECK(usage.total_allocations() == 3 + 2 + 1);
+}
+
+TEST_CASE("Circuit::memory_usage covers objects, lists, tables and state", "[memory]") {
+    auto circuit = build_ripple_carry_adder(64);
+    decompose_to_nand(*circuit);
+    const MemoryUsage usage = circuit->memory_usage();
+    const size_t gates = circuit->gates().size();
+    const size_t wires = circuit->wires().size();
+
+    for (const char* name : {"gates", "wires", "gate inputs", "wire destinations", "netlist",
+                             "compiled netlist", "signal state"}) {
+        INFO(name);
+        CHECK(usage.category(name).bytes > 0);
+        CHECK(usage.category(name).allocations > 0);
+    }
+    CHECK(usage.category("gates").bytes >= gates * sizeof(Gate));
+    CHECK(usage.category("wires").bytes >= wires * sizeof(Wire));
+    // The arenas allocate chunks, not objects
+    CHECK(usage.category("gates").allocations < gates / 100);
+
+    const CompiledNetlist& net = circuit->compiled();
+    CHECK(usage.category("compiled netlist").bytes >=
+          net.input_wires.size() * sizeof(uint32_t) + net.fanout_slots.size() * sizeof(uint32_t));
+    CHECK(usage.category("signal state").bytes >= wires * sizeof(LaneBlock<1>));
+
+    // Twice the adder, about twice the memory
+    auto wider = build_ripple_carry_adder(128);
+    decompose_to_nand(*wider);
+    const size_t bytes = usage.total_bytes();
+    CHECK(wider->memory_usage().total_bytes() > bytes * 3 / 2);
+    CHECK(wider->memory_usage().total_bytes() < bytes * 3);
+}
+
+TEST_CASE("Rendering and timing structures report their per-id tables", "[memory]") {
+    auto circuit = build_ripple_carry_adder(16);
+    const Layout layout = compute_layout(*circuit);
+    const MemoryUsage layout_usage = layout.memory_usage();
+    CHECK(layout_usage.category("gate positions").bytes >= circuit->gates().size() * sizeof(Rect));
+
+    size_t branch_lists = 0;
+    size_t points = 0;
+    for (const auto& branches : layout.wire_paths) {
+        branch_lists += branches.capacity() > 0 ? 1 : 0;
+        for (const WirePath& path : branches) {
+            points += path.points.size();
+        }
+    }
+    CHECK(layout_usage.category("wire paths").allocations == branch_lists + 1);
+    CHECK(layout_usage.category("path points").bytes >= points * (sizeof(Vec2) + sizeof(float)));
+
+    PropagationScheduler scheduler(circuit.get());
+    CHECK(scheduler.memory_usage().category("depths").bytes >=
+          circuit->gates().size() * sizeof(int));
+    CHECK(scheduler.memory_usage().category("resolve schedule").bytes > 0);
+
+    AnimationState anim(circuit.get());
+    CHECK(anim.memory_usage().category("gate animations").bytes >=
+          circuit->gates().size() * sizeof(GateAnim));
+    CHECK(anim.memory_usage().category("wire animations").bytes >=
+          circuit->wires().size() * sizeof(WireAnim));
+
+    const SpatialIndex index(layout);
+    CHECK(index.memory_usage().category("gate cells").bytes >=
+          circuit->gates().size() * sizeof(Rect));
+    CHECK(index.memory_usage().category("wire cells").allocations > 0);
+}
@@ -0,0 +1,149 @@
+/// @file test_module.cpp
+/// @brief Tests for sub-circuit instantiation and module instances in built adders
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/module.hpp"
+#include "simulation/nand_decompose.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace gateflow;
+
+namespace {
+
+/// Sets A and B on an N-bit adder and returns its outputs as a number
+uint64_t add(Circuit& circuit, int bits, uint64_t a, uint64_t b) {
+    for (int i = 0; i < bits; i++) {
+        circuit.set_input(static_cast<size_t>(i), ((a >> i) & 1) != 0);
+        circuit.set_input(static_cast<size_t>(bits + i), ((b >> i) & 1) != 0);
+    }
+    (void)circuit.propagate();
+    uint64_t sum = 0;
+    for (int i = 0; i <= bits; i++) {
+        sum |= static_cast<uint64_t>(circuit.get_output(static_cast<size_t>(i))) << i;
+    }
+    return sum;
+}
+
+} // namespace
+
+TEST_CASE("instantiate() stamps a module behind the given input wires", "[module]") {
+    auto full_adder = build_full_adder();
+
+    // Two chained full adders make a 2-bit adder with carry-in
+    Circuit circuit;
+    std::vector<Wire*> in;
+    for (int i = 0; i < 5; i++) {
+        in.push_back(circuit.add_wire());
+        circuit.mark_input(in.back());
+    }
+    Gate* outside = circuit.add_gate(GateType::BUFFER);
+    circuit.connect(in[4], nullptr, outside);
+    Wire* cin = circuit.add_wire();
+    circuit.connect(cin, outside, nullptr);
+
+    const std::vector<Wire*> bit0 = instantiate(circuit, *full_adder, "full_adder",
+                                                {in[0], in[2], cin});
+    const std::vector<Wire*> bit1 = instantiate(circuit, *full_adder, "full_adder",
+                                                {in[1], in[3], bit0[1]});
+    REQUIRE(bit0.size() == 2);
+    REQUIRE(bit1.size() == 2);
+    circuit.mark_output(bit0[0]);
+    circuit.mark_output(bit1[0]);
+    circuit.mark_output(bit1[1]);
+    circuit.finalize();
+
+    CHECK(circuit.gates().size() == 1 + 2 * full_adder->gates().size());
+    REQUIRE(circuit.num_instances() == 2);
+    CHECK(circuit.instance_module(0) == "full_adder");
+    CHECK(circuit.instance_of(outside) == Circuit::NO_INSTANCE);
+    for (size_t id = 1; id < circuit.gates().size(); id++) {
+        const Gate* gate = circuit.gates()[id];
+        CHECK(circuit.instance_of(gate) == (id <= full_adder->gates().size() ? 0u : 1u));
+        CHECK(gate->get_type() == full_adder->gates()[(id - 1) % 5]->get_type());
+    }
+
+    for (uint64_t v = 0; v < 32; v++) {
+        for (size_t i = 0; i < 5; i++) {
+            circuit.set_input(i, ((v >> i) & 1) != 0);
+        }
+        (void)circuit.propagate();
+        const uint64_t expected = (v & 3) + ((v >> 2) & 3) + (v >> 4);
+        const uint64_t got = static_cast<uint64_t>(circuit.get_output(0)) |
+                             static_cast<uint64_t>(circuit.get_output(1)) << 1 |
+                             static_cast<uint64_t>(circuit.get_output(2)) << 2;
+        CHECK(got == expected);
+    }
+}
+
+TEST_CASE("instantiate() rejects bad modules and port lists", "[module]") {
+    auto half_adder = build_half_adder();
+    Circuit circuit;
+    Wire* a = circuit.add_wire();
+    circuit.mark_input(a);
+
+    CHECK_THROWS_AS(instantiate(circuit, *half_adder, "half_adder", {a}), std::invalid_argument);
+    CHECK_THROWS_AS(instantiate(circuit, *half_adder, "half_adder", {a, nullptr}),
+                    std::invalid_argument);
+    Circuit open;
+    CHECK_THROWS_AS(instantiate(circuit, open, "open", {}), std::runtime_error);
+    CHECK_THROWS_AS(circuit.add_gate(GateType::NOT, 0), std::invalid_argument);
+}
+
+TEST_CASE("Ripple-carry adder bits are module instances", "[module]") {
+    constexpr int BITS = 6;
+    auto circuit = build_ripple_carry_adder(BITS);
+
+    REQUIRE(circuit->num_instances() == BITS);
+    CHECK(circuit->instance_module(0) == "half_adder");
+    for (uint32_t i = 1; i < BITS; i++) {
+        CHECK(circuit->instance_module(i) == "full_adder");
+    }
+    // Cells are stamped in bit order, so gate ids run bit by bit
+    for (const Gate* gate : circuit->gates()) {
+        const uint32_t id = gate->get_id();
+        CHECK(circuit->instance_of(gate) == (id < 2 ? 0 : (id - 2) / 5 + 1));
+    }
+
+    // Decomposition keeps each new gate in its bit, and clone() keeps the tags
+    decompose_to_nand(*circuit);
+    auto copy = circuit->clone();
+    REQUIRE(copy->num_instances() == BITS);
+    std::vector<size_t> per_bit(BITS, 0);
+    for (const Gate* gate : copy->gates()) {
+        REQUIRE(copy->instance_of(gate) < BITS);
+        CHECK(copy->instance_of(gate) == circuit->instance_of(circuit->gates()[gate->get_id()]));
+        per_bit[copy->instance_of(gate)]++;
+    }
+    CHECK(per_bit[0] == 6); // XOR = 4 NANDs, AND = 2
+    for (int b = 1; b < BITS; b++) {
+        CHECK(per_bit[static_cast<size_t>(b)] == 15);
+    }
+}
+
+TEST_CASE("A NAND-only ripple-carry build matches decomposing the logical adder", "[module]") {
+    constexpr int BITS = 4;
+    auto stamped = build_ripple_carry_adder(BITS, true);
+    auto decomposed = build_ripple_carry_adder(BITS);
+    decompose_to_nand(*decomposed);
+
+    CHECK(stamped->gates().size() == decomposed->gates().size());
+    CHECK(stamped->compiled().num_levels() == decomposed->compiled().num_levels());
+    REQUIRE(stamped->num_instances() == BITS);
+    for (const Gate* gate : stamped->gates()) {
+        CHECK(gate->get_type() == GateType::NAND);
+    }
+    for (uint64_t a = 0; a < (1u << BITS); a++) {
+        for (uint64_t b = 0; b < (1u << BITS); b++) {
+            INFO(a << " + " << b);
+            CHECK(add(*stamped, BITS, a, b) == a + b);
+            CHECK(add(*decomposed, BITS, a, b) == a + b);
+        }
+    }
+}
@@ -7,7 +7,10 @@
 #include "simulation/circuit_builder.hpp"
 #include "simulation/nand_decompose.hpp"
 
+#include <cstdint>
 #include <cstdlib>
+#include <memory>
+#include <stdexcept>
 #include <vector>
 
 using namespace gateflow;
@@ -316,3 +319,74 @@ TEST_CASE("NAND decomposition — 7-bit ripple-carry adder spot checks", "[nand]
         CHECK(read_output() == tc.result);
     }
 }
+
+TEST_CASE("NAND decomposition — wide gates, fan-out and circuit metadata", "[nand]") {
+    // Three-input AND, OR and XOR over shared inputs, all read by a wide NAND
+    auto circuit = std::make_unique<Circuit>();
+    std::vector<Wire*> in;
+    for (int i = 0; i < 3; i++) {
+        in.push_back(circuit->add_wire());
+        circuit->mark_input(in.back());
+    }
+    const uint32_t cell = circuit->add_instance("cell");
+    std::vector<Wire*> outs;
+    for (GateType type : {GateType::AND, GateType::OR, GateType::XOR}) {
+        Gate* gate = circuit->add_gate(type, cell);
+        for (Wire* w : in) {
+            circuit->connect(w, nullptr, gate);
+        }
+        outs.push_back(circuit->add_wire());
+        circuit->connect(outs.back(), gate, nullptr);
+        circuit->mark_output(outs.back());
+    }
+    Gate* all = circuit->add_gate(GateType::NAND);
+    for (Wire* w : outs) {
+        circuit->connect(w, nullptr, all);
+    }
+    Wire* all_out = circuit->add_wire();
+    circuit->connect(all_out, all, nullptr);
+    circuit->mark_output(all_out);
+    circuit->add_input_bus("X", 0, 3);
+    circuit->finalize();
+
+    std::vector<std::vector<bool>> original;
+    for (uint64_t v = 0; v < 8; v++) {
+        circuit->set_bus("X", v);
+        (void)circuit->propagate();
+        std::vector<bool> row;
+        for (size_t o = 0; o < circuit->num_outputs(); o++) {
+            row.push_back(circuit->get_output(o));
+        }
+        original.push_back(row);
+    }
+
+    decompose_to_nand(*circuit);
+    verify_all_nand(*circuit);
+    CHECK(circuit->gates().size() == 2 + 4 + 8 + 1);
+    REQUIRE(circuit->num_instances() == 1);
+    size_t in_cell = 0;
+    for (const Gate* gate : circuit->gates()) {
+        in_cell += circuit->instance_of(gate) == cell ? 1 : 0;
+        // Emitted source-first, so gate ids stay a topological order
+        for (const Wire* w : gate->get_inputs()) {
+            if (const Gate* src = w->get_source()) {
+                CHECK(src->get_id() < gate->get_id());
+            }
+        }
+    }
+    CHECK(in_cell == 14);
+
+    // The last pass left X = 7; the values and the bus carry over
+    CHECK(circuit->input_wires()[2]->get_value());
+    for (uint64_t v = 0; v < 8; v++) {
+        circuit->set_bus("X", v);
+        (void)circuit->propagate();
+        for (size_t o = 0; o < circuit->num_outputs(); o++) {
+            INFO("X=" << v << " output " << o);
+            CHECK(circuit->get_output(o) == original[v][o]);
+        }
+    }
+
+    Circuit open;
+    CHECK_THROWS_AS(decompose_to_nand(open), std::runtime_error);
+}
@@ -0,0 +1,280 @@
+/// @file test_netlist_file.cpp
+/// @brief Tests for netlist file round trips, validation of malformed images and stored layouts
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "rendering/layout_cache.hpp"
+#include "rendering/layout_engine.hpp"
+#include "rendering/layout_file.hpp"
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/nand_decompose.hpp"
+#include "simulation/netlist_file.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <utility>
+
+using namespace gateflow;
+
+namespace {
+
+void require_same_compiled(const CompiledNetlist& a, const CompiledNetlist& b) {
+    REQUIRE(a.types == b.types);
+    REQUIRE(a.gate_ids == b.gate_ids);
+    REQUIRE(a.outputs == b.outputs);
+    REQUIRE(a.input_offsets == b.input_offsets);
+    REQUIRE(a.input_wires == b.input_wires);
+    REQUIRE(a.level_offsets == b.level_offsets);
+    REQUIRE(a.gate_levels == b.gate_levels);
+    REQUIRE(a.level_runs == b.level_runs);
+    REQUIRE(a.fanout_offsets == b.fanout_offsets);
+    REQUIRE(a.fanout_slots == b.fanout_slots);
+    REQUIRE(a.runs.size() == b.runs.size());
+    for (size_t r = 0; r < a.runs.size(); r++) {
+        CHECK(a.runs[r].type == b.runs[r].type);
+        CHECK(a.runs[r].arity == b.runs[r].arity);
+        CHECK(a.runs[r].begin == b.runs[r].begin);
+        CHECK(a.runs[r].end == b.runs[r].end);
+    }
+}
+
+/// Drives both circuits with the same random inputs and compares outputs
+void require_same_behavior(Circuit& a, Circuit& b) {
+    REQUIRE(a.num_inputs() == b.num_inputs());
+    REQUIRE(a.num_outputs() == b.num_outputs());
+    std::mt19937 rng(20);
+    for (int trial = 0; trial < 32; trial++) {
+        for (size_t i = 0; i < a.num_inputs(); i++) {
+            const bool v = (rng() & 1) != 0;
+            a.set_input(i, v);
+            b.set_input(i, v);
+        }
+        (void)a.propagate();
+        (void)b.propagate();
+        for (size_t o = 0; o < a.num_outputs(); o++) {
+            REQUIRE(a.get_output(o) == b.get_output(o));
+        }
+    }
+}
+
+/// Overwrites one 32-bit field of an image in place
+void poke(std::vector<uint8_t>& image, size_t offset, uint32_t value) {
+    std::memcpy(image.data() + offset, &value, sizeof(value));
+}
+
+size_t section_offset(const std::vector<uint8_t>& image, NetlistSection id) {
+    NetlistFileHeader header{};
+    std::memcpy(&header, image.data(), sizeof(header));
+    for (uint32_t i = 0; i < header.section_count; i++) {
+        NetlistSectionEntry entry{};
+        std::memcpy(&entry, image.data() + sizeof(header) + i * sizeof(entry), sizeof(entry));
+        if (entry.id == static_cast<uint32_t>(id)) {
+            return static_cast<size_t>(entry.offset);
+        }
+    }
+    FAIL("section not found");
+    return 0;
+}
+
+} // namespace
+
+TEST_CASE("A netlist file round-trips structure, compiled form and behavior", "[netlist_file]") {
+    auto original = build_kogge_stone_adder(16);
+    decompose_to_nand(*original);
+
+    const NetlistFile file = NetlistFile::from_bytes(serialize_netlist(*original));
+    REQUIRE(file.has_compiled());
+    REQUIRE_FALSE(file.has_section(NetlistSection::LAYOUT));
+    CHECK(file.num_gates() == original->gates().size());
+    CHECK(file.num_wires() == original->wires().size());
+
+    auto loaded = load_circuit(file);
+    REQUIRE(loaded->is_finalized());
+    CHECK(loaded->structural_hash() == original->structural_hash());
+    require_same_compiled(loaded->compiled(), original->compiled());
+    for (size_t slot = 0; slot < loaded->topological_order().size(); slot++) {
+        CHECK(loaded->topological_order()[slot]->get_id() ==
+              original->topological_order()[slot]->get_id());
+    }
+    // Destination lists keep their order, not only their contents
+    for (const Wire* wire : original->wires()) {
+        const auto& want = wire->get_destinations();
+        const auto& got = loaded->wires()[wire->get_id()]->get_destinations();
+        REQUIRE(got.size() == want.size());
+        for (size_t k = 0; k < want.size(); k++) {
+            CHECK(got[k]->get_id() == want[k]->get_id());
+        }
+    }
+    require_same_behavior(*original, *loaded);
+}
+
+TEST_CASE("A netlist file without a compiled section is finalized on load", "[netlist_file]") {
+    auto original = build_ripple_carry_adder(8);
+    NetlistSaveOptions options;
+    options.include_compiled = false;
+
+    const NetlistFile file = NetlistFile::from_bytes(serialize_netlist(*original, options));
+    REQUIRE_FALSE(file.has_compiled());
+    REQUIRE_THROWS_AS(file.compiled(), std::runtime_error);
+
+    auto loaded = load_circuit(file);
+    require_same_compiled(loaded->compiled(), original->compiled());
+    require_same_behavior(*original, *loaded);
+
+    Circuit unfinalized;
+    unfinalized.mark_input(unfinalized.add_wire());
+    CHECK_THROWS_AS(serialize_netlist(unfinalized), std::runtime_error);
+    CHECK_NOTHROW(serialize_netlist(unfinalized, options));
+}
+
+TEST_CASE("open() maps a saved netlist file", "[netlist_file]") {
+    auto original = build_brent_kung_adder(12);
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "gateflow_test_netlist.gfnl").string();
+    save_netlist(*original, path);
+
+    {
+        const NetlistFile file = NetlistFile::open(path);
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+        CHECK(file.is_mapped());
+#endif
+        CHECK(file.size_bytes() == std::filesystem::file_size(path));
+        REQUIRE(file.inputs().size == original->num_inputs());
+        for (size_t i = 0; i < file.inputs().size; i++) {
+            CHECK(file.inputs()[i] == original->input_wires()[i]->get_id());
+        }
+        auto loaded = load_circuit(file);
+        require_same_behavior(*original, *loaded);
+    }
+    std::remove(path.c_str());
+
+    CHECK_THROWS_AS(NetlistFile::open(path), std::runtime_error);
+}
+
+TEST_CASE("Malformed netlist images are rejected when opened", "[netlist_file]") {
+    auto circuit = build_ripple_carry_adder(4);
+    const std::vector<uint8_t> good = serialize_netlist(*circuit);
+    REQUIRE_NOTHROW(NetlistFile::from_bytes(good));
+
+    SECTION("truncated") {
+        std::vector<uint8_t> image(good.begin(), good.begin() + good.size() / 2);
+        CHECK_THROWS_AS(NetlistFile::from_bytes(image), std::runtime_error);
+        CHECK_THROWS_AS(NetlistFile::from_bytes({}), std::runtime_error);
+    }
+    SECTION("bad magic") {
+        std::vector<uint8_t> image = good;
+        image[0] = 'X';
+        CHECK_THROWS_AS(NetlistFile::from_bytes(image), std::runtime_error);
+    }
+    SECTION("newer version") {
+        std::vector<uint8_t> image = good;
+        poke(image, offsetof(NetlistFileHeader, version), NETLIST_FILE_VERSION + 1);
+        CHECK_THROWS_AS(NetlistFile::from_bytes(image), std::runtime_error);
+    }
+    SECTION("foreign byte order") {
+        std::vector<uint8_t> image = good;
+        poke(image, offsetof(NetlistFileHeader, byte_order), 0x04030201u);
+        CHECK_THROWS_AS(NetlistFile::from_bytes(image), std::runtime_error);
+    }
+    SECTION("fan-in wire out of range") {
+        std::vector<uint8_t> image = good;
+        poke(image, section_offset(image, NetlistSection::FANIN_WIRES),
+             static_cast<uint32_t>(circuit->wires().size()));
+        CHECK_THROWS_AS(NetlistFile::from_bytes(image), std::runtime_error);
+    }
+    SECTION("unknown gate type") {
+        std::vector<uint8_t> image = good;
+        image[section_offset(image, NetlistSection::GATE_TYPES)] = 0xFF;
+        CHECK_THROWS_AS(NetlistFile::from_bytes(image), std::runtime_error);
+    }
+}
+
+TEST_CASE("A stored compiled netlist that disagrees with its gates is refused",
+          "[netlist_file]") {
+    auto circuit = build_ripple_carry_adder(4);
+    std::vector<uint8_t> image = serialize_netlist(*circuit);
+
+    SECTION("fan-in and fan-out lists disagree") {
+        // Gate 0's first input now names another wire than the fan-out says
+        const size_t at = section_offset(image, NetlistSection::FANIN_WIRES);
+        uint32_t first = 0;
+        std::memcpy(&first, image.data() + at, sizeof(first));
+        poke(image, at, first == 0 ? 1 : 0);
+        const NetlistFile file = NetlistFile::from_bytes(image);
+        CHECK_THROWS_AS(load_circuit(file), std::runtime_error);
+    }
+    SECTION("a gate is moved onto the level it reads from") {
+        const NetlistFile file = NetlistFile::from_bytes(image);
+        CompiledNetlist net = file.compiled();
+        const uint32_t last_slot = static_cast<uint32_t>(net.num_gates() - 1);
+        net.gate_levels[net.gate_ids[last_slot]] = 0;
+
+        auto copy = circuit->clone();
+        CHECK_THROWS_AS(copy->finalize(std::move(net)), std::runtime_error);
+    }
+    SECTION("runs claim the wrong kernel") {
+        const NetlistFile file = NetlistFile::from_bytes(image);
+        CompiledNetlist net = file.compiled();
+        net.runs[0].arity++;
+
+        auto copy = circuit->clone();
+        CHECK_THROWS_AS(copy->finalize(std::move(net)), std::runtime_error);
+        CHECK_NOTHROW(copy->finalize(file.compiled()));
+    }
+}
+
+TEST_CASE("A stored layout matches the computed one", "[netlist_file][layout]") {
+    auto circuit = build_ripple_carry_adder(7);
+    decompose_to_nand(*circuit);
+    const Layout computed = compute_layout(*circuit);
+
+    NetlistSaveOptions options;
+    options.layout = serialize_layout(computed);
+    const NetlistFile file = NetlistFile::from_bytes(serialize_netlist(*circuit, options));
+    REQUIRE(has_layout_for(file));
+    const Layout stored = load_layout(file);
+
+    REQUIRE(stored.gate_positions.size() == computed.gate_positions.size());
+    for (size_t g = 0; g < computed.gate_positions.size(); g++) {
+        CHECK(stored.gate_positions[g].x == computed.gate_positions[g].x);
+        CHECK(stored.gate_positions[g].y == computed.gate_positions[g].y);
+        CHECK(stored.gate_positions[g].w == computed.gate_positions[g].w);
+        CHECK(stored.gate_positions[g].h == computed.gate_positions[g].h);
+    }
+    REQUIRE(stored.wire_paths.size() == computed.wire_paths.size());
+    for (size_t w = 0; w < computed.wire_paths.size(); w++) {
+        REQUIRE(stored.wire_paths[w].size() == computed.wire_paths[w].size());
+        for (size_t b = 0; b < computed.wire_paths[w].size(); b++) {
+            const WirePath& want = computed.wire_paths[w][b];
+            const WirePath& got = stored.wire_paths[w][b];
+            REQUIRE(got.points.size() == want.points.size());
+            for (size_t p = 0; p < want.points.size(); p++) {
+                CHECK(got.points[p].x == want.points[p].x);
+                CHECK(got.points[p].y == want.points[p].y);
+            }
+            CHECK(got.cumulative_lengths == want.cumulative_lengths);
+            CHECK(got.total_length == want.total_length);
+        }
+    }
+    CHECK(stored.input_positions.size() == computed.input_positions.size());
+    CHECK(stored.output_positions.size() == computed.output_positions.size());
+    CHECK(stored.bounding_box.w == computed.bounding_box.w);
+    CHECK(stored.bounding_box.h == computed.bounding_box.h);
+
+    // Seeding the cache makes the loaded circuit a hit
+    auto loaded = load_circuit(file);
+    LayoutCache cache;
+    const Layout& seeded = cache.insert(*loaded, load_layout(file));
+    CHECK(&cache.get(*loaded) == &seeded);
+    CHECK(cache.hits() == 1);
+    CHECK(cache.misses() == 0);
+
+    // A file without a layout has none to offer
+    const NetlistFile bare = NetlistFile::from_bytes(serialize_netlist(*circuit));
+    CHECK_FALSE(has_layout_for(bare));
+    CHECK_THROWS_AS(load_layout(bare), std::runtime_error);
+}
@@ -0,0 +1,144 @@
+/// @file test_optimize.cpp
+/// @brief Tests that optimize() preserves behavior while merging, folding and pruning gates
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/nand_decompose.hpp"
+#include "simulation/optimize.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace gateflow;
+
+namespace {
+
+/// Output bits for every input combination (inputs must be few)
+std::vector<uint64_t> truth_table(Circuit& circuit) {
+    std::vector<uint64_t> rows;
+    const size_t n = circuit.num_inputs();
+    for (uint64_t v = 0; v < (uint64_t{1} << n); v++) {
+        for (size_t i = 0; i < n; i++) {
+            circuit.set_input(i, ((v >> i) & 1) != 0);
+        }
+        (void)circuit.propagate();
+        uint64_t row = 0;
+        for (size_t o = 0; o < circuit.num_outputs(); o++) {
+            row |= uint64_t{circuit.get_output(o)} << o;
+        }
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+void check_accounting(const OptimizeStats& stats) {
+    CHECK(stats.merged + stats.folded + stats.removed + stats.gates_after == stats.gates_before);
+}
+
+/// Adds a gate reading @p inputs and returns its new output wire
+Wire* add(Circuit& c, GateType type, std::vector<Wire*> inputs) {
+    Gate* gate = c.add_gate(type);
+    for (Wire* w : inputs) {
+        c.connect(w, nullptr, gate);
+    }
+    Wire* out = c.add_wire();
+    c.connect(out, gate, nullptr);
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("optimize() shrinks a NAND adder without changing its outputs", "[optimize]") {
+    auto circuit = build_ripple_carry_adder(4);
+    decompose_to_nand(*circuit);
+    const std::vector<uint64_t> expected = truth_table(*circuit);
+    const size_t inputs = circuit->num_inputs();
+    const size_t outputs = circuit->num_outputs();
+    const size_t gates = circuit->gates().size();
+
+    OptimizeStats stats = optimize(*circuit);
+
+    REQUIRE(circuit->is_finalized());
+    REQUIRE(circuit->num_inputs() == inputs);
+    REQUIRE(circuit->num_outputs() == outputs);
+    CHECK(stats.gates_before == gates);
+    CHECK(stats.gates_after == circuit->gates().size());
+    CHECK(stats.gates_after < stats.gates_before);
+    CHECK(stats.merged > 0);  // Shared NAND(A,B) of each XOR/AND pair
+    CHECK(stats.folded > 0);  // NOT(NOT(x)) between AND and OR
+    CHECK(stats.depth_after <= stats.depth_before);
+    check_accounting(stats);
+
+    for (const Gate* gate : circuit->gates()) {
+        CHECK(gate->get_type() == GateType::NAND);
+    }
+    CHECK(truth_table(*circuit) == expected);
+}
+
+TEST_CASE("optimize() leaves an already minimal adder alone", "[optimize]") {
+    auto circuit = build_ripple_carry_adder(3);
+    const std::vector<uint64_t> expected = truth_table(*circuit);
+
+    OptimizeStats stats = optimize(*circuit);
+    CHECK(stats.gates_after == stats.gates_before);
+    CHECK(stats.depth_after == stats.depth_before);
+    CHECK(truth_table(*circuit) == expected);
+}
+
+TEST_CASE("optimize() merges duplicates, folds inversions and drops dead gates",
+          "[optimize]") {
+    Circuit c;
+    Wire* a = c.add_wire();
+    Wire* b = c.add_wire();
+    c.mark_input(a);
+    c.mark_input(b);
+
+    Wire* and1 = add(c, GateType::AND, {a, b});
+    Wire* and2 = add(c, GateType::AND, {b, a});            // Same function as and1
+    Wire* not_not_a = add(c, GateType::NOT, {add(c, GateType::NOT, {a})});
+    Wire* buf_b = add(c, GateType::BUFFER, {b});
+    Wire* both = add(c, GateType::OR, {and1, and2});       // = and1 once merged
+    (void)add(c, GateType::XOR, {a, b});                   // Reaches no output
+    c.mark_output(add(c, GateType::XOR, {both, not_not_a}));
+    c.mark_output(add(c, GateType::AND, {buf_b, a}));      // = and1, but drives an output
+    c.finalize();
+
+    const std::vector<uint64_t> expected = truth_table(c);
+    OptimizeStats stats = optimize(c);
+
+    CHECK(stats.gates_before == 9);
+    CHECK(stats.merged == 1);      // and2
+    CHECK(stats.folded == 3);      // NOT(NOT(a)), BUFFER(b) and OR(x,x) bypassed
+    CHECK(stats.removed == 2);     // The unused XOR and the now-unread inner NOT
+    CHECK(stats.gates_after == 3); // AND(a,b), XOR output, AND output
+    check_accounting(stats);
+    CHECK(truth_table(c) == expected);
+}
+
+TEST_CASE("optimize() keeps input values and order", "[optimize]") {
+    auto circuit = build_ripple_carry_adder(2);
+    decompose_to_nand(*circuit);
+    circuit->set_input(0, true);
+    circuit->set_input(3, true);
+
+    (void)optimize(*circuit);
+    REQUIRE(circuit->input_wires()[0]->get_value());
+    REQUIRE_FALSE(circuit->input_wires()[1]->get_value());
+    REQUIRE(circuit->input_wires()[3]->get_value());
+
+    // A = 1, B = 2 → 3
+    (void)circuit->propagate();
+    CHECK(circuit->get_output(0));
+    CHECK(circuit->get_output(1));
+    CHECK_FALSE(circuit->get_output(2));
+}
+
+TEST_CASE("optimize() requires a finalized circuit", "[optimize]") {
+    Circuit c;
+    Wire* a = c.add_wire();
+    c.mark_input(a);
+    c.mark_output(add(c, GateType::NOT, {a}));
+    REQUIRE_THROWS_AS(optimize(c), std::runtime_error);
+}
@@ -1,11 +1,17 @@
 /// @file test_propagation.cpp
 /// @brief Tests for topological sort correctness and propagation behavior
 
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/lane_simulator.hpp"
+#include "simulation/nand_decompose.hpp"
 
 #include <algorithm>
+#include <memory>
+#include <random>
 #include <unordered_map>
 
 using namespace gateflow;
@@ -193,3 +199,568 @@ TEST_CASE("PropagationResult accurately reports wire changes", "[propagation]")
     auto r3 = circuit.propagate();
     CHECK(r3.changed_wires.size() >= 1);
 }
+
+TEST_CASE("Compiled netlist mirrors the gate/wire graph in level order", "[propagation]") {
+    auto circuit = build_ripple_carry_adder(4);
+    const CompiledNetlist& net = circuit->compiled();
+
+    REQUIRE(net.num_gates() == circuit->gates().size());
+    REQUIRE(net.input_offsets.size() == net.num_gates() + 1);
+    REQUIRE(net.level_offsets.front() == 0);
+    REQUIRE(net.level_offsets.back() == net.num_gates());
+
+    for (size_t level = 0; level < net.num_levels(); level++) {
+        for (uint32_t slot = net.level_offsets[level]; slot < net.level_offsets[level + 1]; slot++) {
+            const Gate* gate = circuit->gates()[net.gate_ids[slot]];
+            INFO("slot=" << slot << " gate=" << gate->get_id());
+
+            CHECK(circuit->topological_order()[slot] == gate);
+            CHECK(net.types[slot] == gate->get_type());
+            CHECK(net.gate_levels[gate->get_id()] == level);
+            CHECK(net.outputs[slot] == gate->get_output()->get_id());
+
+            const auto& inputs = gate->get_inputs();
+            REQUIRE(net.input_offsets[slot + 1] - net.input_offsets[slot] == inputs.size());
+            for (size_t k = 0; k < inputs.size(); k++) {
+                const Wire* in = inputs[k];
+                CHECK(net.input_wires[net.input_offsets[slot] + k] == in->get_id());
+                // Every driver sits on a strictly lower level
+                if (const Gate* src = in->get_source(); src != nullptr) {
+                    CHECK(net.gate_levels[src->get_id()] < level);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Compiled propagation keeps Wire and Gate accessors in sync", "[propagation]") {
+    auto circuit = build_ripple_carry_adder(4);
+
+    for (int a : {0, 5, 15}) {
+        for (int b : {0, 9, 15}) {
+            for (int i = 0; i < 4; i++) {
+                circuit->set_input(i, (a >> i) & 1);
+                circuit->set_input(4 + i, (b >> i) & 1);
+            }
+            auto result = circuit->propagate();
+
+            for (const auto& gate : circuit->gates()) {
+                CHECK(gate->get_state() == gate->get_output()->get_value());
+            }
+            for (const Wire* w : result.changed_wires) {
+                CHECK(w->value_changed());
+            }
+
+            int sum = 0;
+            for (int i = 0; i <= 4; i++) {
+                sum |= circuit->get_output(i) ? (1 << i) : 0;
+            }
+            INFO(a << " + " << b);
+            CHECK(sum == a + b);
+        }
+    }
+
+    // A repeated pass changes nothing and leaves no stale edge flags behind
+    auto idle = circuit->propagate();
+    CHECK(idle.changed_wires.empty());
+    CHECK(idle.changed_gates.empty());
+    for (const auto& wire : circuit->wires()) {
+        if (wire->get_source() != nullptr) {
+            CHECK_FALSE(wire->value_changed());
+        }
+    }
+}
+
+TEST_CASE("Mutating a finalized circuit requires finalize() again", "[propagation]") {
+    Circuit circuit;
+    Wire* in = circuit.add_wire();
+    circuit.mark_input(in);
+    Gate* not_gate = circuit.add_gate(GateType::NOT);
+    Wire* out = circuit.add_wire();
+    circuit.mark_output(out);
+    circuit.connect(in, nullptr, not_gate);
+    circuit.connect(out, not_gate, nullptr);
+    circuit.finalize();
+    CHECK(circuit.is_finalized());
+
+    (void)circuit.add_wire();
+    CHECK_FALSE(circuit.is_finalized());
+    CHECK_THROWS_AS(circuit.propagate(), std::runtime_error);
+
+    circuit.finalize();
+    circuit.set_input(0, true);
+    (void)circuit.propagate();
+    CHECK(circuit.get_output(0) == false);
+}
+
+namespace {
+
+/// Checks every A,B pair of an N-bit adder with 64 vectors per packed pass.
+/// Vector v encodes A = v mod 2^bits, B = v / 2^bits. Returns the pass count.
+int verify_adder_exhaustively_packed(Circuit& circuit, int bits) {
+    const uint64_t total = uint64_t{1} << (2 * bits);
+    int passes = 0;
+
+    for (uint64_t base = 0; base < total; base += 64) {
+        const uint64_t lanes = std::min<uint64_t>(64, total - base);
+        for (int i = 0; i < 2 * bits; i++) {
+            uint64_t word = 0;
+            for (uint64_t lane = 0; lane < lanes; lane++) {
+                word |= (((base + lane) >> i) & 1) << lane;
+            }
+            circuit.set_input_packed(static_cast<size_t>(i), word);
+        }
+
+        circuit.propagate_packed();
+        passes++;
+
+        for (uint64_t lane = 0; lane < lanes; lane++) {
+            uint64_t v = base + lane;
+            uint64_t a = v & ((uint64_t{1} << bits) - 1);
+            uint64_t b = v >> bits;
+            uint64_t sum = 0;
+            for (int i = 0; i <= bits; i++) {
+                sum |= ((circuit.get_output_packed(static_cast<size_t>(i)) >> lane) & 1) << i;
+            }
+            if (sum != a + b) {
+                FAIL_CHECK(a << " + " << b << " gave " << sum);
+            }
+        }
+    }
+    return passes;
+}
+
+} // namespace
+
+TEST_CASE("Packed propagation checks every 7-bit adder input in 256 passes", "[propagation]") {
+    auto circuit = build_ripple_carry_adder(7);
+    CHECK(verify_adder_exhaustively_packed(*circuit, 7) == 256);
+
+    decompose_to_nand(*circuit);
+    CHECK(verify_adder_exhaustively_packed(*circuit, 7) == 256);
+}
+
+TEST_CASE("Packed propagation is independent of scalar state", "[propagation]") {
+    auto circuit = build_ripple_carry_adder(2);
+    circuit->set_input(0, true); // A = 1
+    (void)circuit->propagate();
+
+    // Lane 0: 3 + 3, lane 1: 0 + 0
+    for (size_t i = 0; i < 4; i++) {
+        circuit->set_input_packed(i, 0b01);
+    }
+    circuit->propagate_packed();
+
+    CHECK(circuit->get_output_packed(0) == 0b00); // S0
+    CHECK(circuit->get_output_packed(1) == 0b01); // S1
+    CHECK(circuit->get_output_packed(2) == 0b01); // Cout
+    CHECK(circuit->get_output(0) == true);        // scalar 1 + 0 untouched
+}
+
+TEST_CASE("Packed simulation requires a finalized circuit", "[propagation]") {
+    Circuit circuit;
+    Wire* w = circuit.add_wire();
+    circuit.mark_input(w);
+    circuit.mark_output(w);
+
+    CHECK_THROWS_AS(circuit.propagate_packed(), std::runtime_error);
+    CHECK_THROWS_AS(circuit.set_input_packed(0, 1), std::runtime_error);
+    CHECK_THROWS_AS(circuit.set_input_packed(1, 1), std::out_of_range);
+}
+
+TEST_CASE("Compiled netlist groups each level into same-type runs", "[propagation]") {
+    auto circuit = build_ripple_carry_adder(4);
+    decompose_to_nand(*circuit);
+    circuit->finalize();
+    const CompiledNetlist& net = circuit->compiled();
+
+    uint32_t next_slot = 0;
+    for (const GateRun& run : net.runs) {
+        REQUIRE(run.begin == next_slot);
+        REQUIRE(run.end > run.begin);
+        next_slot = run.end;
+
+        const uint32_t level = net.gate_levels[net.gate_ids[run.begin]];
+        for (uint32_t slot = run.begin; slot < run.end; slot++) {
+            CHECK(net.types[slot] == run.type);
+            CHECK(net.input_offsets[slot + 1] - net.input_offsets[slot] == run.arity);
+            CHECK(net.gate_levels[net.gate_ids[slot]] == level);
+        }
+    }
+    CHECK(next_slot == net.num_gates());
+}
+
+namespace {
+
+/// Exhaustively checks an adder with a W-word lane simulator. Returns the
+/// number of passes, i.e. total vectors / (64 * W).
+template <size_t W> int verify_adder_exhaustively_lanes(const Circuit& circuit, int bits) {
+    LaneSimulator<W> sim(circuit);
+    const uint64_t total = uint64_t{1} << (2 * bits);
+    int passes = 0;
+
+    for (uint64_t base = 0; base < total; base += LaneBlock<W>::LANES) {
+        for (int i = 0; i < 2 * bits; i++) {
+            LaneBlock<W> block{};
+            for (uint64_t lane = 0; lane < LaneBlock<W>::LANES && base + lane < total; lane++) {
+                block.words[lane / 64] |= (((base + lane) >> i) & 1) << (lane % 64);
+            }
+            sim.set_input(static_cast<size_t>(i), block);
+        }
+
+        sim.propagate();
+        passes++;
+
+        for (uint64_t lane = 0; lane < LaneBlock<W>::LANES && base + lane < total; lane++) {
+            uint64_t v = base + lane;
+            uint64_t a = v & ((uint64_t{1} << bits) - 1);
+            uint64_t b = v >> bits;
+            uint64_t sum = 0;
+            for (int i = 0; i <= bits; i++) {
+                uint64_t word = sim.get_output(static_cast<size_t>(i)).words[lane / 64];
+                sum |= ((word >> (lane % 64)) & 1) << i;
+            }
+            if (sum != a + b) {
+                FAIL_CHECK(a << " + " << b << " gave " << sum << " (width " << W << ")");
+            }
+        }
+    }
+    return passes;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Lane simulator checks every 7-bit adder input at each width",
+                   "[propagation][lanes]", LaneBlock<1>, LaneBlock<2>, LaneBlock<4>) {
+    constexpr size_t W = TestType::WORDS;
+    const int expected_passes = static_cast<int>(16384 / TestType::LANES);
+
+    auto circuit = build_ripple_carry_adder(7);
+    CHECK(verify_adder_exhaustively_lanes<W>(*circuit, 7) == expected_passes);
+
+    decompose_to_nand(*circuit);
+    CHECK(verify_adder_exhaustively_lanes<W>(*circuit, 7) == expected_passes);
+}
+
+TEMPLATE_TEST_CASE("Lane simulator matches scalar propagation on n-ary gates",
+                   "[propagation][lanes]", LaneBlock<1>, LaneBlock<2>, LaneBlock<4>) {
+    constexpr size_t W = TestType::WORDS;
+
+    // Four inputs feed 3-input AND/NAND/OR/XOR, a NOT, a BUFFER and a
+    // 2-input XOR of two of those, plus a dangling gate with no output wire.
+    Circuit circuit;
+    std::vector<Wire*> in;
+    for (int i = 0; i < 4; i++) {
+        in.push_back(circuit.add_wire());
+        circuit.mark_input(in.back());
+    }
+    auto add = [&](GateType type, std::vector<Wire*> inputs) {
+        Gate* g = circuit.add_gate(type);
+        for (Wire* w : inputs) {
+            circuit.connect(w, nullptr, g);
+        }
+        Wire* out = circuit.add_wire();
+        circuit.connect(out, g, nullptr);
+        circuit.mark_output(out);
+        return out;
+    };
+    Wire* w_and = add(GateType::AND, {in[0], in[1], in[2]});
+    Wire* w_nand = add(GateType::NAND, {in[1], in[2], in[3]});
+    add(GateType::OR, {in[0], in[2], in[3]});
+    add(GateType::XOR, {in[0], in[1], in[3]});
+    add(GateType::NOT, {in[3]});
+    add(GateType::BUFFER, {in[2]});
+    add(GateType::XOR, {w_and, w_nand});
+    Gate* dangling = circuit.add_gate(GateType::AND);
+    circuit.connect(in[0], nullptr, dangling);
+    circuit.connect(in[1], nullptr, dangling);
+    circuit.finalize();
+
+    std::mt19937_64 rng(42);
+    LaneSimulator<W> sim(circuit);
+    std::vector<LaneBlock<W>> inputs(4);
+    for (size_t i = 0; i < 4; i++) {
+        for (uint64_t& word : inputs[i].words) {
+            word = rng();
+        }
+        sim.set_input(i, inputs[i]);
+    }
+    sim.propagate();
+
+    for (size_t lane = 0; lane < TestType::LANES; lane++) {
+        for (size_t i = 0; i < 4; i++) {
+            circuit.set_input(i, (inputs[i].words[lane / 64] >> (lane % 64)) & 1);
+        }
+        (void)circuit.propagate();
+        for (size_t o = 0; o < circuit.num_outputs(); o++) {
+            bool lane_value = (sim.get_output(o).words[lane / 64] >> (lane % 64)) & 1;
+            if (lane_value != circuit.get_output(o)) {
+                FAIL_CHECK("output " << o << " lane " << lane << " (width " << W << ")");
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Lane simulator validates its circuit", "[propagation][lanes]", LaneBlock<1>,
+                   LaneBlock<2>, LaneBlock<4>) {
+    constexpr size_t W = TestType::WORDS;
+
+    Circuit circuit;
+    Wire* a = circuit.add_wire();
+    Wire* b = circuit.add_wire();
+    Wire* out = circuit.add_wire();
+    Gate* g = circuit.add_gate(GateType::NOT);
+    circuit.connect(a, nullptr, g);
+    circuit.connect(b, nullptr, g);
+    circuit.connect(out, g, nullptr);
+    circuit.mark_input(a);
+    circuit.mark_output(out);
+
+    CHECK_THROWS_AS(LaneSimulator<W>(circuit), std::runtime_error);
+    CHECK_THROWS_AS(circuit.finalize(), std::invalid_argument); // NOT with 2 inputs
+
+    Circuit valid;
+    Wire* in = valid.add_wire();
+    Wire* inv = valid.add_wire();
+    Gate* n = valid.add_gate(GateType::NOT);
+    valid.connect(in, nullptr, n);
+    valid.connect(inv, n, nullptr);
+    valid.mark_input(in);
+    valid.mark_output(inv);
+    valid.finalize();
+
+    LaneSimulator<W> sim(valid);
+    CHECK_THROWS_AS(sim.set_input(1, LaneBlock<W>{}), std::out_of_range);
+    CHECK_THROWS_AS(sim.get_output(1), std::out_of_range);
+}
+
+namespace {
+
+std::vector<uint32_t> gate_ids(const std::vector<Gate*>& gates) {
+    std::vector<uint32_t> ids;
+    for (const Gate* g : gates) {
+        ids.push_back(g->get_id());
+    }
+    return ids;
+}
+
+std::vector<uint32_t> wire_ids(const std::vector<Wire*>& wires) {
+    std::vector<uint32_t> ids;
+    for (const Wire* w : wires) {
+        ids.push_back(w->get_id());
+    }
+    return ids;
+}
+
+} // namespace
+
+TEST_CASE("Incremental propagation reports exactly what a full pass would", "[propagation]") {
+    auto incremental = build_ripple_carry_adder(16);
+    auto reference = build_ripple_carry_adder(16);
+    decompose_to_nand(*incremental);
+    decompose_to_nand(*reference);
+    (void)incremental->propagate();
+    (void)reference->propagate();
+
+    std::mt19937 rng(7);
+    for (int step = 0; step < 200; step++) {
+        // Toggle one to three random inputs per step
+        int toggles = 1 + static_cast<int>(rng() % 3);
+        for (int t = 0; t < toggles; t++) {
+            size_t i = rng() % incremental->num_inputs();
+            bool v = !incremental->input_wires()[i]->get_value();
+            incremental->set_input(i, v);
+            reference->set_input(i, v);
+        }
+
+        // Re-finalizing marks every gate dirty, forcing a full evaluation
+        reference->finalize();
+        PropagationResult full = reference->propagate();
+        PropagationResult inc = incremental->propagate();
+
+        REQUIRE(gate_ids(inc.changed_gates) == gate_ids(full.changed_gates));
+        REQUIRE(wire_ids(inc.changed_wires) == wire_ids(full.changed_wires));
+        CHECK(inc.gates_evaluated <= full.gates_evaluated);
+        for (size_t o = 0; o < incremental->num_outputs(); o++) {
+            REQUIRE(incremental->get_output(o) == reference->get_output(o));
+        }
+    }
+}
+
+TEST_CASE("Incremental propagation cost follows activity, not gate count", "[propagation]") {
+    auto circuit = build_ripple_carry_adder(64);
+    PropagationResult first = circuit->propagate();
+    CHECK(first.gates_evaluated == circuit->gates().size());
+
+    // A63 with B = 0 and no carry in touches only the top full adder
+    circuit->set_input(63, true);
+    PropagationResult toggle = circuit->propagate();
+    CHECK(toggle.gates_evaluated > 0);
+    CHECK(toggle.gates_evaluated <= 5);
+    CHECK(circuit->get_output(63) == true);
+
+    // Re-setting an input to its current value schedules nothing
+    circuit->set_input(63, true);
+    PropagationResult idle = circuit->propagate();
+    CHECK(idle.gates_evaluated == 0);
+    CHECK(idle.changed_gates.empty());
+    CHECK(idle.changed_wires.empty());
+}
+
+TEST_CASE("Incremental propagation keeps Gate dirty flags in sync", "[propagation]") {
+    auto circuit = build_ripple_carry_adder(2);
+    for (const auto& gate : circuit->gates()) {
+        CHECK(gate->is_dirty()); // nothing evaluated since finalize()
+    }
+
+    (void)circuit->propagate();
+    for (const auto& gate : circuit->gates()) {
+        CHECK_FALSE(gate->is_dirty());
+    }
+
+    // A0's readers become dirty until the next pass
+    Wire* a0 = circuit->input_wires()[0];
+    circuit->set_input(0, true);
+    for (const Gate* dest : a0->get_destinations()) {
+        CHECK(dest->is_dirty());
+    }
+    (void)circuit->propagate();
+    for (const auto& gate : circuit->gates()) {
+        CHECK_FALSE(gate->is_dirty());
+    }
+}
+
+TEST_CASE("Finalize validates gate arity once", "[propagation]") {
+    Circuit circuit;
+    Wire* a = circuit.add_wire();
+    Gate* g = circuit.add_gate(GateType::AND);
+    circuit.connect(a, nullptr, g);
+    CHECK_THROWS_AS(circuit.finalize(), std::invalid_argument); // AND with 1 input
+
+    // Fan-in beyond MAX_GATE_INPUTS can't be packed into an input mask
+    Circuit wide;
+    Gate* big = wide.add_gate(GateType::OR);
+    for (size_t i = 0; i <= MAX_GATE_INPUTS; i++) {
+        Wire* w = wide.add_wire();
+        wide.connect(w, nullptr, big);
+        wide.mark_input(w);
+    }
+    CHECK_THROWS_AS(wide.finalize(), std::runtime_error);
+}
+
+TEST_CASE("Propagate into a caller-owned result reuses it", "[propagation]") {
+    auto circuit = build_ripple_carry_adder(4);
+    PropagationResult result;
+    circuit->propagate(result);
+    CHECK(result.gates_evaluated == circuit->gates().size());
+
+    circuit->set_input(0, true);
+    circuit->propagate(result);
+    CHECK_FALSE(result.changed_wires.empty());
+    CHECK(circuit->get_output(0) == true);
+
+    // Stale contents from the previous pass are cleared
+    circuit->propagate(result);
+    CHECK(result.changed_gates.empty());
+    CHECK(result.changed_wires.empty());
+    CHECK(result.gates_evaluated == 0);
+}
+
+namespace {
+
+/// Layered random netlist: each layer has @p width gates of mixed types
+/// reading from earlier layers, so every level is wide enough to split.
+std::unique_ptr<Circuit> build_wide_layered(int layers, int width, uint32_t seed) {
+    auto circuit = std::make_unique<Circuit>();
+    std::mt19937 rng(seed);
+    const GateType kinds[] = {GateType::AND, GateType::OR,  GateType::XOR,
+                              GateType::NAND, GateType::NOT, GateType::BUFFER};
+
+    std::vector<Wire*> available;
+    for (int i = 0; i < 64; i++) {
+        Wire* in = circuit->add_wire();
+        circuit->mark_input(in);
+        available.push_back(in);
+    }
+    for (int layer = 0; layer < layers; layer++) {
+        std::vector<Wire*> produced;
+        for (int g = 0; g < width; g++) {
+            GateType type = kinds[rng() % 6];
+            Gate* gate = circuit->add_gate(type);
+            size_t arity =
+                (type == GateType::NOT || type == GateType::BUFFER) ? 1 : 2 + rng() % 3;
+            for (size_t k = 0; k < arity; k++) {
+                circuit->connect(available[rng() % available.size()], nullptr, gate);
+            }
+            Wire* out = circuit->add_wire();
+            circuit->connect(out, gate, nullptr);
+            produced.push_back(out);
+        }
+        available.insert(available.end(), produced.begin(), produced.end());
+    }
+    for (size_t i = available.size() - 128; i < available.size(); i++) {
+        circuit->mark_output(available[i]);
+    }
+    circuit->finalize();
+    return circuit;
+}
+
+} // namespace
+
+TEST_CASE("Parallel packed propagation matches serial", "[propagation][parallel]") {
+    auto serial = build_wide_layered(6, 3000, 11);
+    auto parallel = serial->clone();
+    parallel->set_parallelism(4, 1);
+    REQUIRE(parallel->thread_pool() != nullptr);
+    REQUIRE(serial->thread_pool() == nullptr);
+
+    std::mt19937_64 rng(5);
+    for (int pass = 0; pass < 4; pass++) {
+        for (size_t i = 0; i < serial->num_inputs(); i++) {
+            uint64_t lanes = rng();
+            serial->set_input_packed(i, lanes);
+            parallel->set_input_packed(i, lanes);
+        }
+        serial->propagate_packed();
+        parallel->propagate_packed();
+        for (size_t i = 0; i < serial->num_outputs(); i++) {
+            REQUIRE(parallel->get_output_packed(i) == serial->get_output_packed(i));
+        }
+    }
+}
+
+TEST_CASE("Parallel lane simulation matches serial", "[propagation][parallel][lanes]") {
+    auto serial = build_wide_layered(5, 2000, 23);
+    auto parallel = serial->clone();
+    parallel->set_parallelism(3, 512);
+
+    LaneSimulator<2> sim_serial(*serial);
+    LaneSimulator<2> sim_parallel(*parallel);
+    std::mt19937_64 rng(9);
+    for (size_t i = 0; i < serial->num_inputs(); i++) {
+        LaneBlock<2> block{{rng(), rng()}};
+        sim_serial.set_input(i, block);
+        sim_parallel.set_input(i, block);
+    }
+    sim_serial.propagate();
+    sim_parallel.propagate();
+    for (size_t i = 0; i < serial->num_outputs(); i++) {
+        REQUIRE(sim_parallel.get_output(i).words[0] == sim_serial.get_output(i).words[0]);
+        REQUIRE(sim_parallel.get_output(i).words[1] == sim_serial.get_output(i).words[1]);
+    }
+}
+
+TEST_CASE("Parallelism settings survive clone and can be turned off", "[propagation][parallel]") {
+    auto circuit = build_ripple_carry_adder(6);
+    circuit->set_parallelism(2, 64);
+    auto copy = circuit->clone();
+    REQUIRE(copy->thread_pool() != nullptr);
+    CHECK(copy->thread_pool() != circuit->thread_pool());
+    CHECK(copy->min_parallel_level_slots() == 64);
+
+    // Adder levels are far below the threshold, so this runs serially
+    CHECK(verify_adder_exhaustively_packed(*copy, 6) == 64);
+
+    circuit->set_parallelism(1);
+    CHECK(circuit->thread_pool() == nullptr);
+}
@@ -6,6 +6,9 @@
 
 #include "simulation/circuit.hpp"
 #include "timing/propagation_scheduler.hpp"
+#include "timing/static_timing.hpp"
+
+#include <stdexcept>
 
 using namespace gateflow;
 using Catch::Approx;
@@ -78,22 +81,22 @@ TEST_CASE("PropagationScheduler step advances exactly one depth", "[scheduler]")
 
     PropagationScheduler scheduler(&circuit);
 
-    CHECK(scheduler.current_depth() == Approx(-1.0f));
+    CHECK(scheduler.current_time() == Approx(-1.0f));
 
     scheduler.step();
     scheduler.tick(0.0f);
-    CHECK(scheduler.current_depth() == Approx(0.0f));
+    CHECK(scheduler.current_time() == Approx(0.0f));
 
     scheduler.tick(1.0f); // no-op while paused unless another step requested
-    CHECK(scheduler.current_depth() == Approx(0.0f));
+    CHECK(scheduler.current_time() == Approx(0.0f));
 
     scheduler.step();
     scheduler.tick(0.0f);
-    CHECK(scheduler.current_depth() == Approx(1.0f));
+    CHECK(scheduler.current_time() == Approx(1.0f));
 
     scheduler.step();
     scheduler.tick(0.0f);
-    CHECK(scheduler.current_depth() == Approx(2.0f));
+    CHECK(scheduler.current_time() == Approx(2.0f));
 }
 
 TEST_CASE("PropagationScheduler wire and gate resolution boundaries", "[scheduler]") {
@@ -130,3 +133,149 @@ TEST_CASE("PropagationScheduler wire and gate resolution boundaries", "[schedule
     CHECK(scheduler.wire_signal_progress(out) == Approx(1.0f));
     CHECK(scheduler.is_complete());
 }
+
+TEST_CASE("PropagationScheduler lists gates per depth", "[scheduler]") {
+    Circuit circuit = build_not_chain_3();
+    PropagationScheduler scheduler(&circuit);
+    const auto& order = circuit.topological_order();
+
+    for (int depth = 0; depth <= 2; depth++) {
+        REQUIRE(scheduler.gates_at_depth(depth).size() == 1);
+        CHECK(scheduler.gates_at_depth(depth)[0] == order[depth]);
+    }
+    CHECK(scheduler.gates_at_depth(-1).empty());
+    CHECK(scheduler.gates_at_depth(3).empty());
+}
+
+TEST_CASE("PropagationScheduler reports gates resolved by each tick", "[scheduler]") {
+    Circuit circuit = build_not_chain_3();
+    PropagationScheduler scheduler(&circuit);
+    scheduler.set_mode(PlaybackMode::REALTIME);
+    scheduler.set_speed(1.0f);
+    const auto& order = circuit.topological_order();
+
+    scheduler.tick(0.5f); // -1 -> -0.5: nothing crosses a depth
+    CHECK(scheduler.newly_resolved().empty());
+
+    scheduler.tick(0.5f); // -> 0.0: depth 0
+    REQUIRE(scheduler.newly_resolved().size() == 1);
+    CHECK(scheduler.newly_resolved()[0] == order[0]);
+
+    scheduler.tick(2.0f); // -> 2.0: depths 1 and 2 in one frame
+    REQUIRE(scheduler.newly_resolved().size() == 2);
+    CHECK(scheduler.newly_resolved()[0] == order[1]);
+    CHECK(scheduler.newly_resolved()[1] == order[2]);
+
+    scheduler.tick(5.0f); // clamped at max_depth + 1, nothing new
+    CHECK(scheduler.newly_resolved().empty());
+    CHECK(scheduler.is_complete());
+
+    scheduler.reset();
+    CHECK(scheduler.newly_resolved().empty());
+    scheduler.step();
+    scheduler.tick(0.0f);
+    REQUIRE(scheduler.newly_resolved().size() == 1);
+    CHECK(scheduler.newly_resolved()[0] == order[0]);
+}
+
+TEST_CASE("PropagationScheduler seeks and steps back without re-propagating", "[scheduler]") {
+    Circuit circuit = build_not_chain_3();
+    (void)circuit.propagate();
+    PropagationScheduler scheduler(&circuit);
+    const auto& order = circuit.topological_order();
+
+    scheduler.seek(1.5f); // forward: depths 0 and 1 resolve
+    CHECK(scheduler.current_time() == Approx(1.5f));
+    REQUIRE(scheduler.newly_resolved().size() == 2);
+    CHECK(scheduler.newly_resolved()[1] == order[1]);
+    CHECK(scheduler.gate_resolve_fraction(order[1]) == Approx(0.5f));
+    CHECK(scheduler.mode() == PlaybackMode::REALTIME); // seek leaves the mode alone
+
+    scheduler.seek(0.5f); // backward
+    CHECK(scheduler.newly_resolved().empty());
+    CHECK(scheduler.resolved_count() == 1);
+    CHECK_FALSE(scheduler.is_gate_resolved(order[1]));
+
+    scheduler.seek(100.0f);
+    CHECK(scheduler.current_time() == Approx(scheduler.end_time()));
+    scheduler.seek(-5.0f);
+    CHECK(scheduler.current_time() == Approx(-1.0f));
+
+    // step_back lands on each earlier depth, then before the inputs, and pauses
+    scheduler.seek(scheduler.end_time());
+    const float expected[] = {2.0f, 1.0f, 0.0f, -1.0f, -1.0f};
+    for (float t : expected) {
+        scheduler.step_back();
+        CHECK(scheduler.current_time() == Approx(t));
+    }
+    CHECK(scheduler.mode() == PlaybackMode::PAUSED);
+    CHECK(scheduler.resolved_count() == 0);
+
+    // A step back between depths lands on the depth just passed
+    scheduler.seek(1.25f);
+    scheduler.step_back();
+    CHECK(scheduler.current_time() == Approx(1.0f));
+}
+
+TEST_CASE("PropagationScheduler ignores gates from another circuit", "[scheduler]") {
+    Circuit circuit = build_not_chain_3();
+    Circuit other = build_single_not();
+    PropagationScheduler scheduler(&circuit);
+    scheduler.tick(10.0f);
+
+    const Gate* foreign = other.gates()[0];
+    CHECK(scheduler.gate_depth(foreign) == -1);
+    CHECK_FALSE(scheduler.is_gate_resolved(foreign));
+    CHECK(scheduler.gate_resolve_fraction(foreign) == Approx(0.0f));
+}
+
+TEST_CASE("PropagationScheduler replays in gate-delay time", "[scheduler]") {
+    Circuit circuit = build_not_chain_3();
+    DelayModel model = DelayModel::unit();
+    model.set_delay(GateType::NOT, 0.5f);
+    TimingAnalysis timing(circuit, model);
+    const auto& order = circuit.topological_order();
+
+    PropagationScheduler scheduler(&circuit);
+    scheduler.use_delay_time(timing);
+    REQUIRE(scheduler.uses_delay_time());
+    CHECK(scheduler.end_time() == Approx(1.5f));
+    CHECK(scheduler.gate_depth(order[2]) == 2); // Depths are unchanged
+
+    scheduler.set_mode(PlaybackMode::REALTIME);
+    scheduler.set_speed(1.0f);
+    scheduler.tick(1.0f); // -> 0.0: first NOT starts
+    REQUIRE(scheduler.newly_resolved().size() == 1);
+    scheduler.tick(0.75f); // -> 0.75: second NOT started at 0.5, halfway through
+    REQUIRE(scheduler.newly_resolved().size() == 1);
+    CHECK(scheduler.newly_resolved()[0] == order[1]);
+    CHECK(scheduler.gate_resolve_fraction(order[1]) == Approx(0.5f));
+    CHECK(scheduler.wire_signal_progress(order[0]->get_output()) == Approx(1.0f));
+    CHECK_FALSE(scheduler.is_gate_resolved(order[2]));
+
+    scheduler.tick(10.0f);
+    CHECK(scheduler.current_time() == Approx(1.5f));
+    CHECK(scheduler.is_complete());
+
+    // Steps land on each gate's start time
+    scheduler.reset();
+    const float expected[] = {0.0f, 0.5f, 1.0f, 1.5f, 1.5f};
+    for (float t : expected) {
+        scheduler.step();
+        scheduler.tick(0.0f);
+        CHECK(scheduler.current_time() == Approx(t));
+    }
+
+    scheduler.use_depth_time();
+    CHECK_FALSE(scheduler.uses_delay_time());
+    CHECK(scheduler.end_time() == Approx(3.0f));
+    CHECK(scheduler.current_time() == Approx(-1.0f));
+}
+
+TEST_CASE("PropagationScheduler rejects timing of another circuit", "[scheduler]") {
+    Circuit circuit = build_not_chain_3();
+    Circuit other = build_not_chain_3();
+    TimingAnalysis timing(other, DelayModel::unit());
+    PropagationScheduler scheduler(&circuit);
+    CHECK_THROWS_AS(scheduler.use_delay_time(timing), std::invalid_argument);
+}
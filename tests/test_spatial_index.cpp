@@ -0,0 +1,178 @@
+/// @file test_spatial_index.cpp
+/// @brief Tests for viewport culling queries, hit-testing and the pan/zoom view math
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "rendering/layout_engine.hpp"
+#include "rendering/spatial_index.hpp"
+#include "rendering/viewport.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/nand_decompose.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace gateflow;
+using Catch::Approx;
+
+namespace {
+
+bool overlaps(const Rect& a, const Rect& b) {
+    return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h && b.y <= a.y + a.h;
+}
+
+/// Gates whose rect meets @p area, by linear scan
+std::vector<uint32_t> gates_in(const Layout& layout, const Rect& area) {
+    std::vector<uint32_t> ids;
+    for (uint32_t g = 0; g < layout.gate_positions.size(); g++) {
+        if (overlaps(layout.gate_positions[g], area)) {
+            ids.push_back(g);
+        }
+    }
+    return ids;
+}
+
+/// Wires with a segment whose bounding box meets @p area, by linear scan
+std::vector<uint32_t> wires_in(const Layout& layout, const Rect& area) {
+    std::vector<uint32_t> ids;
+    for (uint32_t w = 0; w < layout.wire_paths.size(); w++) {
+        bool hit = false;
+        for (const WirePath& path : layout.wire_paths[w]) {
+            for (size_t i = 0; i + 1 < path.points.size() && !hit; i++) {
+                const Vec2 a = path.points[i];
+                const Vec2 b = path.points[i + 1];
+                Rect box = {std::min(a.x, b.x), std::min(a.y, b.y), std::abs(a.x - b.x),
+                            std::abs(a.y - b.y)};
+                hit = overlaps(box, area);
+            }
+        }
+        if (hit) {
+            ids.push_back(w);
+        }
+    }
+    return ids;
+}
+
+} // namespace
+
+TEST_CASE("Spatial index finds exactly the gates in view", "[spatial_index]") {
+    auto circuit = build_ripple_carry_adder(16);
+    decompose_to_nand(*circuit);
+    Layout layout = compute_layout(*circuit);
+    SpatialIndex index(layout);
+    VisibleSet visible;
+
+    const Rect& box = layout.bounding_box;
+    const Rect areas[] = {
+        box,
+        {box.x + box.w * 0.25f, box.y, box.w * 0.1f, box.h},
+        {box.x + box.w * 0.5f, box.y + box.h * 0.5f, 7.0f, 3.0f},
+        {box.x - 100.0f, box.y - 100.0f, 10.0f, 10.0f}, // Outside
+    };
+    for (const Rect& area : areas) {
+        index.query(area, visible);
+        CHECK(visible.gates() == gates_in(layout, area));
+
+        // Wires are conservative: every crossing wire is reported
+        std::vector<uint32_t> expected = wires_in(layout, area);
+        CHECK(std::includes(visible.wires().begin(), visible.wires().end(), expected.begin(),
+                            expected.end()));
+        CHECK(std::is_sorted(visible.wires().begin(), visible.wires().end()));
+        CHECK(std::adjacent_find(visible.wires().begin(), visible.wires().end()) ==
+              visible.wires().end());
+    }
+
+    // The whole box shows every routed wire
+    index.query(box, visible);
+    size_t routed = 0;
+    for (const auto& branches : layout.wire_paths) {
+        routed += branches.empty() ? 0 : 1;
+    }
+    CHECK(visible.wires().size() == routed);
+}
+
+TEST_CASE("Spatial index queries are independent of cell size", "[spatial_index]") {
+    auto circuit = build_ripple_carry_adder(8);
+    Layout layout = compute_layout(*circuit);
+    SpatialIndex coarse(layout, 50.0f);
+    SpatialIndex fine(layout, 0.5f);
+    CHECK(coarse.num_cells() < fine.num_cells());
+
+    const Rect area = {layout.bounding_box.x + 10.0f, layout.bounding_box.y + 2.0f, 12.0f, 9.0f};
+    VisibleSet a;
+    VisibleSet b;
+    coarse.query(area, a);
+    fine.query(area, b);
+    CHECK(a.gates() == b.gates());
+    CHECK(a.gates() == gates_in(layout, area));
+
+    // Reusing a set across queries does not leak earlier results
+    coarse.query({-1000.0f, -1000.0f, 1.0f, 1.0f}, a);
+    CHECK(a.gates().empty());
+    CHECK(a.wires().empty());
+    coarse.query(area, a);
+    CHECK(a.gates() == b.gates());
+}
+
+TEST_CASE("Zooming keeps the point under the anchor fixed", "[viewport]") {
+    float scale = 10.0f;
+    Vector2 offset = {30.0f, -20.0f};
+    const Vector2 anchor = {200.0f, 150.0f};
+    const Vec2 before = {(anchor.x - offset.x) / scale, (anchor.y - offset.y) / scale};
+
+    zoom_about(scale, offset, anchor, 2.0f, 1.0f, 100.0f);
+    CHECK(scale == Approx(20.0f));
+    CHECK((anchor.x - offset.x) / scale == Approx(before.x));
+    CHECK((anchor.y - offset.y) / scale == Approx(before.y));
+
+    // Clamped to the range, still about the anchor
+    zoom_about(scale, offset, anchor, 100.0f, 1.0f, 50.0f);
+    CHECK(scale == Approx(50.0f));
+    CHECK((anchor.x - offset.x) / scale == Approx(before.x));
+}
+
+TEST_CASE("Visible area inverts the view transform", "[viewport]") {
+    const float scale = 8.0f;
+    const Vector2 offset = {-40.0f, 16.0f};
+    Rect area = visible_area(scale, offset, {0.0f, 0.0f, 800.0f, 600.0f});
+    CHECK(area.x == Approx(5.0f));
+    CHECK(area.y == Approx(-2.0f));
+    CHECK(area.w == Approx(100.0f));
+    CHECK(area.h == Approx(75.0f));
+
+    CHECK(is_detailed(DETAIL_MIN_SCALE));
+    CHECK_FALSE(is_detailed(DETAIL_MIN_SCALE * 0.5f));
+}
+
+TEST_CASE("Gate hit-test matches a last-match linear scan", "[spatial_index]") {
+    auto circuit = build_ripple_carry_adder(8);
+    Layout layout = compute_layout(*circuit);
+    SpatialIndex index(layout);
+
+    const Rect& box = layout.bounding_box;
+    int hits = 0;
+    for (int i = -2; i <= 62; i++) {
+        for (int j = -2; j <= 62; j++) {
+            Vec2 p{box.x + box.w * static_cast<float>(i) / 60.0f,
+                   box.y + box.h * static_cast<float>(j) / 60.0f};
+            uint32_t expected = NO_GATE;
+            for (uint32_t g = 0; g < layout.gate_positions.size(); g++) {
+                const Rect& r = layout.gate_positions[g];
+                if (p.x >= r.x && p.x < r.x + r.w && p.y >= r.y && p.y < r.y + r.h) {
+                    expected = g;
+                }
+            }
+            CHECK(index.gate_at(p) == expected);
+            hits += expected != NO_GATE ? 1 : 0;
+        }
+    }
+    CHECK(hits > 0);
+
+    // Every gate is found at its own centre
+    for (uint32_t g = 0; g < layout.gate_positions.size(); g++) {
+        const Rect& r = layout.gate_positions[g];
+        CHECK(index.gate_at({r.x + r.w / 2, r.y + r.h / 2}) == g);
+    }
+}
@@ -0,0 +1,169 @@
+/// @file test_static_timing.cpp
+/// @brief Tests for arrival/required times, slack and critical-path extraction
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/circuit.hpp"
+#include "simulation/circuit_builder.hpp"
+#include "simulation/nand_decompose.hpp"
+#include "timing/static_timing.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace gateflow;
+using Catch::Approx;
+
+namespace {
+
+/// in ─ NOT ─ XOR ─ out      (long arm: NOT then XOR)
+/// in ──────┘                 (short arm straight into the XOR)
+/// plus an AND reading both inputs that drives a second output
+Circuit build_two_arm() {
+    Circuit c;
+    Wire* a = c.add_wire();
+    Wire* b = c.add_wire();
+    c.mark_input(a);
+    c.mark_input(b);
+
+    Gate* not_gate = c.add_gate(GateType::NOT);
+    Gate* xor_gate = c.add_gate(GateType::XOR);
+    Gate* and_gate = c.add_gate(GateType::AND);
+    Wire* not_out = c.add_wire();
+    Wire* xor_out = c.add_wire();
+    Wire* and_out = c.add_wire();
+
+    c.connect(a, nullptr, not_gate);
+    c.connect(not_out, not_gate, xor_gate);
+    c.connect(b, nullptr, xor_gate);
+    c.connect(xor_out, xor_gate, nullptr);
+    c.connect(a, nullptr, and_gate);
+    c.connect(b, nullptr, and_gate);
+    c.connect(and_out, and_gate, nullptr);
+    c.mark_output(xor_out);
+    c.mark_output(and_out);
+    c.finalize();
+    return c;
+}
+
+} // namespace
+
+TEST_CASE("DelayModel presets and overrides", "[sta]") {
+    DelayModel unit = DelayModel::unit();
+    DelayModel typical = DelayModel::typical();
+    for (size_t t = 0; t < GATE_TYPE_COUNT; t++) {
+        CHECK(unit.delay(static_cast<GateType>(t)) == 1.0f);
+        CHECK(typical.delay(static_cast<GateType>(t)) > 0.0f);
+    }
+    CHECK(typical.delay(GateType::NAND) == 1.0f);
+    CHECK(typical.delay(GateType::NOT) < typical.delay(GateType::NAND));
+    CHECK(typical.delay(GateType::XOR) > typical.delay(GateType::AND));
+
+    unit.set_delay(GateType::XOR, 3.5f);
+    CHECK(unit.delay(GateType::XOR) == 3.5f);
+    CHECK_THROWS_AS(unit.set_delay(GateType::OR, -1.0f), std::invalid_argument);
+    CHECK_THROWS_AS(unit.set_delay(GateType::OR, NAN), std::invalid_argument);
+}
+
+TEST_CASE("Arrival, required time and slack follow the delay model", "[sta]") {
+    Circuit c = build_two_arm();
+    DelayModel model = DelayModel::unit();
+    model.set_delay(GateType::NOT, 1.0f);
+    model.set_delay(GateType::XOR, 2.0f);
+    model.set_delay(GateType::AND, 1.5f);
+    TimingAnalysis sta(c, model);
+
+    const Gate* not_gate = c.gates()[0];
+    const Gate* xor_gate = c.gates()[1];
+    const Gate* and_gate = c.gates()[2];
+
+    CHECK(sta.arrival(c.input_wires()[0]) == Approx(0.0f));
+    CHECK(sta.arrival(not_gate) == Approx(1.0f));
+    CHECK(sta.arrival(xor_gate) == Approx(3.0f));
+    CHECK(sta.start_time(xor_gate) == Approx(1.0f));
+    CHECK(sta.arrival(and_gate) == Approx(1.5f));
+    CHECK(sta.critical_delay() == Approx(3.0f));
+
+    CHECK(sta.slack(not_gate) == Approx(0.0f));
+    CHECK(sta.slack(xor_gate) == Approx(0.0f));
+    CHECK(sta.required(and_gate) == Approx(3.0f)); // Outputs are required at the critical delay
+    CHECK(sta.slack(and_gate) == Approx(1.5f));
+}
+
+TEST_CASE("Critical path is listed from input to output", "[sta]") {
+    Circuit c = build_two_arm();
+    TimingAnalysis sta(c, DelayModel::typical());
+    const CriticalPath& path = sta.critical_path();
+
+    REQUIRE(path.gates.size() == 2);
+    REQUIRE(path.wires.size() == 3);
+    CHECK(path.gates[0]->get_type() == GateType::NOT);
+    CHECK(path.gates[1]->get_type() == GateType::XOR);
+    CHECK(path.wires.front() == c.input_wires()[0]);
+    CHECK(path.wires.back() == c.output_wires()[0]);
+    for (size_t i = 0; i < path.gates.size(); i++) {
+        CHECK(path.wires[i + 1] == path.gates[i]->get_output());
+    }
+
+    CHECK(sta.on_critical_path(path.gates[0]));
+    CHECK_FALSE(sta.on_critical_path(c.gates()[2]));
+    CHECK(sta.on_critical_path(c.input_wires()[0]));
+    CHECK_FALSE(sta.on_critical_path(c.input_wires()[1]));
+}
+
+TEST_CASE("Unit delays reproduce the levelized depth", "[sta]") {
+    auto circuit = build_ripple_carry_adder(7);
+    TimingAnalysis sta(*circuit, DelayModel::unit());
+    const CompiledNetlist& net = circuit->compiled();
+
+    for (const Gate* gate : circuit->gates()) {
+        CHECK(sta.start_time(gate) == Approx(static_cast<float>(net.gate_levels[gate->get_id()])));
+        CHECK(sta.slack(gate) >= -1e-4f);
+    }
+    CHECK(sta.critical_delay() == Approx(static_cast<float>(net.num_levels())));
+    CHECK(sta.critical_path().gates.size() == net.num_levels());
+}
+
+TEST_CASE("Critical path of a ripple-carry adder runs along the carry chain", "[sta]") {
+    for (bool nand : {false, true}) {
+        auto circuit = build_ripple_carry_adder(7);
+        if (nand) {
+            decompose_to_nand(*circuit);
+        }
+        TimingAnalysis sta(*circuit, DelayModel::typical());
+        const CriticalPath& path = sta.critical_path();
+        INFO((nand ? "NAND" : "logical") << " delay " << path.delay);
+
+        // It starts at a low operand bit (bit 1's XOR outlasts bit 0's carry
+        // AND) and ends at the top sum bit or the carry-out
+        const Wire* start = path.wires.front();
+        bool low_bit = false;
+        for (size_t i : {0, 1, 7, 8}) {
+            low_bit = low_bit || start == circuit->input_wires()[i];
+        }
+        CHECK(low_bit);
+        const Wire* end = path.wires.back();
+        CHECK((end == circuit->output_wires()[6] || end == circuit->output_wires()[7]));
+
+        float sum = 0.0f;
+        for (const Gate* gate : path.gates) {
+            sum += sta.delay(gate);
+            CHECK(sta.slack(gate) == Approx(0.0f).margin(1e-4));
+        }
+        CHECK(sum == Approx(path.delay));
+    }
+}
+
+TEST_CASE("TimingAnalysis rejects unfinalized circuits and foreign gates", "[sta]") {
+    Circuit open;
+    Wire* in = open.add_wire();
+    open.mark_input(in);
+    CHECK_THROWS_AS(TimingAnalysis(open, DelayModel::unit()), std::runtime_error);
+
+    Circuit c = build_two_arm();
+    Circuit other = build_two_arm();
+    TimingAnalysis sta(c, DelayModel::unit());
+    CHECK_THROWS_AS(sta.arrival(other.gates()[0]), std::invalid_argument);
+    CHECK_FALSE(sta.on_critical_path(other.gates()[0]));
+}
@@ -0,0 +1,65 @@
+/// @file test_thread_pool.cpp
+/// @brief Tests that ThreadPool covers every index exactly once per call
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/thread_pool.hpp"
+
+#include <atomic>
+#include <vector>
+
+using namespace gateflow;
+
+TEST_CASE("parallel_for visits each index exactly once", "[thread_pool]") {
+    ThreadPool pool(4);
+    REQUIRE(pool.concurrency() == 4);
+
+    std::vector<std::atomic<int>> hits(10'000);
+    for (int round = 0; round < 20; round++) {
+        pool.parallel_for(0, hits.size(), 97, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; i++) {
+                hits[i].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (const auto& h : hits) {
+        REQUIRE(h.load() == 20);
+    }
+}
+
+TEST_CASE("parallel_for is a barrier between calls", "[thread_pool]") {
+    ThreadPool pool(3);
+    std::vector<int> values(4096, 0);
+
+    // Each pass reads what the previous pass wrote at a different index
+    for (int pass = 1; pass <= 8; pass++) {
+        std::vector<int> prev = values;
+        pool.parallel_for(0, values.size(), 64, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; i++) {
+                values[i] = prev[(i + 1) % prev.size()] + 1;
+            }
+        });
+        for (int v : values) {
+            REQUIRE(v == pass);
+        }
+    }
+}
+
+TEST_CASE("parallel_for handles empty, tiny and single-thread ranges", "[thread_pool]") {
+    ThreadPool serial(1);
+    CHECK(serial.concurrency() == 1);
+
+    int calls = 0;
+    serial.parallel_for(5, 5, 1, [&](size_t, size_t) { calls++; });
+    CHECK(calls == 0);
+
+    size_t covered = 0;
+    serial.parallel_for(0, 1000, 10, [&](size_t lo, size_t hi) { covered += hi - lo; });
+    CHECK(covered == 1000);
+
+    ThreadPool pool(4);
+    std::vector<std::pair<size_t, size_t>> chunks;
+    pool.parallel_for(10, 20, 100, [&](size_t lo, size_t hi) { chunks.emplace_back(lo, hi); });
+    REQUIRE(chunks.size() == 1); // one chunk runs inline on the caller
+    CHECK(chunks[0] == std::make_pair<size_t, size_t>(10, 20));
+}
@@ -0,0 +1,215 @@
+/// @file test_vcd_writer.cpp
+/// @brief Tests for the streaming VCD trace: header, change windows and replay
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/circuit_builder.hpp"
+#include "timing/static_timing.hpp"
+#include "timing/vcd_writer.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace gateflow;
+
+namespace {
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/// A parsed trace: variable names by code, and every change after $dumpvars
+struct Trace {
+    std::map<std::string, std::string> names; ///< code -> name
+    std::map<std::string, char> initial;      ///< code -> value in $dumpvars
+    struct Change {
+        uint64_t time;
+        std::string code;
+        char value;
+    };
+    std::vector<Change> changes;
+    std::vector<uint64_t> times; ///< Every #time line, in file order
+    std::string timescale;
+};
+
+Trace parse_vcd(const std::string& path) {
+    std::ifstream in(path);
+    Trace trace;
+    std::string line;
+    bool dumpvars = false;
+    uint64_t time = 0;
+    while (std::getline(in, line)) {
+        std::istringstream words(line);
+        std::string first;
+        words >> first;
+        if (first == "$var") {
+            std::string type, width, code, name;
+            words >> type >> width >> code >> name;
+            trace.names[code] = name;
+        } else if (first == "$timescale") {
+            std::string unit;
+            words >> trace.timescale >> unit;
+            trace.timescale += " " + unit;
+        } else if (first == "$dumpvars") {
+            dumpvars = true;
+        } else if (first == "$end") {
+            dumpvars = false;
+        } else if (!first.empty() && first[0] == '#') {
+            time = std::stoull(first.substr(1));
+            trace.times.push_back(time);
+        } else if (!first.empty() && (first[0] == '0' || first[0] == '1')) {
+            const std::string code = first.substr(1);
+            if (dumpvars) {
+                trace.initial[code] = first[0];
+            } else {
+                trace.changes.push_back({time, code, first[0]});
+            }
+        }
+    }
+    return trace;
+}
+
+void apply(Circuit& circuit, int bits, uint64_t a, uint64_t b) {
+    for (int i = 0; i < bits; i++) {
+        circuit.set_input(i, ((a >> i) & 1) != 0);
+        circuit.set_input(bits + i, ((b >> i) & 1) != 0);
+    }
+}
+
+} // namespace
+
+TEST_CASE("VCD trace replays to the circuit's values after every vector", "[vcd]") {
+    const int bits = 6;
+    auto circuit = build_ripple_carry_adder(bits);
+    (void)circuit->propagate();
+
+    const std::string path = temp_path("gateflow_test_trace.vcd");
+    const uint64_t vectors[][2] = {{3, 4}, {63, 1}, {63, 1}, {0, 0}, {21, 42}};
+    std::vector<std::vector<char>> expected; // Per vector: value per wire id
+    uint64_t span = 0;
+    {
+        VcdWriter vcd(*circuit, path);
+        span = vcd.vector_span();
+        CHECK(span == circuit->compiled().num_levels() + 1);
+        PropagationResult result;
+        for (const auto& v : vectors) {
+            apply(*circuit, bits, v[0], v[1]);
+            circuit->propagate(result);
+            vcd.record(result);
+            std::vector<char> values;
+            for (const Wire* w : circuit->wires()) {
+                values.push_back(w->get_value() ? '1' : '0');
+            }
+            expected.push_back(std::move(values));
+        }
+        CHECK(vcd.vectors() == 5);
+        vcd.close();
+    }
+
+    Trace trace = parse_vcd(path);
+    std::remove(path.c_str());
+    CHECK(trace.timescale == "1 ns");
+    REQUIRE(trace.names.size() == circuit->wires().size());
+    REQUIRE(trace.initial.size() == circuit->wires().size());
+
+    // Name and code of every wire id
+    std::map<std::string, uint32_t> id_of;
+    for (const auto& [code, name] : trace.names) {
+        if (name.rfind("in", 0) == 0) {
+            id_of[code] = circuit->input_wires()[std::stoul(name.substr(2))]->get_id();
+        } else if (name.rfind("out", 0) == 0) {
+            id_of[code] = circuit->output_wires()[std::stoul(name.substr(3))]->get_id();
+        } else {
+            id_of[code] = static_cast<uint32_t>(std::stoul(name.substr(1)));
+        }
+    }
+
+    // Timestamps strictly increase
+    for (size_t i = 1; i < trace.times.size(); i++) {
+        CHECK(trace.times[i] > trace.times[i - 1]);
+    }
+
+    std::vector<char> values(circuit->wires().size(), '0');
+    for (const auto& [code, value] : trace.initial) {
+        values[id_of[code]] = value;
+    }
+    size_t next = 0;
+    for (size_t v = 0; v < expected.size(); v++) {
+        const uint64_t start = (v + 1) * span;
+        while (next < trace.changes.size() && trace.changes[next].time < start + span) {
+            const auto& change = trace.changes[next++];
+            CHECK(change.time >= start);
+            const uint32_t id = id_of[change.code];
+            CHECK(values[id] != change.value); // Only real changes are written
+            values[id] = change.value;
+
+            // Inputs at the window start, gate outputs one past their level
+            const Gate* src = circuit->wires()[id]->get_source();
+            const uint64_t offset =
+                src == nullptr ? 0 : circuit->compiled().gate_levels[src->get_id()] + 1;
+            CHECK(change.time == start + offset);
+        }
+        CHECK(values == expected[v]);
+    }
+    CHECK(next == trace.changes.size());
+}
+
+TEST_CASE("VCD trace in delay time stamps changes at their arrival", "[vcd]") {
+    const int bits = 4;
+    auto circuit = build_ripple_carry_adder(bits);
+    (void)circuit->propagate();
+    TimingAnalysis timing(*circuit, DelayModel::typical());
+
+    const std::string path = temp_path("gateflow_test_trace_delay.vcd");
+    uint64_t span = 0;
+    {
+        VcdWriter vcd(timing, path);
+        CHECK(vcd.delay_time());
+        span = vcd.vector_span();
+        CHECK(span >= static_cast<uint64_t>(timing.critical_delay() * VcdWriter::DELAY_TICKS));
+        apply(*circuit, bits, 15, 1);
+        vcd.record(circuit->propagate());
+        CHECK(vcd.changes() > 0);
+    }
+
+    Trace trace = parse_vcd(path);
+    std::remove(path.c_str());
+    CHECK(trace.timescale == "10 ps");
+    REQUIRE_FALSE(trace.changes.empty());
+    for (size_t i = 1; i < trace.times.size(); i++) {
+        CHECK(trace.times[i] > trace.times[i - 1]);
+    }
+    for (const auto& change : trace.changes) {
+        const std::string& name = trace.names[change.code];
+        const Wire* wire = nullptr;
+        if (name.rfind("in", 0) == 0) {
+            wire = circuit->input_wires()[std::stoul(name.substr(2))];
+        } else if (name.rfind("out", 0) == 0) {
+            wire = circuit->output_wires()[std::stoul(name.substr(3))];
+        } else {
+            wire = circuit->wires()[std::stoul(name.substr(1))];
+        }
+        const auto ticks = static_cast<uint64_t>(
+            std::llround(static_cast<double>(timing.arrival(wire)) * VcdWriter::DELAY_TICKS));
+        CHECK(change.time == span + ticks);
+    }
+}
+
+TEST_CASE("VCD writer rejects records after close", "[vcd]") {
+    auto circuit = build_ripple_carry_adder(2);
+    (void)circuit->propagate();
+    const std::string path = temp_path("gateflow_test_trace_closed.vcd");
+    VcdWriter vcd(*circuit, path);
+    vcd.close();
+    CHECK_THROWS_AS(vcd.record(PropagationResult{}), std::runtime_error);
+    CHECK_NOTHROW(vcd.close());
+    std::remove(path.c_str());
+
+    CHECK_THROWS_AS(VcdWriter(*circuit, temp_path("no_such_dir/trace.vcd")), std::runtime_error);
+}
@@ -0,0 +1,154 @@
+/// @file test_wire_geometry.cpp
+/// @brief Tests for the cached screen-space wire geometry and path interpolation
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "rendering/layout_engine.hpp"
+#include "rendering/wire_geometry.hpp"
+#include "simulation/circuit_builder.hpp"
+
+#include <cmath>
+
+using namespace gateflow;
+using Catch::Approx;
+
+namespace {
+
+/// Reference interpolation: walks the path segment by segment
+Vec2 linear_lerp(const WirePath& path, float t) {
+    if (t <= 0.0f || path.total_length <= 0.0f || path.points.size() < 2) {
+        return path.points.front();
+    }
+    float target = t * path.total_length;
+    for (size_t i = 0; i + 1 < path.points.size(); i++) {
+        float start = path.cumulative_lengths[i];
+        float end = path.cumulative_lengths[i + 1];
+        if (target <= end) {
+            float frac = (end - start > 0.001f) ? (target - start) / (end - start) : 0.0f;
+            return {path.points[i].x + (path.points[i + 1].x - path.points[i].x) * frac,
+                    path.points[i].y + (path.points[i + 1].y - path.points[i].y) * frac};
+        }
+    }
+    return path.points.back();
+}
+
+} // namespace
+
+TEST_CASE("Wire geometry has one segment per polyline edge", "[wire_geometry]") {
+    auto circuit = build_ripple_carry_adder(4);
+    Layout layout = compute_layout(*circuit);
+
+    WireGeometry geometry;
+    REQUIRE(geometry.update(*circuit, layout, 20.0f, {5.0f, 7.0f}));
+
+    size_t expected_segments = 0;
+    size_t expected_joints = 0;
+    for (const Wire* wire : circuit->wires()) {
+        const WireShape& shape = geometry.wire(wire->get_id());
+        size_t routed = 0;
+        for (const WirePath& path : layout.wire_branches(wire)) {
+            if (path.points.size() >= 2) {
+                expected_segments += path.points.size() - 1;
+                expected_joints += path.points.size() - 2;
+                routed++;
+            }
+        }
+        CHECK(shape.end_branch - shape.first_branch == routed);
+        CHECK(shape.carry == (routed > 0 && is_carry_wire(wire)));
+    }
+    CHECK(geometry.segments().size() == expected_segments);
+    CHECK(geometry.joints().size() == expected_joints);
+    CHECK_FALSE(geometry.carry_wires().empty());
+}
+
+TEST_CASE("Wire geometry rebuilds only when the layout or view changes", "[wire_geometry]") {
+    auto circuit = build_ripple_carry_adder(2);
+    Layout layout = compute_layout(*circuit);
+    Layout other = compute_layout(*circuit);
+
+    WireGeometry geometry;
+    CHECK(geometry.update(*circuit, layout, 10.0f, {0.0f, 0.0f}));
+    CHECK_FALSE(geometry.update(*circuit, layout, 10.0f, {0.0f, 0.0f}));
+    CHECK(geometry.update(*circuit, layout, 12.0f, {0.0f, 0.0f}));
+    CHECK(geometry.update(*circuit, layout, 12.0f, {3.0f, 0.0f}));
+    CHECK(geometry.update(*circuit, other, 12.0f, {3.0f, 0.0f}));
+    CHECK(geometry.rebuilds() == 4);
+
+    geometry.invalidate();
+    CHECK(geometry.update(*circuit, other, 12.0f, {3.0f, 0.0f}));
+    CHECK(geometry.rebuilds() == 5);
+}
+
+TEST_CASE("Wire segments are in screen space with unit normals", "[wire_geometry]") {
+    auto circuit = build_ripple_carry_adder(3);
+    Layout layout = compute_layout(*circuit);
+    const float scale = 25.0f;
+    const Vector2 offset = {40.0f, -12.0f};
+
+    WireGeometry geometry;
+    geometry.update(*circuit, layout, scale, offset);
+
+    for (const Wire* wire : circuit->wires()) {
+        const WireShape& shape = geometry.wire(wire->get_id());
+        const auto& paths = layout.wire_branches(wire);
+        uint32_t b = shape.first_branch;
+        for (const WirePath& path : paths) {
+            if (path.points.size() < 2) {
+                continue;
+            }
+            const WireBranchGeometry& branch = geometry.branches()[b++];
+            REQUIRE(branch.end_segment - branch.first_segment == path.points.size() - 1);
+            for (size_t i = 0; i + 1 < path.points.size(); i++) {
+                const WireSegment& seg = geometry.segments()[branch.first_segment + i];
+                CHECK(seg.from.x == Approx(path.points[i].x * scale + offset.x));
+                CHECK(seg.from.y == Approx(path.points[i].y * scale + offset.y));
+                CHECK(seg.to.x == Approx(path.points[i + 1].x * scale + offset.x));
+                CHECK(seg.to.y == Approx(path.points[i + 1].y * scale + offset.y));
+                CHECK(seg.start == path.cumulative_lengths[i]);
+                CHECK(seg.end == path.cumulative_lengths[i + 1]);
+
+                float dx = seg.to.x - seg.from.x;
+                float dy = seg.to.y - seg.from.y;
+                if (dx != 0.0f || dy != 0.0f) {
+                    CHECK(std::hypot(seg.normal.x, seg.normal.y) == Approx(1.0f));
+                    CHECK(seg.normal.x * dx + seg.normal.y * dy == Approx(0.0f).margin(1e-3));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Binary-search path interpolation matches a linear walk", "[wire_geometry]") {
+    auto circuit = build_ripple_carry_adder(4);
+    Layout layout = compute_layout(*circuit);
+    const float scale = 15.0f;
+    const Vector2 offset = {3.0f, 9.0f};
+
+    WireGeometry geometry;
+    geometry.update(*circuit, layout, scale, offset);
+
+    for (const Wire* wire : circuit->wires()) {
+        const WireShape& shape = geometry.wire(wire->get_id());
+        uint32_t b = shape.first_branch;
+        for (const WirePath& path : layout.wire_branches(wire)) {
+            if (path.points.size() < 2) {
+                continue;
+            }
+            const WireBranchGeometry& branch = geometry.branches()[b++];
+            for (int step = -1; step <= 33; step++) {
+                float t = static_cast<float>(step) / 32.0f;
+                Vec2 expected = linear_lerp(path, t);
+                Vec2 actual = lerp_along_path(path, t);
+                CHECK(actual.x == Approx(expected.x));
+                CHECK(actual.y == Approx(expected.y));
+
+                // point_at() is the same interpolation, on screen
+                float clamped = std::fmin(std::fmax(t, 0.0f), 1.0f);
+                Vector2 screen = geometry.point_at(branch, clamped * branch.length);
+                CHECK(screen.x == Approx(expected.x * scale + offset.x));
+                CHECK(screen.y == Approx(expected.y * scale + offset.y));
+            }
+        }
+    }
+}